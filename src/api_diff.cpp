@@ -0,0 +1,211 @@
+#include "api_diff.h"
+#include "entities/constant.h"
+#include "entities/enum.h"
+#include "entities/field.h"
+#include "entities/method.h"
+#include "entities/struct.h"
+#include "entities/traversal.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace busrpc {
+
+namespace {
+
+std::string GetFieldTypeStr(const Field& field)
+{
+    return field.isRepeated() ? "repeated " + field.fieldTypeName() : field.fieldTypeName();
+}
+
+std::string GetFieldFlagsStr(const Field& field)
+{
+    if (field.isObservable() && field.isHashed()) {
+        return "observable,hashed";
+    } else if (field.isObservable()) {
+        return "observable";
+    } else if (field.isHashed()) {
+        return "hashed";
+    } else {
+        return "";
+    }
+}
+
+std::string GetStructFlagsStr(const Struct& structure)
+{
+    return structure.isHashed() ? "hashed" : "";
+}
+
+// Traverses entities of the old project and compares them with the same entities of the new project
+class ApiDiffer {
+public:
+    ApiDiffer(const Project& oldProject, const Project& newProject, ApiDiff& diff):
+        oldProject_(oldProject),
+        newProject_(newProject),
+        diff_(diff)
+    { }
+
+    void diff(const Entity& root)
+    {
+        for (auto it = EntityIterator(&root); it != EntityIterator(); ++it) {
+            if (!diffEntity(**it)) {
+                it.skipNested();
+            }
+        }
+    }
+
+private:
+    // Return false if entities nested to the \a entity should not be compared
+    bool diffEntity(const Entity& entity)
+    {
+        switch (entity.type()) {
+        case EntityTypeId::Namespace:
+        case EntityTypeId::Service:
+            if (auto counterpart = find<Entity>(entity);
+                counterpart && oldProject_.contentHash(&entity) == newProject_.contentHash(counterpart)) {
+                ++diff_.unchanged;
+                return false;
+            }
+
+            break;
+        case EntityTypeId::Method:
+            if (!diffMethod(static_cast<const Method&>(entity))) {
+                return false;
+            }
+
+            break;
+        case EntityTypeId::Struct:
+            if (!diffStruct(static_cast<const Struct&>(entity))) {
+                return false;
+            }
+
+            break;
+        case EntityTypeId::Enum: diffEnum(static_cast<const Enum&>(entity)); return false;
+        case EntityTypeId::Field:
+        case EntityTypeId::Constant: return false;
+        default: break;
+        }
+
+        return true;
+    }
+
+    // Return counterpart of the old project \a entity in the new project or nullptr if it does not exist
+    template<typename TEntity>
+    const TEntity* find(const Entity& entity) const
+    {
+        auto counterpart = newProject_.find(entity.dname());
+        return counterpart && counterpart->type() == entity.type() ? static_cast<const TEntity*>(counterpart)
+                                                                   : nullptr;
+    }
+
+    void add(ApiChangeKind kind, const Entity& entity, std::string oldValue = {}, std::string newValue = {})
+    {
+        diff_.changes.push_back({kind, entity.dname(), std::move(oldValue), std::move(newValue)});
+    }
+
+    // Return false if method is removed
+    bool diffMethod(const Method& method)
+    {
+        auto counterpart = find<Method>(method);
+
+        if (!counterpart) {
+            add(ApiChangeKind::Method_Removed, method);
+            return false;
+        }
+
+        if (method.params() && !counterpart->params()) {
+            add(ApiChangeKind::Struct_Removed, *method.params());
+        }
+
+        if (method.retval() && !counterpart->retval()) {
+            add(ApiChangeKind::Struct_Removed, *method.retval());
+        }
+
+        return true;
+    }
+
+    // Return false if structure is removed
+    bool diffStruct(const Struct& structure)
+    {
+        auto counterpart = find<Struct>(structure);
+
+        if (!counterpart) {
+            return false;
+        }
+
+        if (structure.isHashed() != counterpart->isHashed()) {
+            add(ApiChangeKind::Struct_Flags_Changed,
+                structure,
+                GetStructFlagsStr(structure),
+                GetStructFlagsStr(*counterpart));
+        }
+
+        std::unordered_map<int32_t, const Field*> fields;
+
+        for (const auto& field: counterpart->fields()) {
+            fields.emplace(field->number(), field);
+        }
+
+        for (const auto& field: structure.fields()) {
+            auto it = fields.find(field->number());
+
+            // removed field is wire-compatible unless it's number is reused
+            if (it == fields.end()) {
+                continue;
+            }
+
+            const Field* newField = it->second;
+
+            if (newField->name() != field->name()) {
+                add(ApiChangeKind::Field_Number_Reused, *field, field->name(), newField->name());
+                continue;
+            }
+
+            if (GetFieldTypeStr(*field) != GetFieldTypeStr(*newField)) {
+                add(ApiChangeKind::Field_Type_Changed, *field, GetFieldTypeStr(*field), GetFieldTypeStr(*newField));
+            }
+
+            if (GetFieldFlagsStr(*field) != GetFieldFlagsStr(*newField)) {
+                add(ApiChangeKind::Field_Flags_Changed, *field, GetFieldFlagsStr(*field), GetFieldFlagsStr(*newField));
+            }
+        }
+
+        return true;
+    }
+
+    void diffEnum(const Enum& enumeration)
+    {
+        auto counterpart = find<Enum>(enumeration);
+
+        if (!counterpart) {
+            return;
+        }
+
+        for (const auto& constant: enumeration.constants()) {
+            auto it = counterpart->constants().find(constant->name());
+
+            if (it == counterpart->constants().end()) {
+                add(ApiChangeKind::Constant_Removed, *constant, std::to_string(constant->value()));
+            } else if ((*it)->value() != constant->value()) {
+                add(ApiChangeKind::Constant_Value_Changed,
+                    *constant,
+                    std::to_string(constant->value()),
+                    std::to_string((*it)->value()));
+            }
+        }
+    }
+
+    const Project& oldProject_;
+    const Project& newProject_;
+    ApiDiff& diff_;
+};
+} // namespace
+
+ApiDiff DiffApi(const Project& oldProject, const Project& newProject)
+{
+    ApiDiff diff;
+    ApiDiffer(oldProject, newProject, diff).diff(oldProject);
+    return diff;
+}
+} // namespace busrpc
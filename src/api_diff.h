@@ -0,0 +1,74 @@
+#pragma once
+
+#include "entities/project.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// \file api_diff.h Detection of the wire-incompatible changes between two versions of the busrpc project.
+
+namespace busrpc {
+
+/// Kind of the wire-incompatible change.
+enum class ApiChangeKind {
+    Method_Removed = 1,        ///< Method is removed.
+    Struct_Removed = 2,        ///< Method parameters or return value structure is removed.
+    Field_Number_Reused = 3,   ///< Field number is reused by the field with another name.
+    Field_Type_Changed = 4,    ///< Field type (including it's repeated flag) is changed.
+    Field_Flags_Changed = 5,   ///< Field observable or hashed flag is changed.
+    Struct_Flags_Changed = 6,  ///< Structure hashed flag is changed.
+    Constant_Removed = 7,      ///< Enumeration constant is removed.
+    Constant_Value_Changed = 8 ///< Enumeration constant value is changed.
+};
+
+/// Get API change kind string representation.
+/// \note \c nullptr is returned if \a kind is unknown.
+constexpr const char* GetApiChangeKindStr(ApiChangeKind kind)
+{
+    switch (kind) {
+    case ApiChangeKind::Method_Removed: return "method_removed";
+    case ApiChangeKind::Struct_Removed: return "struct_removed";
+    case ApiChangeKind::Field_Number_Reused: return "field_number_reused";
+    case ApiChangeKind::Field_Type_Changed: return "field_type_changed";
+    case ApiChangeKind::Field_Flags_Changed: return "field_flags_changed";
+    case ApiChangeKind::Struct_Flags_Changed: return "struct_flags_changed";
+    case ApiChangeKind::Constant_Removed: return "constant_removed";
+    case ApiChangeKind::Constant_Value_Changed: return "constant_value_changed";
+    default: return nullptr;
+    }
+}
+
+/// Wire-incompatible change.
+struct ApiChange {
+    /// Kind of the change.
+    ApiChangeKind kind;
+
+    /// Distinguished name of the changed entity (as defined by the old project version).
+    std::string dname;
+
+    /// Changed property value in the old project version (empty if not applicable).
+    std::string oldValue = {};
+
+    /// Changed property value in the new project version (empty if not applicable).
+    std::string newValue = {};
+};
+
+/// Result of the comparison of two project versions.
+struct ApiDiff {
+    /// Wire-incompatible changes in the order in which old project entities are traversed.
+    std::vector<ApiChange> changes;
+
+    /// Number of namespaces and services skipped because their content did not change.
+    std::size_t unchanged = 0;
+};
+
+/// Find wire-incompatible changes made to the \a oldProject by the \a newProject.
+/// \note Entities are matched by distinguished names. API namespaces and implementation services, which content hash
+///       (see \ref Project::contentHash) is the same in both projects, are skipped without comparing their entities.
+/// \note Following changes are detected: removed methods, removed method parameters and return value structures,
+///       reused field numbers, changed field types, changed observable and hashed flags of the fields and structures,
+///       removed enumeration constants and changed enumeration constant values. Changes made to the entities, which
+///       are removed as a whole (for example, structures nested in the removed method), are not reported.
+ApiDiff DiffApi(const Project& oldProject, const Project& newProject);
+} // namespace busrpc
@@ -1,14 +1,18 @@
 #include "app.h"
 #include "commands/check/check_command.h"
+#include "commands/diff/diff_command.h"
 #include "commands/gendoc/gendoc_command.h"
 #include "commands/help/help_command.h"
 #include "commands/imports/imports_command.h"
+#include "commands/lsp/lsp_command.h"
+#include "commands/run/run_command.h"
 #include "commands/version/version_command.h"
 #include "configure.h"
 
 #include <CLI/CLI.hpp>
 
 #include <cassert>
+#include <charconv>
 #include <set>
 #include <sstream>
 #include <string>
@@ -25,6 +29,15 @@ struct CheckOptions {
     bool ignoreDocWarnings = false;
     bool ignoreStyleWarnings = false;
     bool warningAsError = false;
+    std::string cacheFile = {};
+    std::string scope = {};
+    std::string shard = {};
+};
+
+struct DiffOptions {
+    std::string oldProjectDir = {};
+    std::string newProjectDir = {};
+    std::string protobufRoot = {};
 };
 
 struct GenDocOptions {
@@ -32,6 +45,11 @@ struct GenDocOptions {
     std::string projectDir = {};
     std::string outputDir = {};
     std::string protobufRoot = {};
+    std::size_t jobs = 1;
+    bool sharded = false;
+    bool compact = false;
+    bool searchIndex = false;
+    std::string scope = {};
 };
 
 struct HelpOptions {
@@ -43,6 +61,24 @@ struct ImportsOptions {
     std::string projectDir = {};
     std::string protobufRoot = {};
     bool onlyDeps = false;
+    bool all = false;
+    std::string format = {};
+    bool fast = false;
+    std::size_t jobs = 1;
+    bool reverse = false;
+    bool entities = false;
+    std::string indexFile = {};
+    std::string service = {};
+    std::vector<std::string> outputs = {};
+};
+
+struct LspOptions {
+    std::string projectDir = {};
+    std::string protobufRoot = {};
+};
+
+struct RunOptions {
+    std::vector<std::string> commands = {};
 };
 
 template<typename TCommand>
@@ -76,9 +112,33 @@ void AddOutputDirOption(CLI::App& app, std::string& outputDir)
     app.add_option("-d,--output-dir", outputDir, "Output directory");
 }
 
-void AddProtobufFilesPositionalOption(CLI::App& app, std::vector<std::string>& files)
+CLI::Option* AddScopeOption(CLI::App& app, std::string& scope)
+{
+    return app.add_option("--scope",
+                          scope,
+                          "Distinguished name of the project entity (for example, 'busrpc.api.billing') whose "
+                          "directory should be processed together with its dependencies instead of the whole project");
+}
+
+// Parse shard specification in the 'INDEX/COUNT' format, where INDEX is one-based
+bool ParseShard(const std::string& value, std::size_t& index, std::size_t& count)
+{
+    auto pos = value.find('/');
+
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    auto indexResult = std::from_chars(value.data(), value.data() + pos, index);
+    auto countResult = std::from_chars(value.data() + pos + 1, value.data() + value.size(), count);
+
+    return indexResult.ec == std::errc() && indexResult.ptr == value.data() + pos && countResult.ec == std::errc() &&
+           countResult.ptr == value.data() + value.size() && index >= 1 && index <= count;
+}
+
+CLI::Option* AddProtobufFilesPositionalOption(CLI::App& app, std::vector<std::string>& files)
 {
-    app.add_option("files", files, "Protobuf files");
+    return app.add_option("files", files, "Protobuf files");
 }
 
 } // namespace
@@ -91,12 +151,23 @@ void DefineCommand(CLI::App& app, const std::function<void(CheckArgs)>& callback
     app.description("Check API for conformance to the busrpc specification");
 
     app.final_callback([callback, optsPtr]() {
+        std::size_t shardIndex = 1;
+        std::size_t shardCount = 1;
+
+        if (!optsPtr->shard.empty()) {
+            ParseShard(optsPtr->shard, shardIndex, shardCount);
+        }
+
         callback({std::move(optsPtr->projectDir),
                   std::move(optsPtr->protobufRoot),
                   optsPtr->ignoreSpecWarnings,
                   optsPtr->ignoreDocWarnings,
                   optsPtr->ignoreStyleWarnings,
-                  optsPtr->warningAsError});
+                  optsPtr->warningAsError,
+                  std::move(optsPtr->cacheFile),
+                  std::move(optsPtr->scope),
+                  shardIndex - 1,
+                  shardCount});
     });
 
     AddProjectDirOption(app, optsPtr->projectDir);
@@ -106,6 +177,46 @@ void DefineCommand(CLI::App& app, const std::function<void(CheckArgs)>& callback
     app.add_flag("--ignore-doc", optsPtr->ignoreDocWarnings, "Ignore documentation warnings");
     app.add_flag("--ignore-style", optsPtr->ignoreStyleWarnings, "Ignore style warnings");
     app.add_flag("-w,--warning-as-error", optsPtr->warningAsError, "Treat warnings as errors");
+    app.add_option("--cache", optsPtr->cacheFile, "File where to cache check results between command invocations");
+    auto scopeOpt = AddScopeOption(app, optsPtr->scope);
+
+    app.add_option("--shard",
+                   optsPtr->shard,
+                   "Check only the shard of the project specified as INDEX/COUNT (namespaces and services are "
+                   "distributed between COUNT shards by hash of their names)")
+        ->check(CLI::Validator(
+            [](std::string& value) {
+                std::size_t index = 0;
+                std::size_t count = 0;
+                return ParseShard(value, index, count)
+                           ? std::string()
+                           : std::string("shard should be specified as INDEX/COUNT, where 1 <= INDEX <= COUNT");
+            },
+            "INDEX/COUNT"))
+        ->excludes(scopeOpt);
+}
+
+void DefineCommand(CLI::App& app, const std::function<void(DiffArgs)>& callback)
+{
+    assert(callback);
+
+    auto optsPtr = std::make_shared<DiffOptions>();
+    app.description("Detect wire-incompatible changes between two versions of the busrpc project");
+
+    app.final_callback([callback, optsPtr]() {
+        callback({std::move(optsPtr->oldProjectDir),
+                  std::move(optsPtr->newProjectDir),
+                  std::move(optsPtr->protobufRoot)});
+    });
+
+    AddProtobufRootOption(app, optsPtr->protobufRoot);
+
+    app.add_option("old", optsPtr->oldProjectDir, "Old busrpc project directory")
+        ->required()
+        ->check(CLI::ExistingDirectory);
+    app.add_option("new", optsPtr->newProjectDir, "New busrpc project directory")
+        ->required()
+        ->check(CLI::ExistingDirectory);
 }
 
 void DefineCommand(CLI::App& app, const std::function<void(GenDocArgs)>& callback)
@@ -120,21 +231,47 @@ void DefineCommand(CLI::App& app, const std::function<void(GenDocArgs)>& callbac
 
         if (optsPtr->format == GetGenDocFormatStr(GenDocFormat::Json)) {
             format = GenDocFormat::Json;
+        } else if (optsPtr->format == GetGenDocFormatStr(GenDocFormat::Cbor)) {
+            format = GenDocFormat::Cbor;
+        } else if (optsPtr->format == GetGenDocFormatStr(GenDocFormat::MsgPack)) {
+            format = GenDocFormat::MsgPack;
         }
 
         assert(format != static_cast<GenDocFormat>(0));
 
-        callback(
-            {format, std::move(optsPtr->projectDir), std::move(optsPtr->outputDir), std::move(optsPtr->protobufRoot)});
+        callback({format,
+                  std::move(optsPtr->projectDir),
+                  std::move(optsPtr->outputDir),
+                  std::move(optsPtr->protobufRoot),
+                  optsPtr->jobs,
+                  optsPtr->sharded,
+                  optsPtr->compact,
+                  optsPtr->searchIndex,
+                  std::move(optsPtr->scope)});
     });
 
     app.add_option("--format", optsPtr->format, "Documentation format")
         ->default_val(GetGenDocFormatStr(GenDocFormat::Json))
-        ->check(CLI::IsMember(std::set<std::string>{GetGenDocFormatStr(GenDocFormat::Json)}));
+        ->check(CLI::IsMember(std::set<std::string>{GetGenDocFormatStr(GenDocFormat::Json),
+                                                    GetGenDocFormatStr(GenDocFormat::Cbor),
+                                                    GetGenDocFormatStr(GenDocFormat::MsgPack)}));
 
     AddProjectDirOption(app, optsPtr->projectDir);
     AddOutputDirOption(app, optsPtr->outputDir);
     AddProtobufRootOption(app, optsPtr->protobufRoot);
+
+    app.add_option("-j,--jobs", optsPtr->jobs, "Number of threads used to generate documentation")
+        ->default_val(1)
+        ->check(CLI::PositiveNumber);
+
+    app.add_flag("--sharded",
+                 optsPtr->sharded,
+                 "Write documentation for each namespace, class, method and service to a separate file");
+
+    app.add_flag("--compact", optsPtr->compact, "Write JSON documentation in the compact schema with a string table");
+
+    app.add_flag("--search-index", optsPtr->searchIndex, "Write search index of the documentation");
+    AddScopeOption(app, optsPtr->scope);
 }
 
 void DefineCommand(CLI::App& app, const std::function<void(HelpArgs)>& callback)
@@ -151,9 +288,12 @@ void DefineCommand(CLI::App& app, const std::function<void(HelpArgs)>& callback)
 
     app.add_option("command", optsPtr->commandName, "Name of the command")
         ->check(CLI::IsMember(std::set<std::string>{GetCommandName(CommandId::Check),
+                                                    GetCommandName(CommandId::Diff),
                                                     GetCommandName(CommandId::GenDoc),
                                                     GetCommandName(CommandId::Help),
                                                     GetCommandName(CommandId::Imports),
+                                                    GetCommandName(CommandId::Lsp),
+                                                    GetCommandName(CommandId::Run),
                                                     GetCommandName(CommandId::Version)}));
 }
 
@@ -166,19 +306,120 @@ void DefineCommand(CLI::App& app, const std::function<void(ImportsArgs)>& callba
     app.positionals_at_end(true);
 
     app.final_callback([callback, optsPtr]() {
+        ImportsFormat format = static_cast<ImportsFormat>(0);
+
+        if (optsPtr->format == GetImportsFormatStr(ImportsFormat::List)) {
+            format = ImportsFormat::List;
+        } else if (optsPtr->format == GetImportsFormatStr(ImportsFormat::Depfile)) {
+            format = ImportsFormat::Depfile;
+        } else if (optsPtr->format == GetImportsFormatStr(ImportsFormat::Ninja)) {
+            format = ImportsFormat::Ninja;
+        } else if (optsPtr->format == GetImportsFormatStr(ImportsFormat::Json)) {
+            format = ImportsFormat::Json;
+        }
+
+        assert(format != static_cast<ImportsFormat>(0));
+
         callback({std::move(optsPtr->files),
                   std::move(optsPtr->projectDir),
                   std::move(optsPtr->protobufRoot),
-                  optsPtr->onlyDeps});
+                  optsPtr->onlyDeps,
+                  optsPtr->all,
+                  format,
+                  optsPtr->fast,
+                  optsPtr->jobs,
+                  optsPtr->reverse,
+                  optsPtr->entities,
+                  std::move(optsPtr->indexFile),
+                  std::move(optsPtr->service),
+                  std::move(optsPtr->outputs)});
     });
 
     AddProjectDirOption(app, optsPtr->projectDir);
     AddProtobufRootOption(app, optsPtr->protobufRoot);
-    AddProtobufFilesPositionalOption(app, optsPtr->files);
+    auto filesOpt = AddProtobufFilesPositionalOption(app, optsPtr->files);
 
     app.add_flag("--only-deps",
                  optsPtr->onlyDeps,
                  "Only output paths to the dependencies, do not output paths to the files themselves");
+
+    auto allOpt = app.add_flag("--all", optsPtr->all, "Process all protobuf files of the project")->excludes(filesOpt);
+
+    auto formatOpt = app.add_option("--format", optsPtr->format, "Output format")
+        ->default_val(GetImportsFormatStr(ImportsFormat::List))
+        ->check(CLI::IsMember(std::set<std::string>{GetImportsFormatStr(ImportsFormat::List),
+                                                    GetImportsFormatStr(ImportsFormat::Depfile),
+                                                    GetImportsFormatStr(ImportsFormat::Ninja),
+                                                    GetImportsFormatStr(ImportsFormat::Json)}));
+
+    app.add_flag("--fast", optsPtr->fast, "Only tokenize import statements instead of parsing files");
+
+    app.add_option("-j,--jobs", optsPtr->jobs, "Number of threads used to read import statements in fast mode")
+        ->default_val(1)
+        ->check(CLI::PositiveNumber);
+
+    auto reverseOpt = app.add_flag("--reverse", optsPtr->reverse, "Output files importing the specified file(s)")
+                          ->excludes(allOpt)
+                          ->excludes(formatOpt);
+
+    app.add_flag("--entities", optsPtr->entities, "Output directories of the busrpc entities instead of files")
+        ->needs(reverseOpt);
+
+    app.add_option("--index", optsPtr->indexFile, "File where to store import graph between command invocations")
+        ->needs(reverseOpt);
+
+    app.add_option("--service", optsPtr->service, "Process files needed to compile the service")
+        ->excludes(filesOpt)
+        ->excludes(allOpt)
+        ->excludes(reverseOpt);
+
+    app.add_option("-o,--output",
+                   optsPtr->outputs,
+                   "Pattern of the file generated from each processed file ('%' is replaced by the file path without "
+                   "extension), required for depfile and ninja formats")
+        ->excludes(reverseOpt);
+}
+
+void DefineCommand(CLI::App& app, const std::function<void(LspArgs)>& callback)
+{
+    assert(callback);
+
+    auto optsPtr = std::make_shared<LspOptions>();
+    app.description("Run language server for the project over standard input and output");
+
+    app.final_callback([callback, optsPtr]() {
+        callback({std::move(optsPtr->projectDir), std::move(optsPtr->protobufRoot)});
+    });
+
+    AddProjectDirOption(app, optsPtr->projectDir);
+    AddProtobufRootOption(app, optsPtr->protobufRoot);
+}
+
+void DefineCommand(CLI::App& app, const std::function<void(RunArgs)>& callback)
+{
+    assert(callback);
+
+    auto optsPtr = std::make_shared<RunOptions>();
+    app.description("Run several commands over the project parsed once");
+
+    app.final_callback([callback, optsPtr]() {
+        std::vector<RunArgs::CommandArgs> commands;
+
+        for (const auto& commandLine: optsPtr->commands) {
+            CLI::App commandApp;
+            DefineCommand(*commandApp.add_subcommand(GetCommandName(CommandId::Check)),
+                          [&commands](CheckArgs args) { commands.emplace_back(std::move(args)); });
+            DefineCommand(*commandApp.add_subcommand(GetCommandName(CommandId::GenDoc)),
+                          [&commands](GenDocArgs args) { commands.emplace_back(std::move(args)); });
+            commandApp.require_subcommand(1, 1);
+            commandApp.parse(commandLine);
+        }
+
+        callback({std::move(commands)});
+    });
+
+    app.add_option("commands", optsPtr->commands, "Commands to run with their options (for example, 'check -w')")
+        ->required();
 }
 
 void DefineCommand(CLI::App& app, const std::function<void(VersionArgs)>& callback)
@@ -198,9 +439,12 @@ void InitApp(CLI::App& app, std::ostream& out, std::ostream& err)
     });
 
     DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Check)), CreateInvoker<CheckCommand>(out, err));
+    DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Diff)), CreateInvoker<DiffCommand>(out, err));
     DefineCommand(*app.add_subcommand(GetCommandName(CommandId::GenDoc)), CreateInvoker<GenDocCommand>(out, err));
     DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Help)), CreateInvoker<HelpCommand>(out, err));
     DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Imports)), CreateInvoker<ImportsCommand>(out, err));
+    DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Lsp)), CreateInvoker<LspCommand>(out, err));
+    DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Run)), CreateInvoker<RunCommand>(out, err));
     DefineCommand(*app.add_subcommand(GetCommandName(CommandId::Version)), CreateInvoker<VersionCommand>(out, err));
 
     app.require_subcommand(0, 1);
@@ -0,0 +1,182 @@
+#include "check_cache.h"
+#include "configure.h"
+#include "entities/project.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace busrpc {
+
+namespace {
+
+constexpr const char* Version_Key = "version";
+constexpr const char* Entries_Key = "entries";
+constexpr const char* Category_Key = "category";
+constexpr const char* Value_Key = "value";
+constexpr const char* Description_Key = "description";
+constexpr const char* File_Key = "file";
+constexpr const char* Line_Key = "line";
+constexpr const char* Column_Key = "column";
+constexpr const char* Entity_Key = "entity";
+
+// Only errors of these categories are produced by the project check and thus can be cached
+const std::error_category* FindCategory(const std::string& name)
+{
+    for (auto category: {&spec_error_category(), &spec_warn_category(), &doc_warn_category(), &style_warn_category()}) {
+        if (name == category->name()) {
+            return category;
+        }
+    }
+
+    return nullptr;
+}
+} // namespace
+
+const CheckCache::Errors* CheckCache::find(uint64_t hash)
+{
+    auto it = entries_.find(hash);
+
+    if (it == entries_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+
+    ++hits_;
+    used_.insert(hash);
+    return &it->second;
+}
+
+const CheckCache::Errors& CheckCache::store(uint64_t hash, Errors errors)
+{
+    auto& entry = entries_[hash];
+    entry = std::move(errors);
+    used_.insert(hash);
+    return entry;
+}
+
+void CheckCache::prune()
+{
+    std::erase_if(entries_, [this](const auto& entry) { return !used_.contains(entry.first); });
+    used_.clear();
+}
+
+bool CheckCache::load(const std::filesystem::path& file)
+{
+    entries_.clear();
+    used_.clear();
+
+    std::ifstream in(file);
+
+    if (!in.is_open()) {
+        return false;
+    }
+
+    json doc = json::parse(in, nullptr, false);
+
+    if (!doc.is_object() || doc.value(Version_Key, "") != BUSRPC_VERSION || !doc[Entries_Key].is_object()) {
+        return false;
+    }
+
+    std::unordered_map<uint64_t, Errors> entries;
+
+    for (const auto& [key, value]: doc[Entries_Key].items()) {
+        if (!value.is_array()) {
+            return false;
+        }
+
+        Errors errors;
+
+        for (const auto& error: value) {
+            // required keys are checked before access, because const json::operator[] requires key to exist
+            if (!error.is_object() || !error.contains(Category_Key) || !error.contains(Value_Key) ||
+                !error.contains(Description_Key) || !error[Category_Key].is_string() ||
+                !error[Value_Key].is_number_integer() || !error[Description_Key].is_string()) {
+                return false;
+            }
+
+            auto category = FindCategory(error[Category_Key].get<std::string>());
+
+            if (!category) {
+                return false;
+            }
+
+            // error location is optional and is only stored if it is set
+            ErrorCollector::ErrorLocation location;
+
+            try {
+                location.file = error.value(File_Key, std::string{});
+                location.line = error.value(Line_Key, -1);
+                location.column = error.value(Column_Key, -1);
+                location.entity = error.value(Entity_Key, std::string{});
+            } catch (const json::exception&) {
+                return false;
+            }
+
+            errors.push_back({{error[Value_Key].get<int>(), *category},
+                              error[Description_Key].get<std::string>(),
+                              std::move(location)});
+        }
+
+        try {
+            std::size_t pos = 0;
+            uint64_t hash = std::stoull(key, &pos, 16);
+
+            if (pos != key.size()) {
+                return false;
+            }
+
+            entries.emplace(hash, std::move(errors));
+        } catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    entries_ = std::move(entries);
+    return true;
+}
+
+bool CheckCache::save(const std::filesystem::path& file) const
+{
+    json doc;
+    doc[Version_Key] = BUSRPC_VERSION;
+    doc[Entries_Key] = json::object();
+
+    for (auto hash: used_) {
+        auto& errors = doc[Entries_Key][HashToString(hash)];
+        errors = json::array();
+
+        for (const auto& error: entries_.at(hash)) {
+            json entry = {{Category_Key, error.code.category().name()},
+                          {Value_Key, error.code.value()},
+                          {Description_Key, error.description}};
+
+            if (!error.location.file.empty()) {
+                entry[File_Key] = error.location.file;
+            }
+
+            if (error.location.line >= 0) {
+                entry[Line_Key] = error.location.line;
+            }
+
+            if (error.location.column >= 0) {
+                entry[Column_Key] = error.location.column;
+            }
+
+            if (!error.location.entity.empty()) {
+                entry[Entity_Key] = error.location.entity;
+            }
+
+            errors.push_back(std::move(entry));
+        }
+    }
+
+    std::ofstream out(file);
+    out << doc;
+    return static_cast<bool>(out);
+}
+} // namespace busrpc
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "error_collector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// \file check_cache.h Cache of the project check results.
+
+namespace busrpc {
+
+/// Cache of the project check results.
+/// \note Cache maps content hash of the entity subtree (see \ref Project::contentHash) to the errors found in this
+///       subtree by the project check. If subtree does not change between two checks, it's errors are replayed from
+///       the cache instead of checking the subtree again.
+/// \note Cache is not thread-safe.
+class CheckCache {
+public:
+    /// Errors found in the entity subtree.
+    using Errors = std::vector<ErrorCollector::ErrorInfo>;
+
+    /// Return errors cached for the subtree with the specified \a hash or \c nullptr if subtree is not cached.
+    /// \note Method marks found entry as used (only used entries are saved by \ref save method).
+    const Errors* find(uint64_t hash);
+
+    /// Store \a errors found in the subtree with the specified \a hash and return stored errors.
+    /// \note Stored entry is marked as used.
+    const Errors& store(uint64_t hash, Errors errors);
+
+    /// Load cache from the \a file.
+    /// \note Returns \c false and leaves cache empty if file does not exist, can't be parsed or was created by
+    ///       another version of the development tool.
+    bool load(const std::filesystem::path& file);
+
+    /// Save cache to the \a file.
+    /// \note Only entries, which were used since the cache was loaded, are saved. This prevents cache from growing
+    ///       indefinitely when project changes.
+    /// \note Returns \c false if file can't be written.
+    bool save(const std::filesystem::path& file) const;
+
+    /// Remove entries, which were not used since the cache was loaded or since the previous call to this method.
+    /// \note Method resets marks of the used entries, so remaining entries are not saved by \ref save method until
+    ///       they are used again.
+    /// \note Allows long-living cache (like the one held by the language server) not to grow indefinitely when
+    ///       project changes.
+    void prune();
+
+    /// Number of subtrees, which errors were found in the cache.
+    std::size_t hits() const noexcept { return hits_; }
+
+    /// Number of subtrees, which errors were not found in the cache.
+    std::size_t misses() const noexcept { return misses_; }
+
+    /// Number of cache entries.
+    std::size_t size() const noexcept { return entries_.size(); }
+
+private:
+    std::unordered_map<uint64_t, Errors> entries_;
+    std::unordered_set<uint64_t> used_;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+} // namespace busrpc
@@ -1,3 +1,4 @@
+#include "check_cache.h"
 #include "commands/check/check_command.h"
 #include "parser/parser.h"
 
@@ -23,6 +24,7 @@ public:
         case CheckErrc::Protobuf_Parsing_Failed: return "Failed to parse protobuf file";
         case CheckErrc::File_Read_Failed: return "Failed to read file";
         case CheckErrc::Invalid_Project_Dir: return "Invalid busrpc project directory";
+        case CheckErrc::Invalid_Scope: return "Invalid scope";
         default: return "Unknown error";
         }
     }
@@ -36,32 +38,64 @@ public:
         case CheckErrc::Protobuf_Parsing_Failed: return condition == CommandError::Protobuf_Parsing_Failed;
         case CheckErrc::File_Read_Failed: return condition == CommandError::File_Operation_Failed;
         case CheckErrc::Invalid_Project_Dir: return condition == CommandError::Invalid_Argument;
+        case CheckErrc::Invalid_Scope: return condition == CommandError::Invalid_Argument;
         default: return false;
         }
     }
 };
-} // namespace
 
-std::error_code CheckCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
+std::vector<const std::error_category*> GetIgnoredCategories(const CheckArgs& args)
 {
     std::vector<const std::error_category*> ignoredCategories;
 
-    if (args().ignoreSpecWarnings()) {
+    if (args.ignoreSpecWarnings()) {
         ignoredCategories.push_back(&spec_warn_category());
     }
 
-    if (args().ignoreDocWarnings()) {
+    if (args.ignoreDocWarnings()) {
         ignoredCategories.push_back(&doc_warn_category());
     }
 
-    if (args().ignoreStyleWarnings()) {
+    if (args.ignoreStyleWarnings()) {
         ignoredCategories.push_back(&style_warn_category());
     }
 
+    return ignoredCategories;
+}
+} // namespace
+
+std::error_code CheckCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
+{
     Parser parser(args().projectDir(), args().protobufRootDir());
-    ErrorCollector ecol = parser.parse(std::move(ignoredCategories)).second;
+    CheckCache cache;
+    CheckCache* cachePtr = !args().cacheFile().empty() ? &cache : nullptr;
+
+    if (cachePtr) {
+        cache.load(args().cacheFile());
+    }
+
+    ParserShard shard{args().shardIndex(), args().shardCount()};
+    ErrorCollector ecol = parser.parse(GetIgnoredCategories(args()), cachePtr, args().scope(), shard).second;
+    return tryExecuteParsed(parser, ecol, cachePtr, out, err);
+}
+
+std::error_code CheckCommand::tryExecuteParsed(const Parser& parser,
+                                               const ErrorCollector& parserEcol,
+                                               const CheckCache* cache,
+                                               std::ostream& out,
+                                               std::ostream& err) const
+{
+    ErrorCollector ecol = parserEcol.filter(GetIgnoredCategories(args()));
     std::error_code result(0, check_error_category());
 
+    // project is not checked if parser error occurs, so cache should not be updated in this case
+    if (cache && !args().cacheFile().empty() &&
+        (!ecol || ecol.majorError()->code.category() != parser_error_category())) {
+        if (!cache->save(args().cacheFile())) {
+            err << ("Failed to write check cache to '" + args().cacheFile().string() + "' file") << std::endl;
+        }
+    }
+
     if (ecol) {
         err << ecol;
         ErrorCollector::ErrorInfo majorError = ecol.majorError().value();
@@ -69,6 +103,8 @@ std::error_code CheckCommand::tryExecuteImpl(std::ostream& out, std::ostream& er
         if (majorError.code.category() == parser_error_category()) {
             if (ecol.find(ParserErrc::Invalid_Project_Dir)) {
                 result = CheckErrc::Invalid_Project_Dir;
+            } else if (ecol.find(ParserErrc::Invalid_Scope)) {
+                result = CheckErrc::Invalid_Scope;
             } else if (ecol.find(ParserErrc::Read_Failed)) {
                 result = CheckErrc::File_Read_Failed;
             } else {
@@ -2,6 +2,7 @@
 
 #include "commands/command.h"
 
+#include <cstddef>
 #include <filesystem>
 #include <functional>
 #include <string>
@@ -16,6 +17,10 @@ class App;
 
 namespace busrpc {
 
+class CheckCache;
+class ErrorCollector;
+class Parser;
+
 /// Command-specific error code.
 enum class CheckErrc {
     /// Busrpc protobuf style violated.
@@ -38,7 +43,10 @@ enum class CheckErrc {
     File_Read_Failed = 5,
 
     /// Busrpc project directory does not exist or does not represent a valid project directory.
-    Invalid_Project_Dir = 6
+    Invalid_Project_Dir = 6,
+
+    /// Scope does not denote an entity directory of the project.
+    Invalid_Scope = 7
 };
 
 /// Return error category for the \c check command.
@@ -56,13 +64,21 @@ public:
               bool ignoreSpecWarnings = false,
               bool ignoreDocWarnings = false,
               bool ignoreStyleWarnings = false,
-              bool warningAsError = false):
+              bool warningAsError = false,
+              std::filesystem::path cacheFile = {},
+              std::string scope = {},
+              std::size_t shardIndex = 0,
+              std::size_t shardCount = 1):
         projectDir_(std::move(projectDir)),
         protobufRootDir_(std::move(protobufRootDir)),
         ignoreSpecWarnings_(ignoreSpecWarnings),
         ignoreDocWarnings_(ignoreDocWarnings),
         ignoreStyleWarnings_(ignoreStyleWarnings),
-        warningAsError_(warningAsError)
+        warningAsError_(warningAsError),
+        cacheFile_(std::move(cacheFile)),
+        scope_(std::move(scope)),
+        shardIndex_(shardIndex),
+        shardCount_(shardCount)
     { }
 
     /// Busrpc project directory.
@@ -90,6 +106,27 @@ public:
     /// Flag indicating whether warnings should be treated as errors.
     bool warningAsError() const noexcept { return warningAsError_; }
 
+    /// File where check results are cached between command invocations.
+    /// \note If empty, check results are not cached.
+    /// \note Cache allows to skip checking of the structures and enumerations, which did not change since the
+    ///       previous invocation. Command output does not depend on whether the cache is used or not.
+    const std::filesystem::path& cacheFile() const noexcept { return cacheFile_; }
+
+    /// Distinguished name of the project entity to be checked (for example, 'busrpc.api.billing').
+    /// \note If empty, whole project is checked. Otherwise only the entity subtree and it's dependencies are parsed
+    ///       and checked (see \ref Parser::parse).
+    const std::string& scope() const noexcept { return scope_; }
+
+    /// Zero-based index of the project shard to be checked.
+    /// \note Namespaces and services are distributed between shards by the stable hash of their names (see
+    ///       \ref ParserShard), so several command invocations with different shard indexes can check the project in
+    ///       parallel. Union of their outputs is the same as the output of the single invocation for the whole project.
+    std::size_t shardIndex() const noexcept { return shardIndex_; }
+
+    /// Total number of the project shards.
+    /// \note If \c 1, whole project is checked.
+    std::size_t shardCount() const noexcept { return shardCount_; }
+
 private:
     std::filesystem::path projectDir_;
     std::filesystem::path protobufRootDir_;
@@ -97,6 +134,10 @@ private:
     bool ignoreDocWarnings_;
     bool ignoreStyleWarnings_;
     bool warningAsError_;
+    std::filesystem::path cacheFile_;
+    std::string scope_;
+    std::size_t shardIndex_;
+    std::size_t shardCount_;
 };
 
 /// Check API for conformance to the busrpc specification.
@@ -108,6 +149,17 @@ public:
     /// Create command.
     explicit CheckCommand(CheckArgs args) noexcept: BaseType(std::move(args)) { }
 
+    /// Execute command for the project already parsed by the \a parser.
+    /// \note Errors of the categories ignored by the command are filtered out of the errors \a parserEcol collected
+    ///       during parsing, thus the same parsing result can be shared by several commands (see \ref RunCommand).
+    /// \note If \a cache is set, it is assumed that project was parsed using it and cache is saved to the
+    ///       \ref CheckArgs::cacheFile.
+    std::error_code tryExecuteParsed(const Parser& parser,
+                                     const ErrorCollector& parserEcol,
+                                     const CheckCache* cache,
+                                     std::ostream& out,
+                                     std::ostream& err) const;
+
 protected:
     /// Execute command.
     std::error_code tryExecuteImpl(std::ostream& out, std::ostream& err) const override;
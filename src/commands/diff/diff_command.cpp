@@ -0,0 +1,167 @@
+#include "commands/diff/diff_command.h"
+#include "api_diff.h"
+#include "generators/json_writer.h"
+#include "parser/parser.h"
+
+#include <cassert>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace busrpc {
+
+namespace {
+
+class DiffErrorCategory: public std::error_category {
+public:
+    const char* name() const noexcept override { return "diff"; }
+
+    std::string message(int code) const override
+    {
+        switch (static_cast<DiffErrc>(code)) {
+        case DiffErrc::Breaking_Change: return "Wire-incompatible API change detected";
+        case DiffErrc::Spec_Violated: return "Busrpc specification violated";
+        case DiffErrc::Protobuf_Parsing_Failed: return "Failed to parse protobuf file";
+        case DiffErrc::File_Read_Failed: return "Failed to read source file";
+        case DiffErrc::Invalid_Project_Dir: return "Invalid busrpc project directory";
+        default: return "Unknown error";
+        }
+    }
+
+    bool equivalent(int code, const std::error_condition& condition) const noexcept override
+    {
+        switch (static_cast<DiffErrc>(code)) {
+        case DiffErrc::Breaking_Change: return condition == CommandError::Spec_Violated;
+        case DiffErrc::Spec_Violated: return condition == CommandError::Spec_Violated;
+        case DiffErrc::Protobuf_Parsing_Failed: return condition == CommandError::Protobuf_Parsing_Failed;
+        case DiffErrc::File_Read_Failed: return condition == CommandError::File_Operation_Failed;
+        case DiffErrc::Invalid_Project_Dir: return condition == CommandError::Invalid_Argument;
+        default: return false;
+        }
+    }
+};
+
+constexpr std::size_t Diff_Indent = 2;
+
+// Parse project and return it together with the error code (error is also outputted to \a err)
+std::pair<ProjectPtr, std::error_code> ParseProject(const Parser& parser, std::ostream& err)
+{
+    std::vector<const std::error_category*> ignoredCategories;
+    ignoredCategories.push_back(&spec_warn_category());
+    ignoredCategories.push_back(&doc_warn_category());
+    ignoredCategories.push_back(&style_warn_category());
+
+    auto [projectPtr, ecol] = parser.parse(std::move(ignoredCategories));
+    std::error_code result(0, diff_error_category());
+
+    if (ecol) {
+        err << ecol;
+        ErrorCollector::ErrorInfo majorError = ecol.majorError().value();
+
+        if (majorError.code.category() == parser_error_category()) {
+            if (ecol.find(ParserErrc::Invalid_Project_Dir)) {
+                result = DiffErrc::Invalid_Project_Dir;
+            } else if (ecol.find(ParserErrc::Read_Failed)) {
+                result = DiffErrc::File_Read_Failed;
+            } else {
+                result = DiffErrc::Protobuf_Parsing_Failed;
+            }
+        } else {
+            assert(majorError.code.category() == spec_error_category());
+            result = DiffErrc::Spec_Violated;
+        }
+    }
+
+    return {std::move(projectPtr), result};
+}
+
+void WriteOptionalString(JsonWriter& writer, const std::string& value)
+{
+    if (value.empty()) {
+        writer.nullValue();
+    } else {
+        writer.stringValue(value);
+    }
+}
+
+void WriteDiff(std::ostream& out, const ApiDiff& diff)
+{
+    JsonWriter writer(out, Diff_Indent);
+    writer.beginObject();
+    writer.key("changes");
+    writer.beginArray();
+
+    for (const auto& change: diff.changes) {
+        writer.beginObject();
+        writer.key("dname");
+        writer.stringValue(change.dname);
+        writer.key("kind");
+        writer.stringValue(GetApiChangeKindStr(change.kind));
+        writer.key("new");
+        WriteOptionalString(writer, change.newValue);
+        writer.key("old");
+        WriteOptionalString(writer, change.oldValue);
+        writer.endObject();
+    }
+
+    writer.endArray();
+    writer.key("compatible");
+    writer.boolValue(diff.changes.empty());
+    writer.key("unchanged");
+    writer.intValue(static_cast<int64_t>(diff.unchanged));
+    writer.endObject();
+    writer.flush();
+    out << std::endl;
+}
+} // namespace
+
+std::error_code DiffCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
+{
+    Parser oldParser(args().oldProjectDir(), args().protobufRootDir());
+    Parser newParser(args().newProjectDir(), args().protobufRootDir());
+    auto [oldProjectPtr, oldResult] = ParseProject(oldParser, err);
+    auto [newProjectPtr, newResult] = ParseProject(newParser, err);
+
+    // project with specification errors is still compared (like it is still documented by the 'gendoc' command)
+    for (auto parseResult: {oldResult, newResult}) {
+        if (parseResult && parseResult != DiffErrc::Spec_Violated) {
+            err << "Failed to compare busrpc projects in '" << oldParser.projectDir().string() << "' and '"
+                << newParser.projectDir().string() << "' directories" << std::endl;
+            return parseResult;
+        }
+    }
+
+    for (const auto& [parser, parseResult]: {std::pair(&oldParser, oldResult), std::pair(&newParser, newResult)}) {
+        if (parseResult) {
+            err << "Busrpc project in '" << parser->projectDir().string()
+                << "' directory violates the specification, comparison result may be incomplete" << std::endl;
+        }
+    }
+
+    ApiDiff diff = DiffApi(*oldProjectPtr, *newProjectPtr);
+    WriteDiff(out, diff);
+
+    // breaking changes are reported regardless of the specification errors, because they are the main result
+    if (!diff.changes.empty()) {
+        err << ("Busrpc project in '" + newParser.projectDir().string() +
+                "' directory is not wire-compatible with the project in '" + oldParser.projectDir().string() +
+                "' directory")
+            << std::endl;
+        return DiffErrc::Breaking_Change;
+    }
+
+    return oldResult ? oldResult : newResult;
+}
+
+const std::error_category& diff_error_category()
+{
+    static const DiffErrorCategory category;
+    return category;
+}
+
+std::error_code make_error_code(DiffErrc e)
+{
+    return {static_cast<int>(e), diff_error_category()};
+}
+} // namespace busrpc
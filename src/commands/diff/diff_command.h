@@ -0,0 +1,100 @@
+#pragma once
+
+#include "commands/command.h"
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <system_error>
+
+/// \dir commands/diff Types and utilites for \c diff command implementation.
+/// \file diff_command.h Command \c diff implementation.
+
+namespace CLI {
+class App;
+}
+
+namespace busrpc {
+
+/// Command-specific error code.
+enum class DiffErrc {
+    /// New project version contains wire-incompatible changes.
+    Breaking_Change = 1,
+
+    /// Busrpc specification violated by one of the project versions.
+    Spec_Violated = 2,
+
+    /// Failed to parse protobuf file.
+    Protobuf_Parsing_Failed = 3,
+
+    /// Failed to read source file.
+    File_Read_Failed = 4,
+
+    /// Busrpc project directory does not exist or does not represent a valid project directory.
+    Invalid_Project_Dir = 5
+};
+
+/// Return error category for the \c diff command.
+const std::error_category& diff_error_category();
+
+/// Create error code from the \ref DiffErrc value.
+std::error_code make_error_code(DiffErrc errc);
+
+/// Arguments of the \c diff command.
+class DiffArgs {
+public:
+    /// Create \c diff command arguments.
+    DiffArgs(std::filesystem::path oldProjectDir,
+             std::filesystem::path newProjectDir,
+             std::filesystem::path protobufRootDir = {}):
+        oldProjectDir_(std::move(oldProjectDir)),
+        newProjectDir_(std::move(newProjectDir)),
+        protobufRootDir_(std::move(protobufRootDir))
+    { }
+
+    /// Directory of the old busrpc project version.
+    const std::filesystem::path& oldProjectDir() const noexcept { return oldProjectDir_; }
+
+    /// Directory of the new busrpc project version.
+    const std::filesystem::path& newProjectDir() const noexcept { return newProjectDir_; }
+
+    /// Root directory for protobuf built-in '.proto' files ('google/protobuf/descriptor.proto', etc.).
+    /// \note On *nix systems, '/usr/include' and '/usr/include/local' are implicitly added to the list of directories
+    ///       where to search built-in protobuf '.proto' files. However, this directories are only searched if
+    ///       file was not found in the command's protobuf root directory.
+    const std::filesystem::path& protobufRootDir() const noexcept { return protobufRootDir_; }
+
+private:
+    std::filesystem::path oldProjectDir_;
+    std::filesystem::path newProjectDir_;
+    std::filesystem::path protobufRootDir_;
+};
+
+/// Detect wire-incompatible changes between two versions of the busrpc project.
+/// \note Command outputs JSON object with the following properties:
+///       - "changes" - array of detected changes (objects with "dname", "kind", "new" and "old" properties, where
+///         "kind" is one of the \ref ApiChangeKind string representations and "new" and "old" are changed property
+///         values or \c null if not applicable);
+///       - "compatible" - \c true if no wire-incompatible changes are detected;
+///       - "unchanged" - number of namespaces and services skipped because their content did not change.
+class DiffCommand: public Command<CommandId::Diff, DiffArgs> {
+public:
+    /// Base type.
+    using BaseType = Command<CommandId::Diff, DiffArgs>;
+
+    /// Create command.
+    explicit DiffCommand(DiffArgs args) noexcept: BaseType(std::move(args)) { }
+
+protected:
+    /// Execute command.
+    std::error_code tryExecuteImpl(std::ostream& out, std::ostream& err) const override;
+};
+
+/// Define \c diff command line options and set a \a callback to be invoked when \a app encounters the command.
+void DefineCommand(CLI::App& app, const std::function<void(DiffArgs)>& callback);
+} // namespace busrpc
+
+namespace std {
+template<>
+struct is_error_code_enum<busrpc::DiffErrc>: true_type { };
+} // namespace std
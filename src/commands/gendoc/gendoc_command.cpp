@@ -1,9 +1,16 @@
 #include "commands/gendoc/gendoc_command.h"
+#include "generators/cbor_generator.h"
+#include "generators/incremental_writer.h"
 #include "generators/json_generator.h"
+#include "generators/msgpack_generator.h"
+#include "generators/search_index.h"
 #include "parser/parser.h"
 
 #include <cassert>
+#include <filesystem>
+#include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -24,6 +31,8 @@ public:
         case GenDocErrc::File_Read_Failed: return "Failed to read source file";
         case GenDocErrc::File_Write_Failed: return "Failed to write generated documentation";
         case GenDocErrc::Invalid_Project_Dir: return "Invalid busrpc project directory";
+        case GenDocErrc::Unsupported_Format: return "Documentation format is not supported";
+        case GenDocErrc::Invalid_Scope: return "Invalid scope";
         default: return "Unknown error";
         }
     }
@@ -36,20 +45,148 @@ public:
         case GenDocErrc::File_Read_Failed: return condition == CommandError::File_Operation_Failed;
         case GenDocErrc::File_Write_Failed: return condition == CommandError::File_Operation_Failed;
         case GenDocErrc::Invalid_Project_Dir: return condition == CommandError::Invalid_Argument;
+        case GenDocErrc::Unsupported_Format: return condition == CommandError::Invalid_Argument;
+        case GenDocErrc::Invalid_Scope: return condition == CommandError::Invalid_Argument;
         default: return false;
         }
     }
 };
+
+constexpr std::size_t Json_Doc_Indent = 2;
+
+const char* GetDocFile(GenDocFormat format)
+{
+    switch (format) {
+    case GenDocFormat::Cbor: return Cbor_Doc_File;
+    case GenDocFormat::MsgPack: return MsgPack_Doc_File;
+    default: return Json_Doc_File;
+    }
+}
+
+bool WriteDoc(const Project& project,
+              GenDocFormat format,
+              const std::filesystem::path& file,
+              std::size_t jobs,
+              bool compact,
+              SearchIndex* index)
+{
+    std::ofstream outputFile(file, format == GenDocFormat::Json ? std::ios::out : std::ios::out | std::ios::binary);
+
+    if (!outputFile.is_open()) {
+        return false;
+    }
+
+    switch (format) {
+    case GenDocFormat::Cbor: CborGenerator(outputFile).generate(project); break;
+    case GenDocFormat::MsgPack: MsgPackGenerator(outputFile).generate(project); break;
+    default:
+        if (compact) {
+            CompactJsonGenerator(outputFile, index).generate(project);
+        } else {
+            outputFile << std::setw(static_cast<int>(Json_Doc_Indent));
+            JsonGenerator(outputFile, jobs, index).generate(project);
+        }
+    }
+
+    return true;
+}
+
+bool WriteSearchIndex(const SearchIndex& index, const std::filesystem::path& file)
+{
+    std::ofstream outputFile(file);
+
+    if (!outputFile.is_open()) {
+        return false;
+    }
+
+    index.write(outputFile);
+    return true;
+}
+
+bool WriteJsonDocShards(const Project& project, const std::filesystem::path& dir, std::size_t jobs, SearchIndex* index)
+{
+    std::error_code ec;
+    std::filesystem::create_directory(dir, ec);
+
+    if (ec) {
+        return false;
+    }
+
+    bool isWritten = true;
+    IncrementalWriter writer(dir);
+    JsonShardsGenerator generator(
+        [&writer, &isWritten](const std::string& file, const std::string& content) {
+            isWritten = writer.write(file, content) && isWritten;
+        },
+        Json_Doc_Indent,
+        jobs,
+        index);
+
+    generator.generate(project);
+
+    if (index) {
+        std::ostringstream indexContent;
+        index->write(indexContent);
+        isWritten = writer.write(Search_Index_File, indexContent.str()) && isWritten;
+    }
+
+    return writer.commit() && isWritten;
+}
+
+std::error_code CheckOutputMode(const GenDocArgs& args, std::ostream& err)
+{
+    if (args.sharded() && args.format() != GenDocFormat::Json) {
+        err << ("Sharded documentation can't be generated in the '" + std::string(GetGenDocFormatStr(args.format())) +
+                "' format")
+            << std::endl;
+        return GenDocErrc::Unsupported_Format;
+    }
+
+    if (args.compact() && (args.sharded() || args.format() != GenDocFormat::Json)) {
+        err << "Compact schema is only supported for the single-file JSON documentation" << std::endl;
+        return GenDocErrc::Unsupported_Format;
+    }
+
+    if (args.searchIndex() && args.format() != GenDocFormat::Json) {
+        err << "Search index is only supported for the JSON documentation" << std::endl;
+        return GenDocErrc::Unsupported_Format;
+    }
+
+    return {0, gendoc_error_category()};
+}
+
+// Specification and style warnings are not related to documentation
+std::vector<const std::error_category*> GetIgnoredCategories()
+{
+    return {&spec_warn_category(), &style_warn_category()};
+}
 } // namespace
 
 std::error_code GenDocCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
 {
-    std::vector<const std::error_category*> ignoredCategories;
-    ignoredCategories.push_back(&spec_warn_category());
-    ignoredCategories.push_back(&style_warn_category());
+    if (auto ec = CheckOutputMode(args(), err)) {
+        return ec;
+    }
 
     Parser parser(args().projectDir(), args().protobufRootDir());
-    auto [projectPtr, ecol] = parser.parse(std::move(ignoredCategories));
+    auto [projectPtr, ecol] = parser.parse(GetIgnoredCategories(), nullptr, args().scope());
+
+    // documentation generators may read project from several threads
+    auto project = Project::Freeze(std::move(projectPtr));
+    return tryExecuteParsed(parser, *project, ecol, out, err);
+}
+
+std::error_code GenDocCommand::tryExecuteParsed(const Parser& parser,
+                                                const Project& project,
+                                                const ErrorCollector& parserEcol,
+                                                std::ostream& out,
+                                                std::ostream& err) const
+{
+    if (auto ec = CheckOutputMode(args(), err)) {
+        return ec;
+    }
+
+    ErrorCollector ecol = parserEcol.filter(GetIgnoredCategories());
     std::error_code result(0, gendoc_error_category());
 
     if (ecol) {
@@ -59,6 +196,8 @@ std::error_code GenDocCommand::tryExecuteImpl(std::ostream& out, std::ostream& e
         if (majorError.code.category() == parser_error_category()) {
             if (ecol.find(ParserErrc::Invalid_Project_Dir)) {
                 result = GenDocErrc::Invalid_Project_Dir;
+            } else if (ecol.find(ParserErrc::Invalid_Scope)) {
+                result = GenDocErrc::Invalid_Scope;
             } else if (ecol.find(ParserErrc::Read_Failed)) {
                 result = GenDocErrc::File_Read_Failed;
             } else {
@@ -71,23 +210,28 @@ std::error_code GenDocCommand::tryExecuteImpl(std::ostream& out, std::ostream& e
         }
     }
 
-    std::string outputFilename = (args().outputDir() / Json_Doc_File).string();
+    auto outputPath = args().outputDir() / (args().sharded() ? Json_Doc_Shards_Dir : GetDocFile(args().format()));
 
-    if (result != GenDocErrc::Invalid_Project_Dir) {
-        std::ofstream outputFile(outputFilename);
-        outputFile << std::setw(2);
+    if (result != GenDocErrc::Invalid_Project_Dir && result != GenDocErrc::Invalid_Scope) {
+        SearchIndex index;
+        auto indexPtr = args().searchIndex() ? &index : nullptr;
+        bool isWritten = false;
 
-        if (outputFile.is_open()) {
-            JsonGenerator generator(outputFile);
-            generator.generate(*projectPtr);
+        if (args().sharded()) {
+            isWritten = WriteJsonDocShards(project, outputPath, args().jobs(), indexPtr);
         } else {
+            isWritten = WriteDoc(project, args().format(), outputPath, args().jobs(), args().compact(), indexPtr) &&
+                        (!indexPtr || WriteSearchIndex(index, args().outputDir() / Search_Index_File));
+        }
+
+        if (!isWritten) {
             result = GenDocErrc::File_Write_Failed;
         }
     }
 
     if (!result) {
-        out << ("Busrpc project '" + parser.projectDir().string() + "' JSON documentation is written to '" +
-                outputFilename + "'")
+        out << ("Busrpc project '" + parser.projectDir().string() + "' documentation is written to '" +
+                outputPath.string() + "'")
             << std::endl;
     } else {
         err << ("Failed to build documentation for busrpc project in '" + parser.projectDir().string() + "' directory")
@@ -2,6 +2,7 @@
 
 #include "commands/command.h"
 
+#include <cstddef>
 #include <filesystem>
 #include <functional>
 #include <string>
@@ -16,6 +17,10 @@ class App;
 
 namespace busrpc {
 
+class ErrorCollector;
+class Parser;
+class Project;
+
 /// Command-specific error code.
 enum class GenDocErrc {
     /// Busrpc specification violated.
@@ -31,7 +36,13 @@ enum class GenDocErrc {
     File_Write_Failed = 4,
 
     /// Busrpc project directory does not exist or does not represent a valid project directory.
-    Invalid_Project_Dir = 5
+    Invalid_Project_Dir = 5,
+
+    /// Documentation format is not supported for the requested output mode.
+    Unsupported_Format = 6,
+
+    /// Scope does not denote an entity directory of the project.
+    Invalid_Scope = 7
 };
 
 /// Return error category for the \c gendoc command.
@@ -43,7 +54,13 @@ std::error_code make_error_code(GenDocErrc errc);
 /// Format of the generated documentation.
 enum class GenDocFormat {
     /// JSON.
-    Json = 1
+    Json = 1,
+
+    /// CBOR (Concise Binary Object Representation).
+    Cbor = 2,
+
+    /// MessagePack.
+    MsgPack = 3
 };
 
 /// Return string representation of a documentation format.
@@ -52,6 +69,8 @@ constexpr const char* GetGenDocFormatStr(GenDocFormat lang)
 {
     switch (lang) {
     case GenDocFormat::Json: return "json";
+    case GenDocFormat::Cbor: return "cbor";
+    case GenDocFormat::MsgPack: return "msgpack";
     default: return nullptr;
     }
 }
@@ -63,11 +82,21 @@ public:
     GenDocArgs(GenDocFormat format = GenDocFormat::Json,
                std::filesystem::path projectDir = std::filesystem::current_path(),
                std::filesystem::path outputDir = std::filesystem::current_path(),
-               std::filesystem::path protobufRootDir = {}):
+               std::filesystem::path protobufRootDir = {},
+               std::size_t jobs = 1,
+               bool sharded = false,
+               bool compact = false,
+               bool searchIndex = false,
+               std::string scope = {}):
         format_(format),
         projectDir_(std::move(projectDir)),
         outputDir_(std::move(outputDir)),
-        protobufRootDir_(std::move(protobufRootDir))
+        protobufRootDir_(std::move(protobufRootDir)),
+        jobs_(jobs),
+        sharded_(sharded),
+        compact_(compact),
+        searchIndex_(searchIndex),
+        scope_(std::move(scope))
     { }
 
     /// Format of the documentation.
@@ -88,11 +117,44 @@ public:
     ///       file was not found in the command's protobuf root directory.
     const std::filesystem::path& protobufRootDir() const noexcept { return protobufRootDir_; }
 
+    /// Number of threads used to generate documentation.
+    /// \note API namespaces and implementation services are rendered in parallel if value is greater than 1.
+    std::size_t jobs() const noexcept { return jobs_; }
+
+    /// Flag indicating whether documentation should be split to multiple files (shards).
+    /// \note If flag is set, documentation is written to the \ref Json_Doc_Shards_Dir subdirectory of the output
+    ///       directory (see \ref JsonShardsGenerator for details), otherwise it is written to the single
+    ///       \ref Json_Doc_File file.
+    /// \note Sharded documentation can only be generated in the JSON format.
+    /// \note Sharded documentation is updated incrementally: only changed files are rewritten and stale files are
+    ///       removed (see \ref IncrementalWriter).
+    bool sharded() const noexcept { return sharded_; }
+
+    /// Flag indicating whether documentation should be written in the compact JSON schema.
+    /// \note Compact schema is only supported for the single-file JSON documentation (see \ref CompactJsonGenerator
+    ///       for details). Documentation in the compact schema is always generated by a single thread.
+    bool compact() const noexcept { return compact_; }
+
+    /// Flag indicating whether search index of the documentation should be generated.
+    /// \note Search index (see \ref SearchIndex) is written to the \ref Search_Index_File next to the documentation
+    ///       (or to the sharded documentation directory). It is only supported for the JSON documentation.
+    bool searchIndex() const noexcept { return searchIndex_; }
+
+    /// Distinguished name of the project entity to be documented (for example, 'busrpc.api.billing').
+    /// \note If empty, whole project is documented. Otherwise documentation is built only for the entity subtree and
+    ///       it's dependencies (see \ref Parser::parse).
+    const std::string& scope() const noexcept { return scope_; }
+
 private:
     GenDocFormat format_;
     std::filesystem::path projectDir_;
     std::filesystem::path outputDir_;
     std::filesystem::path protobufRootDir_;
+    std::size_t jobs_;
+    bool sharded_;
+    bool compact_;
+    bool searchIndex_;
+    std::string scope_;
 };
 
 /// Generate API documentation.
@@ -104,6 +166,15 @@ public:
     /// Create command.
     explicit GenDocCommand(GenDocArgs args) noexcept: BaseType(std::move(args)) { }
 
+    /// Generate documentation for the \a project already parsed by the \a parser.
+    /// \note Errors of the categories ignored by the command are filtered out of the errors \a parserEcol collected
+    ///       during parsing, thus the same parsing result can be shared by several commands (see \ref RunCommand).
+    std::error_code tryExecuteParsed(const Parser& parser,
+                                     const Project& project,
+                                     const ErrorCollector& parserEcol,
+                                     std::ostream& out,
+                                     std::ostream& err) const;
+
 protected:
     /// Execute command.
     std::error_code tryExecuteImpl(std::ostream& out, std::ostream& err) const override;
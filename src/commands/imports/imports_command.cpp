@@ -1,5 +1,11 @@
 #include "commands/imports/imports_command.h"
+#include "constants.h"
 #include "error_collector.h"
+#include "generators/json_writer.h"
+#include "import_index.h"
+#include "protobuf_importer.h"
+#include "thread_pool.h"
+#include "types.h"
 #include "utils.h"
 
 #ifdef _MSC_VER
@@ -15,6 +21,9 @@
 #endif
 
 #include <google/protobuf/compiler/importer.h>
+#include <google/protobuf/io/tokenizer.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 
 #ifdef _MSC_VER
 #    pragma warning(pop)
@@ -22,9 +31,16 @@
 #    pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace protobuf = google::protobuf;
 
@@ -43,6 +59,7 @@ public:
         case ImportsErrc::File_Read_Failed: return "Failed to read file";
         case ImportsErrc::File_Not_Found: return "File not found";
         case ImportsErrc::Invalid_Project_Dir: return "Invalid busrpc project directory";
+        case ImportsErrc::Output_Not_Specified: return "Generated output is not specified";
         default: return "Unknown error";
         }
     }
@@ -54,6 +71,7 @@ public:
         case ImportsErrc::File_Read_Failed: return condition == CommandError::File_Operation_Failed;
         case ImportsErrc::File_Not_Found: return condition == CommandError::Invalid_Argument;
         case ImportsErrc::Invalid_Project_Dir: return condition == CommandError::Invalid_Argument;
+        case ImportsErrc::Output_Not_Specified: return condition == CommandError::Invalid_Argument;
         default: return false;
         }
     }
@@ -67,24 +85,486 @@ bool IsSystemFile(std::filesystem::path filePath)
            std::search(filePath.begin(), filePath.end(), sysPath.begin(), sysPath.end()) == filePath.begin();
 }
 
-void FillImportsRecursively(const protobuf::FileDescriptor* desc, std::set<std::string>& imports)
+// Maps file to the files directly imported by it
+using ImportGraph = std::map<std::string, std::set<std::string>>;
+
+constexpr std::size_t Json_Graph_Indent = 2;
+
+// Extension of the protobuf files replaced by the generated output pattern
+constexpr std::string_view Proto_File_Extension = ".proto";
+
+void FillImportGraphRecursively(const protobuf::FileDescriptor* desc, ImportGraph& graph)
 {
     if (!desc) {
         return;
     }
 
-    if (imports.count(desc->name())) {
+    auto [it, isInserted] = graph.emplace(desc->name(), std::set<std::string>{});
+
+    if (!isInserted) {
         // already processed
         return;
     }
 
-    imports.insert(desc->name());
-
     for (int i = 0; i < desc->dependency_count(); ++i) {
         if (!IsSystemFile(desc->dependency(i)->name())) {
-            FillImportsRecursively(desc->dependency(i), imports);
+            it->second.insert(desc->dependency(i)->name());
+            FillImportGraphRecursively(desc->dependency(i), graph);
+        }
+    }
+}
+
+void FillImportsRecursively(const ImportGraph& graph, const std::string& file, std::set<std::string>& imports)
+{
+    auto it = graph.find(file);
+
+    if (it == graph.end() || !imports.insert(file).second) {
+        // file failed to import or already processed
+        return;
+    }
+
+    for (const auto& dependency: it->second) {
+        FillImportsRecursively(graph, dependency, imports);
+    }
+}
+
+class TokenizerErrorCollector: public protobuf::io::ErrorCollector {
+public:
+    void AddError(int, protobuf::io::ColumnNumber, const std::string&) override { hasErrors_ = true; }
+
+    bool hasErrors() const noexcept { return hasErrors_; }
+
+private:
+    bool hasErrors_ = false;
+};
+
+// Return files imported by the \a file using only the protobuf tokenizer (file is not parsed)
+// Only the file header (syntax, edition, package, import and option statements) is tokenized; scanning stops at the
+// first token of any other statement, so file body is neither tokenized nor read past the first input buffer
+// Returns std::nullopt if file can't be read or it's header is malformed
+std::optional<std::vector<std::string>> ScanImports(const std::filesystem::path& file)
+{
+    std::ifstream in(file, std::ios::binary);
+
+    if (!in.is_open()) {
+        return std::nullopt;
+    }
+
+    protobuf::io::IstreamInputStream input(&in);
+    TokenizerErrorCollector errors;
+    protobuf::io::Tokenizer tokenizer(&input, &errors);
+    std::vector<std::string> imports;
+
+    while (tokenizer.Next()) {
+        const auto& text = tokenizer.current().text;
+
+        if (text == "import") {
+            if (!tokenizer.Next()) {
+                return std::nullopt;
+            }
+
+            if (tokenizer.current().text == "public" || tokenizer.current().text == "weak") {
+                if (!tokenizer.Next()) {
+                    return std::nullopt;
+                }
+            }
+
+            if (tokenizer.current().type != protobuf::io::Tokenizer::TYPE_STRING) {
+                return std::nullopt;
+            }
+
+            std::string import;
+            protobuf::io::Tokenizer::ParseString(tokenizer.current().text, &import);
+            imports.push_back(std::move(import));
+
+            if (!tokenizer.Next() || tokenizer.current().text != ";") {
+                return std::nullopt;
+            }
+        } else if (text == "syntax" || text == "edition" || text == "package" || text == "option") {
+            // skip statement until ';' (option value may be an aggregate enclosed in braces)
+            std::size_t depth = 0;
+
+            while (tokenizer.Next() && (depth != 0 || tokenizer.current().text != ";")) {
+                if (tokenizer.current().text == "{") {
+                    ++depth;
+                } else if (tokenizer.current().text == "}" && depth-- == 0) {
+                    return std::nullopt;
+                }
+            }
+
+            if (tokenizer.current().text != ";") {
+                return std::nullopt;
+            }
+        } else if (text != ";") {
+            // first definition ends the file header
+            break;
         }
     }
+
+    if (errors.hasErrors()) {
+        return std::nullopt;
+    }
+
+    return imports;
+}
+
+// Build import graph of the \a files by scanning their import statements level by level using \a jobs threads
+// Files, which could not be scanned unambiguously (or which import files not found in the project directory), are
+// returned to be imported by the protobuf importer; files already added to the \a graph are not scanned again
+std::vector<std::string> FillImportGraphByScanning(const std::filesystem::path& projectPath,
+                                                   const std::set<std::string>& files,
+                                                   std::size_t jobs,
+                                                   ImportGraph& graph)
+{
+    std::vector<std::string> unresolved;
+    std::set<std::string> visited(files.begin(), files.end());
+    std::vector<std::string> level(files.begin(), files.end());
+
+    while (!level.empty()) {
+        std::vector<std::optional<std::vector<std::string>>> scanned(level.size());
+        std::vector<std::string> nextLevel;
+
+        ThreadPool::Shared().parallelFor(level.size(), jobs, [&](std::size_t i) {
+            scanned[i] = ScanImports(projectPath / level[i]);
+
+            if (scanned[i]) {
+                auto isResolved = [&projectPath](const std::string& import) {
+                    return IsSystemFile(import) || std::filesystem::is_regular_file(projectPath / import);
+                };
+
+                if (!std::all_of(scanned[i]->begin(), scanned[i]->end(), isResolved)) {
+                    scanned[i].reset();
+                }
+            }
+        });
+
+        for (std::size_t i = 0; i < level.size(); ++i) {
+            if (!scanned[i]) {
+                unresolved.push_back(level[i]);
+                continue;
+            }
+
+            auto& dependencies = graph[level[i]];
+
+            for (auto& import: *scanned[i]) {
+                if (!IsSystemFile(import)) {
+                    if (graph.count(import) == 0 && visited.insert(import).second) {
+                        nextLevel.push_back(import);
+                    }
+
+                    dependencies.insert(std::move(import));
+                }
+            }
+        }
+
+        level = std::move(nextLevel);
+    }
+
+    return unresolved;
+}
+
+void FillImportGraph(ProtobufImporter& importer,
+                     const std::filesystem::path& projectPath,
+                     const std::set<std::string>& files,
+                     bool fast,
+                     std::size_t jobs,
+                     ImportGraph& graph)
+{
+    if (fast) {
+        for (const auto& file: FillImportGraphByScanning(projectPath, files, jobs, graph)) {
+            FillImportGraphRecursively(importer.Import(file), graph);
+        }
+    } else {
+        for (const auto& file: files) {
+            // importer caches imported files, so each shared dependency is imported only once
+            FillImportGraphRecursively(importer.Import(file), graph);
+        }
+    }
+}
+
+std::set<std::string> GetProjectFiles(const std::filesystem::path& projectPath)
+{
+    std::set<std::string> files;
+
+    for (const auto& entry: std::filesystem::recursive_directory_iterator(projectPath)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".proto") {
+            files.insert(entry.path().lexically_relative(projectPath).generic_string());
+        }
+    }
+
+    return files;
+}
+
+// Return all project files, which directly or indirectly import any of the \a files (including \a files themselves)
+std::set<std::string> FindImporters(const ImportsArgs& args,
+                                    ProtobufImporter& importer,
+                                    const std::filesystem::path& projectPath,
+                                    const std::set<std::string>& files,
+                                    ErrorCollector& ecol,
+                                    std::ostream& err)
+{
+    ImportIndex index;
+    ImportGraph graph;
+    std::set<std::string> projectFiles;
+    std::map<std::string, uint64_t> stamps;
+
+    if (!args.indexFile().empty()) {
+        index.load(args.indexFile());
+    }
+
+    try {
+        projectFiles = GetProjectFiles(projectPath);
+    } catch (const std::filesystem::filesystem_error& e) {
+        ecol.add(ImportsErrc::File_Read_Failed, std::make_pair("dir", projectPath), e.what());
+    }
+
+    std::set<std::string> changedFiles;
+
+    for (const auto& file: projectFiles) {
+        const ImportIndex::Imports* imports = nullptr;
+
+        try {
+            auto stamp = ImportIndex::GetStamp(projectPath / file);
+            stamps.emplace(file, stamp);
+            imports = index.find(file, stamp);
+        } catch (const std::filesystem::filesystem_error&) { }
+
+        if (imports) {
+            graph.emplace(file, *imports);
+        } else {
+            changedFiles.insert(file);
+        }
+    }
+
+    FillImportGraph(importer, projectPath, changedFiles, args.fast(), args.jobs(), graph);
+
+    for (const auto& file: changedFiles) {
+        auto stampIt = stamps.find(file);
+        auto graphIt = graph.find(file);
+
+        // files, which failed to import, are not indexed and will be read again next time
+        if (stampIt != stamps.end() && graphIt != graph.end()) {
+            index.store(file, stampIt->second, graphIt->second);
+        }
+    }
+
+    if (!args.indexFile().empty() && !index.save(args.indexFile())) {
+        err << ("Failed to write import index to '" + args.indexFile().string() + "' file") << std::endl;
+    }
+
+    return index.findImporters(files);
+}
+
+// Return busrpc entity directory (namespace, class, method, service, etc.) containing \a file
+std::string GetEntityDir(const std::string& file)
+{
+    auto dir = std::filesystem::path(file).parent_path().generic_string();
+    return dir.empty() ? "." : dir;
+}
+
+void WriteImporters(std::ostream& out,
+                    const std::set<std::string>& importers,
+                    const std::set<std::string>& files,
+                    bool onlyDeps,
+                    bool entities)
+{
+    std::set<std::string> result;
+
+    for (const auto& file: importers) {
+        if (!onlyDeps || files.count(file) == 0) {
+            result.insert(entities ? GetEntityDir(file) : file);
+        }
+    }
+
+    for (const auto& file: result) {
+        out << file << std::endl;
+    }
+}
+
+// Return files of the service directory and descriptor files of the methods implemented or invoked by the service
+// Methods are found by the field types of the service descriptor 'Implements' and 'Invokes' structures
+std::set<std::string> GetServiceFiles(ProtobufImporter& importer,
+                                      const std::filesystem::path& projectPath,
+                                      const std::string& serviceName,
+                                      ErrorCollector& ecol)
+{
+    std::set<std::string> files;
+
+    // service name is joined to the project path, so it should not be able to denote directory outside of it
+    if (!IsValidEntityName(serviceName)) {
+        ecol.add(ImportsErrc::File_Not_Found, std::make_pair("service", serviceName), "invalid service name");
+        return files;
+    }
+
+    auto serviceDir = std::filesystem::path(Implementation_Entity_Name) / serviceName;
+    auto descFile = (serviceDir / Service_Desc_File).generic_string();
+
+    if (!std::filesystem::is_regular_file(projectPath / descFile)) {
+        ecol.add(ImportsErrc::File_Not_Found, std::make_pair("service", serviceName));
+        return files;
+    }
+
+    try {
+        for (const auto& entry: std::filesystem::directory_iterator(projectPath / serviceDir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".proto") {
+                files.insert((serviceDir / entry.path().filename()).generic_string());
+            }
+        }
+    } catch (const std::filesystem::filesystem_error& e) {
+        ecol.add(ImportsErrc::File_Read_Failed, std::make_pair("dir", serviceDir), e.what());
+    }
+
+    auto fileDesc = importer.Import(descFile);
+    auto desc = fileDesc ? fileDesc->FindMessageTypeByName(GetPredefinedStructName(StructTypeId::Service_Desc))
+                         : nullptr;
+
+    if (desc) {
+        for (auto structType: {StructTypeId::Service_Implements, StructTypeId::Service_Invokes}) {
+            auto methods = desc->FindNestedTypeByName(GetPredefinedStructName(structType));
+
+            for (int i = 0; methods && i < methods->field_count(); ++i) {
+                if (auto methodDesc = methods->field(i)->message_type()) {
+                    files.insert(methodDesc->file()->name());
+                }
+            }
+        }
+    }
+
+    return files;
+}
+
+std::string EscapeMakePath(const std::string& path)
+{
+    std::string result;
+
+    for (auto ch: path) {
+        if (ch == ' ' || ch == '#') {
+            result.push_back('\\');
+        } else if (ch == '$') {
+            result.push_back('$');
+        }
+
+        result.push_back(ch);
+    }
+
+    return result;
+}
+
+std::string EscapeNinjaPath(const std::string& path)
+{
+    std::string result;
+
+    for (auto ch: path) {
+        if (ch == ' ' || ch == ':' || ch == '$') {
+            result.push_back('$');
+        }
+
+        result.push_back(ch);
+    }
+
+    return result;
+}
+
+void WriteList(std::ostream& out, const ImportGraph& graph, const std::set<std::string>& files, bool onlyDeps)
+{
+    std::set<std::string> imports;
+
+    for (const auto& file: files) {
+        FillImportsRecursively(graph, file, imports);
+    }
+
+    for (const auto& file: imports) {
+        if (!onlyDeps || files.count(file) == 0) {
+            out << file << std::endl;
+        }
+    }
+}
+
+// Return path to the file generated from the protobuf file by the output pattern
+std::string GetOutputPath(const std::string& pattern, const std::string& file)
+{
+    std::string stem = file;
+
+    if (stem.ends_with(Proto_File_Extension)) {
+        stem.resize(stem.size() - Proto_File_Extension.size());
+    }
+
+    std::string result;
+
+    for (auto ch: pattern) {
+        if (ch == '%') {
+            result.append(stem);
+        } else {
+            result.push_back(ch);
+        }
+    }
+
+    return result;
+}
+
+// Rules are keyed by the generated files, because source file is not an output of any build edge
+void WriteRules(std::ostream& out,
+                const ImportGraph& graph,
+                const std::set<std::string>& files,
+                const std::vector<std::string>& outputs,
+                bool isNinja)
+{
+    auto escape = isNinja ? EscapeNinjaPath : EscapeMakePath;
+
+    if (isNinja) {
+        out << "ninja_dyndep_version = 1" << std::endl;
+    }
+
+    for (const auto& file: files) {
+        if (graph.count(file) == 0) {
+            continue;
+        }
+
+        std::set<std::string> imports;
+        FillImportsRecursively(graph, file, imports);
+        imports.erase(file);
+
+        if (isNinja) {
+            out << "build " << escape(GetOutputPath(outputs.front(), file)) << ": dyndep";
+
+            if (!imports.empty()) {
+                out << " |";
+            }
+        } else {
+            for (const auto& output: outputs) {
+                out << (&output == &outputs.front() ? "" : " ") << escape(GetOutputPath(output, file));
+            }
+
+            out << ": " << escape(file);
+        }
+
+        for (const auto& dependency: imports) {
+            out << ' ' << escape(dependency);
+        }
+
+        out << std::endl;
+    }
+}
+
+void WriteJson(std::ostream& out, const ImportGraph& graph)
+{
+    JsonWriter writer(out, Json_Graph_Indent);
+    writer.beginObject();
+
+    for (const auto& [file, dependencies]: graph) {
+        writer.key(file);
+        writer.beginArray();
+
+        for (const auto& dependency: dependencies) {
+            writer.stringValue(dependency);
+        }
+
+        writer.endArray();
+    }
+
+    writer.endObject();
+    writer.flush();
+    out << std::endl;
 }
 } // namespace
 
@@ -93,8 +573,8 @@ std::error_code ImportsCommand::tryExecuteImpl(std::ostream& out, std::ostream&
     ErrorCollector ecol(ImportsErrc::Protobuf_Parsing_Failed, SeverityByErrorCodeValue);
     ErrorCollectorGuard ecolGuard(ecol, err);
 
-    std::set<std::string> imports;
-    std::set<std::string> ignored;
+    ImportGraph graph;
+    std::set<std::string> files;
     std::filesystem::path projectPath;
     std::filesystem::path protobufPath;
 
@@ -123,32 +603,54 @@ std::error_code ImportsCommand::tryExecuteImpl(std::ostream& out, std::ostream&
     sourceTree.MapPath("", "/usr/local/include");
 #endif
 
-    protobuf::compiler::Importer importer(&sourceTree, ecol.getProtobufCollector());
-
-    for (const auto& file: args().files()) {
-        std::filesystem::path filePath;
+    ProtobufImporter importer(&sourceTree, ecol.getProtobufCollector());
 
+    if (!args().service().empty()) {
+        files = GetServiceFiles(importer, projectPath, args().service(), ecol);
+    } else if (args().all()) {
         try {
-            if (!InitRelativePathToExistingFile(filePath, file, projectPath)) {
-                ecol.add(ImportsErrc::File_Not_Found, std::make_pair("file", file));
-            }
-        } catch (const std::filesystem::filesystem_error&) {
-            ecol.add(ImportsErrc::File_Read_Failed, std::make_pair("file", file));
+            files = GetProjectFiles(projectPath);
+        } catch (const std::filesystem::filesystem_error& e) {
+            ecol.add(ImportsErrc::File_Read_Failed, std::make_pair("dir", projectPath), e.what());
         }
-
-        if (!filePath.empty()) {
-            if (args().onlyDeps()) {
-                ignored.insert(filePath.generic_string());
+    } else {
+        for (const auto& file: args().files()) {
+            std::filesystem::path filePath;
+
+            try {
+                if (!InitRelativePathToExistingFile(filePath, file, projectPath)) {
+                    ecol.add(ImportsErrc::File_Not_Found, std::make_pair("file", file));
+                }
+            } catch (const std::filesystem::filesystem_error&) {
+                ecol.add(ImportsErrc::File_Read_Failed, std::make_pair("file", file));
             }
 
-            FillImportsRecursively(importer.Import(filePath.generic_string().c_str()), imports);
+            if (!filePath.empty()) {
+                files.insert(filePath.generic_string());
+            }
         }
     }
 
-    for (const auto& file: imports) {
-        if (ignored.count(file) == 0) {
-            out << file << std::endl;
-        }
+    if (args().reverse()) {
+        auto importers = FindImporters(args(), importer, projectPath, files, ecol, err);
+        WriteImporters(out, importers, files, args().onlyDeps(), args().entities());
+        return !ecol ? std::error_code(0, imports_error_category()) : ecol.majorError()->code;
+    }
+
+    bool isRulesFormat = args().format() == ImportsFormat::Depfile || args().format() == ImportsFormat::Ninja;
+
+    if (isRulesFormat && args().outputs().empty()) {
+        ecol.add(ImportsErrc::Output_Not_Specified, std::make_pair("format", GetImportsFormatStr(args().format())));
+        return ecol.majorError()->code;
+    }
+
+    FillImportGraph(importer, projectPath, files, args().fast(), args().jobs(), graph);
+
+    switch (args().format()) {
+    case ImportsFormat::Depfile: WriteRules(out, graph, files, args().outputs(), false); break;
+    case ImportsFormat::Ninja: WriteRules(out, graph, files, args().outputs(), true); break;
+    case ImportsFormat::Json: WriteJson(out, graph); break;
+    default: WriteList(out, graph, files, args().onlyDeps()); break;
     }
 
     return !ecol ? std::error_code(0, imports_error_category()) : ecol.majorError()->code;
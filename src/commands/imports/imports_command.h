@@ -2,6 +2,7 @@
 
 #include "commands/command.h"
 
+#include <cstddef>
 #include <filesystem>
 #include <functional>
 #include <string>
@@ -29,7 +30,10 @@ enum class ImportsErrc {
     File_Not_Found = 3,
 
     /// Busrpc project directory does not exist or does not represent a valid project directory.
-    Invalid_Project_Dir = 4
+    Invalid_Project_Dir = 4,
+
+    /// Output format requires generated output path(s), but they are not specified.
+    Output_Not_Specified = 5
 };
 
 /// Return error category for the \c imports command.
@@ -38,6 +42,34 @@ const std::error_category& imports_error_category();
 /// Create error code from the \ref ImportsErrc value.
 std::error_code make_error_code(ImportsErrc errc);
 
+/// Format of the command output.
+enum class ImportsFormat {
+    /// List of files (one file per line).
+    List = 1,
+
+    /// Makefile dependency file.
+    Depfile = 2,
+
+    /// Ninja dynamic dependency file.
+    Ninja = 3,
+
+    /// JSON adjacency list.
+    Json = 4
+};
+
+/// Return string representation of an output format.
+/// \note \c nullptr is returned if \a format is unknown.
+constexpr const char* GetImportsFormatStr(ImportsFormat format)
+{
+    switch (format) {
+    case ImportsFormat::List: return "list";
+    case ImportsFormat::Depfile: return "depfile";
+    case ImportsFormat::Ninja: return "ninja";
+    case ImportsFormat::Json: return "json";
+    default: return nullptr;
+    }
+}
+
 /// Arguments of the \c imports command.
 class ImportsArgs {
 public:
@@ -45,11 +77,29 @@ public:
     ImportsArgs(std::vector<std::string> files = {},
                 std::filesystem::path projectDir = std::filesystem::current_path(),
                 std::filesystem::path protobufRoot = {},
-                bool onlyDeps = false):
+                bool onlyDeps = false,
+                bool all = false,
+                ImportsFormat format = ImportsFormat::List,
+                bool fast = false,
+                std::size_t jobs = 1,
+                bool reverse = false,
+                bool entities = false,
+                std::filesystem::path indexFile = {},
+                std::string service = {},
+                std::vector<std::string> outputs = {}):
         files_(std::move(files)),
         projectDir_(std::move(projectDir)),
         protobufRoot_(std::move(protobufRoot)),
-        onlyDeps_(onlyDeps)
+        onlyDeps_(onlyDeps),
+        all_(all),
+        format_(format),
+        fast_(fast),
+        jobs_(jobs),
+        reverse_(reverse),
+        entities_(entities),
+        indexFile_(std::move(indexFile)),
+        service_(std::move(service)),
+        outputs_(std::move(outputs))
     { }
 
     /// Files which imports to output (should be nested in the busrpc project directory).
@@ -65,16 +115,87 @@ public:
     const std::filesystem::path& protobufRoot() const noexcept { return protobufRoot_; }
 
     /// Flag indicating whether \ref files themselves should not be outputted.
+    /// \note Only affects \ref ImportsFormat::List output format.
     bool onlyDeps() const noexcept { return onlyDeps_; }
 
+    /// Flag indicating whether all '.proto' files of the busrpc project should be processed.
+    /// \note If set, \ref files are ignored.
+    bool all() const noexcept { return all_; }
+
+    /// Output format.
+    ImportsFormat format() const noexcept { return format_; }
+
+    /// Flag indicating whether import statements should be read by the protobuf tokenizer instead of importing files.
+    /// \note In this mode only the file header (statements preceding the first definition) is tokenized, which is
+    ///       much faster, but syntax errors outside of the header are not detected and import statements placed after
+    ///       the first definition are ignored. Files, which header can't be tokenized unambiguously or which import
+    ///       files not found in the \ref projectDir, are still imported by the protobuf importer.
+    bool fast() const noexcept { return fast_; }
+
+    /// Number of threads used to read import statements of the files in \ref fast mode.
+    std::size_t jobs() const noexcept { return jobs_; }
+
+    /// Flag indicating whether files, which directly or indirectly import \ref files, should be outputted instead of
+    /// files imported by them.
+    /// \note In this mode import graph of the whole project is built and output is always a sorted list (\ref format
+    ///       is ignored).
+    bool reverse() const noexcept { return reverse_; }
+
+    /// Flag indicating whether directories of the busrpc entities (namespaces, classes, methods, services, etc.)
+    /// containing the files should be outputted instead of the files themselves.
+    /// \note Only affects \ref reverse mode.
+    bool entities() const noexcept { return entities_; }
+
+    /// File where to store import graph of the project between command invocations.
+    /// \note Only affects \ref reverse mode. If set, imports of the files, which did not change since the previous
+    ///       command invocation, are taken from this file (see \ref ImportIndex).
+    const std::filesystem::path& indexFile() const noexcept { return indexFile_; }
+
+    /// Name of the service, which files should be processed.
+    /// \note If set, \ref files and \ref all are ignored and instead the command processes files of the service
+    ///       directory and descriptor files of the methods implemented or invoked by the service (methods are found
+    ///       by the types of the service descriptor 'Implements' and 'Invokes' structure fields). Thus, the command
+    ///       outputs the minimal set of files needed to compile the service.
+    const std::string& service() const noexcept { return service_; }
+
+    /// Patterns of the paths to the files generated from each processed file.
+    /// \note Character '%' in the pattern is replaced by the path to the processed file without '.proto' extension
+    ///       (for example, pattern 'gen/%.pb.cc' for the file 'ns/file.proto' gives 'gen/ns/file.pb.cc').
+    /// \note Required for \ref ImportsFormat::Depfile and \ref ImportsFormat::Ninja formats, because dependency
+    ///       rules are keyed by the generated files and not by the processed files themselves. Ignored for other
+    ///       formats.
+    const std::vector<std::string>& outputs() const noexcept { return outputs_; }
+
 private:
     std::vector<std::string> files_;
     std::filesystem::path projectDir_;
     std::filesystem::path protobufRoot_;
     bool onlyDeps_;
+    bool all_;
+    ImportsFormat format_;
+    bool fast_;
+    std::size_t jobs_;
+    bool reverse_;
+    bool entities_;
+    std::filesystem::path indexFile_;
+    std::string service_;
+    std::vector<std::string> outputs_;
 };
 
 /// Output relative paths to the files directly or indirectly imported by the specified file(s).
+/// \note Command builds import graph of the specified files (or of all project files if \ref ImportsArgs::all is
+///       set) importing each file only once and outputs it in one of the following formats:
+///       - \ref ImportsFormat::List - sorted list of the specified files and all their imports;
+///       - \ref ImportsFormat::Depfile - Makefile rule for each specified file, which targets are files generated
+///         from it (see \ref ImportsArgs::outputs) and prerequisites are the file itself and all files directly or
+///         indirectly imported by it;
+///       - \ref ImportsFormat::Ninja - ninja dyndep file with a build statement for each specified file, which output
+///         is the file generated from it by the first pattern of \ref ImportsArgs::outputs (ninja identifies the
+///         edge by any of it's outputs and requires exactly one statement per edge) and implicit inputs are all files
+///         directly or indirectly imported by it;
+///       - \ref ImportsFormat::Json - JSON object, which maps each file of the graph to the sorted array of files
+///         directly imported by it.
+/// \note Built-in protobuf files are not included in the graph.
 class ImportsCommand: public Command<CommandId::Imports, ImportsArgs> {
 public:
     /// Base type.
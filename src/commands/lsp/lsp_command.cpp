@@ -0,0 +1,70 @@
+#include "commands/lsp/lsp_command.h"
+#include "commands/lsp/lsp_server.h"
+#include "constants.h"
+
+#include <iostream>
+#include <string>
+
+namespace busrpc {
+
+namespace {
+
+class LspErrorCategory: public std::error_category {
+public:
+    const char* name() const noexcept override { return "lsp"; }
+
+    std::string message(int code) const override
+    {
+        switch (static_cast<LspErrc>(code)) {
+        case LspErrc::Protocol_Violated: return "Language server protocol violated";
+        case LspErrc::Invalid_Project_Dir: return "Invalid busrpc project directory";
+        default: return "Unknown error";
+        }
+    }
+
+    bool equivalent(int code, const std::error_condition& condition) const noexcept override
+    {
+        switch (static_cast<LspErrc>(code)) {
+        case LspErrc::Protocol_Violated: return condition == CommandError::Invalid_Argument;
+        case LspErrc::Invalid_Project_Dir: return condition == CommandError::Invalid_Argument;
+        default: return false;
+        }
+    }
+};
+} // namespace
+
+std::error_code LspCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
+{
+    auto projectDir = args().projectDir().empty() ? std::filesystem::current_path() : args().projectDir();
+    std::error_code ec;
+
+    if (!std::filesystem::is_regular_file(projectDir / Busrpc_Builtin_File, ec)) {
+        err << ("Directory '" + projectDir.string() + "' is not a busrpc project directory") << std::endl;
+        return LspErrc::Invalid_Project_Dir;
+    }
+
+    LspServer server(std::move(projectDir), args().protobufRootDir());
+
+    // standard input synchronized with C streams is not buffered, so server can't see whether there are more
+    // messages to read and coalesce document changes (see LspServer::serve)
+    std::ios::sync_with_stdio(false);
+
+    if (!server.serve(std::cin, out)) {
+        err << "Language server client exited without shutdown request" << std::endl;
+        return LspErrc::Protocol_Violated;
+    }
+
+    return {0, lsp_error_category()};
+}
+
+const std::error_category& lsp_error_category()
+{
+    static const LspErrorCategory category;
+    return category;
+}
+
+std::error_code make_error_code(LspErrc e)
+{
+    return {static_cast<int>(e), lsp_error_category()};
+}
+} // namespace busrpc
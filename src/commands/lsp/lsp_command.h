@@ -0,0 +1,82 @@
+#pragma once
+
+#include "commands/command.h"
+
+#include <filesystem>
+#include <functional>
+#include <system_error>
+
+/// \dir commands/lsp Types and utilites for \c lsp command implementation.
+/// \file lsp_command.h Command \c lsp implementation.
+
+namespace CLI {
+class App;
+}
+
+namespace busrpc {
+
+/// Command-specific error code.
+enum class LspErrc {
+    /// Client violated the Language Server Protocol.
+    /// \note This code is returned if message can't be read from the standard input or client exits without sending
+    ///       \c shutdown request.
+    Protocol_Violated = 1,
+
+    /// Busrpc project directory does not exist or does not represent a valid project directory.
+    Invalid_Project_Dir = 2
+};
+
+/// Return error category for the \c lsp command.
+const std::error_category& lsp_error_category();
+
+/// Create error code from the \ref LspErrc value.
+std::error_code make_error_code(LspErrc errc);
+
+/// Arguments of the \c lsp command.
+class LspArgs {
+public:
+    /// Create \c lsp command arguments.
+    LspArgs(std::filesystem::path projectDir = std::filesystem::current_path(),
+            std::filesystem::path protobufRootDir = {}):
+        projectDir_(std::move(projectDir)),
+        protobufRootDir_(std::move(protobufRootDir))
+    { }
+
+    /// Busrpc project directory.
+    /// \note If empty, working directory is assumed.
+    const std::filesystem::path& projectDir() const noexcept { return projectDir_; }
+
+    /// Root directory for protobuf built-in '.proto' files ('google/protobuf/descriptor.proto', etc.).
+    /// \note On *nix systems, '/usr/include' and '/usr/include/local' are implicitly added to the list of directories
+    ///       where to search built-in protobuf '.proto' files. However, this directories are only searched if
+    ///       file was not found in the command's protobuf root directory.
+    const std::filesystem::path& protobufRootDir() const noexcept { return protobufRootDir_; }
+
+private:
+    std::filesystem::path projectDir_;
+    std::filesystem::path protobufRootDir_;
+};
+
+/// Run language server for the project.
+/// \note Server communicates with the client (editor) over the standard input and output (see \ref LspServer).
+class LspCommand: public Command<CommandId::Lsp, LspArgs> {
+public:
+    /// Base type.
+    using BaseType = Command<CommandId::Lsp, LspArgs>;
+
+    /// Create command.
+    explicit LspCommand(LspArgs args) noexcept: BaseType(std::move(args)) { }
+
+protected:
+    /// Execute command.
+    std::error_code tryExecuteImpl(std::ostream& out, std::ostream& err) const override;
+};
+
+/// Define \c lsp command line options and set a \a callback to be invoked when \a app encounters the command.
+void DefineCommand(CLI::App& app, const std::function<void(LspArgs)>& callback);
+} // namespace busrpc
+
+namespace std {
+template<>
+struct is_error_code_enum<busrpc::LspErrc>: true_type { };
+} // namespace std
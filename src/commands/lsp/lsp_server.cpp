@@ -0,0 +1,1055 @@
+#include "commands/lsp/lsp_server.h"
+#include "configure.h"
+#include "constants.h"
+#include "parser/parser.h"
+
+#ifdef _MSC_VER
+#    pragma warning(push)
+#    pragma warning(disable : 4100)
+#    pragma warning(disable : 4251)
+#else
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpedantic"
+#    pragma GCC diagnostic ignored "-Wconversion"
+#    pragma GCC diagnostic ignored "-Wsign-conversion"
+#    pragma GCC diagnostic ignored "-Wshadow"
+#endif
+
+#include <google/protobuf/compiler/parser.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/io/tokenizer.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#ifdef _MSC_VER
+#    pragma warning(pop)
+#else
+#    pragma GCC diagnostic pop
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace protobuf = google::protobuf;
+using json = nlohmann::json;
+
+namespace busrpc {
+
+namespace {
+
+// JSON-RPC and LSP error codes
+constexpr int Parse_Error = -32700;
+constexpr int Invalid_Request = -32600;
+constexpr int Method_Not_Found = -32601;
+constexpr int Invalid_Params = -32602;
+constexpr int Server_Not_Initialized = -32002;
+
+// LSP diagnostic severities
+constexpr int Severity_Error = 1;
+constexpr int Severity_Warning = 2;
+constexpr int Severity_Information = 3;
+
+// LSP message type for the 'window/logMessage' notification
+constexpr int Message_Type_Log = 4;
+
+// LSP text document synchronization kind (documents are synced by sending the full content)
+constexpr int Text_Document_Sync_Full = 1;
+
+// LSP completion item kinds
+constexpr int Completion_Kind_Method = 2;
+constexpr int Completion_Kind_Field = 5;
+constexpr int Completion_Kind_Class = 7;
+constexpr int Completion_Kind_Module = 9;
+constexpr int Completion_Kind_Enum = 13;
+constexpr int Completion_Kind_Enum_Member = 20;
+constexpr int Completion_Kind_Struct = 22;
+
+// Maximum number of items returned by the 'textDocument/completion' request
+constexpr std::size_t Max_Completion_Items = 100;
+
+// Width of the tab character used by the protobuf tokenizer when counting columns
+constexpr int Tab_Width = 8;
+
+constexpr const char* Content_Length_Header = "Content-Length:";
+constexpr const char* File_Uri_Scheme = "file://";
+
+void WriteMessage(std::ostream& out, const json& message)
+{
+    std::string content = message.dump();
+    out << Content_Length_Header << " " << content.size() << "\r\n\r\n" << content << std::flush;
+}
+
+void WriteResponse(std::ostream& out, const json& id, json result)
+{
+    WriteMessage(out, {{"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}});
+}
+
+void WriteError(std::ostream& out, const json& id, int code, const std::string& message)
+{
+    WriteMessage(out, {{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}});
+}
+
+void WriteNotification(std::ostream& out, const std::string& method, json params)
+{
+    WriteMessage(out, {{"jsonrpc", "2.0"}, {"method", method}, {"params", std::move(params)}});
+}
+
+// Read message content framed according to the LSP base protocol
+// Returns nullopt if stream is exhausted or message header is malformed
+std::optional<std::string> ReadMessage(std::istream& in)
+{
+    std::optional<std::size_t> length;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (line.empty()) {
+            if (length) {
+                break;
+            }
+
+            continue;
+        }
+
+        if (line.compare(0, std::strlen(Content_Length_Header), Content_Length_Header) == 0) {
+            try {
+                length = std::stoull(line.substr(std::strlen(Content_Length_Header)));
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (!length) {
+        return std::nullopt;
+    }
+
+    std::string content(*length, '\0');
+
+    if (!in.read(content.data(), static_cast<std::streamsize>(*length))) {
+        return std::nullopt;
+    }
+
+    return content;
+}
+
+std::string DecodeUri(const std::string& uri)
+{
+    std::string result;
+
+    for (std::size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+
+            result.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        } else {
+            result.push_back(uri[i]);
+        }
+    }
+
+    return result;
+}
+
+std::string EncodeUri(const std::string& path)
+{
+    std::ostringstream out;
+    out << std::hex << std::uppercase;
+
+    for (char ch: path) {
+        auto byte = static_cast<unsigned char>(ch);
+
+        if (std::isalnum(byte) || std::strchr("-._~/:", ch)) {
+            out << ch;
+        } else {
+            out << '%' << std::setw(2) << std::setfill('0') << static_cast<unsigned>(byte);
+        }
+    }
+
+    return out.str();
+}
+
+// Return content line with the specified number or empty string if content does not have such line
+std::string GetLine(const std::string& content, unsigned line)
+{
+    std::istringstream in(content);
+    std::string text;
+
+    for (unsigned i = 0; i <= line; ++i) {
+        if (!std::getline(in, text)) {
+            return {};
+        }
+    }
+
+    return text;
+}
+
+bool IsUtf8Continuation(char ch)
+{
+    return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+}
+
+// Return number of UTF-16 code units (used by LSP to count characters) occupied by the code point, which UTF-8
+// representation starts with the specified byte
+unsigned GetUtf16Length(char first)
+{
+    return static_cast<unsigned char>(first) >= 0xF0 ? 2 : 1;
+}
+
+// Convert offset of the byte in the UTF-8 line to the offset in UTF-16 code units
+unsigned GetCharacter(const std::string& line, std::size_t offset)
+{
+    unsigned character = 0;
+
+    for (std::size_t i = 0; i < std::min(offset, line.size()); ++i) {
+        if (!IsUtf8Continuation(line[i])) {
+            character += GetUtf16Length(line[i]);
+        }
+    }
+
+    return character;
+}
+
+// Convert offset in UTF-16 code units to the offset of the byte in the UTF-8 line
+std::size_t GetOffset(const std::string& line, unsigned character)
+{
+    std::size_t offset = 0;
+
+    for (unsigned current = 0; offset < line.size() && current < character;) {
+        current += GetUtf16Length(line[offset++]);
+
+        while (offset < line.size() && IsUtf8Continuation(line[offset])) {
+            ++offset;
+        }
+    }
+
+    return offset;
+}
+
+// Convert protobuf tokenizer column (tab advances column to the next multiple of the tab width) to the offset of the
+// byte in the line
+std::size_t GetColumnOffset(const std::string& line, int column)
+{
+    std::size_t offset = 0;
+
+    for (int current = 0; offset < line.size() && current < column; ++offset) {
+        current = line[offset] == '\t' ? current + Tab_Width - current % Tab_Width : current + 1;
+    }
+
+    return offset;
+}
+
+// Return LSP position for the protobuf tokenizer line and column in the file content
+json MakePosition(const std::string& content, int line, int column)
+{
+    auto lineNo = static_cast<unsigned>(std::max(line, 0));
+    std::string text = GetLine(content, lineNo);
+    return {{"line", lineNo}, {"character", GetCharacter(text, GetColumnOffset(text, column))}};
+}
+
+json MakeRange(json start, json end)
+{
+    return {{"start", std::move(start)}, {"end", std::move(end)}};
+}
+
+int GetSeverity(std::error_code ec)
+{
+    if (ec.category() == parser_error_category() || ec.category() == spec_error_category()) {
+        return Severity_Error;
+    } else if (ec.category() == spec_warn_category()) {
+        return Severity_Warning;
+    } else {
+        return Severity_Information;
+    }
+}
+
+// Return true if entity of the specified type is represented by the project directory
+bool IsDirectoryEntity(EntityTypeId type)
+{
+    switch (type) {
+    case EntityTypeId::Project:
+    case EntityTypeId::Api:
+    case EntityTypeId::Implementation:
+    case EntityTypeId::Namespace:
+    case EntityTypeId::Class:
+    case EntityTypeId::Method:
+    case EntityTypeId::Service: return true;
+    default: return false;
+    }
+}
+
+// Return file where entity is defined relative to the project directory
+std::filesystem::path GetEntityFile(const Entity* entity)
+{
+    switch (entity->type()) {
+    case EntityTypeId::Struct: return static_cast<const Struct*>(entity)->file();
+    case EntityTypeId::Enum: return static_cast<const Enum*>(entity)->file();
+    case EntityTypeId::Field: return GetEntityFile(entity->parent());
+    case EntityTypeId::Constant: return GetEntityFile(entity->parent());
+    case EntityTypeId::Namespace: return entity->dir() / Namespace_Desc_File;
+    case EntityTypeId::Class: return entity->dir() / Class_Desc_File;
+    case EntityTypeId::Method: return entity->dir() / Method_Desc_File;
+    case EntityTypeId::Service: return entity->dir() / Service_Desc_File;
+    default: return Busrpc_Builtin_File;
+    }
+}
+
+// Return file where error is located relative to the project directory
+std::string GetErrorFile(const Project& project, const ErrorCollector::ErrorInfo& error)
+{
+    if (!error.location.file.empty()) {
+        return error.location.file;
+    } else if (auto entity = error.location.entity.empty() ? nullptr : project.find(error.location.entity)) {
+        return GetEntityFile(entity).generic_string();
+    } else {
+        return Busrpc_Builtin_File;
+    }
+}
+
+// Return true if path denotes directory or file nested in it (any path is nested in the empty directory)
+bool IsWithinDir(const std::string& path, const std::string& dir)
+{
+    return dir.empty() ||
+           (path.compare(0, dir.size(), dir) == 0 && (path.size() == dir.size() || path[dir.size()] == '/'));
+}
+
+// Return directory of the namespace or service, which contains the file, or empty string if file does not belong to
+// any namespace or service
+std::string GetScopeDir(const std::string& relPath)
+{
+    std::filesystem::path path(relPath);
+    auto it = path.begin();
+
+    if (std::distance(it, path.end()) < 3 || (*it != Api_Entity_Name && *it != Implementation_Entity_Name)) {
+        return {};
+    }
+
+    return (*it / *std::next(it)).generic_string();
+}
+
+// Parse file content into the descriptor proto with the source code info
+// Parsing errors are ignored, because locations of the entities, which were parsed before the error, are still known
+protobuf::FileDescriptorProto ParseFile(const std::string& content)
+{
+    protobuf::FileDescriptorProto file;
+    protobuf::io::ArrayInputStream in(content.data(), static_cast<int>(content.size()));
+    protobuf::io::Tokenizer tokenizer(&in, nullptr);
+    protobuf::compiler::Parser parser;
+    parser.Parse(&tokenizer, &file);
+    return file;
+}
+
+// Return index of the descriptor with the specified name or -1 if descriptor is not found
+template<typename TDescriptorProto>
+int FindDescriptorIndex(const protobuf::RepeatedPtrField<TDescriptorProto>& descriptors, const std::string& name)
+{
+    for (int i = 0; i < descriptors.size(); ++i) {
+        if (descriptors.Get(i).name() == name) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Location of the entity name in the file (line and columns are counted by the protobuf tokenizer)
+struct NameLocation {
+    int line;
+    int column;
+    int endColumn;
+};
+
+// Find location of the entity name in the parsed file using it's source code info
+// Returns nullopt if entity is not declared in the file as a protobuf type, field or enumeration constant
+std::optional<NameLocation> FindDeclaration(const protobuf::FileDescriptorProto& file, const Entity* entity)
+{
+    std::deque<const Entity*> entities;
+
+    for (auto current = entity; current; current = current->parent()) {
+        auto type = current->type();
+
+        if (type != EntityTypeId::Struct && type != EntityTypeId::Enum && type != EntityTypeId::Field &&
+            type != EntityTypeId::Constant) {
+            break;
+        }
+
+        entities.push_front(current);
+    }
+
+    // location path is a sequence of the descriptor proto field numbers and indices of the nested descriptors (see
+    // SourceCodeInfo.Location.path)
+    std::vector<int> path;
+    const protobuf::DescriptorProto* message = nullptr;
+    const protobuf::EnumDescriptorProto* enumeration = nullptr;
+
+    for (auto current: entities) {
+        int index = -1;
+
+        switch (current->type()) {
+        case EntityTypeId::Struct:
+            {
+                const auto& messages = message ? message->nested_type() : file.message_type();
+                index = FindDescriptorIndex(messages, current->name());
+                path.push_back(message ? static_cast<int>(protobuf::DescriptorProto::kNestedTypeFieldNumber)
+                                       : static_cast<int>(protobuf::FileDescriptorProto::kMessageTypeFieldNumber));
+                message = index != -1 ? &messages.Get(index) : nullptr;
+                break;
+            }
+        case EntityTypeId::Enum:
+            {
+                const auto& enums = message ? message->enum_type() : file.enum_type();
+                index = FindDescriptorIndex(enums, current->name());
+                path.push_back(message ? static_cast<int>(protobuf::DescriptorProto::kEnumTypeFieldNumber)
+                                       : static_cast<int>(protobuf::FileDescriptorProto::kEnumTypeFieldNumber));
+                enumeration = index != -1 ? &enums.Get(index) : nullptr;
+                break;
+            }
+        case EntityTypeId::Field:
+            index = message ? FindDescriptorIndex(message->field(), current->name()) : -1;
+            path.push_back(protobuf::DescriptorProto::kFieldFieldNumber);
+            break;
+        default:
+            index = enumeration ? FindDescriptorIndex(enumeration->value(), current->name()) : -1;
+            path.push_back(protobuf::EnumDescriptorProto::kValueFieldNumber);
+            break;
+        }
+
+        if (index == -1) {
+            return std::nullopt;
+        }
+
+        path.push_back(index);
+    }
+
+    if (path.empty()) {
+        return std::nullopt;
+    }
+
+    // name field has the same number in all descriptor protos
+    path.push_back(protobuf::DescriptorProto::kNameFieldNumber);
+
+    for (const auto& location: file.source_code_info().location()) {
+        // span is [start line, start column, end column] if location does not span several lines
+        if (std::equal(path.begin(), path.end(), location.path().begin(), location.path().end()) &&
+            location.span_size() == 3) {
+
+            return NameLocation{location.span(0), location.span(1), location.span(2)};
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool IsWordChar(char ch)
+{
+    return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_' || ch == '.';
+}
+
+// Return word (type name) under the cursor
+std::string GetWord(const std::string& content, unsigned line, unsigned character)
+{
+    std::string text = GetLine(content, line);
+    std::size_t pos = GetOffset(text, character);
+
+    if ((pos == text.size() || !IsWordChar(text[pos])) && pos > 0) {
+        --pos;
+    }
+
+    if (pos >= text.size() || !IsWordChar(text[pos])) {
+        return {};
+    }
+
+    std::size_t begin = pos;
+    std::size_t end = pos;
+
+    while (begin > 0 && IsWordChar(text[begin - 1])) {
+        --begin;
+    }
+
+    while (end < text.size() && IsWordChar(text[end])) {
+        ++end;
+    }
+
+    return text.substr(begin, end - begin);
+}
+
+// Return part of the word (type name) preceding the cursor
+std::string GetWordPrefix(const std::string& content, unsigned line, unsigned character)
+{
+    std::string text = GetLine(content, line);
+    std::size_t end = GetOffset(text, character);
+    std::size_t begin = end;
+
+    while (begin > 0 && IsWordChar(text[begin - 1])) {
+        --begin;
+    }
+
+    return text.substr(begin, end - begin);
+}
+
+// Return protobuf package of the project file
+// Entity, which files are placed in the directory, has distinguished name matching the protobuf package of these
+// files
+std::string GetPackage(const std::string& relPath)
+{
+    std::string package = Project_Entity_Name;
+
+    for (const auto& component: std::filesystem::path(relPath).parent_path()) {
+        package.append(".").append(component.string());
+    }
+
+    return package;
+}
+
+// Find entity by the type name used in the scope of the entity (protobuf package) using protobuf name resolution
+// rules
+// Names declared in the structures are resolved first, because they are closer to the usage than package names
+const Entity* ResolveTypeName(const Project& project,
+                              const GeneralCompositeEntity* scope,
+                              const std::filesystem::path& file,
+                              const std::string& name)
+{
+    if (name.front() == '.') {
+        return project.find(name.substr(1));
+    }
+
+    std::vector<const Struct*> structs(scope->structs().begin(), scope->structs().end());
+
+    for (std::size_t i = 0; i < structs.size(); ++i) {
+        auto structure = structs[i];
+
+        if (structure->file() != file) {
+            continue;
+        }
+
+        if (auto entity = project.find(structure->dname() + "." + name)) {
+            return entity;
+        }
+
+        structs.insert(structs.end(), structure->structs().begin(), structure->structs().end());
+    }
+
+    for (std::string package = scope->dname(); !package.empty();) {
+        if (auto entity = project.find(package + "." + name)) {
+            return entity;
+        }
+
+        auto pos = package.rfind('.');
+        package = pos != std::string::npos ? package.substr(0, pos) : std::string{};
+    }
+
+    return project.find(name);
+}
+
+int GetCompletionKind(EntityTypeId type)
+{
+    switch (type) {
+    case EntityTypeId::Class: return Completion_Kind_Class;
+    case EntityTypeId::Method: return Completion_Kind_Method;
+    case EntityTypeId::Struct: return Completion_Kind_Struct;
+    case EntityTypeId::Field: return Completion_Kind_Field;
+    case EntityTypeId::Enum: return Completion_Kind_Enum;
+    case EntityTypeId::Constant: return Completion_Kind_Enum_Member;
+    default: return Completion_Kind_Module;
+    }
+}
+
+std::string GetHoverText(const Entity* entity)
+{
+    std::ostringstream out;
+    out << "**" << GetEntityTypeIdStr(entity->type()) << "** `" << entity->dname() << "`";
+
+    for (const auto& line: entity->docs().description()) {
+        out << (&line == &entity->docs().description().front() ? "\n\n" : "\n") << line;
+    }
+
+    for (const auto& [name, values]: entity->docs().commands()) {
+        for (const auto& value: values) {
+            out << "\n\n`\\" << name << "`" << (value.empty() ? "" : " ") << value;
+        }
+    }
+
+    return out.str();
+}
+} // namespace
+
+LspServer::LspServer(std::filesystem::path projectDir, std::filesystem::path protobufRoot):
+    projectDir_(std::move(projectDir)),
+    protobufRoot_(std::move(protobufRoot))
+{
+    std::error_code ec;
+    auto canonicalDir = std::filesystem::weakly_canonical(projectDir_, ec);
+
+    if (!ec) {
+        projectDir_ = std::move(canonicalDir);
+    }
+}
+
+bool LspServer::serve(std::istream& in, std::ostream& out)
+{
+    while (!isExited_) {
+        auto message = ReadMessage(in);
+
+        if (!message) {
+            break;
+        }
+
+        handleMessage(*message, out);
+
+        // changes received while previous change was analyzed are analyzed together
+        if (in.rdbuf()->in_avail() <= 0) {
+            analyzePending(out);
+        }
+    }
+
+    return isExited_ && isShutdown_;
+}
+
+void LspServer::handle(const std::string& message, std::ostream& out)
+{
+    handleMessage(message, out);
+    analyzePending(out);
+}
+
+void LspServer::handleMessage(const std::string& message, std::ostream& out)
+{
+    json doc = json::parse(message, nullptr, false);
+
+    if (doc.is_discarded() || !doc.is_object()) {
+        WriteError(out, nullptr, Parse_Error, "failed to parse message");
+        return;
+    }
+
+    auto methodIt = doc.find("method");
+    auto idIt = doc.find("id");
+
+    if (methodIt == doc.end() || !methodIt->is_string()) {
+        // responses are ignored, because server does not send requests to the client
+        if (idIt != doc.end() && !doc.contains("result") && !doc.contains("error")) {
+            WriteError(out, *idIt, Invalid_Request, "message does not specify method");
+        }
+
+        return;
+    }
+
+    json params = doc.value("params", json::object());
+
+    if (idIt != doc.end()) {
+        try {
+            handleRequest(*idIt, methodIt->get<std::string>(), params, out);
+        } catch (const json::exception& e) {
+            WriteError(out, *idIt, Invalid_Params, e.what());
+        }
+    } else {
+        try {
+            handleNotification(methodIt->get<std::string>(), params);
+        } catch (const json::exception&) {
+            // notifications can't be responded with error
+        }
+    }
+}
+
+void LspServer::handleRequest(const json& id, const std::string& method, const json& params, std::ostream& out)
+{
+    // request is responded using the project, which reflects all changes received before it
+    analyzePending(out);
+
+    if (method == "initialize") {
+        isInitialized_ = true;
+        json capabilities = {
+            {"textDocumentSync", {{"openClose", true}, {"change", Text_Document_Sync_Full}, {"save", true}}},
+            {"definitionProvider", true},
+            {"hoverProvider", true},
+            {"completionProvider", {{"triggerCharacters", {"."}}}}};
+        WriteResponse(out,
+                      id,
+                      {{"capabilities", std::move(capabilities)},
+                       {"serverInfo", {{"name", "busrpc"}, {"version", BUSRPC_VERSION}}}});
+    } else if (!isInitialized_) {
+        WriteError(out, id, Server_Not_Initialized, "server is not initialized");
+    } else if (isShutdown_) {
+        WriteError(out, id, Invalid_Request, "server is shut down");
+    } else if (method == "shutdown") {
+        isShutdown_ = true;
+        WriteResponse(out, id, nullptr);
+    } else if (method == "textDocument/definition") {
+        WriteResponse(out, id, findDefinition(params));
+    } else if (method == "textDocument/hover") {
+        WriteResponse(out, id, getHover(params));
+    } else if (method == "textDocument/completion") {
+        WriteResponse(out, id, getCompletions(params));
+    } else {
+        WriteError(out, id, Method_Not_Found, "method '" + method + "' is not supported");
+    }
+}
+
+void LspServer::handleNotification(const std::string& method, const json& params)
+{
+    if (method == "exit") {
+        isExited_ = true;
+        return;
+    }
+
+    if (!isInitialized_ || isShutdown_) {
+        return;
+    }
+
+    // analysis is postponed to coalesce document changes (see serve)
+    auto requestAnalysis = [this](const std::string& relPath) {
+        if (auto dir = GetScopeDir(relPath); !dir.empty()) {
+            pendingDirs_.insert(std::move(dir));
+        } else {
+            isFullAnalysisPending_ = true;
+        }
+    };
+
+    if (method == "initialized" || method == "workspace/didChangeWatchedFiles") {
+        isFullAnalysisPending_ = true;
+    } else if (method == "textDocument/didOpen") {
+        auto relPath = getRelativePath(params.at("textDocument").at("uri").get<std::string>());
+
+        if (relPath) {
+            std::string text = params.at("textDocument").at("text").get<std::string>();
+            bool isChanged = !project_ || getContent(*relPath) != text;
+            overlay_[*relPath] = std::move(text);
+
+            if (isChanged) {
+                requestAnalysis(*relPath);
+            }
+        }
+    } else if (method == "textDocument/didChange") {
+        auto relPath = getRelativePath(params.at("textDocument").at("uri").get<std::string>());
+        const auto& changes = params.at("contentChanges");
+
+        // server requests full document synchronization, so the last change contains the whole document
+        if (relPath && !changes.empty()) {
+            overlay_[*relPath] = changes.back().at("text").get<std::string>();
+            requestAnalysis(*relPath);
+        }
+    } else if (method == "textDocument/didClose") {
+        auto relPath = getRelativePath(params.at("textDocument").at("uri").get<std::string>());
+        auto it = relPath ? overlay_.find(*relPath) : overlay_.end();
+
+        if (it != overlay_.end()) {
+            std::string text = std::move(it->second);
+            overlay_.erase(it);
+
+            // document may be closed without saving changes
+            if (getContent(*relPath) != text) {
+                requestAnalysis(*relPath);
+            }
+        }
+    }
+}
+
+json LspServer::findDefinition(const json& params) const
+{
+    std::string relPath;
+    auto entity = findEntity(params, relPath);
+
+    if (!entity) {
+        return nullptr;
+    }
+
+    auto file = GetEntityFile(entity).generic_string();
+    std::string content = getContent(file);
+    auto name = FindDeclaration(ParseFile(content), entity);
+
+    if (!name) {
+        return {{"uri", getUri(file)}, {"range", MakeRange(MakePosition(content, 0, 0), MakePosition(content, 0, 0))}};
+    }
+
+    return {{"uri", getUri(file)},
+            {"range",
+             MakeRange(MakePosition(content, name->line, name->column),
+                       MakePosition(content, name->line, name->endColumn))}};
+}
+
+json LspServer::getHover(const json& params) const
+{
+    std::string relPath;
+    auto entity = findEntity(params, relPath);
+
+    if (!entity) {
+        return nullptr;
+    }
+
+    return {{"contents", {{"kind", "markdown"}, {"value", GetHoverText(entity)}}}};
+}
+
+json LspServer::getCompletions(const json& params) const
+{
+    json items = json::array();
+    auto path = getRelativePath(params.at("textDocument").at("uri").get<std::string>());
+
+    if (!project_ || !path) {
+        return items;
+    }
+
+    std::string name = GetWordPrefix(getContent(*path),
+                                      params.at("position").at("line").get<unsigned>(),
+                                      params.at("position").at("character").get<unsigned>());
+    std::vector<std::string> prefixes;
+
+    // relative name may refer to the entity from the file package or any of it's parent packages; names from the
+    // inner packages hide names from the outer ones
+    if (!name.empty() && name.front() == '.') {
+        prefixes.push_back(name.substr(1));
+    } else {
+        for (std::string package = GetPackage(*path); !package.empty();) {
+            prefixes.push_back(package + "." + name);
+            auto pos = package.rfind('.');
+            package = pos != std::string::npos ? package.substr(0, pos) : std::string{};
+        }
+
+        prefixes.push_back(name);
+    }
+
+    std::set<std::string> labels;
+
+    for (const auto& prefix: prefixes) {
+        for (const auto& entry: project_->dnames().complete(prefix, Max_Completion_Items - labels.size())) {
+            std::string label(entry.dname.substr(entry.dname.rfind('.') + 1));
+
+            if (labels.insert(label).second) {
+                items.push_back({{"label", std::move(label)},
+                                 {"kind", GetCompletionKind(entry.entity->type())},
+                                 {"detail", std::string(entry.dname)}});
+            }
+        }
+    }
+
+    return items;
+}
+
+void LspServer::analyzePending(std::ostream& out)
+{
+    if (!isFullAnalysisPending_ && pendingDirs_.empty()) {
+        return;
+    }
+
+    bool isFull = isFullAnalysisPending_ || !project_;
+    std::set<std::string> dirs = std::move(pendingDirs_);
+    pendingDirs_.clear();
+    isFullAnalysisPending_ = false;
+
+    for (auto it = dirs.begin(); !isFull && it != dirs.end(); ++it) {
+        isFull = !analyzeScope(*it, out);
+    }
+
+    if (isFull) {
+        analyze(out);
+    }
+}
+
+void LspServer::analyze(std::ostream& out)
+{
+    auto start = std::chrono::steady_clock::now();
+    Parser parser(projectDir_, protobufRoot_, overlay_);
+    auto [project, ecol] = parser.parse({}, &cache_);
+    project_ = Project::Freeze(std::move(project));
+
+    // cache is not used if project is not checked because of the parser errors
+    if (!ecol.majorError() || ecol.majorError()->code.category() != parser_error_category()) {
+        cache_.prune();
+        prunedCacheSize_ = cache_.size();
+    }
+
+    analysisTime_ = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    analysisScope_.clear();
+
+    publishDiagnostics(ecol, {}, out);
+    WriteNotification(out,
+                      "window/logMessage",
+                      {{"type", Message_Type_Log},
+                       {"message", "project analyzed in " + std::to_string(analysisTime_.count() / 1000) + " ms"}});
+}
+
+bool LspServer::analyzeScope(const std::string& scopeDir, std::ostream& out)
+{
+    // project is not checked if any file fails to parse, so errors of other files may appear only when the whole
+    // project is analyzed
+    for (const auto& [file, errors]: fileErrors_) {
+        if (!IsWithinDir(file, scopeDir) && std::any_of(errors.begin(), errors.end(), [](const auto& error) {
+                return error.code.category() == parser_error_category();
+            })) {
+            return false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::string scope = std::string(Project_Entity_Name) + "." + scopeDir;
+    std::replace(scope.begin(), scope.end(), '/', '.');
+    Parser parser(projectDir_, protobufRoot_, overlay_);
+    auto [part, ecol] = parser.parse({}, &cache_, scope);
+
+    if (ecol.find(ParserErrc::Invalid_Project_Dir) || ecol.find(ParserErrc::Invalid_Scope) ||
+        !Project::Splice(project_, std::move(part), scope)) {
+        return false;
+    }
+
+    if (cache_.size() > 2 * prunedCacheSize_) {
+        cache_.prune();
+        prunedCacheSize_ = cache_.size();
+    }
+
+    analysisTime_ = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    analysisScope_ = std::move(scope);
+
+    publishDiagnostics(ecol, scopeDir, out);
+    WriteNotification(out,
+                      "window/logMessage",
+                      {{"type", Message_Type_Log},
+                       {"message",
+                        analysisScope_ + " analyzed in " + std::to_string(analysisTime_.count() / 1000) + " ms"}});
+    return true;
+}
+
+void LspServer::publishDiagnostics(const ErrorCollector& ecol, const std::string& dir, std::ostream& out)
+{
+    std::set<std::string> files;
+
+    // errors of the analyzed files are replaced and diagnostics of the files, which no longer have errors, are cleared
+    for (auto it = fileErrors_.begin(); it != fileErrors_.end();) {
+        if (IsWithinDir(it->first, dir)) {
+            files.insert(it->first);
+            it = fileErrors_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto& error: ecol.errors()) {
+        if (auto file = GetErrorFile(*project_, error); IsWithinDir(file, dir)) {
+            files.insert(file);
+            fileErrors_[std::move(file)].push_back(error);
+        }
+    }
+
+    for (const auto& file: files) {
+        auto it = fileErrors_.find(file);
+
+        WriteNotification(
+            out,
+            "textDocument/publishDiagnostics",
+            {{"uri", getUri(file)},
+             {"diagnostics", it != fileErrors_.end() ? getDiagnostics(file, it->second) : json::array()}});
+    }
+}
+
+json LspServer::getDiagnostics(const std::string& file, const std::vector<ErrorCollector::ErrorInfo>& errors) const
+{
+    json diagnostics = json::array();
+    std::string content = getContent(file);
+
+    // file is parsed only if some of the errors should be located at the entity name
+    std::optional<protobuf::FileDescriptorProto> parsedFile;
+
+    for (const auto& error: errors) {
+        const auto& location = error.location;
+        auto entity = location.entity.empty() ? nullptr : project_->find(location.entity);
+        json rangeStart = MakePosition(content, location.line, location.column);
+        json rangeEnd = rangeStart;
+
+        // errors found by the project check are located at the name of the entity, which is their subject
+        if (location.line < 0 && entity && GetEntityFile(entity) == file) {
+            if (!parsedFile) {
+                parsedFile = ParseFile(content);
+            }
+
+            if (auto name = FindDeclaration(*parsedFile, entity)) {
+                rangeStart = MakePosition(content, name->line, name->column);
+                rangeEnd = MakePosition(content, name->line, name->endColumn);
+            }
+        }
+
+        diagnostics.push_back({{"range", MakeRange(std::move(rangeStart), std::move(rangeEnd))},
+                               {"severity", GetSeverity(error.code)},
+                               {"code", error.code.value()},
+                               {"source", "busrpc"},
+                               {"message", error.description}});
+    }
+
+    return diagnostics;
+}
+
+std::optional<std::string> LspServer::getRelativePath(const std::string& uri) const
+{
+    if (uri.compare(0, std::strlen(File_Uri_Scheme), File_Uri_Scheme) != 0) {
+        return std::nullopt;
+    }
+
+    std::string path = DecodeUri(uri.substr(std::strlen(File_Uri_Scheme)));
+
+#ifdef _WIN32
+    // URI path of the file on Windows looks like '/C:/dir/file'
+    if (path.size() > 2 && path[0] == '/' && path[2] == ':') {
+        path.erase(0, 1);
+    }
+#endif
+
+    std::error_code ec;
+    auto canonicalPath = std::filesystem::weakly_canonical(path, ec);
+    auto relPath = (ec ? std::filesystem::path(path) : canonicalPath).lexically_relative(projectDir_);
+
+    if (relPath.empty() || *relPath.begin() == "..") {
+        return std::nullopt;
+    }
+
+    return relPath.generic_string();
+}
+
+std::string LspServer::getUri(const std::string& relPath) const
+{
+    std::string path = (projectDir_ / relPath).generic_string();
+    return File_Uri_Scheme + EncodeUri(path.front() == '/' ? path : "/" + path);
+}
+
+std::string LspServer::getContent(const std::string& relPath) const
+{
+    if (auto it = overlay_.find(relPath); it != overlay_.end()) {
+        return it->second;
+    }
+
+    std::ifstream file(projectDir_ / relPath, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+const Entity* LspServer::findEntity(const json& params, std::string& relPath) const
+{
+    auto path = getRelativePath(params.at("textDocument").at("uri").get<std::string>());
+
+    if (!project_ || !path) {
+        return nullptr;
+    }
+
+    relPath = *path;
+    std::string name = GetWord(getContent(relPath),
+                               params.at("position").at("line").get<unsigned>(),
+                               params.at("position").at("character").get<unsigned>());
+
+    if (name.empty()) {
+        return nullptr;
+    }
+
+    auto scope = project_->find(GetPackage(relPath));
+
+    if (!scope || !IsDirectoryEntity(scope->type())) {
+        return project_->find(name.front() == '.' ? name.substr(1) : name);
+    }
+
+    return ResolveTypeName(*project_, static_cast<const GeneralCompositeEntity*>(scope), relPath, name);
+}
+} // namespace busrpc
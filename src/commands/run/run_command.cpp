@@ -0,0 +1,173 @@
+#include "check_cache.h"
+#include "commands/run/run_command.h"
+#include "parser/parser.h"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace busrpc {
+
+namespace {
+
+class RunErrorCategory: public std::error_category {
+public:
+    const char* name() const noexcept override { return "run"; }
+
+    std::string message(int code) const override
+    {
+        switch (static_cast<RunErrc>(code)) {
+        case RunErrc::Spec_Violated: return "Busrpc specification violated";
+        case RunErrc::Protobuf_Parsing_Failed: return "Failed to parse protobuf file";
+        case RunErrc::File_Operation_Failed: return "File or directory access error";
+        case RunErrc::Invalid_Argument: return "Invalid argument";
+        default: return "Unknown error";
+        }
+    }
+
+    bool equivalent(int code, const std::error_condition& condition) const noexcept override
+    {
+        switch (static_cast<RunErrc>(code)) {
+        case RunErrc::Spec_Violated: return condition == CommandError::Spec_Violated;
+        case RunErrc::Protobuf_Parsing_Failed: return condition == CommandError::Protobuf_Parsing_Failed;
+        case RunErrc::File_Operation_Failed: return condition == CommandError::File_Operation_Failed;
+        case RunErrc::Invalid_Argument: return condition == CommandError::Invalid_Argument;
+        default: return false;
+        }
+    }
+};
+
+// Project directory, protobuf root directory, parsing scope and shard (index and count)
+using ProjectKey =
+    std::tuple<std::filesystem::path, std::filesystem::path, std::string, std::pair<std::size_t, std::size_t>>;
+
+// Project parsed once for all commands with the same key
+struct ParsedProject {
+    FrozenProjectPtr project;
+    ErrorCollector ecol;
+    CheckCache cache;
+    bool isCacheUsed = false;
+};
+
+std::pair<std::size_t, std::size_t> GetShard(const CheckArgs& args)
+{
+    return {args.shardIndex(), args.shardCount()};
+}
+
+std::pair<std::size_t, std::size_t> GetShard(const GenDocArgs&)
+{
+    return {0, 1};
+}
+
+ProjectKey GetProjectKey(const RunArgs::CommandArgs& commandArgs)
+{
+    return std::visit(
+        [](const auto& args) {
+            return ProjectKey(args.projectDir(), args.protobufRootDir(), args.scope(), GetShard(args));
+        },
+        commandArgs);
+}
+
+// Return cache file of the first check command for the project with the specified key
+std::filesystem::path FindCacheFile(const RunArgs& args, const ProjectKey& key)
+{
+    for (const auto& commandArgs: args.commands()) {
+        auto checkArgs = std::get_if<CheckArgs>(&commandArgs);
+
+        if (checkArgs && !checkArgs->cacheFile().empty() && GetProjectKey(commandArgs) == key) {
+            return checkArgs->cacheFile();
+        }
+    }
+
+    return {};
+}
+
+RunErrc GetRunErrc(std::error_code ec)
+{
+    if (ec == CommandError::Invalid_Argument) {
+        return RunErrc::Invalid_Argument;
+    } else if (ec == CommandError::File_Operation_Failed) {
+        return RunErrc::File_Operation_Failed;
+    } else if (ec == CommandError::Protobuf_Parsing_Failed) {
+        return RunErrc::Protobuf_Parsing_Failed;
+    } else {
+        return RunErrc::Spec_Violated;
+    }
+}
+} // namespace
+
+std::error_code RunCommand::tryExecuteImpl(std::ostream& out, std::ostream& err) const
+{
+    std::map<ProjectKey, ParsedProject> projects;
+    std::vector<std::pair<CommandId, std::error_code>> results;
+    std::error_code result(0, run_error_category());
+
+    for (const auto& commandArgs: args().commands()) {
+        auto key = GetProjectKey(commandArgs);
+        Parser parser(std::get<0>(key), std::get<1>(key));
+        auto it = projects.find(key);
+
+        if (it == projects.end()) {
+            it = projects.try_emplace(key).first;
+            auto& parsed = it->second;
+            auto cacheFile = FindCacheFile(args(), key);
+
+            if (!cacheFile.empty()) {
+                parsed.cache.load(cacheFile);
+                parsed.isCacheUsed = true;
+            }
+
+            // errors are not ignored here, because each command filters them by it's own ignored categories
+            ProjectPtr project;
+            std::tie(project, parsed.ecol) = parser.parse({},
+                                                          parsed.isCacheUsed ? &parsed.cache : nullptr,
+                                                          std::get<2>(key),
+                                                          {std::get<3>(key).first, std::get<3>(key).second});
+            parsed.project = Project::Freeze(std::move(project));
+        }
+
+        const auto& parsed = it->second;
+
+        if (auto checkArgs = std::get_if<CheckArgs>(&commandArgs)) {
+            auto cache = parsed.isCacheUsed ? &parsed.cache : nullptr;
+            results.emplace_back(CommandId::Check,
+                                 CheckCommand(*checkArgs).tryExecuteParsed(parser, parsed.ecol, cache, out, err));
+        } else {
+            GenDocCommand command(std::get<GenDocArgs>(commandArgs));
+            results.emplace_back(CommandId::GenDoc,
+                                 command.tryExecuteParsed(parser, *parsed.project, parsed.ecol, out, err));
+        }
+
+        if (results.back().second && static_cast<int>(GetRunErrc(results.back().second)) > result.value()) {
+            result = GetRunErrc(results.back().second);
+        }
+    }
+
+    for (const auto& [id, ec]: results) {
+        out << GetCommandName(id) << ": " << ec.value();
+
+        if (ec) {
+            out << " (" << ec.message() << ")";
+        }
+
+        out << std::endl;
+    }
+
+    return result;
+}
+
+const std::error_category& run_error_category()
+{
+    static const RunErrorCategory category;
+    return category;
+}
+
+std::error_code make_error_code(RunErrc e)
+{
+    return {static_cast<int>(e), run_error_category()};
+}
+} // namespace busrpc
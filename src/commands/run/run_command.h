@@ -0,0 +1,87 @@
+#pragma once
+
+#include "commands/check/check_command.h"
+#include "commands/command.h"
+#include "commands/gendoc/gendoc_command.h"
+
+#include <functional>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+/// \dir commands/run Types and utilites for \c run command implementation.
+/// \file run_command.h Command \c run implementation.
+
+namespace CLI {
+class App;
+}
+
+namespace busrpc {
+
+/// Command-specific error code.
+/// \note Error code of the \c run command is the most severe error condition (see \ref CommandError) of the executed
+///       commands.
+enum class RunErrc {
+    /// Busrpc specification violated.
+    Spec_Violated = 1,
+
+    /// Failed to parse protobuf file.
+    Protobuf_Parsing_Failed = 2,
+
+    /// File or directory operation failed.
+    File_Operation_Failed = 3,
+
+    /// Invalid command argument.
+    Invalid_Argument = 4
+};
+
+/// Return error category for the \c run command.
+const std::error_category& run_error_category();
+
+/// Create error code from the \ref RunErrc value.
+std::error_code make_error_code(RunErrc errc);
+
+/// Arguments of the \c run command.
+class RunArgs {
+public:
+    /// Arguments of the command to run.
+    using CommandArgs = std::variant<CheckArgs, GenDocArgs>;
+
+    /// Create \c run command arguments.
+    RunArgs(std::vector<CommandArgs> commands = {}): commands_(std::move(commands)) { }
+
+    /// Commands to run in the order of execution.
+    /// \note Commands with the same project directory, protobuf root directory and scope share the parsed project.
+    ///       Each command still filters parsing errors by it's own ignored categories and writes it's own output.
+    /// \note If some \c check commands set the cache file, project is parsed with the cache loaded from the file of
+    ///       the first such command and the cache is saved to the file of each such command.
+    const std::vector<CommandArgs>& commands() const noexcept { return commands_; }
+
+private:
+    std::vector<CommandArgs> commands_;
+};
+
+/// Run several commands over the project parsed once.
+/// \note All commands are executed even if some of them fail. Error code of each command is written to the output
+///       after all commands are finished.
+class RunCommand: public Command<CommandId::Run, RunArgs> {
+public:
+    /// Base type.
+    using BaseType = Command<CommandId::Run, RunArgs>;
+
+    /// Create command.
+    explicit RunCommand(RunArgs args) noexcept: BaseType(std::move(args)) { }
+
+protected:
+    /// Execute command.
+    std::error_code tryExecuteImpl(std::ostream& out, std::ostream& err) const override;
+};
+
+/// Define \c run command line options and set a \a callback to be invoked when \a app encounters the command.
+void DefineCommand(CLI::App& app, const std::function<void(RunArgs)>& callback);
+} // namespace busrpc
+
+namespace std {
+template<>
+struct is_error_code_enum<busrpc::RunErrc>: true_type { };
+} // namespace std
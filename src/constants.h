@@ -25,6 +25,36 @@ inline constexpr const char* Service_Desc_File = "service.proto";
 /// Name of the file with busrpc project JSON documentation.
 inline constexpr const char* Json_Doc_File = "busrpc-project.json";
 
+/// Identifier of the compact JSON documentation schema.
+inline constexpr const char* Compact_Json_Schema = "busrpc-compact";
+
+/// Version of the compact JSON documentation schema.
+inline constexpr int Compact_Json_Schema_Version = 1;
+
+/// Name of the file with the search index of busrpc project documentation.
+inline constexpr const char* Search_Index_File = "busrpc-search-index.json";
+
+/// Identifier of the search index schema.
+inline constexpr const char* Search_Index_Schema = "busrpc-search-index";
+
+/// Version of the search index schema.
+inline constexpr int Search_Index_Schema_Version = 1;
+
+/// Name of the file with busrpc project CBOR documentation.
+inline constexpr const char* Cbor_Doc_File = "busrpc-project.cbor";
+
+/// Name of the file with busrpc project MessagePack documentation.
+inline constexpr const char* MsgPack_Doc_File = "busrpc-project.msgpack";
+
+/// Name of the directory with sharded busrpc project JSON documentation.
+inline constexpr const char* Json_Doc_Shards_Dir = "busrpc-project";
+
+/// Name of the sharded JSON documentation index file.
+inline constexpr const char* Json_Doc_Index_File = "index.json";
+
+/// Name of the manifest file, which stores content hashes of the documentation files written by the previous run.
+inline constexpr const char* Doc_Manifest_File = "manifest.json";
+
 /// Predefined \ref Project entity name.
 inline constexpr const char* Project_Entity_Name = "busrpc";
 
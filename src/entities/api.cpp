@@ -26,4 +26,31 @@ Namespace* Api::addNamespace(const std::string& name)
     namespaces_.insert(ns);
     return ns;
 }
+
+EntityResult<Namespace> Api::tryAddNamespace(const std::string& name)
+{
+    auto result = tryAddNestedEntity<Namespace>(name, name);
+
+    if (result) {
+        namespaces_.insert(result.value());
+    }
+
+    return result;
+}
+
+std::unique_ptr<Namespace> Api::releaseNamespace(const std::string& name)
+{
+    if (namespaces_.find(name) == namespaces_.end()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Namespace> ns(static_cast<Namespace*>(releaseNestedEntity(name).release()));
+    namespaces_.erase(ns.get());
+    return ns;
+}
+
+void Api::adoptNamespace(std::unique_ptr<Namespace> ns)
+{
+    namespaces_.insert(static_cast<Namespace*>(adoptNestedEntity(std::move(ns))));
+}
 } // namespace busrpc
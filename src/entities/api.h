@@ -6,6 +6,7 @@
 #include "entities/project.h"
 #include "entities/struct.h"
 
+#include <memory>
 #include <string>
 
 /// \file api.h Project API entity.
@@ -20,6 +21,8 @@ class Api: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// Project to which API belongs.
     const Project* parent() const noexcept;
@@ -34,12 +37,20 @@ public:
     /// \throws name_conflict_error if nested entity with the same name already exists
     Namespace* addNamespace(const std::string& name);
 
+    /// Add namespace without throwing entity errors.
+    /// \note Returns error code if namespace can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Namespace> tryAddNamespace(const std::string& name);
+
 protected:
     /// Create API entity.
     explicit Api(CompositeEntity* project);
 
 private:
     friend class CompositeEntity;
+    friend class Project;
+
+    std::unique_ptr<Namespace> releaseNamespace(const std::string& name);
+    void adoptNamespace(std::unique_ptr<Namespace> ns);
 
     EntityContainer<Namespace> namespaces_;
 };
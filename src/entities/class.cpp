@@ -27,6 +27,17 @@ Method* Class::addMethod(const std::string& name)
     return method;
 }
 
+EntityResult<Method> Class::tryAddMethod(const std::string& name)
+{
+    auto result = tryAddNestedEntity<Method>(name, name);
+
+    if (result) {
+        methods_.insert(result.value());
+    }
+
+    return result;
+}
+
 void Class::onNestedEntityAdded(Entity* entity)
 {
     if (entity->type() == EntityTypeId::Struct) {
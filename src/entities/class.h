@@ -19,6 +19,8 @@ class Class: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// Namespace where class is defined.
     const Namespace* parent() const noexcept;
@@ -43,6 +45,10 @@ public:
     /// \throws name_conflict_error if nested entity with the same name already exists
     Method* addMethod(const std::string& name);
 
+    /// Add method without throwing entity errors.
+    /// \note Returns error code if method can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Method> tryAddMethod(const std::string& name);
+
 protected:
     /// Create class entity.
     Class(CompositeEntity* ns, const std::string& name);
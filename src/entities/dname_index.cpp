@@ -0,0 +1,193 @@
+#include "entities/dname_index.h"
+#include "entities/traversal.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace busrpc {
+
+namespace {
+
+// Compare characters in the same way as std::string_view does, so that the nodes are searched in the order in which
+// they are created from the sorted entries
+bool IsLess(char lhs, char rhs) noexcept
+{
+    return static_cast<unsigned char>(lhs) < static_cast<unsigned char>(rhs);
+}
+} // namespace
+
+DnameIndex::DnameIndex(const Entity& root)
+{
+    std::vector<std::pair<std::size_t, const Entity*>> offsets;
+
+    for (const Entity* entity: EntitySubtree(root)) {
+        offsets.emplace_back(dnames_.size(), entity);
+        dnames_.insert(dnames_.end(), entity->dname().begin(), entity->dname().end());
+    }
+
+    // entries are created after all dnames are stored, because storage may be reallocated
+    entries_.reserve(offsets.size());
+
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        std::size_t end = i + 1 < offsets.size() ? offsets[i + 1].first : dnames_.size();
+        entries_.push_back({{dnames_.data() + offsets[i].first, end - offsets[i].first}, offsets[i].second});
+    }
+
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.dname < rhs.dname;
+    });
+
+    if (entries_.empty()) {
+        return;
+    }
+
+    // nodes are created in the breadth-first order, which makes children of each node contiguous; until node is
+    // processed, it's depth is the depth of it's parent
+    nodes_.push_back({0, 0, 0, 0, 0, static_cast<uint32_t>(entries_.size())});
+
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        auto begin = entries_.begin() + nodes_[i].firstEntry;
+        auto end = entries_.begin() + nodes_[i].endEntry;
+        std::string_view first = begin->dname;
+        std::string_view last = (end - 1)->dname;
+        std::size_t depth = nodes_[i].depth;
+
+        while (depth < first.size() && depth < last.size() && first[depth] == last[depth]) {
+            ++depth;
+        }
+
+        nodes_[i].labelSize = static_cast<uint32_t>(depth - nodes_[i].depth);
+        nodes_[i].depth = static_cast<uint32_t>(depth);
+        nodes_[i].firstChild = static_cast<uint32_t>(nodes_.size());
+
+        if (begin->dname.size() == depth) {
+            ++begin;
+        }
+
+        while (begin != end) {
+            char ch = begin->dname[depth];
+            auto childEnd =
+                std::partition_point(begin, end, [depth, ch](const Entry& entry) { return entry.dname[depth] == ch; });
+            nodes_.push_back({static_cast<uint32_t>(depth),
+                              0,
+                              0,
+                              0,
+                              static_cast<uint32_t>(begin - entries_.begin()),
+                              static_cast<uint32_t>(childEnd - entries_.begin())});
+            begin = childEnd;
+        }
+
+        nodes_[i].childCount = static_cast<uint32_t>(nodes_.size() - nodes_[i].firstChild);
+    }
+}
+
+const Entity* DnameIndex::find(std::string_view dname) const noexcept
+{
+    auto node = findNode(dname);
+    return node && node->depth == dname.size() && hasEntity(*node) ? entries_[node->firstEntry].entity : nullptr;
+}
+
+std::span<const DnameIndex::Entry> DnameIndex::findPrefix(std::string_view prefix) const noexcept
+{
+    auto node = findNode(prefix);
+    return node ? std::span<const Entry>(entries_).subspan(node->firstEntry, node->endEntry - node->firstEntry)
+                : std::span<const Entry>();
+}
+
+std::span<const DnameIndex::Entry> DnameIndex::findScope(std::string_view scope) const noexcept
+{
+    auto entries = findPrefix(scope);
+
+    // separator precedes any character allowed in the entity name, so entities nested to the scope entity are
+    // placed before other entities with the same prefix
+    auto end = std::partition_point(entries.begin(), entries.end(), [&scope](const Entry& entry) {
+        return entry.dname.size() == scope.size() || entry.dname[scope.size()] == '.';
+    });
+
+    return entries.first(static_cast<std::size_t>(end - entries.begin()));
+}
+
+std::vector<DnameIndex::Entry> DnameIndex::complete(std::string_view prefix, std::size_t limit) const
+{
+    std::vector<Entry> result;
+    auto node = findNode(prefix);
+
+    if (!node || limit == 0) {
+        return result;
+    }
+
+    std::string_view rest = entries_[node->firstEntry].dname.substr(prefix.size(), node->depth - prefix.size());
+
+    if (rest.find('.') != std::string_view::npos) {
+        return result;
+    }
+
+    // each visited node either contains completion or has several children, because dnames of the parent entities
+    // are also indexed, so number of visited nodes is proportional to the result size
+    std::vector<const Node*> nodes = {node};
+
+    while (!nodes.empty() && result.size() < limit) {
+        node = nodes.back();
+        nodes.pop_back();
+
+        if (hasEntity(*node)) {
+            result.push_back(entries_[node->firstEntry]);
+        }
+
+        for (auto i = node->firstChild + node->childCount; i > node->firstChild; --i) {
+            if (getLabel(nodes_[i - 1]).find('.') == std::string_view::npos) {
+                nodes.push_back(&nodes_[i - 1]);
+            }
+        }
+    }
+
+    return result;
+}
+
+const DnameIndex::Node* DnameIndex::findNode(std::string_view prefix) const noexcept
+{
+    if (nodes_.empty()) {
+        return nullptr;
+    }
+
+    const Node* node = &nodes_.front();
+
+    while (true) {
+        std::size_t begin = node->depth - node->labelSize;
+        std::size_t count = std::min<std::size_t>(prefix.size(), node->depth) - begin;
+
+        if (entries_[node->firstEntry].dname.compare(begin, count, prefix.substr(begin, count)) != 0) {
+            return nullptr;
+        }
+
+        if (prefix.size() <= node->depth) {
+            return node;
+        }
+
+        auto childrenBegin = nodes_.begin() + node->firstChild;
+        auto childrenEnd = childrenBegin + node->childCount;
+        std::size_t depth = node->depth;
+        char ch = prefix[depth];
+        auto child = std::lower_bound(childrenBegin, childrenEnd, ch, [this, depth](const Node& candidate, char value) {
+            return IsLess(entries_[candidate.firstEntry].dname[depth], value);
+        });
+
+        if (child == childrenEnd || entries_[child->firstEntry].dname[depth] != ch) {
+            return nullptr;
+        }
+
+        node = &*child;
+    }
+}
+
+std::string_view DnameIndex::getLabel(const Node& node) const noexcept
+{
+    return entries_[node.firstEntry].dname.substr(node.depth - node.labelSize, node.labelSize);
+}
+
+bool DnameIndex::hasEntity(const Node& node) const noexcept
+{
+    return entries_[node.firstEntry].dname.size() == node.depth;
+}
+} // namespace busrpc
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "entities/entity.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/// \file dname_index.h Radix tree of the entity distinguished names.
+
+namespace busrpc {
+
+/// Radix tree (compressed trie) of the distinguished names of the entity subtree.
+/// \note Index is built once and can't be modified, so it can be safely accessed by several threads concurrently.
+/// \note Index is stored in three flat arrays (dnames, entries sorted by dname and tree nodes), which do not depend
+///       on the entity tree. Nodes do not store their labels, because label is a substring of the dname of any entry
+///       below the node.
+/// \note Prefix lookup takes time proportional to the prefix length, so prefix and scope queries return result in
+///       time, which does not depend on the index size. Completion takes time proportional to the result size.
+class DnameIndex {
+public:
+    /// Indexed entity.
+    struct Entry {
+        /// Entity distinguished name.
+        std::string_view dname;
+
+        /// Entity.
+        const Entity* entity;
+    };
+
+    /// Create empty index.
+    DnameIndex() = default;
+
+    /// Create index of the entity subtree with the specified \a root.
+    explicit DnameIndex(const Entity& root);
+
+    /// Index is not copyable, because entries refer to the dnames stored in the index.
+    DnameIndex(const DnameIndex&) = delete;
+
+    /// Move index.
+    DnameIndex(DnameIndex&&) noexcept = default;
+
+    /// Index is not copyable, because entries refer to the dnames stored in the index.
+    DnameIndex& operator=(const DnameIndex&) = delete;
+
+    /// Move index.
+    DnameIndex& operator=(DnameIndex&&) noexcept = default;
+
+    /// Return entity with the specified \a dname or \c nullptr if entity is not found.
+    const Entity* find(std::string_view dname) const noexcept;
+
+    /// Return entries with dname starting with \a prefix in ascending order of dnames.
+    std::span<const Entry> findPrefix(std::string_view prefix) const noexcept;
+
+    /// Return entries of the entity with the specified \a scope dname and all entities nested to it (directly or
+    /// indirectly) in ascending order of dnames.
+    /// \note Scope entity is the first entry of the result (if it is indexed).
+    std::span<const Entry> findScope(std::string_view scope) const noexcept;
+
+    /// Return entries with dname starting with \a prefix and not containing name separator after it in ascending
+    /// order of dnames.
+    /// \note For example, completions of the prefix "busrpc.api.b" are the namespaces of the API starting with "b",
+    ///       but not classes of these namespaces.
+    /// \note At most \a limit entries are returned.
+    std::vector<Entry> complete(std::string_view prefix, std::size_t limit = SIZE_MAX) const;
+
+    /// All entries in ascending order of dnames.
+    std::span<const Entry> entries() const noexcept { return entries_; }
+
+    /// Number of indexed entities.
+    std::size_t size() const noexcept { return entries_.size(); }
+
+private:
+    // Node covers entries [firstEntry, endEntry), which dnames have the same first 'depth' characters
+    // Node label is the last 'labelSize' characters of this common prefix
+    // Children are stored contiguously in the order of the first character of their labels
+    struct Node {
+        uint32_t depth;
+        uint32_t labelSize;
+        uint32_t firstChild;
+        uint32_t childCount;
+        uint32_t firstEntry;
+        uint32_t endEntry;
+    };
+
+    const Node* findNode(std::string_view prefix) const noexcept;
+    std::string_view getLabel(const Node& node) const noexcept;
+    bool hasEntity(const Node& node) const noexcept;
+
+    std::vector<char> dnames_;
+    std::vector<Entry> entries_;
+    std::vector<Node> nodes_;
+};
+} // namespace busrpc
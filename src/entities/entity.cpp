@@ -3,10 +3,28 @@
 #include "entities/struct.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace busrpc {
 
 namespace {
 
+class EntityErrorCategory: public std::error_category {
+public:
+    const char* name() const noexcept override { return "entity error"; }
+
+    std::string message(int code) const override
+    {
+        switch (static_cast<EntityErrc>(code)) {
+        case EntityErrc::Invalid_Name: return "Invalid entity name";
+        case EntityErrc::Name_Conflict: return "Name conflicts with existing one";
+        case EntityErrc::Invalid_Entity: return "Invalid entity";
+        default: return "Unknown error";
+        }
+    }
+};
+
 std::vector<std::string> TrimEmptyLines(const std::vector<std::string>& description)
 {
     std::vector<std::string> result;
@@ -139,6 +157,55 @@ void CompositeEntity::setNestedEntityAddedCallback(NestedEntityAddedCallback cal
     }
 }
 
+void CompositeEntity::compact()
+{
+    std::vector<CompositeEntity*> entities = {this};
+
+    while (!entities.empty()) {
+        CompositeEntity* entity = entities.back();
+        entities.pop_back();
+        entity->storage_.shrink_to_fit();
+        entity->onNestedEntityAdded_ = nullptr;
+
+        for (const auto& nested: entity->storage_) {
+            if (IsCompositeEntityType(nested->type())) {
+                entities.push_back(static_cast<CompositeEntity*>(nested.get()));
+            }
+        }
+    }
+}
+
+std::unique_ptr<Entity> CompositeEntity::releaseNestedEntity(std::string_view name)
+{
+    auto nestedIt = nested_.find(name);
+
+    if (nestedIt == nested_.end()) {
+        return nullptr;
+    }
+
+    auto storageIt = std::find_if(storage_.begin(), storage_.end(), [entity = *nestedIt](const auto& entityPtr) {
+        return entityPtr.get() == entity;
+    });
+    std::unique_ptr<Entity> entityPtr = std::move(*storageIt);
+    storage_.erase(storageIt);
+    nested_.erase(nestedIt);
+    entityPtr->parent_ = nullptr;
+    return entityPtr;
+}
+
+Entity* CompositeEntity::adoptNestedEntity(std::unique_ptr<Entity> entity)
+{
+    assert(entity->dname() == dname() + "." + entity->name());
+
+    if (!nested_.insert(entity.get()).second) {
+        throw name_conflict_error(type(), dname(), entity->name());
+    }
+
+    entity->parent_ = this;
+    storage_.push_back(std::move(entity));
+    return storage_.back().get();
+}
+
 Struct* GeneralCompositeEntity::addStruct(const std::string& name,
                                           const std::string& filename,
                                           StructFlags flags,
@@ -155,4 +222,42 @@ Enum* GeneralCompositeEntity::addEnum(const std::string& name, const std::string
     enums_.insert(ptr);
     return ptr;
 }
+
+EntityResult<Struct> GeneralCompositeEntity::tryAddStruct(const std::string& name,
+                                                          const std::string& filename,
+                                                          StructFlags flags,
+                                                          EntityDocs docs)
+{
+    auto result = tryAddNestedEntity<Struct>(name, name, filename, flags, std::move(docs));
+
+    if (result) {
+        structs_.insert(result.value());
+    }
+
+    return result;
+}
+
+EntityResult<Enum> GeneralCompositeEntity::tryAddEnum(const std::string& name,
+                                                      const std::string& filename,
+                                                      EntityDocs docs)
+{
+    auto result = tryAddNestedEntity<Enum>(name, name, filename, std::move(docs));
+
+    if (result) {
+        enums_.insert(result.value());
+    }
+
+    return result;
+}
+
+const std::error_category& entity_error_category()
+{
+    static const EntityErrorCategory category;
+    return category;
+}
+
+std::error_code make_error_code(EntityErrc e)
+{
+    return {static_cast<int>(e), entity_error_category()};
+}
 } // namespace busrpc
@@ -8,9 +8,10 @@
 #include <functional>
 #include <map>
 #include <memory>
-#include <queue>
 #include <set>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <vector>
 
@@ -23,6 +24,55 @@ class CompositeEntity;
 class Enum;
 class Struct;
 
+/// Error code of the non-throwing entity insertion.
+enum class EntityErrc {
+    Invalid_Name = 1,  ///< Entity name is not a valid busrpc entity name.
+    Name_Conflict = 2, ///< Nested entity with the same name is already added.
+    Invalid_Entity = 3 ///< Entity can't be created from the specified parameters.
+};
+
+/// Return entity error category.
+const std::error_category& entity_error_category();
+
+/// Create error code from the \ref EntityErrc value.
+std::error_code make_error_code(EntityErrc errc);
+
+/// Result of the non-throwing entity insertion, which contains either added entity or an error code.
+template<typename TEntity>
+class EntityResult {
+public:
+    /// Create result for successfully added \a entity.
+    EntityResult(TEntity* entity) noexcept: entity_(entity), ec_{} { }
+
+    /// Create result for the failed insertion.
+    EntityResult(EntityErrc errc) noexcept: entity_(nullptr), ec_(make_error_code(errc)) { }
+
+    /// Create result from the result of the derived entity insertion.
+    template<typename TDerived> requires std::is_convertible_v<TDerived*, TEntity*>
+    EntityResult(const EntityResult<TDerived>& other) noexcept: entity_(other.value()), ec_(other.error())
+    { }
+
+    /// Return \c true if entity was added.
+    bool hasValue() const noexcept { return !ec_; }
+
+    /// Return \c true if entity was added.
+    explicit operator bool() const noexcept { return hasValue(); }
+
+    /// Added entity.
+    /// \note \c nullptr if entity was not added.
+    TEntity* value() const noexcept { return entity_; }
+
+    /// Added entity.
+    TEntity* operator->() const noexcept { return entity_; }
+
+    /// Error code explaining why entity was not added.
+    std::error_code error() const noexcept { return ec_; }
+
+private:
+    TEntity* entity_;
+    std::error_code ec_;
+};
+
 /// Entity documentation.
 class EntityDocs {
 public:
@@ -106,17 +156,14 @@ protected:
     void setDocumentation(EntityDocs docs) noexcept { docs_ = std::move(docs); }
 
 private:
+    friend class CompositeEntity;
+
     CompositeEntity* parent_;
     EntityTypeId type_;
     std::string name_;
     std::string dname_;
     std::filesystem::path dir_;
     EntityDocs docs_;
-
-    std::map<std::string, const Entity*> nested_;
-    std::queue<std::shared_ptr<Entity>> storage_;
-
-    std::function<void(const Entity*)> onNestedEntityAdded_;
 };
 
 /// Entity concept.
@@ -183,20 +230,54 @@ protected:
     template<EntityConcept TEntity, typename... TArgs>
     TEntity* addNestedEntity(TArgs&&... args)
     {
-        std::shared_ptr<TEntity> entityPtr(new TEntity(this, std::forward<TArgs>(args)...));
-        auto alreadyExists = !nested_.insert(entityPtr.get()).second;
+        std::unique_ptr<TEntity> entityPtr(new TEntity(this, std::forward<TArgs>(args)...));
+        TEntity* entity = entityPtr.get();
+        auto alreadyExists = !nested_.insert(entity).second;
 
         if (!alreadyExists) {
-            storage_.push(entityPtr);
+            storage_.push_back(std::move(entityPtr));
         } else {
-            throw name_conflict_error(type(), dname(), entityPtr->name());
+            throw name_conflict_error(type(), dname(), entity->name());
         }
 
         if (onNestedEntityAdded_) {
-            onNestedEntityAdded_(entityPtr.get());
+            onNestedEntityAdded_(entity);
         }
 
-        return entityPtr.get();
+        return entity;
+    }
+
+    /// Create entity and add it to the list of nested entites without throwing entity errors.
+    /// \tparam TArgs arguments that forwarded to \c TEntity constructor.
+    /// \note Parameter \a name should match the name of the created entity. It is checked before the entity is
+    ///       created, so nothing is constructed if \a name is invalid or conflicts with existing nested entity.
+    /// \note Errors detected by the \c TEntity constructor are reported as \ref EntityErrc::Invalid_Entity.
+    template<EntityConcept TEntity, typename... TArgs>
+    EntityResult<TEntity> tryAddNestedEntity(std::string_view name, TArgs&&... args)
+    {
+        if (!IsValidEntityName(name)) {
+            return EntityErrc::Invalid_Name;
+        } else if (nested_.find(name) != nested_.end()) {
+            return EntityErrc::Name_Conflict;
+        }
+
+        std::unique_ptr<TEntity> entityPtr;
+
+        try {
+            entityPtr.reset(new TEntity(this, std::forward<TArgs>(args)...));
+        } catch (const entity_error&) {
+            return EntityErrc::Invalid_Entity;
+        }
+
+        TEntity* entity = entityPtr.get();
+        nested_.insert(entity);
+        storage_.push_back(std::move(entityPtr));
+
+        if (onNestedEntityAdded_) {
+            onNestedEntityAdded_(entity);
+        }
+
+        return entity;
     }
 
     /// Set callback to be invoked when nested entity is added.
@@ -207,8 +288,27 @@ protected:
     ///       and then calls original callback. This mechanism allows to chain callbacks.
     void setNestedEntityAddedCallback(NestedEntityAddedCallback callback);
 
+    /// Release memory used only while the entity subtree is built.
+    /// \note Method releases nested entity added callbacks and unused capacity of the nested entity storage for
+    ///       all composite entities of the subtree. Nested entities can still be added after this method is called,
+    ///       but callbacks are not invoked for them anymore.
+    void compact();
+
+    /// Remove immediately nested entity with the specified \a name and return it.
+    /// \note Returns \c nullptr if entity is not found.
+    /// \note Typed containers of the derived entities (for example, \ref GeneralCompositeEntity::structs) are not
+    ///       updated by this method.
+    std::unique_ptr<Entity> releaseNestedEntity(std::string_view name);
+
+    /// Add \a entity released from another composite entity with the same distinguished name to the list of nested
+    /// entities.
+    /// \throws name_conflict_error if entity with the same name is already added
+    /// \note Nested entity added callback is not invoked for the adopted entity and it's nested entities, so entity
+    ///       subtree should be compacted before it is released (see \ref compact).
+    Entity* adoptNestedEntity(std::unique_ptr<Entity> entity);
+
 private:
-    std::queue<std::shared_ptr<Entity>> storage_;
+    std::vector<std::unique_ptr<Entity>> storage_;
     EntityContainer<Entity> nested_;
     NestedEntityAddedCallback onNestedEntityAdded_;
 };
@@ -247,8 +347,26 @@ protected:
     ///       parent structure filename is used instead of if.
     Enum* addEnum(const std::string& name, const std::string& filename, EntityDocs docs = {});
 
+    /// Add nested structure without throwing entity errors.
+    /// \note Same as \ref addStruct, but returns error code if structure can't be added (see
+    ///       \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Struct> tryAddStruct(const std::string& name,
+                                      const std::string& filename,
+                                      StructFlags flags = StructFlags::None,
+                                      EntityDocs docs = {});
+
+    /// Add nested enumeration without throwing entity errors.
+    /// \note Same as \ref addEnum, but returns error code if enumeration can't be added (see
+    ///       \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Enum> tryAddEnum(const std::string& name, const std::string& filename, EntityDocs docs = {});
+
 private:
     EntityContainer<Struct> structs_;
     EntityContainer<Enum> enums_;
 };
 } // namespace busrpc
+
+namespace std {
+template<>
+struct is_error_code_enum<busrpc::EntityErrc>: true_type { };
+} // namespace std
@@ -29,4 +29,31 @@ Service* Implementation::addService(const std::string& name)
     implementation_.insert(service);
     return service;
 }
+
+EntityResult<Service> Implementation::tryAddService(const std::string& name)
+{
+    auto result = tryAddNestedEntity<Service>(name, name);
+
+    if (result) {
+        implementation_.insert(result.value());
+    }
+
+    return result;
+}
+
+std::unique_ptr<Service> Implementation::releaseService(const std::string& name)
+{
+    if (implementation_.find(name) == implementation_.end()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Service> service(static_cast<Service*>(releaseNestedEntity(name).release()));
+    implementation_.erase(service.get());
+    return service;
+}
+
+void Implementation::adoptService(std::unique_ptr<Service> service)
+{
+    implementation_.insert(static_cast<Service*>(adoptNestedEntity(std::move(service))));
+}
 } // namespace busrpc
@@ -4,6 +4,7 @@
 #include "entities/project.h"
 #include "entities/service.h"
 
+#include <memory>
 #include <string>
 
 /// \file implementation.h Project services entity.
@@ -18,6 +19,8 @@ class Implementation: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// Project to which entity belongs.
     const Project* parent() const noexcept;
@@ -32,12 +35,20 @@ public:
     /// \throws name_conflict_error if nested entity with the same name already exists
     Service* addService(const std::string& name);
 
+    /// Add service without throwing entity errors.
+    /// \note Returns error code if service can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Service> tryAddService(const std::string& name);
+
 protected:
     /// Create services entity.
     explicit Implementation(CompositeEntity* project);
 
 private:
     friend class CompositeEntity;
+    friend class Project;
+
+    std::unique_ptr<Service> releaseService(const std::string& name);
+    void adoptService(std::unique_ptr<Service> service);
 
     EntityContainer<Service> implementation_;
 };
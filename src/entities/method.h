@@ -17,6 +17,8 @@ class Method: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// Class where method is defined.
     const Class* parent() const noexcept;
@@ -28,6 +28,17 @@ Class* Namespace::addClass(const std::string& name)
     return cls;
 }
 
+EntityResult<Class> Namespace::tryAddClass(const std::string& name)
+{
+    auto result = tryAddNestedEntity<Class>(name, name);
+
+    if (result) {
+        classes_.insert(result.value());
+    }
+
+    return result;
+}
+
 void Namespace::onNestedEntityAdded(Entity* entity)
 {
     if (entity->type() == EntityTypeId::Struct) {
@@ -19,6 +19,8 @@ class Namespace: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// API where namespace is defined.
     const Api* parent() const noexcept;
@@ -36,6 +38,10 @@ public:
     /// \throws name_conflict_error if nested entity with the same name already exists
     Class* addClass(const std::string& name);
 
+    /// Add class without throwing entity errors.
+    /// \note Returns error code if class can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Class> tryAddClass(const std::string& name);
+
 protected:
     /// Create namespace entity.
     Namespace(CompositeEntity* api, const std::string& name);
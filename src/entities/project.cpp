@@ -1,4 +1,6 @@
 #include "entities/project.h"
+#include "check_cache.h"
+#include "entities/traversal.h"
 #include "utils.h"
 
 #include <cassert>
@@ -74,6 +76,18 @@ public:
     }
 };
 
+// Return location of the error, which subject is the entity
+ErrorCollector::ErrorLocation GetErrorLocation(const Entity* entity)
+{
+    return {.entity = entity->dname()};
+}
+
+// Return location of the error, which subject is the built-in entity (if entity is missing, error is located in the
+// built-in file)
+ErrorCollector::ErrorLocation GetBuiltinErrorLocation(const Entity* builtin)
+{
+    return builtin ? GetErrorLocation(builtin) : ErrorCollector::ErrorLocation{.file = Busrpc_Builtin_File};
+}
 } // namespace
 
 Project::Project(std::filesystem::path root):
@@ -98,6 +112,110 @@ Implementation* Project::addImplementation()
     return implementation;
 }
 
+EntityResult<Api> Project::tryAddApi()
+{
+    auto result = tryAddNestedEntity<Api>(Api_Entity_Name);
+
+    if (result) {
+        api_ = result.value();
+    }
+
+    return result;
+}
+
+EntityResult<Implementation> Project::tryAddImplementation()
+{
+    auto result = tryAddNestedEntity<Implementation>(Implementation_Entity_Name);
+
+    if (result) {
+        implementation_ = result.value();
+    }
+
+    return result;
+}
+
+const DnameIndex& Project::dnames() const
+{
+    if (isFrozen_) {
+        std::call_once(*dnamesFlag_, [this]() { dnames_ = DnameIndex(*this); });
+    }
+
+    return dnames_;
+}
+
+std::shared_ptr<const Project> Project::Freeze(std::shared_ptr<Project> project)
+{
+    if (project && !project->isFrozen_) {
+        project->compact();
+        project->entityDirectory_.rehash(0);
+        project->isFrozen_ = true;
+    }
+
+    return project;
+}
+
+bool Project::Splice(std::shared_ptr<const Project>& project,
+                     std::shared_ptr<Project> part,
+                     const std::string& dname)
+{
+    auto separatorPos = dname.rfind('.');
+
+    if (!project || !project->isFrozen_ || project.use_count() != 1 || !part || separatorPos == std::string::npos) {
+        return false;
+    }
+
+    // project is not shared, so there is no one who may access it's read-only view while it is modified
+    Project* target = const_cast<Project*>(project.get());
+    std::string parentDname = dname.substr(0, separatorPos);
+    std::string name = dname.substr(separatorPos + 1);
+    std::unique_ptr<Entity> removed;
+    const Entity* added = nullptr;
+
+    // callbacks of the part entities refer to the part and must be released before entities are moved
+    part->compact();
+
+    // entity is not added if it's name conflicts with the structure or enumeration (as when project is parsed)
+    if (target->api_ && parentDname == target->api_->dname()) {
+        auto api = const_cast<Api*>(target->api_);
+        auto ns = part->api_ ? const_cast<Api*>(part->api_)->releaseNamespace(name) : nullptr;
+        removed = api->releaseNamespace(name);
+
+        if (ns && api->nested().find(name) == api->nested().end()) {
+            added = ns.get();
+            api->adoptNamespace(std::move(ns));
+        }
+    } else if (target->implementation_ && parentDname == target->implementation_->dname()) {
+        auto implementation = const_cast<Implementation*>(target->implementation_);
+        auto service = part->implementation_ ? const_cast<Implementation*>(part->implementation_)->releaseService(name)
+                                             : nullptr;
+        removed = implementation->releaseService(name);
+
+        if (service && implementation->nested().find(name) == implementation->nested().end()) {
+            added = service.get();
+            implementation->adoptService(std::move(service));
+        }
+    } else {
+        return false;
+    }
+
+    if (removed) {
+        for (const Entity* entity: EntitySubtree(*removed)) {
+            target->entityDirectory_.erase(entity->dname());
+        }
+    }
+
+    if (added) {
+        for (const Entity* entity: EntitySubtree(*added)) {
+            target->entityDirectory_.emplace(entity->dname(), entity);
+        }
+    }
+
+    // index is rebuilt on the next access; flag can't be reset, so it is replaced (project is not shared)
+    target->dnamesFlag_ = std::make_unique<std::once_flag>();
+    target->dnames_ = DnameIndex();
+    return true;
+}
+
 const Entity* Project::find(const std::string& dname) const
 {
     std::string prefix = Project_Entity_Name;
@@ -141,25 +259,34 @@ ErrorCollector Project::check(std::vector<const std::error_category*> ignoredCat
     return ecol;
 }
 
-void Project::check(ErrorCollector& ecol) const
+void Project::check(ErrorCollector& ecol, CheckCache* cache, const CheckFilter& filter) const
 {
-    checkErrc(errc_, ecol);
-    checkException(exception_, ecol);
-    checkCallMessage(callMessage_, ecol);
-    checkResultMessage(resultMessage_, ecol);
-
-    checkNestedStructs(this, ecol);
-    checkNestedEnums(this, ecol);
+    if (!filter || filter(this)) {
+        checkErrc(errc_, ecol);
+        checkException(exception_, ecol);
+        checkCallMessage(callMessage_, ecol);
+        checkResultMessage(resultMessage_, ecol);
+
+        checkNestedStructs(this, ecol, cache);
+        checkNestedEnums(this, ecol, cache);
+    }
 
     if (api_) {
-        checkApi(api_, ecol);
+        checkApi(api_, ecol, cache, filter);
     }
 
     if (implementation_) {
-        checkImplementation(implementation_, ecol);
+        checkImplementation(implementation_, ecol, cache, filter);
     }
 }
 
+uint64_t Project::contentHash(const Entity* entity) const
+{
+    StableHash hash;
+    hashEntity(entity, hash);
+    return hash.value();
+}
+
 void Project::onNestedEntityAdded(Entity* entity)
 {
     entityDirectory_.emplace(entity->dname(), entity).second;
@@ -182,22 +309,27 @@ void Project::onNestedEntityAdded(Entity* entity)
     }
 }
 
-void Project::checkApi(const Api* api, ErrorCollector& ecol) const
+void Project::checkApi(const Api* api, ErrorCollector& ecol, CheckCache* cache, const CheckFilter& filter) const
 {
-    checkNestedStructs(api, ecol);
-    checkNestedEnums(api, ecol);
+    if (!filter || filter(this)) {
+        checkNestedStructs(api, ecol, cache);
+        checkNestedEnums(api, ecol, cache);
+    }
 
     for (const auto& ns: api->namespaces()) {
-        checkNamespace(ns, ecol);
+        if (!filter || filter(ns)) {
+            checkNamespace(ns, ecol, cache);
+        }
     }
 }
 
 void Project::checkErrc(const Enum* errc, ErrorCollector& ecol) const
 {
     if (!errc) {
-        ecol.add(SpecErrc::Missing_Builtin, std::make_pair("builtin", Errc_Enum_Name));
+        ecol.add(GetBuiltinErrorLocation(errc), SpecErrc::Missing_Builtin, std::make_pair("builtin", Errc_Enum_Name));
     } else if (errc->file().filename() != Busrpc_Builtin_File) {
-        ecol.add(SpecErrc::Missing_Builtin,
+        ecol.add(GetBuiltinErrorLocation(errc),
+                 SpecErrc::Missing_Builtin,
                  std::make_pair("builtin", Errc_Enum_Name),
                  "should be defined inside '" + std::string(Busrpc_Builtin_File) + "' files");
     }
@@ -208,10 +340,11 @@ void Project::checkException(const Struct* exception, ErrorCollector& ecol) cons
     constexpr const char* typeName = GetPredefinedStructName(StructTypeId::Exception);
 
     if (!exception) {
-        ecol.add(SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
+        ecol.add(GetBuiltinErrorLocation(exception), SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
         return;
     } else if (exception->file().filename() != Busrpc_Builtin_File) {
-        ecol.add(SpecErrc::Missing_Builtin,
+        ecol.add(GetBuiltinErrorLocation(exception),
+                 SpecErrc::Missing_Builtin,
                  std::make_pair("builtin", typeName),
                  "should be defined inside '" + std::string(Busrpc_Builtin_File) + "' file");
     } else {
@@ -221,17 +354,20 @@ void Project::checkException(const Struct* exception, ErrorCollector& ecol) cons
             auto entityIt = entityDirectory_.find((*codeIt)->fieldTypeName());
 
             if (entityIt == entityDirectory_.end() || entityIt->second != errc_) {
-                ecol.add(SpecErrc::Nonconforming_Builtin,
+                ecol.add(GetBuiltinErrorLocation(exception),
+                         SpecErrc::Nonconforming_Builtin,
                          std::make_pair("builtin", typeName),
                          "'" + std::string(Exception_Code_Field_Name) + "' field type should be '" + Errc_Enum_Name +
                              "'");
             } else if (CheckAny((*codeIt)->flags(), FieldFlags::Optional | FieldFlags::Repeated)) {
-                ecol.add(SpecErrc::Nonconforming_Builtin,
+                ecol.add(GetBuiltinErrorLocation(exception),
+                         SpecErrc::Nonconforming_Builtin,
                          std::make_pair("builtin", typeName),
                          "'" + std::string(Exception_Code_Field_Name) + "' field should not be optional or repeated");
             }
         } else {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(exception),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Exception_Code_Field_Name) + "' field does not exist");
         }
@@ -243,9 +379,10 @@ void Project::checkCallMessage(const Struct* call, ErrorCollector& ecol) const
     constexpr const char* typeName = GetPredefinedStructName(StructTypeId::Call_Message);
 
     if (!call) {
-        ecol.add(SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
+        ecol.add(GetBuiltinErrorLocation(call), SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
     } else if (call->file().filename() != Busrpc_Builtin_File) {
-        ecol.add(SpecErrc::Missing_Builtin,
+        ecol.add(GetBuiltinErrorLocation(call),
+                 SpecErrc::Missing_Builtin,
                  std::make_pair("builtin", typeName),
                  "should be defined inside '" + std::string(Busrpc_Builtin_File) + "' file");
     } else {
@@ -253,51 +390,62 @@ void Project::checkCallMessage(const Struct* call, ErrorCollector& ecol) const
         auto paramsIt = call->fields().find(Call_Message_Params_Field_Name);
 
         if (oidIt == call->fields().end()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Object_Id_Field_Name) + "' field does not exist");
         } else if ((*oidIt)->fieldType() != FieldTypeId::Bytes) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Object_Id_Field_Name) + "' field type should be 'bytes'");
         } else if (!CheckAll((*oidIt)->flags(), FieldFlags::Optional)) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Object_Id_Field_Name) + "' field should be optional");
         } else if (CheckAny((*oidIt)->flags(), FieldFlags::Repeated)) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Object_Id_Field_Name) + "' field should not be repeated");
         } else if (!(*oidIt)->oneofName().empty()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Object_Id_Field_Name) + "' field should not belong to oneof");
         }
 
         if (paramsIt == call->fields().end()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Params_Field_Name) + "' field does not exist");
         } else if ((*paramsIt)->fieldType() != FieldTypeId::Bytes) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Params_Field_Name) + "' field type should be 'bytes'");
         } else if (!CheckAll((*paramsIt)->flags(), FieldFlags::Optional)) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Params_Field_Name) + "' field should be optional");
         } else if (CheckAny((*paramsIt)->flags(), FieldFlags::Repeated)) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Params_Field_Name) + "' field should not be repeated");
         } else if (!(*paramsIt)->oneofName().empty()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Call_Message_Params_Field_Name) + "' field should not belong to oneof");
         }
 
         if (oidIt != call->fields().end() && paramsIt != call->fields().end() && call->fields().size() > 2) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(call),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "should contain only '" + std::string(Call_Message_Object_Id_Field_Name) + "' and '" +
                          Call_Message_Params_Field_Name + "' fields");
@@ -310,9 +458,10 @@ void Project::checkResultMessage(const Struct* result, ErrorCollector& ecol) con
     constexpr const char* typeName = GetPredefinedStructName(StructTypeId::Result_Message);
 
     if (!result) {
-        ecol.add(SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
+        ecol.add(GetBuiltinErrorLocation(result), SpecErrc::Missing_Builtin, std::make_pair("builtin", typeName));
     } else if (result->file().filename() != Busrpc_Builtin_File) {
-        ecol.add(SpecErrc::Missing_Builtin,
+        ecol.add(GetBuiltinErrorLocation(result),
+                 SpecErrc::Missing_Builtin,
                  std::make_pair("builtin", typeName),
                  "should be defined inside '" + std::string(Busrpc_Builtin_File) + "' file");
     } else {
@@ -320,24 +469,28 @@ void Project::checkResultMessage(const Struct* result, ErrorCollector& ecol) con
         auto exceptionIt = result->fields().find(Result_Message_Exception_Field_Name);
 
         if (retvalIt == result->fields().end()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(result),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Result_Message_Retval_Field_Name) + "' field does not exist");
         } else if ((*retvalIt)->fieldType() != FieldTypeId::Bytes) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(result),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Result_Message_Retval_Field_Name) + "' field type should be 'bytes'");
         }
 
         if (exceptionIt == result->fields().end()) {
-            ecol.add(SpecErrc::Nonconforming_Builtin,
+            ecol.add(GetBuiltinErrorLocation(result),
+                     SpecErrc::Nonconforming_Builtin,
                      std::make_pair("builtin", typeName),
                      "'" + std::string(Result_Message_Exception_Field_Name) + "' field does not exist");
         } else {
             auto entityIt = entityDirectory_.find((*exceptionIt)->fieldTypeName());
 
             if (entityIt == entityDirectory_.end() || entityIt->second != exception_) {
-                ecol.add(SpecErrc::Nonconforming_Builtin,
+                ecol.add(GetBuiltinErrorLocation(result),
+                         SpecErrc::Nonconforming_Builtin,
                          std::make_pair("builtin", typeName),
                          "'" + std::string(Result_Message_Exception_Field_Name) + "' field type should be '" +
                              GetPredefinedStructName(StructTypeId::Exception) + "'");
@@ -346,14 +499,16 @@ void Project::checkResultMessage(const Struct* result, ErrorCollector& ecol) con
 
         if (retvalIt != result->fields().end() && exceptionIt != result->fields().end()) {
             if ((*retvalIt)->oneofName().empty() || (*retvalIt)->oneofName() != (*exceptionIt)->oneofName()) {
-                ecol.add(SpecErrc::Nonconforming_Builtin,
+                ecol.add(GetBuiltinErrorLocation(result),
+                         SpecErrc::Nonconforming_Builtin,
                          std::make_pair("builtin", typeName),
                          "fields '" + std::string(Result_Message_Retval_Field_Name) + "' and '" +
                              Result_Message_Exception_Field_Name + "' should belong to the same oneof");
             }
 
             if (result->fields().size() > 2) {
-                ecol.add(SpecErrc::Nonconforming_Builtin,
+                ecol.add(GetBuiltinErrorLocation(result),
+                         SpecErrc::Nonconforming_Builtin,
                          std::make_pair("builtin", typeName),
                          "should contain only '" + std::string(Result_Message_Retval_Field_Name) + "' and '" +
                              Result_Message_Exception_Field_Name + "' fields");
@@ -362,21 +517,22 @@ void Project::checkResultMessage(const Struct* result, ErrorCollector& ecol) con
     }
 }
 
-void Project::checkNamespace(const Namespace* ns, ErrorCollector& ecol) const
+void Project::checkNamespace(const Namespace* ns, ErrorCollector& ecol, CheckCache* cache) const
 {
     checkNamespaceDesc(ns, ecol);
 
     if (!IsLowercaseWithUnderscores(ns->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(ns),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(ns->type()), ns->dname()),
                  "name should consists of lowercase letters, digits and underscores");
     }
 
-    checkNestedStructs(ns, ecol);
-    checkNestedEnums(ns, ecol);
+    checkNestedStructs(ns, ecol, cache);
+    checkNestedEnums(ns, ecol, cache);
 
     for (const auto& cls: ns->classes()) {
-        checkClass(cls, ecol);
+        checkClass(cls, ecol, cache);
     }
 }
 
@@ -385,34 +541,39 @@ void Project::checkNamespaceDesc(const Namespace* ns, ErrorCollector& ecol) cons
     auto desc = ns->descriptor();
 
     if (!desc) {
-        ecol.add(SpecErrc::No_Descriptor, std::make_pair(GetEntityTypeIdStr(ns->type()), ns->dname()));
+        ecol.add(GetErrorLocation(ns),
+                 SpecErrc::No_Descriptor,
+                 std::make_pair(GetEntityTypeIdStr(ns->type()), ns->dname()));
     } else if (desc->file().filename() != Namespace_Desc_File) {
-        ecol.add(SpecErrc::No_Descriptor,
+        ecol.add(GetErrorLocation(ns),
+                 SpecErrc::No_Descriptor,
                  std::make_pair(GetEntityTypeIdStr(ns->type()), ns->dname()),
                  "descriptor should be defined inside '" + std::string(Namespace_Desc_File) + "' file");
     } else if (!desc->fields().empty() || !desc->structs().empty() || !desc->enums().empty()) {
-        ecol.add(SpecWarn::Unexpected_Nested_Entity,
+        ecol.add(GetErrorLocation(ns),
+                 SpecWarn::Unexpected_Nested_Entity,
                  std::make_pair(GetEntityTypeIdStr(ns->type()), ns->dname()),
                  "deviations from the descriptor format defined in the specification are discouraged");
     }
 }
 
-void Project::checkClass(const Class* cls, ErrorCollector& ecol) const
+void Project::checkClass(const Class* cls, ErrorCollector& ecol, CheckCache* cache) const
 {
     checkClassDesc(cls, ecol);
     checkObjectId(cls, ecol);
 
     if (!IsLowercaseWithUnderscores(cls->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(cls),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()),
                  "name should consists of lowercase letters, digits and underscores");
     }
 
-    checkNestedStructs(cls, ecol);
-    checkNestedEnums(cls, ecol);
+    checkNestedStructs(cls, ecol, cache);
+    checkNestedEnums(cls, ecol, cache);
 
     for (const auto& method: cls->methods()) {
-        checkMethod(method, ecol);
+        checkMethod(method, ecol, cache);
     }
 }
 
@@ -421,9 +582,12 @@ void Project::checkClassDesc(const Class* cls, ErrorCollector& ecol) const
     auto desc = cls->descriptor();
 
     if (!desc) {
-        ecol.add(SpecErrc::No_Descriptor, std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()));
+        ecol.add(GetErrorLocation(cls),
+                 SpecErrc::No_Descriptor,
+                 std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()));
     } else if (desc->file().filename() != Class_Desc_File) {
-        ecol.add(SpecErrc::No_Descriptor,
+        ecol.add(GetErrorLocation(cls),
+                 SpecErrc::No_Descriptor,
                  std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()),
                  "descriptor should be defined inside '" + std::string(Class_Desc_File) + "' file");
     } else {
@@ -437,7 +601,8 @@ void Project::checkClassDesc(const Class* cls, ErrorCollector& ecol) const
         }
 
         if (!desc->fields().empty() || hasUnexpectedStructs || !desc->enums().empty()) {
-            ecol.add(SpecWarn::Unexpected_Nested_Entity,
+            ecol.add(GetErrorLocation(cls),
+                     SpecWarn::Unexpected_Nested_Entity,
                      std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()),
                      "deviations from the descriptor format defined in the specification are discouraged");
         }
@@ -447,25 +612,27 @@ void Project::checkClassDesc(const Class* cls, ErrorCollector& ecol) const
 void Project::checkObjectId(const Class* cls, ErrorCollector& ecol) const
 {
     if (cls->objectId() && !cls->objectId()->isEncodable()) {
-        ecol.add(SpecErrc::Not_Encodable_Type,
+        ecol.add(GetErrorLocation(cls),
+                 SpecErrc::Not_Encodable_Type,
                  std::make_pair(GetEntityTypeIdStr(cls->type()), cls->dname()),
                  "'" + std::string(GetPredefinedStructName(StructTypeId::Class_Object_Id)) +
                      "' structure should be encodable");
     }
 }
 
-void Project::checkMethod(const Method* method, ErrorCollector& ecol) const
+void Project::checkMethod(const Method* method, ErrorCollector& ecol, CheckCache* cache) const
 {
     checkMethodDesc(method, ecol);
 
     if (!IsLowercaseWithUnderscores(method->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(method),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()),
                  "name should consists of lowercase letters, digits and underscores");
     }
 
-    checkNestedStructs(method, ecol);
-    checkNestedEnums(method, ecol);
+    checkNestedStructs(method, ecol, cache);
+    checkNestedEnums(method, ecol, cache);
 }
 
 void Project::checkMethodDesc(const Method* method, ErrorCollector& ecol) const
@@ -473,13 +640,17 @@ void Project::checkMethodDesc(const Method* method, ErrorCollector& ecol) const
     auto desc = method->descriptor();
 
     if (!desc) {
-        ecol.add(SpecErrc::No_Descriptor, std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()));
+        ecol.add(GetErrorLocation(method),
+                 SpecErrc::No_Descriptor,
+                 std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()));
     } else if (desc->file().filename() != Method_Desc_File) {
-        ecol.add(SpecErrc::No_Descriptor,
+        ecol.add(GetErrorLocation(method),
+                 SpecErrc::No_Descriptor,
                  std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()),
                  "descriptor should be defined inside '" + std::string(Method_Desc_File) + "' file");
     } else if (method->parent()->descriptor() && method->parent()->isStatic() && !method->isStatic()) {
-        ecol.add(SpecErrc::Not_Static_Method,
+        ecol.add(GetErrorLocation(method),
+                 SpecErrc::Not_Static_Method,
                  std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()),
                  "static class can contain only static methods");
     } else {
@@ -495,37 +666,46 @@ void Project::checkMethodDesc(const Method* method, ErrorCollector& ecol) const
         }
 
         if (!desc->fields().empty() || hasUnexpectedStructs || !desc->enums().empty()) {
-            ecol.add(SpecWarn::Unexpected_Nested_Entity,
+            ecol.add(GetErrorLocation(method),
+                     SpecWarn::Unexpected_Nested_Entity,
                      std::make_pair(GetEntityTypeIdStr(method->type()), method->dname()),
                      "deviations from the descriptor format defined in the specification are discouraged");
         }
     }
 }
 
-void Project::checkImplementation(const Implementation* implementation, ErrorCollector& ecol) const
+void Project::checkImplementation(const Implementation* implementation,
+                                  ErrorCollector& ecol,
+                                  CheckCache* cache,
+                                  const CheckFilter& filter) const
 {
-    checkNestedStructs(implementation, ecol);
-    checkNestedEnums(implementation, ecol);
+    if (!filter || filter(this)) {
+        checkNestedStructs(implementation, ecol, cache);
+        checkNestedEnums(implementation, ecol, cache);
+    }
 
     for (const auto& service: implementation->services()) {
-        checkService(service, ecol);
+        if (!filter || filter(service)) {
+            checkService(service, ecol, cache);
+        }
     }
 }
 
-void Project::checkService(const Service* service, ErrorCollector& ecol) const
+void Project::checkService(const Service* service, ErrorCollector& ecol, CheckCache* cache) const
 {
     checkServiceDesc(service, ecol);
     checkServiceDeps(service, true, ecol);
     checkServiceDeps(service, false, ecol);
 
     if (!IsLowercaseWithUnderscores(service->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(service),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()),
                  "name should consists of lowercase letters, digits and underscores");
     }
 
-    checkNestedStructs(service, ecol);
-    checkNestedEnums(service, ecol);
+    checkNestedStructs(service, ecol, cache);
+    checkNestedEnums(service, ecol, cache);
 }
 
 void Project::checkServiceDesc(const Service* service, ErrorCollector& ecol) const
@@ -533,9 +713,12 @@ void Project::checkServiceDesc(const Service* service, ErrorCollector& ecol) con
     auto desc = service->descriptor();
 
     if (!desc) {
-        ecol.add(SpecErrc::No_Descriptor, std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()));
+        ecol.add(GetErrorLocation(service),
+                 SpecErrc::No_Descriptor,
+                 std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()));
     } else if (desc->file().filename() != Service_Desc_File) {
-        ecol.add(SpecErrc::No_Descriptor,
+        ecol.add(GetErrorLocation(service),
+                 SpecErrc::No_Descriptor,
                  std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()),
                  "descriptor should be defined inside '" + std::string(Service_Desc_File) + "' file");
     } else {
@@ -551,7 +734,8 @@ void Project::checkServiceDesc(const Service* service, ErrorCollector& ecol) con
         }
 
         if (!desc->fields().empty() || hasUnexpectedStructs || !desc->enums().empty()) {
-            ecol.add(SpecWarn::Unexpected_Nested_Entity,
+            ecol.add(GetErrorLocation(service),
+                     SpecWarn::Unexpected_Nested_Entity,
                      std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()),
                      "deviations from the descriptor format defined in the specification are discouraged");
         }
@@ -601,34 +785,71 @@ void Project::checkServiceDeps(const Service* service, bool checkImplemented, Er
     }
 
     if (err == Error::Has_Unknown_Method) {
-        ecol.add(SpecErrc::Unknown_Method,
+        ecol.add(GetErrorLocation(service),
+                 SpecErrc::Unknown_Method,
                  std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()),
                  "unknown method referenced in '" + structName + "' structure");
     } else if (err == Error::Multiple_References) {
-        ecol.add(SpecErrc::Multiple_Definitions,
+        ecol.add(GetErrorLocation(service),
+                 SpecErrc::Multiple_Definitions,
                  std::make_pair(GetEntityTypeIdStr(service->type()), service->dname()),
                  "same method referenced more than once in '" + structName + "' structure");
     }
 }
 
-void Project::checkNestedStructs(const GeneralCompositeEntity* entity, ErrorCollector& ecol) const
+void Project::checkNestedStructs(const GeneralCompositeEntity* entity, ErrorCollector& ecol, CheckCache* cache) const
 {
     for (const auto& structure: entity->structs()) {
-        checkStruct(structure, ecol);
+        if (cache) {
+            checkCached(structure, ecol, *cache);
+        } else {
+            checkStruct(structure, ecol);
+        }
     }
 }
 
-void Project::checkNestedEnums(const GeneralCompositeEntity* entity, ErrorCollector& ecol) const
+void Project::checkNestedEnums(const GeneralCompositeEntity* entity, ErrorCollector& ecol, CheckCache* cache) const
 {
     for (const auto& enumeration: entity->enums()) {
-        checkEnum(enumeration, ecol);
+        if (cache) {
+            checkCached(enumeration, ecol, *cache);
+        } else {
+            checkEnum(enumeration, ecol);
+        }
+    }
+}
+
+void Project::checkCached(const Entity* entity, ErrorCollector& ecol, CheckCache& cache) const
+{
+    assert(entity->type() == EntityTypeId::Struct || entity->type() == EntityTypeId::Enum);
+
+    uint64_t hash = contentHash(entity);
+    const CheckCache::Errors* errors = cache.find(hash);
+
+    if (!errors) {
+        // subtree errors are collected separately without ignoring any categories, because cached errors may be
+        // replayed later to the collector ignoring different set of categories
+        ErrorCollector subtreeEcol;
+
+        if (entity->type() == EntityTypeId::Struct) {
+            checkStruct(static_cast<const Struct*>(entity), subtreeEcol);
+        } else {
+            checkEnum(static_cast<const Enum*>(entity), subtreeEcol);
+        }
+
+        errors = &cache.store(hash, subtreeEcol.errors());
+    }
+
+    for (const auto& error: *errors) {
+        ecol.add(error);
     }
 }
 
 void Project::checkStruct(const Struct* structure, ErrorCollector& ecol) const
 {
     if (structure->isHashed() && !structure->isEncodable()) {
-        ecol.add(SpecErrc::Not_Encodable_Type,
+        ecol.add(GetErrorLocation(structure),
+                 SpecErrc::Not_Encodable_Type,
                  std::make_pair(GetEntityTypeIdStr(structure->type()), structure->dname()),
                  "only encodable structures can be hashable");
     }
@@ -650,7 +871,8 @@ void Project::checkStruct(const Struct* structure, ErrorCollector& ecol) const
     checkEntityDocumentation(structure, ecol, allowedDocCommands);
 
     if (!IsCamelCase(structure->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(structure),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(structure->type()), structure->dname()),
                  "name should consists of lower and uppercase letters formatted as CamelCase and digits");
     }
@@ -659,8 +881,10 @@ void Project::checkStruct(const Struct* structure, ErrorCollector& ecol) const
         checkField(field, ecol);
     }
 
-    checkNestedStructs(structure, ecol);
-    checkNestedEnums(structure, ecol);
+    // nested structures and enumerations are covered by the content hash of the parent structure, so there is no
+    // need to cache them separately
+    checkNestedStructs(structure, ecol, nullptr);
+    checkNestedEnums(structure, ecol, nullptr);
 }
 
 void Project::checkField(const Field* field, ErrorCollector& ecol) const
@@ -698,11 +922,15 @@ void Project::checkField(const Field* field, ErrorCollector& ecol) const
 
                 nonScalarFieldTypeEntity = typeIt->second;
             } else {
-                ecol.add(SpecErrc::Unexpected_Type, std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()));
+                ecol.add(GetErrorLocation(field),
+                         SpecErrc::Unexpected_Type,
+                         std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()));
                 isFieldTypeValid = false;
             }
         } else {
-            ecol.add(SpecErrc::Unknown_Type, std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()));
+            ecol.add(GetErrorLocation(field),
+                     SpecErrc::Unknown_Type,
+                     std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()));
             isFieldTypeValid = false;
         }
     }
@@ -712,7 +940,8 @@ void Project::checkField(const Field* field, ErrorCollector& ecol) const
         field->parent()->structType() != StructTypeId::Service_Invokes) {
 
         if (!field->dir().string().starts_with(nonScalarFieldTypeEntity->dir().string())) {
-            ecol.add(SpecErrc::Not_Accessible_Type,
+            ecol.add(GetErrorLocation(field),
+                     SpecErrc::Not_Accessible_Type,
                      std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()),
                      "referenced type '" + nonScalarFieldTypeName + "'");
         }
@@ -730,7 +959,8 @@ void Project::checkField(const Field* field, ErrorCollector& ecol) const
         }
 
         if (!isEncodable) {
-            ecol.add(SpecErrc::Not_Encodable_Type,
+            ecol.add(GetErrorLocation(field),
+                     SpecErrc::Not_Encodable_Type,
                      std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()),
                      "only fields with encodable type can be observable and/or hashable");
         }
@@ -745,7 +975,8 @@ void Project::checkField(const Field* field, ErrorCollector& ecol) const
     checkEntityDocumentation(field, ecol, allowedDocCommands);
 
     if (!IsLowercaseWithUnderscores(field->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(field),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(field->type()), field->dname()),
                  "name should consists of lowercase letters, digits and underscores");
     }
@@ -756,13 +987,16 @@ void Project::checkEnum(const Enum* enumeration, ErrorCollector& ecol) const
     checkEntityDocumentation(enumeration, ecol);
 
     if (!IsCamelCase(enumeration->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(enumeration),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(enumeration->type()), enumeration->dname()),
                  "name should consists of lower and uppercase letters formatted as CamelCase and digits");
     }
 
     if (enumeration->constants().empty()) {
-        ecol.add(SpecErrc::Empty_Enum, std::make_pair(GetEntityTypeIdStr(enumeration->type()), enumeration->dname()));
+        ecol.add(GetErrorLocation(enumeration),
+                 SpecErrc::Empty_Enum,
+                 std::make_pair(GetEntityTypeIdStr(enumeration->type()), enumeration->dname()));
     }
 
     bool hasZero = false;
@@ -776,7 +1010,8 @@ void Project::checkEnum(const Enum* enumeration, ErrorCollector& ecol) const
     }
 
     if (!hasZero) {
-        ecol.add(SpecErrc::No_Zero_Value,
+        ecol.add(GetErrorLocation(enumeration),
+                 SpecErrc::No_Zero_Value,
                  std::make_pair(GetEntityTypeIdStr(enumeration->type()), enumeration->dname()));
     }
 }
@@ -785,7 +1020,8 @@ void Project::checkConstant(const Constant* constant, ErrorCollector& ecol) cons
     checkEntityDocumentation(constant, ecol);
 
     if (!IsUppercaseWithUnderscores(constant->name())) {
-        ecol.add(StyleWarn::Invalid_Name_Format,
+        ecol.add(GetErrorLocation(constant),
+                 StyleWarn::Invalid_Name_Format,
                  std::make_pair(GetEntityTypeIdStr(constant->type()), constant->dname()),
                  "name should consists of uppercase letters, digits and underscores");
     }
@@ -796,11 +1032,14 @@ void Project::checkEntityDocumentation(const Entity* entity,
                                        const std::unordered_set<std::string>& allowedDocCommands) const
 {
     if (entity->docs().description().empty()) {
-        ecol.add(DocWarn::Undocumented_Entity, std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()));
+        ecol.add(GetErrorLocation(entity),
+                 DocWarn::Undocumented_Entity,
+                 std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()));
     } else {
         for (const auto& cmd: entity->docs().commands()) {
             if (allowedDocCommands.find(cmd.first) == allowedDocCommands.end()) {
-                ecol.add(DocWarn::Unknown_Doc_Command,
+                ecol.add(GetErrorLocation(entity),
+                         DocWarn::Unknown_Doc_Command,
                          std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
                          std::make_pair("command", cmd.first));
             }
@@ -819,6 +1058,108 @@ bool Project::isApiEntity(const Entity* entity) const noexcept
     return false;
 }
 
+void Project::hashEntity(const Entity* root, StableHash& hash) const
+{
+    // subtree is hashed in the depth-first order: each composite entity is followed by the number of it's nested
+    // entities and then by the nested entities themselves
+    for (const Entity* entity: EntitySubtree(*root)) {
+        hash.update(static_cast<uint64_t>(entity->type()));
+        hash.update(entity->dname());
+        hash.update(entity->dir().generic_string());
+        hash.update(static_cast<uint64_t>(entity->docs().description().size()));
+
+        for (const auto& line: entity->docs().description()) {
+            hash.update(line);
+        }
+
+        hash.update(static_cast<uint64_t>(entity->docs().commands().size()));
+
+        for (const auto& [name, values]: entity->docs().commands()) {
+            hash.update(name);
+            hash.update(static_cast<uint64_t>(values.size()));
+
+            for (const auto& value: values) {
+                hash.update(value);
+            }
+        }
+
+        switch (entity->type()) {
+        case EntityTypeId::Struct:
+            {
+                auto structure = static_cast<const Struct*>(entity);
+                hash.update(static_cast<uint64_t>(structure->structType()));
+                hash.update(static_cast<uint64_t>(structure->flags()));
+                hash.update(structure->package());
+                hash.update(structure->file().generic_string());
+                break;
+            }
+        case EntityTypeId::Field:
+            {
+                auto field = static_cast<const Field*>(entity);
+                hash.update(static_cast<uint64_t>(static_cast<uint32_t>(field->number())));
+                hash.update(static_cast<uint64_t>(field->fieldType()));
+                hash.update(static_cast<uint64_t>(field->flags()));
+                hash.update(field->oneofName());
+                hash.update(field->defaultValue());
+
+                if (field->fieldType() == FieldTypeId::Map) {
+                    auto mapField = static_cast<const MapField*>(field);
+                    hash.update(static_cast<uint64_t>(mapField->keyType()));
+                    hash.update(static_cast<uint64_t>(mapField->valueType()));
+                    hashFieldType(mapField->valueTypeName(), hash);
+                } else {
+                    hashFieldType(field->fieldTypeName(), hash);
+                }
+
+                break;
+            }
+        case EntityTypeId::Enum:
+            {
+                auto enumeration = static_cast<const Enum*>(entity);
+                hash.update(enumeration->package());
+                hash.update(enumeration->file().generic_string());
+                break;
+            }
+        case EntityTypeId::Constant:
+            hash.update(static_cast<uint64_t>(static_cast<uint32_t>(static_cast<const Constant*>(entity)->value())));
+            break;
+        default: break;
+        }
+
+        if (IsCompositeEntityType(entity->type())) {
+            hash.update(static_cast<uint64_t>(static_cast<const CompositeEntity*>(entity)->nested().size()));
+        }
+    }
+}
+
+void Project::hashFieldType(const std::string& typeName, StableHash& hash) const
+{
+    hash.update(typeName);
+
+    if (typeName.empty()) {
+        return;
+    }
+
+    auto typeIt = entityDirectory_.find(typeName);
+
+    if (typeIt == entityDirectory_.end()) {
+        hash.update(static_cast<uint64_t>(0));
+        return;
+    }
+
+    // referenced type is not hashed entirely to avoid infinite recursion for self-referencing types; instead only
+    // those properties of the type are hashed, which affect the check of the field referencing it
+    const Entity* type = typeIt->second;
+    hash.update(static_cast<uint64_t>(type->type()));
+    hash.update(type->dir().generic_string());
+
+    if (type->type() == EntityTypeId::Struct) {
+        auto structure = static_cast<const Struct*>(type);
+        hash.update(static_cast<uint64_t>(structure->structType()));
+        hash.update(static_cast<uint64_t>(structure->isEncodable()));
+    }
+}
+
 const std::error_category& spec_error_category()
 {
     static const SpecErrorCategory category;
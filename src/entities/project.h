@@ -1,11 +1,16 @@
 #pragma once
 
 #include "entities/api.h"
+#include "entities/dname_index.h"
 #include "entities/entity.h"
 #include "entities/implementation.h"
 #include "error_collector.h"
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <unordered_map>
@@ -22,6 +27,11 @@ class Class;
 class Method;
 class Implementation;
 class Service;
+class CheckCache;
+class StableHash;
+
+/// Predicate selecting entities to be checked (see \ref Project::check).
+using CheckFilter = std::function<bool(const Entity*)>;
 
 /// Busrpc [specification](https://github.com/pananton/busrpc-spec)-related error codes.
 enum class SpecErrc {
@@ -87,6 +97,8 @@ class Project: public GeneralCompositeEntity {
 public:
     using GeneralCompositeEntity::addStruct;
     using GeneralCompositeEntity::addEnum;
+    using GeneralCompositeEntity::tryAddStruct;
+    using GeneralCompositeEntity::tryAddEnum;
 
     /// Create project entity.
     explicit Project(std::filesystem::path root = std::filesystem::current_path());
@@ -94,6 +106,15 @@ public:
     /// Project root directory.
     const std::filesystem::path& root() const noexcept { return root_; }
 
+    /// Flag indicating whether project is frozen (see \ref Freeze).
+    bool isFrozen() const noexcept { return isFrozen_; }
+
+    /// Index of the project entities distinguished names for prefix, scope and completion queries.
+    /// \note Index is built on the first call after project is frozen (see \ref Freeze) and is empty before that.
+    ///       Only commands, which need the index, pay for building it. Concurrent first calls are safe and build the
+    ///       index only once.
+    const DnameIndex& dnames() const;
+
     /// API error code enumeration.
     /// \note Provides extended information about API exception.
     const Enum* errc() const noexcept { return errc_; }
@@ -119,6 +140,15 @@ public:
     ///       from \a dname.
     const Entity* find(const std::string& dname) const;
 
+    /// Calculate content hash of the \a entity subtree.
+    /// \note Hash covers all entity data (name, directory, documentation, type-specific properties), hashes of all
+    ///       nested entities and those properties of the types referenced by the structure fields, which are
+    ///       relevant for the project check (entity type, directory and encodability). Hash does not depend on the
+    ///       entity address, the platform or the order in which entities were added, so it can be persisted and
+    ///       compared with the hash calculated by another process.
+    /// \warning Entity \a entity should belong to the project.
+    uint64_t contentHash(const Entity* entity) const;
+
     /// Add project API.
     /// \throws name_conflict_error if entity is already added.
     Api* addApi();
@@ -127,6 +157,14 @@ public:
     /// \throws name_conflict_error if entity is already added.
     Implementation* addImplementation();
 
+    /// Add project API without throwing entity errors.
+    /// \note Returns error code if API can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Api> tryAddApi();
+
+    /// Add project API implementation without throwing entity errors.
+    /// \note Returns error code if implementation can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Implementation> tryAddImplementation();
+
     /// Check project for conformance with busrpc specification.
     /// \note Parameter \a ignoredCategories contains categories of errors (for example, doc or style warnings)
     ///       that should be ignored by the error collector.
@@ -135,7 +173,40 @@ public:
     ErrorCollector check(std::vector<const std::error_category*> ignoredCategories = {}) const;
 
     /// Check project for conformance with busrpc specification.
-    void check(ErrorCollector& errorCollector) const;
+    /// \note If \a cache is set, then errors of the structures and enumerations (and their nested entities) are
+    ///       looked up in the cache by the subtree content hash (see \ref contentHash) and replayed if found
+    ///       instead of checking the subtree again. Errors of the subtrees not found in the cache are stored to it.
+    ///       Collected errors are exactly the same regardless of whether the cache is used or not.
+    /// \note If \a filter is set, it is invoked for the project itself and for each namespace and service. Namespace
+    ///       or service subtree is checked only if filter returns \c true for it. Filter result for the project
+    ///       determines whether entities not belonging to any namespace or service (built-in types, types defined
+    ///       directly in the project, API or implementation directory) are checked.
+    void check(ErrorCollector& errorCollector, CheckCache* cache = nullptr, const CheckFilter& filter = {}) const;
+
+    /// Freeze the \a project and return read-only view of it.
+    /// \note Frozen project releases callbacks used to build it and unused capacity of the internal containers.
+    /// \note Read-only view only provides access to the \c const methods of the project and it's entities. These
+    ///       methods do not modify any state (including caches) except for the lazily built index of the entities
+    ///       distinguished names (see \ref dnames), which is synchronized internally, so frozen project can be safely
+    ///       accessed by several threads concurrently without synchronization.
+    /// \warning Project must not be modified after it is frozen (for example, through another pointer to it),
+    ///          because entities added to the frozen project are not registered in the project (see \ref find).
+    ///          Use \ref Splice to replace part of the frozen project.
+    static std::shared_ptr<const Project> Freeze(std::shared_ptr<Project> project);
+
+    /// Replace subtree of the namespace or service with the specified \a dname in the frozen \a project with the
+    /// subtree of the same entity from the \a part.
+    /// \note Part is usually built by parsing only the entity directory (see \ref Parser::parse). Other entities of
+    ///       the \a part are discarded. If entity does not exist in the \a part, it is removed from the \a project.
+    /// \note Spliced project stays frozen. Index of the entities distinguished names (see \ref dnames) is rebuilt
+    ///       on the next access, which takes time proportional to the number of project entities, but does not
+    ///       require any file to be read or parsed.
+    /// \note Returns \c false and leaves \a project unchanged if \a dname does not denote a namespace or service,
+    ///       entity parent (API or implementation) is not found in the \a project or if \a project is also
+    ///       referenced by other pointers, because read-only view must not change while it is accessed.
+    static bool Splice(std::shared_ptr<const Project>& project,
+                       std::shared_ptr<Project> part,
+                       const std::string& dname);
 
 private:
     void onNestedEntityAdded(Entity* entity);
@@ -145,25 +216,29 @@ private:
     void checkCallMessage(const Struct* errc, ErrorCollector& ecol) const;
     void checkResultMessage(const Struct* errc, ErrorCollector& ecol) const;
 
-    void checkApi(const Api* api, ErrorCollector& ecol) const;
+    void checkApi(const Api* api, ErrorCollector& ecol, CheckCache* cache, const CheckFilter& filter) const;
 
-    void checkNamespace(const Namespace* ns, ErrorCollector& ecol) const;
+    void checkNamespace(const Namespace* ns, ErrorCollector& ecol, CheckCache* cache) const;
     void checkNamespaceDesc(const Namespace* ns, ErrorCollector& ecol) const;
 
-    void checkClass(const Class* cls, ErrorCollector& ecol) const;
+    void checkClass(const Class* cls, ErrorCollector& ecol, CheckCache* cache) const;
     void checkClassDesc(const Class* cls, ErrorCollector& ecol) const;
     void checkObjectId(const Class* cls, ErrorCollector& ecol) const;
 
-    void checkMethod(const Method* method, ErrorCollector& ecol) const;
+    void checkMethod(const Method* method, ErrorCollector& ecol, CheckCache* cache) const;
     void checkMethodDesc(const Method* method, ErrorCollector& ecol) const;
 
-    void checkImplementation(const Implementation* implementation, ErrorCollector& ecol) const;
-    void checkService(const Service* service, ErrorCollector& ecol) const;
+    void checkImplementation(const Implementation* implementation,
+                             ErrorCollector& ecol,
+                             CheckCache* cache,
+                             const CheckFilter& filter) const;
+    void checkService(const Service* service, ErrorCollector& ecol, CheckCache* cache) const;
     void checkServiceDesc(const Service* service, ErrorCollector& ecol) const;
     void checkServiceDeps(const Service* service, bool checkImplemented, ErrorCollector& ecol) const;
 
-    void checkNestedStructs(const GeneralCompositeEntity* entity, ErrorCollector& ecol) const;
-    void checkNestedEnums(const GeneralCompositeEntity* entity, ErrorCollector& ecol) const;
+    void checkNestedStructs(const GeneralCompositeEntity* entity, ErrorCollector& ecol, CheckCache* cache) const;
+    void checkNestedEnums(const GeneralCompositeEntity* entity, ErrorCollector& ecol, CheckCache* cache) const;
+    void checkCached(const Entity* entity, ErrorCollector& ecol, CheckCache& cache) const;
 
     void checkStruct(const Struct* structure, ErrorCollector& ecol) const;
     void checkField(const Field* field, ErrorCollector& ecol) const;
@@ -175,6 +250,9 @@ private:
                                   const std::unordered_set<std::string>& allowedDocCommands = {}) const;
     bool isApiEntity(const Entity* entity) const noexcept;
 
+    void hashEntity(const Entity* root, StableHash& hash) const;
+    void hashFieldType(const std::string& typeName, StableHash& hash) const;
+
     std::filesystem::path root_;
 
     const Enum* errc_ = nullptr;
@@ -186,11 +264,17 @@ private:
     const Implementation* implementation_ = nullptr;
 
     std::unordered_map<std::string, const Entity*> entityDirectory_;
+    mutable std::unique_ptr<std::once_flag> dnamesFlag_ = std::make_unique<std::once_flag>();
+    mutable DnameIndex dnames_;
+    bool isFrozen_ = false;
 };
 
 /// Pointer to \ref Project.
 using ProjectPtr = std::shared_ptr<Project>;
 
+/// Pointer to the frozen \ref Project (see \ref Project::Freeze).
+using FrozenProjectPtr = std::shared_ptr<const Project>;
+
 } // namespace busrpc
 
 namespace std {
@@ -124,6 +124,16 @@ Enum* Struct::addEnum(const std::string& name, EntityDocs docs)
     return GeneralCompositeEntity::addEnum(name, "", std::move(docs));
 }
 
+EntityResult<Struct> Struct::tryAddStruct(const std::string& name, StructFlags flags, EntityDocs docs)
+{
+    return GeneralCompositeEntity::tryAddStruct(name, "", flags, std::move(docs));
+}
+
+EntityResult<Enum> Struct::tryAddEnum(const std::string& name, EntityDocs docs)
+{
+    return GeneralCompositeEntity::tryAddEnum(name, "", std::move(docs));
+}
+
 void Struct::setDefaultDescription()
 {
     std::vector<std::string> defaultDescription;
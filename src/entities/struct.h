@@ -98,6 +98,16 @@ public:
     /// \throws name_conflict_error if entity with the same name is already added
     Enum* addEnum(const std::string& name, EntityDocs docs = {});
 
+    /// Add nested structure without throwing entity errors.
+    /// \note Returns error code if structure can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Struct> tryAddStruct(const std::string& name,
+                                      StructFlags flags = StructFlags::None,
+                                      EntityDocs docs = {});
+
+    /// Add nested enumeration without throwing entity errors.
+    /// \note Returns error code if enumeration can't be added (see \ref CompositeEntity::tryAddNestedEntity).
+    EntityResult<Enum> tryAddEnum(const std::string& name, EntityDocs docs = {});
+
 protected:
     /// Create structure entity.
     Struct(CompositeEntity* parent,
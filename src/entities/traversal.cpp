@@ -0,0 +1,49 @@
+#include "entities/traversal.h"
+
+namespace busrpc {
+
+EntityIterator& EntityIterator::operator++()
+{
+    if (!isNestedSkipped_ && IsCompositeEntityType(current_->type())) {
+        const auto& nested = static_cast<const CompositeEntity*>(current_)->nested();
+
+        if (!nested.empty()) {
+            stack_.emplace_back(nested.begin(), nested.end());
+            current_ = *nested.begin();
+            return *this;
+        }
+    }
+
+    isNestedSkipped_ = false;
+
+    while (!stack_.empty()) {
+        auto& [it, end] = stack_.back();
+
+        if (++it != end) {
+            current_ = *it;
+            return *this;
+        }
+
+        stack_.pop_back();
+    }
+
+    current_ = nullptr;
+    return *this;
+}
+
+std::vector<const Entity*> GetIndependentSubtrees(const Project& project)
+{
+    std::vector<const Entity*> result;
+
+    if (project.api()) {
+        result.insert(result.end(), project.api()->namespaces().begin(), project.api()->namespaces().end());
+    }
+
+    if (project.implementation()) {
+        result.insert(
+            result.end(), project.implementation()->services().begin(), project.implementation()->services().end());
+    }
+
+    return result;
+}
+} // namespace busrpc
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "entities/api.h"
+#include "entities/class.h"
+#include "entities/constant.h"
+#include "entities/entity.h"
+#include "entities/enum.h"
+#include "entities/field.h"
+#include "entities/implementation.h"
+#include "entities/method.h"
+#include "entities/namespace.h"
+#include "entities/project.h"
+#include "entities/service.h"
+#include "entities/struct.h"
+#include "thread_pool.h"
+#include "types.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// \file traversal.h Generic traversal of the entity tree.
+
+namespace busrpc {
+
+/// Iterator over the entity subtree in the depth-first (pre-order) order.
+/// \note Iterator does not use recursion, so arbitrary deep entity trees can be traversed.
+/// \note Nested entities are visited in the same order as they are stored in \ref CompositeEntity::nested.
+class EntityIterator {
+public:
+    /// Iterator category.
+    using iterator_category = std::forward_iterator_tag;
+
+    /// Iterator value type.
+    using value_type = const Entity*;
+
+    /// Iterator difference type.
+    using difference_type = std::ptrdiff_t;
+
+    /// Iterator pointer type.
+    using pointer = const value_type*;
+
+    /// Iterator reference type.
+    using reference = const value_type&;
+
+    /// Create end iterator.
+    EntityIterator() = default;
+
+    /// Create iterator pointing to the \a root of the subtree.
+    explicit EntityIterator(const Entity* root): current_(root) { }
+
+    /// Current entity.
+    reference operator*() const noexcept { return current_; }
+
+    /// Current entity.
+    pointer operator->() const noexcept { return &current_; }
+
+    /// Advance iterator to the next entity.
+    EntityIterator& operator++();
+
+    /// Advance iterator to the next entity.
+    EntityIterator operator++(int)
+    {
+        EntityIterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    /// Return \c true if iterators point to the same entity.
+    bool operator==(const EntityIterator& other) const noexcept { return current_ == other.current_; }
+
+    /// Depth of the current entity relative to the subtree root (root depth is 0).
+    std::size_t depth() const noexcept { return stack_.size(); }
+
+    /// Do not visit entities nested to the current one when iterator is advanced.
+    void skipNested() noexcept { isNestedSkipped_ = true; }
+
+private:
+    std::vector<std::pair<EntityContainer<Entity>::const_iterator, EntityContainer<Entity>::const_iterator>> stack_;
+    const Entity* current_ = nullptr;
+    bool isNestedSkipped_ = false;
+};
+
+/// Entity subtree, which can be traversed with range-based \c for loop.
+class EntitySubtree {
+public:
+    /// Create subtree with the specified \a root.
+    explicit EntitySubtree(const Entity& root): root_(&root) { }
+
+    /// Iterator pointing to the subtree root.
+    EntityIterator begin() const { return EntityIterator(root_); }
+
+    /// End iterator.
+    EntityIterator end() const noexcept { return {}; }
+
+private:
+    const Entity* root_;
+};
+
+/// Invoke \a visitor for the \a entity casted to it's concrete type (determined by \ref Entity::type).
+/// \note Visitor may be any callable object (for example, set of overloaded lambdas). If visitor can't be invoked
+///       with the concrete entity type, then entity is silently skipped, which means that visitor only needs to
+///       handle entity types it is interested in. Visitor accepting <tt>const Entity&</tt> is invoked for any entity.
+template<typename TVisitor>
+void VisitEntity(const Entity& entity, TVisitor&& visitor)
+{
+    auto invoke = [&visitor]<typename TEntity>(const TEntity& concreteEntity) {
+        if constexpr (std::is_invocable_v<TVisitor&, const TEntity&>) {
+            visitor(concreteEntity);
+        }
+    };
+
+    switch (entity.type()) {
+    case EntityTypeId::Project: invoke(static_cast<const Project&>(entity)); break;
+    case EntityTypeId::Api: invoke(static_cast<const Api&>(entity)); break;
+    case EntityTypeId::Implementation: invoke(static_cast<const Implementation&>(entity)); break;
+    case EntityTypeId::Namespace: invoke(static_cast<const Namespace&>(entity)); break;
+    case EntityTypeId::Class: invoke(static_cast<const Class&>(entity)); break;
+    case EntityTypeId::Method: invoke(static_cast<const Method&>(entity)); break;
+    case EntityTypeId::Struct: invoke(static_cast<const Struct&>(entity)); break;
+    case EntityTypeId::Field: invoke(static_cast<const Field&>(entity)); break;
+    case EntityTypeId::Enum: invoke(static_cast<const Enum&>(entity)); break;
+    case EntityTypeId::Constant: invoke(static_cast<const Constant&>(entity)); break;
+    case EntityTypeId::Service: invoke(static_cast<const Service&>(entity)); break;
+    default: invoke(entity); break;
+    }
+}
+
+/// Invoke \a visitor for each entity of the subtree with the specified \a root in the depth-first order.
+/// \note See \ref VisitEntity for the description of the \a visitor.
+template<typename TVisitor>
+void ForEachEntity(const Entity& root, TVisitor&& visitor)
+{
+    for (const Entity* entity: EntitySubtree(root)) {
+        VisitEntity(*entity, visitor);
+    }
+}
+
+/// Return roots of the independent project subtrees (API namespaces and implementation services).
+/// \note Entities from different subtrees are not nested to each other, so subtrees can be processed in parallel
+///       (see \ref ParallelForEach).
+std::vector<const Entity*> GetIndependentSubtrees(const Project& project);
+
+/// Invoke \a func for each of the \a roots using at most \a jobs threads of the shared thread pool.
+/// \note Roots should not be nested to each other if \a func processes entire root subtree (see
+///       \ref GetIndependentSubtrees).
+/// \note See \ref ThreadPool::parallelFor for details on how threads are used and exceptions are handled.
+template<typename TFunc>
+void ParallelForEach(const std::vector<const Entity*>& roots, std::size_t jobs, TFunc&& func)
+{
+    ThreadPool::Shared().parallelFor(roots.size(), jobs, [&roots, &func](std::size_t i) { func(*roots[i]); });
+}
+} // namespace busrpc
@@ -32,6 +32,17 @@ std::optional<ErrorCollector::ErrorInfo> ErrorCollector::find(std::error_code ec
     return it != errors_.end() ? std::optional<ErrorInfo>(*it) : std::nullopt;
 }
 
+ErrorCollector ErrorCollector::filter(std::vector<const std::error_category*> ignoredCategories) const
+{
+    ErrorCollector result(orderFunc_, std::move(ignoredCategories));
+
+    for (const auto& info: errors_) {
+        result.add(info);
+    }
+
+    return result;
+}
+
 bool ErrorCollector::isIgnored(const std::error_category* category) const noexcept
 {
     auto it = std::find_if(ignoredCategories_.begin(),
@@ -40,6 +51,23 @@ bool ErrorCollector::isIgnored(const std::error_category* category) const noexce
     return it != ignoredCategories_.end();
 }
 
+void ErrorCollector::addErrorInfo(ErrorInfo info)
+{
+    for (const auto& storedInfo: errors_) {
+        if (storedInfo.code.category() == info.code.category() && storedInfo.code.value() == info.code.value() &&
+            storedInfo.description == info.description) {
+            // do not add the same code twice
+            return;
+        }
+    }
+
+    errors_.push_back(std::move(info));
+
+    if (!majorError_ || (orderFunc_ && orderFunc_(majorError_->code, errors_.back().code))) {
+        majorError_ = errors_.back();
+    }
+}
+
 bool SeverityByErrorCodeValue(std::error_code lhs, std::error_code rhs)
 {
     return lhs.value() < rhs.value();
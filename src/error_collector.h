@@ -26,6 +26,25 @@ bool SeverityByErrorCodeValue(std::error_code lhs, std::error_code rhs);
 /// Collects multiple errors.
 class ErrorCollector {
 public:
+    /// Location of the error in the project.
+    struct ErrorLocation {
+        /// File where error is found (relative to the project directory).
+        /// \note Empty if error is not found in a particular file.
+        std::string file = {};
+
+        /// Zero-based line of the error in the \ref file or \c -1 if line is unknown.
+        int line = -1;
+
+        /// Zero-based column of the error in the \ref file or \c -1 if column is unknown.
+        /// \note Column is counted in the same way as by the protobuf tokenizer: each byte of the line occupies one
+        ///       column and tab advances column to the next multiple of 8.
+        int column = -1;
+
+        /// Distinguished name of the entity, which is the subject of the error.
+        /// \note Empty if error is not related to a particular entity.
+        std::string entity = {};
+    };
+
     /// Information about error.
     struct ErrorInfo {
         /// Error code.
@@ -33,6 +52,11 @@ public:
 
         /// Error description.
         std::string description;
+
+        /// Error location.
+        /// \note Location does not affect error description, which should contain all information required to find
+        ///       the error by a human reader.
+        ErrorLocation location = {};
     };
 
     /// Create error collector.
@@ -67,6 +91,17 @@ public:
     ///       building error description.
     template<typename... TSpecifiers>
     void add(std::error_code ec, const TSpecifiers&... specifiers) noexcept
+    {
+        add(ErrorLocation{}, ec, specifiers...);
+    }
+
+    /// Add \a ec found at the specified \a location to the stored errors and append all \a specifiers to the added
+    /// error description.
+    /// \tparam TSpecifiers Specifier types.
+    /// \note Same as the method above, but additionally stores error \a location, which allows tools (for example,
+    ///       language server) to find the error without parsing it's description.
+    template<typename... TSpecifiers>
+    void add(ErrorLocation location, std::error_code ec, const TSpecifiers&... specifiers)
     {
         if (!ec || isIgnored(&ec.category())) {
             return;
@@ -90,19 +125,19 @@ public:
             description.append(specifiersStr);
         }
 
-        for (const auto& info: errors_) {
-            if (info.code.category() == ec.category() && info.code.value() == ec.value() &&
-                info.description == description) {
-                // do not add the same code twice
-                return;
-            }
-        }
-
-        errors_.emplace_back(std::move(ec), std::move(description));
+        addErrorInfo({ec, std::move(description), std::move(location)});
+    }
 
-        if (!majorError_ || (orderFunc_ && orderFunc_(majorError_->code, ec))) {
-            majorError_ = errors_.back();
+    /// Add error \a info previously collected by some other collector.
+    /// \note If \a info does not indicate an error or it's category is ignored, method does nothing.
+    /// \note If exactly the same error was already added, then new one is ignored.
+    void add(ErrorInfo info)
+    {
+        if (!info.code || isIgnored(&info.code.category())) {
+            return;
         }
+
+        addErrorInfo(std::move(info));
     }
 
     /// Clear all added errors.
@@ -116,12 +151,21 @@ public:
     /// \note The most severe error code is determined using \ref SeverityOrder function (see class' constructor).
     const std::optional<ErrorInfo>& majorError() const noexcept { return majorError_; }
 
+    /// Create collector with the same severity order, which contains errors of this collector except ones with
+    /// ignored categories.
+    /// \note Parameter \a ignoredCategories determines error code categories to be ignored by the created collector.
+    /// \note Created collector does not initialize protobuf error collector.
+    ErrorCollector filter(std::vector<const std::error_category*> ignoredCategories) const;
+
     /// Return all errors in the order they were added to the collector.
     const std::vector<ErrorInfo>& errors() const noexcept { return errors_; }
 
     /// Search for the first error with the specified \a ec.
     std::optional<ErrorInfo> find(std::error_code ec);
 
+    /// Return \c true if errors of the \a category are ignored by the collector.
+    bool isIgnored(const std::error_category* category) const noexcept;
+
     /// Return \c true if collector contains error(s).
     explicit operator bool() const noexcept { return static_cast<bool>(majorError_); }
 
@@ -135,7 +179,7 @@ private:
     ErrorCollector(std::error_code* protobufErrorCode,
                    SeverityOrder orderFunc,
                    std::vector<const std::error_category*> ignoredCategories);
-    bool isIgnored(const std::error_category* category) const noexcept;
+    void addErrorInfo(ErrorInfo info);
 
     template<typename TArg, typename... TArgs>
     static void OutputSpecifiers(std::ostream& out, const TArg& arg, const TArgs&... args);
@@ -0,0 +1,15 @@
+#include "generators/cbor_generator.h"
+#include "generators/json_generator.h"
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace busrpc {
+
+void CborGenerator::generate(const Project& project) const
+{
+    json doc = project;
+    json::to_cbor(doc, out_);
+}
+} // namespace busrpc
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "generators/generator.h"
+
+#include <ostream>
+
+/// \file cbor_generator.h Generator, which outputs busrpc project documentation in the CBOR format.
+
+namespace busrpc {
+
+/// Generator, which outputs a single CBOR document containing busrpc project documentation.
+/// \note Document has the same schema as the document created by \ref JsonGenerator.
+/// \note Unlike \ref JsonGenerator, this generator builds the whole document in memory before writing it.
+class CborGenerator: public DocGenerator {
+public:
+    /// Create CBOR generator, which outputs generated CBOR document to \a out.
+    /// \warning Stream \a out should outlive generator and should be opened in binary mode.
+    CborGenerator(std::ostream& out): out_(out) { }
+
+    /// Generate and output CBOR document containing busrpc project documentation.
+    /// \note Project strings are written as is without UTF-8 validation, so document may contain invalid UTF-8 strings
+    ///       if project files are not UTF-8 encoded.
+    void generate(const Project& project) const override;
+
+private:
+    std::ostream& out_;
+};
+} // namespace busrpc
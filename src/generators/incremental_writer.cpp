@@ -0,0 +1,140 @@
+#include "generators/incremental_writer.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <system_error>
+
+using json = nlohmann::json;
+
+namespace busrpc {
+
+namespace {
+
+constexpr const char* Files_Key = "files";
+
+// Suffix of the temporary file, which is renamed to the output file after it's content is written
+constexpr const char* Tmp_File_Suffix = ".tmp";
+
+uint64_t GetContentHash(const std::string& content)
+{
+    StableHash hash;
+    hash.update(content);
+    return hash.value();
+}
+
+// Return true if file name read from the manifest refers to the file inside the output directory
+bool IsValidFileName(const std::string& name)
+{
+    auto path = std::filesystem::path(name).lexically_normal();
+    return !path.empty() && !path.has_root_path() && *path.begin() != ".." && *path.begin() != ".";
+}
+} // namespace
+
+IncrementalWriter::IncrementalWriter(std::filesystem::path dir): dir_(std::move(dir))
+{
+    std::ifstream in(dir_ / Doc_Manifest_File);
+
+    if (!in.is_open()) {
+        return;
+    }
+
+    json manifest = json::parse(in, nullptr, false);
+
+    if (!manifest.is_object() || !manifest[Files_Key].is_object()) {
+        return;
+    }
+
+    for (const auto& [name, hash]: manifest[Files_Key].items()) {
+        if (!IsValidFileName(name)) {
+            // never remove files outside of the output directory
+            continue;
+        }
+
+        if (!hash.is_string()) {
+            previous_.clear();
+            return;
+        }
+
+        try {
+            previous_[name] = std::stoull(hash.get<std::string>(), nullptr, 16);
+        } catch (const std::logic_error&) {
+            previous_.clear();
+            return;
+        }
+    }
+}
+
+bool IncrementalWriter::write(const std::string& name, const std::string& content)
+{
+    auto hash = GetContentHash(content);
+    auto path = dir_ / name;
+    auto it = previous_.find(name);
+    current_[name] = hash;
+
+    if (it != previous_.end() && it->second == hash && std::filesystem::is_regular_file(path)) {
+        ++skipped_;
+        return true;
+    }
+
+    // content is written to the temporary file first, so that existing file is not damaged if write fails
+    auto tmpPath = path;
+    tmpPath += Tmp_File_Suffix;
+    std::ofstream out(tmpPath);
+    out << content;
+    out.close();
+    std::error_code ec;
+
+    if (!out || (std::filesystem::rename(tmpPath, path, ec), ec)) {
+        std::filesystem::remove(tmpPath, ec);
+
+        // file, which was not written, keeps it's previous content and hash (if any), so it is not considered stale
+        if (it != previous_.end()) {
+            current_[name] = it->second;
+        } else {
+            current_.erase(name);
+        }
+
+        return false;
+    }
+
+    ++written_;
+    return true;
+}
+
+bool IncrementalWriter::commit()
+{
+    bool result = true;
+
+    for (const auto& file: previous_) {
+        if (current_.count(file.first) == 0) {
+            std::error_code ec;
+
+            if (std::filesystem::remove(dir_ / file.first, ec)) {
+                ++removed_;
+            } else if (ec) {
+                current_.insert(file);
+                result = false;
+            }
+        }
+    }
+
+    if (previous_ == current_ && std::filesystem::is_regular_file(dir_ / Doc_Manifest_File)) {
+        return result;
+    }
+
+    json manifest;
+    manifest[Files_Key] = json::object();
+
+    for (const auto& file: current_) {
+        manifest[Files_Key][file.first] = HashToString(file.second);
+    }
+
+    std::ofstream out(dir_ / Doc_Manifest_File);
+    out << std::setw(2) << manifest;
+    return result && static_cast<bool>(out);
+}
+} // namespace busrpc
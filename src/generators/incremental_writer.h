@@ -0,0 +1,57 @@
+#pragma once
+
+#include "constants.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+/// \file incremental_writer.h Writer of the documentation files, which rewrites only changed files.
+
+namespace busrpc {
+
+/// Writer of the documentation files, which rewrites only changed files.
+/// \note Writer stores content hash of each written file in the manifest file (\ref Doc_Manifest_File) located in the
+///       output directory. File is rewritten only if it's content hash differs from the hash stored in the manifest
+///       by the previous run (or if file does not exist). Files listed in the manifest, which were not written during
+///       current run, are considered stale and are removed by \ref commit method (if file can't be removed,
+///       it remains in the manifest and removal is retried next time).
+/// \note Files, which are not listed in the manifest, are never removed.
+/// \note Manifest entries, which refer to the files outside of the output directory (absolute paths or paths
+///       containing '..'), are ignored.
+/// \note File content is written to the temporary file, which then replaces the output file, so if file can't be
+///       written, it's previous content remains intact.
+class IncrementalWriter {
+public:
+    /// Create writer, which outputs files to \a dir and load manifest of the previous run from this directory.
+    /// \note If manifest does not exist or is invalid, all files are written.
+    explicit IncrementalWriter(std::filesystem::path dir);
+
+    /// Write file with the specified \a name and \a content unless it is not changed since the previous run.
+    /// \note Returns \c false if file is changed but can't be written.
+    bool write(const std::string& name, const std::string& content);
+
+    /// Remove stale files and save manifest.
+    /// \note Returns \c false if stale file can't be removed or manifest can't be written.
+    bool commit();
+
+    /// Number of files written (created or rewritten).
+    std::size_t written() const noexcept { return written_; }
+
+    /// Number of files skipped because their content is not changed.
+    std::size_t skipped() const noexcept { return skipped_; }
+
+    /// Number of stale files removed.
+    std::size_t removed() const noexcept { return removed_; }
+
+private:
+    std::filesystem::path dir_;
+    std::map<std::string, uint64_t> previous_;
+    std::map<std::string, uint64_t> current_;
+    std::size_t written_ = 0;
+    std::size_t skipped_ = 0;
+    std::size_t removed_ = 0;
+};
+} // namespace busrpc
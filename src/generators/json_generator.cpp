@@ -1,290 +1,1027 @@
+#include "entities/traversal.h"
 #include "generators/json_generator.h"
+#include "generators/json_writer.h"
+#include "thread_pool.h"
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 using json = nlohmann::json;
 
 namespace busrpc {
 
 namespace {
 
-void AddCommonEntityData(json& obj, const Entity& entity)
-{
-    obj["name"] = entity.name();
-    obj["dname"] = entity.dname();
-    obj["dir"] = entity.dir().generic_string();
-    obj["docs"] = entity.docs();
-}
+// Writer, which builds JSON DOM and has the same interface as the streaming JsonWriter
+class DomWriter {
+public:
+    explicit DomWriter(json& root): root_(root) { }
+
+    void beginObject() { stack_.push_back(&place(json::object())); }
+    void endObject() { stack_.pop_back(); }
+    void beginArray() { stack_.push_back(&place(json::array())); }
+    void endArray() { stack_.pop_back(); }
+    void key(std::string_view key) { key_ = key; }
+    void nullValue() { place(nullptr); }
+    void boolValue(bool value) { place(value); }
+    void intValue(int64_t value) { place(value); }
+    void stringValue(std::string_view value) { place(value); }
+
+private:
+    json& place(json value)
+    {
+        if (stack_.empty()) {
+            return root_ = std::move(value);
+        }
 
-void AddNestedStructsAndEnums(json& obj,
-                              const GeneralCompositeEntity& entity,
-                              bool onlyGeneral = true,
-                              bool doNotAddErrc = false)
-{
-    obj["enums"] = nullptr;
+        json& container = *stack_.back();
+
+        if (container.is_object()) {
+            return container[key_] = std::move(value);
+        }
+
+        container.push_back(std::move(value));
+        return container.back();
+    }
+
+    json& root_;
+    std::vector<json*> stack_;
+    std::string key_;
+};
+
+// Writer of the compact schema document, which has the same interface as the streaming JsonWriter
+// Writer omits object members with empty values (null, empty string, array or object) and replaces strings, which are
+// values of the "string-table" keys (dname, dir, etc.), with their index in the string table. Because writer can't
+// know whether container is empty until it is closed, containers are not written until first non-empty value is
+// written to them.
+class CompactWriter {
+public:
+    CompactWriter(JsonWriter& writer, SearchIndex* index): writer_(writer), index_(index) { }
+
+    void beginObject() { beginContainer(true); }
+    void endObject() { endContainer(); }
+    void beginArray() { beginContainer(false); }
+    void endArray() { endContainer(); }
+    void key(std::string_view key) { key_ = key; }
+
+    void nullValue()
+    {
+        if (!isObjectMember()) {
+            writeKey();
+            writer_.nullValue();
+        }
+    }
+
+    void boolValue(bool value)
+    {
+        writeKey();
+        writer_.boolValue(value);
+    }
+
+    void intValue(int64_t value)
+    {
+        writeKey();
+        writer_.intValue(value);
+    }
 
-    for (const auto& enumeration: entity.enums()) {
-        if (!doNotAddErrc || enumeration->name() != Errc_Enum_Name) {
-            obj["enums"][enumeration->name()] = *enumeration;
+    void stringValue(std::string_view value)
+    {
+        if (value.empty() && isObjectMember()) {
+            return;
         }
+
+        bool isTableString = IsTableStringKey(key_);
+        writeKey();
+
+        if (isTableString) {
+            writer_.intValue(static_cast<int64_t>(getStringIndex(value)));
+        } else {
+            writer_.stringValue(value);
+        }
+    }
+
+    const std::vector<const std::string*>& strings() const noexcept { return strings_; }
+    SearchIndex* index() const noexcept { return index_; }
+
+private:
+    struct Frame {
+        std::string key;
+        bool isObject = false;
+        bool isWritten = false;
+    };
+
+    static bool IsTableStringKey(std::string_view key)
+    {
+        return key == "dir" || key == "dname" || key == "fieldTypeName" || key == "file" || key == "keyTypeName" ||
+               key == "package" || key == "valueTypeName";
+    }
+
+    bool isObjectMember() const noexcept { return !stack_.empty() && stack_.back().isObject; }
+
+    void beginContainer(bool isObject)
+    {
+        bool isMember = isObjectMember();
+        stack_.push_back({isMember ? std::move(key_) : std::string(), isObject, false});
+
+        // array elements are never omitted
+        if (!isMember) {
+            writePending();
+        }
+    }
+
+    void endContainer()
+    {
+        if (stack_.back().isWritten) {
+            if (stack_.back().isObject) {
+                writer_.endObject();
+            } else {
+                writer_.endArray();
+            }
+        }
+
+        stack_.pop_back();
     }
 
-    obj["structs"] = nullptr;
+    // Write containers, which were not written yet, and key of the current value
+    void writeKey()
+    {
+        writePending();
 
-    for (const auto& structure: entity.structs()) {
-        if (structure->structType() == StructTypeId::General || !onlyGeneral) {
-            obj["structs"][structure->name()] = *structure;
+        if (isObjectMember()) {
+            writer_.key(key_);
         }
     }
+
+    void writePending()
+    {
+        auto it = std::find_if(stack_.begin(), stack_.end(), [](const Frame& frame) { return !frame.isWritten; });
+
+        for (; it != stack_.end(); ++it) {
+            if (it != stack_.begin() && (it - 1)->isObject) {
+                writer_.key(it->key);
+            }
+
+            if (it->isObject) {
+                writer_.beginObject();
+            } else {
+                writer_.beginArray();
+            }
+
+            it->isWritten = true;
+        }
+    }
+
+    std::size_t getStringIndex(std::string_view str)
+    {
+        auto [it, isInserted] = stringIndex_.emplace(std::string(str), strings_.size());
+
+        if (isInserted) {
+            strings_.push_back(&it->first);
+        }
+
+        return it->second;
+    }
+
+    JsonWriter& writer_;
+    SearchIndex* index_;
+    std::vector<Frame> stack_;
+    std::string key_;
+    std::vector<const std::string*> strings_;
+    std::unordered_map<std::string, std::size_t> stringIndex_;
+};
+
+// Streaming writer, which also adds written entities to the search index (if index is not null)
+class DocWriter: public JsonWriter {
+public:
+    DocWriter(std::ostream& out, std::size_t indent, std::size_t depth, SearchIndex* index):
+        JsonWriter(out, indent, depth),
+        index_(index)
+    { }
+
+    SearchIndex* index() const noexcept { return index_; }
+
+private:
+    SearchIndex* index_;
+};
+
+// Streaming writer, which outputs namespaces and services rendered in advance by the worker threads
+class StitchingWriter: public DocWriter {
+public:
+    StitchingWriter(std::ostream& out,
+                    std::size_t indent,
+                    const std::unordered_map<const Entity*, std::string>& rendered,
+                    SearchIndex* index):
+        DocWriter(out, indent, 0, index),
+        rendered_(rendered)
+    { }
+
+    const std::string& rendered(const Entity& entity) const { return rendered_.at(&entity); }
+
+private:
+    const std::unordered_map<const Entity*, std::string>& rendered_;
+};
+
+// Nesting depth of the namespace (project.api.namespaces.<name>) and service (project.implementation.services.<name>)
+constexpr std::size_t Subtree_Depth = 3;
+
+void WriteEntity(StitchingWriter& writer, const Namespace& ns)
+{
+    writer.rawValue(writer.rendered(ns));
 }
-} // namespace
 
-void JsonGenerator::generate(const Project& project) const
+void WriteEntity(StitchingWriter& writer, const Service& service)
 {
-    json doc = project;
-    out_ << doc;
+    writer.rawValue(writer.rendered(service));
 }
 
-void to_json(json& obj, const Project& project)
+// Functions below write entities using streaming JsonWriter or DomWriter. Because streaming writer outputs object
+// keys immediately, they are written in the ascending byte order (the same order is used by nlohmann::json objects).
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Project& project);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Api& api);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Namespace& ns);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Class& cls);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Method& method);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Implementation& implementation);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Service& service);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const ImplementedMethod& implMethod);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const InvokedMethod& invkMethod);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Struct& structure);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Field& field);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Enum& enumeration);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Constant& constant);
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const EntityDocs& docs);
+
+// Streaming writer, which outputs nested entities having their own shards as links to these shards
+class ShardWriter: public DocWriter {
+public:
+    ShardWriter(std::ostream& out, std::size_t indent, const Entity& shard, SearchIndex* index):
+        DocWriter(out, indent, 0, index),
+        shard_(shard)
+    { }
+
+    const Entity& shard() const noexcept { return shard_; }
+
+private:
+    const Entity& shard_;
+};
+
+std::string GetShardFile(const Entity& entity)
 {
-    AddCommonEntityData(obj, project);
+    return entity.dname() + ".json";
+}
 
-    obj["root"] = project.root();
+template<typename TEntity>
+void WriteShardEntity(ShardWriter& writer, const TEntity& entity)
+{
+    if (&entity == &writer.shard()) {
+        WriteEntity<ShardWriter>(writer, entity);
+        return;
+    }
 
-    if (project.errc()) {
-        obj[Errc_Enum_Name] = *project.errc();
-    } else {
-        obj[Errc_Enum_Name] = nullptr;
+    writer.beginObject();
+    writer.key("brief");
+    writer.stringValue(entity.docs().brief());
+    writer.key("dname");
+    writer.stringValue(entity.dname());
+    writer.key("shard");
+    writer.stringValue(GetShardFile(entity));
+    writer.endObject();
+}
+
+void WriteEntity(ShardWriter& writer, const Project& project)
+{
+    WriteShardEntity(writer, project);
+}
+
+void WriteEntity(ShardWriter& writer, const Api& api)
+{
+    WriteShardEntity(writer, api);
+}
+
+void WriteEntity(ShardWriter& writer, const Implementation& implementation)
+{
+    WriteShardEntity(writer, implementation);
+}
+
+void WriteEntity(ShardWriter& writer, const Namespace& ns)
+{
+    WriteShardEntity(writer, ns);
+}
+
+void WriteEntity(ShardWriter& writer, const Class& cls)
+{
+    WriteShardEntity(writer, cls);
+}
+
+void WriteEntity(ShardWriter& writer, const Method& method)
+{
+    WriteShardEntity(writer, method);
+}
+
+void WriteEntity(ShardWriter& writer, const Service& service)
+{
+    WriteShardEntity(writer, service);
+}
+
+template<typename TWriter>
+void WriteStrings(TWriter& writer, const std::vector<std::string>& strings)
+{
+    writer.beginArray();
+
+    for (const auto& str: strings) {
+        writer.stringValue(str);
     }
 
-    if (project.exception()) {
-        obj[GetPredefinedStructName(StructTypeId::Exception)] = *project.exception();
+    writer.endArray();
+}
+
+// Write entity or null if entity does not exist
+template<typename TWriter, typename TEntity>
+void WriteOptional(TWriter& writer, std::string_view key, const TEntity* entity)
+{
+    writer.key(key);
+
+    if (entity) {
+        WriteEntity(writer, *entity);
     } else {
-        obj[GetPredefinedStructName(StructTypeId::Exception)] = nullptr;
+        writer.nullValue();
     }
+}
 
-    if (project.callMessage()) {
-        obj[GetPredefinedStructName(StructTypeId::Call_Message)] = *project.callMessage();
-    } else {
-        obj[GetPredefinedStructName(StructTypeId::Call_Message)] = nullptr;
+// Write object, which maps entity name to entity, or null if no entity satisfies the filter
+template<typename TWriter, typename TContainer, typename TFilter>
+void WriteNamed(TWriter& writer, std::string_view key, const TContainer& entities, TFilter filter)
+{
+    writer.key(key);
+
+    bool isEmpty = true;
+
+    for (const auto& entity: entities) {
+        if (filter(*entity)) {
+            if (isEmpty) {
+                writer.beginObject();
+                isEmpty = false;
+            }
+
+            writer.key(entity->name());
+            WriteEntity(writer, *entity);
+        }
     }
 
-    if (project.resultMessage()) {
-        obj[GetPredefinedStructName(StructTypeId::Result_Message)] = *project.resultMessage();
+    if (isEmpty) {
+        writer.nullValue();
     } else {
-        obj[GetPredefinedStructName(StructTypeId::Result_Message)] = nullptr;
+        writer.endObject();
     }
+}
 
-    if (project.api()) {
-        obj["api"] = *project.api();
-    } else {
-        obj["api"] = nullptr;
+template<typename TWriter, typename TContainer>
+void WriteNamed(TWriter& writer, std::string_view key, const TContainer& entities)
+{
+    WriteNamed(writer, key, entities, [](const auto&) { return true; });
+}
+
+// Write object, which maps imported method name to imported method, or null if there are no methods
+template<typename TWriter, typename TContainer>
+void WriteImported(TWriter& writer, std::string_view key, const TContainer& methods)
+{
+    writer.key(key);
+
+    if (methods.empty()) {
+        writer.nullValue();
+        return;
     }
 
-    if (project.implementation()) {
-        obj["implementation"] = *project.implementation();
-    } else {
-        obj["implementation"] = nullptr;
+    writer.beginObject();
+
+    for (const auto& method: methods) {
+        writer.key(method.dname());
+        WriteEntity(writer, method);
     }
 
-    AddNestedStructsAndEnums(obj, project, true, true);
+    writer.endObject();
 }
 
-void to_json(json& obj, const Api& api)
+// Write "dir", "dname" and "docs" properties (they are adjacent in the key order, while "name" is not)
+template<typename TWriter>
+void WriteCommonEntityData(TWriter& writer, const Entity& entity)
 {
-    AddCommonEntityData(obj, api);
-    obj["namespaces"] = nullptr;
-
-    for (const auto& ns: api.namespaces()) {
-        obj["namespaces"][ns->name()] = *ns;
+    // entity is indexed by the same traversal, which writes the documentation
+    if constexpr (requires { writer.index(); }) {
+        if (auto index = writer.index()) {
+            index->add(entity);
+        }
     }
 
-    AddNestedStructsAndEnums(obj, api);
+    writer.key("dir");
+    writer.stringValue(entity.dir().generic_string());
+    writer.key("dname");
+    writer.stringValue(entity.dname());
+    writer.key("docs");
+    WriteEntity(writer, entity.docs());
 }
 
-void to_json(json& obj, const Namespace& ns)
+template<typename TWriter>
+void WriteName(TWriter& writer, const Entity& entity)
 {
-    AddCommonEntityData(obj, ns);
-    obj["classes"] = nullptr;
+    writer.key("name");
+    writer.stringValue(entity.name());
+}
 
-    for (const auto& cls: ns.classes()) {
-        obj["classes"][cls->name()] = *cls;
-    }
+template<typename TWriter>
+void WriteNestedEnums(TWriter& writer, const GeneralCompositeEntity& entity, bool doNotAddErrc = false)
+{
+    WriteNamed(writer, "enums", entity.enums(), [doNotAddErrc](const Enum& enumeration) {
+        return !doNotAddErrc || enumeration.name() != Errc_Enum_Name;
+    });
+}
+
+template<typename TWriter>
+void WriteNestedStructs(TWriter& writer, const GeneralCompositeEntity& entity, bool onlyGeneral = true)
+{
+    WriteNamed(writer, "structs", entity.structs(), [onlyGeneral](const Struct& structure) {
+        return structure.structType() == StructTypeId::General || !onlyGeneral;
+    });
+}
 
-    AddNestedStructsAndEnums(obj, ns);
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Project& project)
+{
+    writer.beginObject();
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Call_Message), project.callMessage());
+    WriteOptional(writer, Errc_Enum_Name, project.errc());
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Exception), project.exception());
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Result_Message), project.resultMessage());
+    WriteOptional(writer, "api", project.api());
+    WriteCommonEntityData(writer, project);
+    WriteNestedEnums(writer, project, true);
+    WriteOptional(writer, "implementation", project.implementation());
+    WriteName(writer, project);
+    writer.key("root");
+    writer.stringValue(project.root().string());
+    WriteNestedStructs(writer, project);
+    writer.endObject();
 }
 
-void to_json(json& obj, const Class& cls)
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Api& api)
 {
-    AddCommonEntityData(obj, cls);
+    writer.beginObject();
+    WriteCommonEntityData(writer, api);
+    WriteNestedEnums(writer, api);
+    WriteName(writer, api);
+    WriteNamed(writer, "namespaces", api.namespaces());
+    WriteNestedStructs(writer, api);
+    writer.endObject();
+}
 
-    if (cls.objectId()) {
-        obj[GetPredefinedStructName(StructTypeId::Class_Object_Id)] = *cls.objectId();
-    } else {
-        obj[GetPredefinedStructName(StructTypeId::Class_Object_Id)] = nullptr;
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Namespace& ns)
+{
+    writer.beginObject();
+    WriteNamed(writer, "classes", ns.classes());
+    WriteCommonEntityData(writer, ns);
+    WriteNestedEnums(writer, ns);
+    WriteName(writer, ns);
+    WriteNestedStructs(writer, ns);
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Class& cls)
+{
+    writer.beginObject();
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Class_Object_Id), cls.objectId());
+    WriteCommonEntityData(writer, cls);
+    WriteNestedEnums(writer, cls);
+    writer.key("isStatic");
+    writer.boolValue(cls.isStatic());
+    WriteNamed(writer, "methods", cls.methods());
+    WriteName(writer, cls);
+    WriteNestedStructs(writer, cls);
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Method& method)
+{
+    writer.beginObject();
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Method_Params), method.params());
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Method_Retval), method.retval());
+    WriteCommonEntityData(writer, method);
+    WriteNestedEnums(writer, method);
+    writer.key("isOneway");
+    writer.boolValue(method.isOneway());
+    writer.key("isStatic");
+    writer.boolValue(method.isStatic());
+    WriteName(writer, method);
+    writer.key("postcondition");
+    writer.stringValue(method.postcondition());
+    writer.key("precondition");
+    writer.stringValue(method.precondition());
+    WriteNestedStructs(writer, method);
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Implementation& implementation)
+{
+    writer.beginObject();
+    WriteCommonEntityData(writer, implementation);
+    WriteNestedEnums(writer, implementation);
+    WriteName(writer, implementation);
+    WriteNamed(writer, "services", implementation.services());
+    WriteNestedStructs(writer, implementation);
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Service& service)
+{
+    writer.beginObject();
+    WriteOptional(writer, GetPredefinedStructName(StructTypeId::Service_Config), service.config());
+    writer.key("author");
+    writer.stringValue(service.author());
+    WriteCommonEntityData(writer, service);
+    writer.key("email");
+    writer.stringValue(service.email());
+    WriteNestedEnums(writer, service);
+    WriteImported(writer, "implements", service.implementedMethods());
+    WriteImported(writer, "invokes", service.invokedMethods());
+    WriteName(writer, service);
+    WriteNestedStructs(writer, service);
+    writer.key("url");
+    writer.stringValue(service.url());
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const ImplementedMethod& implMethod)
+{
+    writer.beginObject();
+
+    if (implMethod.acceptedObjectId()) {
+        writer.key("acceptedObjectId");
+        writer.stringValue(*implMethod.acceptedObjectId());
     }
 
-    obj["isStatic"] = cls.isStatic();
-    obj["methods"] = nullptr;
+    if (!implMethod.acceptedParams().empty()) {
+        writer.key("acceptedParams");
+        writer.beginObject();
 
-    for (const auto& method: cls.methods()) {
-        obj["methods"][method->name()] = *method;
+        for (const auto& acceptedParam: implMethod.acceptedParams()) {
+            writer.key(acceptedParam.first);
+            writer.stringValue(acceptedParam.second);
+        }
+
+        writer.endObject();
     }
 
-    AddNestedStructsAndEnums(obj, cls);
+    writer.key("dname");
+    writer.stringValue(implMethod.dname());
+    writer.key("docs");
+    WriteEntity(writer, implMethod.docs());
+    writer.endObject();
 }
 
-void to_json(json& obj, const Method& method)
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const InvokedMethod& invkMethod)
+{
+    writer.beginObject();
+    writer.key("dname");
+    writer.stringValue(invkMethod.dname());
+    writer.key("docs");
+    WriteEntity(writer, invkMethod.docs());
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Struct& structure)
 {
-    AddCommonEntityData(obj, method);
+    writer.beginObject();
+    WriteCommonEntityData(writer, structure);
+    WriteNestedEnums(writer, structure);
+    WriteNamed(writer, "fields", structure.fields());
+    writer.key("file");
+    writer.stringValue(structure.file().generic_string());
+    writer.key("isEncodable");
+    writer.boolValue(structure.isEncodable());
+    writer.key("isHashed");
+    writer.boolValue(structure.isHashed());
+    WriteName(writer, structure);
+    writer.key("package");
+    writer.stringValue(structure.package());
+    WriteNestedStructs(writer, structure, false);
+    writer.endObject();
+}
 
-    if (method.params()) {
-        obj[GetPredefinedStructName(StructTypeId::Method_Params)] = *method.params();
-    } else {
-        obj[GetPredefinedStructName(StructTypeId::Method_Params)] = nullptr;
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Field& field)
+{
+    const MapField* mapField =
+        field.fieldType() == FieldTypeId::Map ? static_cast<const MapField*>(&field) : nullptr;
+
+    writer.beginObject();
+    writer.key("defaultValue");
+    writer.stringValue(field.defaultValue());
+    WriteCommonEntityData(writer, field);
+    writer.key("fieldTypeName");
+    writer.stringValue(field.fieldTypeName());
+    writer.key("isHashed");
+    writer.boolValue(field.isHashed());
+    writer.key("isMap");
+    writer.boolValue(mapField != nullptr);
+    writer.key("isObservable");
+    writer.boolValue(field.isObservable());
+    writer.key("isOptional");
+    writer.boolValue(field.isOptional());
+    writer.key("isRepeated");
+    writer.boolValue(field.isRepeated());
+
+    if (mapField) {
+        writer.key("keyTypeName");
+        writer.stringValue(mapField->keyTypeName());
+    }
+
+    WriteName(writer, field);
+    writer.key("number");
+    writer.intValue(field.number());
+    writer.key("oneofName");
+    writer.stringValue(field.oneofName());
+
+    if (mapField) {
+        writer.key("valueTypeName");
+        writer.stringValue(mapField->valueTypeName());
     }
 
-    if (method.retval()) {
-        obj[GetPredefinedStructName(StructTypeId::Method_Retval)] = *method.retval();
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Enum& enumeration)
+{
+    writer.beginObject();
+    WriteNamed(writer, "constants", enumeration.constants());
+    WriteCommonEntityData(writer, enumeration);
+    writer.key("file");
+    writer.stringValue(enumeration.file().generic_string());
+    WriteName(writer, enumeration);
+    writer.key("package");
+    writer.stringValue(enumeration.package());
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const Constant& constant)
+{
+    writer.beginObject();
+    WriteCommonEntityData(writer, constant);
+    WriteName(writer, constant);
+    writer.key("value");
+    writer.intValue(constant.value());
+    writer.endObject();
+}
+
+template<typename TWriter>
+void WriteEntity(TWriter& writer, const EntityDocs& docs)
+{
+    writer.beginObject();
+    writer.key("brief");
+    writer.stringValue(docs.brief());
+    writer.key("commands");
+
+    if (docs.commands().empty()) {
+        writer.nullValue();
     } else {
-        obj[GetPredefinedStructName(StructTypeId::Method_Retval)] = nullptr;
+        writer.beginObject();
+
+        for (const auto& command: docs.commands()) {
+            writer.key(command.first);
+            WriteStrings(writer, command.second);
+        }
+
+        writer.endObject();
     }
 
-    obj["isStatic"] = method.isStatic();
-    obj["isOneway"] = method.isOneway();
-    obj["precondition"] = method.precondition();
-    obj["postcondition"] = method.postcondition();
+    writer.key("description");
+    WriteStrings(writer, docs.description());
+    writer.endObject();
+}
+
+// Render each entity from \a entities to string using \a jobs threads
+// If \a index is not null, each entity is rendered with it's own search index, which is merged to \a index afterwards
+template<typename TRender>
+std::vector<std::string>
+RenderInParallel(const std::vector<const Entity*>& entities, std::size_t jobs, SearchIndex* index, TRender render)
+{
+    std::vector<std::string> rendered(entities.size());
+    std::vector<SearchIndex> indices(index ? entities.size() : 0);
+
+    ThreadPool::Shared().parallelFor(entities.size(), jobs, [&](std::size_t i) {
+        std::ostringstream out;
+        render(out, *entities[i], index ? &indices[i] : nullptr);
+        rendered[i] = out.str();
+    });
+
+    for (auto& entityIndex: indices) {
+        index->merge(std::move(entityIndex));
+    }
 
-    AddNestedStructsAndEnums(obj, method);
+    return rendered;
 }
 
-void to_json(json& obj, const Implementation& implementation)
+// Render API namespaces and implementation services using \a jobs threads
+std::unordered_map<const Entity*, std::string>
+RenderSubtrees(const Project& project, std::size_t indent, std::size_t jobs, SearchIndex* index)
 {
-    AddCommonEntityData(obj, implementation);
-    obj["services"] = nullptr;
+    std::vector<const Entity*> subtrees = GetIndependentSubtrees(project);
+    auto rendered = RenderInParallel(
+        subtrees, jobs, index, [indent](std::ostream& out, const Entity& entity, SearchIndex* entityIndex) {
+            DocWriter writer(out, indent, Subtree_Depth, entityIndex);
 
-    for (const auto& service: implementation.services()) {
-        obj["services"][service->name()] = *service;
+            if (entity.type() == EntityTypeId::Namespace) {
+                WriteEntity(writer, static_cast<const Namespace&>(entity));
+            } else {
+                WriteEntity(writer, static_cast<const Service&>(entity));
+            }
+
+            writer.flush();
+        });
+
+    std::unordered_map<const Entity*, std::string> result;
+
+    for (std::size_t i = 0; i < subtrees.size(); ++i) {
+        result.emplace(subtrees[i], std::move(rendered[i]));
     }
 
-    AddNestedStructsAndEnums(obj, implementation);
+    return result;
 }
 
-void to_json(json& obj, const Service& service)
+// Return entities, which are written to separate shards, in the depth-first order
+std::vector<const Entity*> GetShardedEntities(const Project& project)
 {
-    AddCommonEntityData(obj, service);
+    std::vector<const Entity*> entities{&project};
 
-    if (service.config()) {
-        obj[GetPredefinedStructName(StructTypeId::Service_Config)] = *service.config();
-    } else {
-        obj[GetPredefinedStructName(StructTypeId::Service_Config)] = nullptr;
+    if (project.api()) {
+        entities.push_back(project.api());
+
+        for (const auto& ns: project.api()->namespaces()) {
+            entities.push_back(ns);
+
+            for (const auto& cls: ns->classes()) {
+                entities.push_back(cls);
+                entities.insert(entities.end(), cls->methods().begin(), cls->methods().end());
+            }
+        }
     }
 
-    obj["author"] = service.author();
-    obj["email"] = service.email();
-    obj["url"] = service.url();
+    if (project.implementation()) {
+        entities.push_back(project.implementation());
+        entities.insert(
+            entities.end(), project.implementation()->services().begin(), project.implementation()->services().end());
+    }
 
-    obj["implements"] = nullptr;
+    return entities;
+}
 
-    for (const auto& implMethod: service.implementedMethods()) {
-        obj["implements"][implMethod.dname()] = implMethod;
+void RenderShard(std::ostream& out, std::size_t indent, const Entity& entity, SearchIndex* index)
+{
+    ShardWriter writer(out, indent, entity, index);
+
+    switch (entity.type()) {
+    case EntityTypeId::Project: WriteEntity(writer, static_cast<const Project&>(entity)); break;
+    case EntityTypeId::Api: WriteEntity(writer, static_cast<const Api&>(entity)); break;
+    case EntityTypeId::Implementation: WriteEntity(writer, static_cast<const Implementation&>(entity)); break;
+    case EntityTypeId::Namespace: WriteEntity(writer, static_cast<const Namespace&>(entity)); break;
+    case EntityTypeId::Class: WriteEntity(writer, static_cast<const Class&>(entity)); break;
+    case EntityTypeId::Method: WriteEntity(writer, static_cast<const Method&>(entity)); break;
+    case EntityTypeId::Service: WriteEntity(writer, static_cast<const Service&>(entity)); break;
+    default: assert(false);
     }
 
-    obj["invokes"] = nullptr;
+    writer.flush();
+}
+
+void RenderShardsIndex(std::ostream& out, std::size_t indent, const Project& project, std::vector<const Entity*> entities)
+{
+    std::sort(entities.begin(), entities.end(), [](const Entity* lhs, const Entity* rhs) {
+        return lhs->dname() < rhs->dname();
+    });
+
+    JsonWriter writer(out, indent);
+    writer.beginObject();
+    writer.key("root");
+    writer.stringValue(project.dname());
+    writer.key("shards");
+    writer.beginObject();
+
+    for (const auto& entity: entities) {
+        writer.key(entity->dname());
+        writer.beginObject();
+        writer.key("brief");
+        writer.stringValue(entity->docs().brief());
+        writer.key("parent");
+
+        if (entity->parent()) {
+            writer.stringValue(entity->parent()->dname());
+        } else {
+            writer.nullValue();
+        }
 
-    for (const auto& invkMethod: service.invokedMethods()) {
-        obj["invokes"][invkMethod.dname()] = invkMethod;
+        writer.key("shard");
+        writer.stringValue(GetShardFile(*entity));
+        writer.key("type");
+        writer.stringValue(GetEntityTypeIdStr(entity->type()));
+        writer.endObject();
     }
 
-    AddNestedStructsAndEnums(obj, service);
+    writer.endObject();
+    writer.endObject();
+    writer.flush();
 }
 
-void to_json(json& obj, const ImplementedMethod& implMethod)
+template<typename TEntity>
+void ToJson(json& obj, const TEntity& entity)
 {
-    obj["dname"] = implMethod.dname();
-    obj["docs"] = implMethod.docs();
+    DomWriter writer(obj);
+    WriteEntity(writer, entity);
+}
+} // namespace
 
-    if (implMethod.acceptedObjectId()) {
-        obj["acceptedObjectId"] = *implMethod.acceptedObjectId();
+void JsonGenerator::generate(const Project& project) const
+{
+    // follow nlohmann::json convention: stream width specifies indentation and is reset after output
+    auto indent = out_.width() > 0 ? static_cast<std::size_t>(out_.width()) : 0;
+    out_.width(0);
+
+    if (jobs_ > 1) {
+        auto rendered = RenderSubtrees(project, indent, jobs_, index_);
+        StitchingWriter writer(out_, indent, rendered, index_);
+        WriteEntity(writer, project);
+        writer.flush();
+    } else {
+        DocWriter writer(out_, indent, 0, index_);
+        WriteEntity(writer, project);
+        writer.flush();
     }
+}
 
-    for (const auto& acceptedParam: implMethod.acceptedParams()) {
-        obj["acceptedParams"][acceptedParam.first] = acceptedParam.second;
+void CompactJsonGenerator::generate(const Project& project) const
+{
+    auto indent = out_.width() > 0 ? static_cast<std::size_t>(out_.width()) : 0;
+    out_.width(0);
+
+    JsonWriter writer(out_, indent);
+    CompactWriter compactWriter(writer, index_);
+
+    writer.beginObject();
+    writer.key("project");
+    WriteEntity(compactWriter, project);
+    writer.key("schema");
+    writer.stringValue(Compact_Json_Schema);
+    writer.key("strings");
+    writer.beginArray();
+
+    for (const auto& str: compactWriter.strings()) {
+        writer.stringValue(*str);
     }
+
+    writer.endArray();
+    writer.key("version");
+    writer.intValue(Compact_Json_Schema_Version);
+    writer.endObject();
+    writer.flush();
 }
 
-void to_json(json& obj, const InvokedMethod& invkMethod)
+void JsonShardsGenerator::generate(const Project& project) const
 {
-    obj["dname"] = invkMethod.dname();
-    obj["docs"] = invkMethod.docs();
+    auto entities = GetShardedEntities(project);
+
+    // shards are rendered in chunks to keep memory usage bounded
+    std::size_t chunkSize = std::max<std::size_t>(jobs_, 1) * 16;
+
+    for (std::size_t pos = 0; pos < entities.size(); pos += chunkSize) {
+        std::vector<const Entity*> chunk(entities.begin() + static_cast<std::ptrdiff_t>(pos),
+                                         entities.begin() + static_cast<std::ptrdiff_t>(
+                                                                std::min(pos + chunkSize, entities.size())));
+        auto rendered =
+            RenderInParallel(chunk, jobs_, index_, [this](std::ostream& out, const Entity& entity, SearchIndex* index) {
+                RenderShard(out, indent_, entity, index);
+            });
+
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            output_(GetShardFile(*chunk[i]), rendered[i]);
+        }
+    }
+
+    std::ostringstream index;
+    RenderShardsIndex(index, indent_, project, std::move(entities));
+    output_(Json_Doc_Index_File, index.str());
 }
 
-void to_json(json& obj, const Struct& structure)
+void to_json(json& obj, const Project& project)
 {
-    AddCommonEntityData(obj, structure);
+    ToJson(obj, project);
+}
 
-    obj["package"] = structure.package();
-    obj["file"] = structure.file().generic_string();
-    obj["isHashed"] = structure.isHashed();
-    obj["isEncodable"] = structure.isEncodable();
-    obj["fields"] = nullptr;
+void to_json(json& obj, const Api& api)
+{
+    ToJson(obj, api);
+}
 
-    for (const auto& field: structure.fields()) {
-        obj["fields"][field->name()] = *field;
-    }
+void to_json(json& obj, const Namespace& ns)
+{
+    ToJson(obj, ns);
+}
 
-    AddNestedStructsAndEnums(obj, structure, false);
+void to_json(json& obj, const Class& cls)
+{
+    ToJson(obj, cls);
 }
 
-void to_json(json& obj, const Field& field)
+void to_json(json& obj, const Method& method)
 {
-    AddCommonEntityData(obj, field);
+    ToJson(obj, method);
+}
 
-    obj["number"] = field.number();
-    obj["fieldTypeName"] = field.fieldTypeName();
-    obj["isOptional"] = field.isOptional();
-    obj["isRepeated"] = field.isRepeated();
-    obj["isObservable"] = field.isObservable();
-    obj["isHashed"] = field.isHashed();
-    obj["oneofName"] = field.oneofName();
-    obj["defaultValue"] = field.defaultValue();
-    obj["isMap"] = field.fieldType() == FieldTypeId::Map;
+void to_json(json& obj, const Implementation& implementation)
+{
+    ToJson(obj, implementation);
+}
 
-    if (field.fieldType() == FieldTypeId::Map) {
-        const auto& mapField = static_cast<const MapField&>(field);
+void to_json(json& obj, const Service& service)
+{
+    ToJson(obj, service);
+}
 
-        obj["keyTypeName"] = mapField.keyTypeName();
-        obj["valueTypeName"] = mapField.valueTypeName();
-    }
+void to_json(json& obj, const ImplementedMethod& implMethod)
+{
+    ToJson(obj, implMethod);
 }
 
-void to_json(json& obj, const Enum& enumeration)
+void to_json(json& obj, const InvokedMethod& invkMethod)
 {
-    AddCommonEntityData(obj, enumeration);
+    ToJson(obj, invkMethod);
+}
 
-    obj["package"] = enumeration.package();
-    obj["file"] = enumeration.file().generic_string();
-    obj["constants"] = nullptr;
+void to_json(json& obj, const Struct& structure)
+{
+    ToJson(obj, structure);
+}
 
-    for (const auto& constant: enumeration.constants()) {
-        obj["constants"][constant->name()] = *constant;
-    }
+void to_json(json& obj, const Field& field)
+{
+    ToJson(obj, field);
+}
+
+void to_json(json& obj, const Enum& enumeration)
+{
+    ToJson(obj, enumeration);
 }
 
 void to_json(json& obj, const Constant& constant)
 {
-    AddCommonEntityData(obj, constant);
-    obj["value"] = constant.value();
+    ToJson(obj, constant);
 }
 
 void to_json(json& obj, const EntityDocs& docs)
 {
-    obj["brief"] = docs.brief();
-    obj["description"] = docs.description();
-    obj["commands"] = nullptr;
-
-    for (const auto& command: docs.commands()) {
-        obj["commands"][command.first] = command.second;
-    }
+    ToJson(obj, docs);
 }
 } // namespace busrpc
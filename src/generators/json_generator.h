@@ -1,26 +1,108 @@
 #include "generators/generator.h"
+#include "generators/search_index.h"
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <ostream>
+#include <string>
 
 /// \file json_generator.h Generator, which outputs busrpc project documentation in the JSON format.
 
 namespace busrpc {
 
 /// Generator, which outputs a single JSON document containint busrpc project documentation.
+/// \note Document is written by the streaming \ref JsonWriter while the project is traversed, no intermediate JSON
+///       DOM is built. Output is byte-identical to the output of the \c nlohmann::json object created by the
+///       \c to_json functions below.
+/// \note Like \c nlohmann::json, generator outputs pretty-printed JSON if width of the output stream is set (width
+///       specifies indentation) and resets the width after the output.
 class JsonGenerator: public DocGenerator {
 public:
     /// Create JSON generator, which outputs generated JSON document to \a out.
-    /// \warning Stream \a out should outlive generator.
-    JsonGenerator(std::ostream& out): out_(out) { }
+    /// \note If \a jobs is greater than 1, API namespaces and implementation services are rendered in parallel by
+    ///       \a jobs threads and then written to \a out in the same order as by the single-threaded generator.
+    /// \note If \a index is not null, documented entities are added to it while the documentation is generated.
+    /// \warning Stream \a out and \a index should outlive generator.
+    JsonGenerator(std::ostream& out, std::size_t jobs = 1, SearchIndex* index = nullptr):
+        out_(out),
+        jobs_(jobs),
+        index_(index)
+    { }
 
     /// Generate and output JSON document containing busrpc project documentation.
+    /// \throw nlohmann::json::type_error if some project string is not a valid UTF-8 string.
     void generate(const Project& project) const override;
 
 private:
     std::ostream& out_;
+    std::size_t jobs_;
+    SearchIndex* index_;
+};
+
+/// Generator, which outputs a single JSON document containing busrpc project documentation in the compact schema.
+/// \note Document is an object with the following properties:
+///       - "project" - project documentation in the same layout as created by \ref JsonGenerator, except that object
+///         properties with empty values (null, empty string, array or object) are omitted and values of "dname",
+///         "dir", "package", "file", "fieldTypeName", "keyTypeName" and "valueTypeName" properties are replaced by
+///         indices in the string table;
+///       - "schema" - \ref Compact_Json_Schema;
+///       - "strings" - string table (array of strings);
+///       - "version" - \ref Compact_Json_Schema_Version.
+/// \note Like \c nlohmann::json, generator outputs pretty-printed JSON if width of the output stream is set (width
+///       specifies indentation) and resets the width after the output.
+class CompactJsonGenerator: public DocGenerator {
+public:
+    /// Create compact JSON generator, which outputs generated JSON document to \a out.
+    /// \note If \a index is not null, documented entities are added to it while the documentation is generated.
+    /// \warning Stream \a out and \a index should outlive generator.
+    CompactJsonGenerator(std::ostream& out, SearchIndex* index = nullptr): out_(out), index_(index) { }
+
+    /// Generate and output JSON document containing busrpc project documentation in the compact schema.
+    /// \throw nlohmann::json::type_error if some project string is not a valid UTF-8 string.
+    void generate(const Project& project) const override;
+
+private:
+    std::ostream& out_;
+    SearchIndex* index_;
+};
+
+/// Generator, which outputs busrpc project documentation as a set of JSON documents (shards).
+/// \note Project, API, implementation and each namespace, class, method and service are written to a separate shard
+///       named '<dname>.json'. Shard has the same layout as the JSON object created by \c to_json for the entity,
+///       except that nested entities with their own shards are replaced by links (objects with "brief", "dname" and
+///       "shard" properties).
+/// \note Generator also outputs an index document named \ref Json_Doc_Index_File. It maps dname of each sharded
+///       entity to the object with "brief", "parent", "shard" and "type" properties.
+class JsonShardsGenerator: public DocGenerator {
+public:
+    /// Function, which is called for each generated document with document file name and content.
+    using Output = std::function<void(const std::string& file, const std::string& content)>;
+
+    /// Create sharded JSON generator, which passes generated documents to \a output.
+    /// \note Documents are pretty-printed with \a indent spaces per nesting level (or compact if \a indent is 0).
+    /// \note If \a jobs is greater than 1, shards are rendered in parallel by \a jobs threads, however \a output is
+    ///       always called from the thread calling \ref generate and in the same order.
+    /// \note If \a index is not null, documented entities are added to it while the documentation is generated.
+    /// \warning Index \a index should outlive generator.
+    JsonShardsGenerator(Output output, std::size_t indent = 2, std::size_t jobs = 1, SearchIndex* index = nullptr):
+        output_(std::move(output)),
+        indent_(indent),
+        jobs_(jobs),
+        index_(index)
+    { }
+
+    /// Generate JSON documents containing busrpc project documentation.
+    /// \throw nlohmann::json::type_error if some project string is not a valid UTF-8 string.
+    void generate(const Project& project) const override;
+
+private:
+    Output output_;
+    std::size_t indent_;
+    std::size_t jobs_;
+    SearchIndex* index_;
 };
 
 /// Convert \ref Project to json.
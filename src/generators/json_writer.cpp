@@ -0,0 +1,253 @@
+#include "generators/json_writer.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cassert>
+#include <charconv>
+
+namespace busrpc {
+
+namespace {
+
+constexpr std::size_t Buffer_Size = 64 * 1024;
+constexpr char Hex_Digits[] = "0123456789abcdef";
+
+// Return length of the valid UTF-8 sequence starting at the beginning of \a str or 0 if sequence is invalid
+std::size_t GetUtf8SequenceLength(std::string_view str)
+{
+    auto byte = [&str](std::size_t i) { return static_cast<unsigned char>(str[i]); };
+    auto isContinuation = [&str, &byte](std::size_t i, unsigned char min = 0x80, unsigned char max = 0xBF) {
+        return i < str.size() && byte(i) >= min && byte(i) <= max;
+    };
+
+    unsigned char lead = byte(0);
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        return isContinuation(1) ? 2 : 0;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        unsigned char min = lead == 0xE0 ? 0xA0 : 0x80;
+        unsigned char max = lead == 0xED ? 0x9F : 0xBF;
+        return isContinuation(1, min, max) && isContinuation(2) ? 3 : 0;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        unsigned char min = lead == 0xF0 ? 0x90 : 0x80;
+        unsigned char max = lead == 0xF4 ? 0x8F : 0xBF;
+        return isContinuation(1, min, max) && isContinuation(2) && isContinuation(3) ? 4 : 0;
+    } else {
+        return 0;
+    }
+}
+} // namespace
+
+JsonWriter::JsonWriter(std::ostream& out, std::size_t indent, std::size_t depth):
+    out_(out),
+    indent_(indent),
+    depth_(depth)
+{
+    buffer_.reserve(Buffer_Size);
+}
+
+JsonWriter::~JsonWriter()
+{
+    try {
+        flush();
+    } catch (...) { }
+}
+
+void JsonWriter::beginObject()
+{
+    beginContainer(true, '{');
+}
+
+void JsonWriter::endObject()
+{
+    endContainer(true, '}');
+}
+
+void JsonWriter::beginArray()
+{
+    beginContainer(false, '[');
+}
+
+void JsonWriter::endArray()
+{
+    endContainer(false, ']');
+}
+
+void JsonWriter::key(std::string_view key)
+{
+    assert(!stack_.empty() && stack_.back().isObject && !hasKey_);
+
+    auto& frame = stack_.back();
+
+#ifndef NDEBUG
+    assert(frame.size == 0 || frame.lastKey < key);
+    frame.lastKey = key;
+#endif
+
+    if (frame.size++ != 0) {
+        write(',');
+    }
+
+    if (indent_ != 0) {
+        writeNewLine(depth_ + stack_.size());
+    }
+
+    write('"');
+    writeEscaped(key);
+    write(indent_ != 0 ? "\": " : "\":");
+    hasKey_ = true;
+}
+
+void JsonWriter::nullValue()
+{
+    beginValue();
+    write("null");
+}
+
+void JsonWriter::boolValue(bool value)
+{
+    beginValue();
+    write(value ? "true" : "false");
+}
+
+void JsonWriter::intValue(int64_t value)
+{
+    std::array<char, 24> str;
+    auto result = std::to_chars(str.data(), str.data() + str.size(), value);
+
+    beginValue();
+    write(std::string_view(str.data(), static_cast<std::size_t>(result.ptr - str.data())));
+}
+
+void JsonWriter::stringValue(std::string_view value)
+{
+    beginValue();
+    write('"');
+    writeEscaped(value);
+    write('"');
+}
+
+void JsonWriter::rawValue(std::string_view value)
+{
+    beginValue();
+    write(value);
+}
+
+void JsonWriter::flush()
+{
+    if (!buffer_.empty()) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+void JsonWriter::beginValue()
+{
+    if (stack_.empty()) {
+        return;
+    }
+
+    auto& frame = stack_.back();
+
+    if (frame.isObject) {
+        assert(hasKey_);
+        hasKey_ = false;
+        return;
+    }
+
+    if (frame.size++ != 0) {
+        write(',');
+    }
+
+    if (indent_ != 0) {
+        writeNewLine(depth_ + stack_.size());
+    }
+}
+
+void JsonWriter::beginContainer(bool isObject, char bracket)
+{
+    beginValue();
+    write(bracket);
+    stack_.push_back({});
+    stack_.back().isObject = isObject;
+}
+
+void JsonWriter::endContainer(bool isObject, char bracket)
+{
+    assert(!stack_.empty() && stack_.back().isObject == isObject && !hasKey_);
+    static_cast<void>(isObject);
+
+    if (stack_.back().size != 0 && indent_ != 0) {
+        writeNewLine(depth_ + stack_.size() - 1);
+    }
+
+    stack_.pop_back();
+    write(bracket);
+}
+
+void JsonWriter::writeNewLine(std::size_t depth)
+{
+    write('\n');
+    buffer_.append(depth * indent_, ' ');
+}
+
+void JsonWriter::writeEscaped(std::string_view str)
+{
+    for (std::size_t i = 0; i < str.size();) {
+        auto ch = static_cast<unsigned char>(str[i]);
+
+        if (ch >= 0x80) {
+            auto length = GetUtf8SequenceLength(str.substr(i));
+
+            if (length == 0) {
+                // let the JSON library report an error exactly as it's serializer does
+                static_cast<void>(nlohmann::json(std::string(str)).dump());
+                length = 1;
+            }
+
+            write(str.substr(i, length));
+            i += length;
+            continue;
+        }
+
+        switch (ch) {
+        case '\b': write("\\b"); break;
+        case '\t': write("\\t"); break;
+        case '\n': write("\\n"); break;
+        case '\f': write("\\f"); break;
+        case '\r': write("\\r"); break;
+        case '"': write("\\\""); break;
+        case '\\': write("\\\\"); break;
+        default:
+            if (ch <= 0x1F) {
+                write("\\u00");
+                write(Hex_Digits[ch >> 4]);
+                write(Hex_Digits[ch & 0x0F]);
+            } else {
+                write(static_cast<char>(ch));
+            }
+        }
+
+        ++i;
+    }
+}
+
+void JsonWriter::write(std::string_view str)
+{
+    buffer_.append(str);
+
+    if (buffer_.size() >= Buffer_Size) {
+        flush();
+    }
+}
+
+void JsonWriter::write(char ch)
+{
+    buffer_.push_back(ch);
+
+    if (buffer_.size() >= Buffer_Size) {
+        flush();
+    }
+}
+} // namespace busrpc
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \file json_writer.h Streaming JSON writer.
+
+namespace busrpc {
+
+/// Streaming JSON writer.
+/// \note Writer outputs JSON directly to the buffered stream without building intermediate DOM. It's memory usage
+///       is bounded by the nesting depth of the written document.
+/// \note Output is byte-identical to the output of the \c nlohmann::json serializer (with \c ensure_ascii disabled)
+///       for the same document, provided that object keys are written in ascending byte order (as \c nlohmann::json
+///       stores them). Key order is checked by the assertion in debug builds.
+class JsonWriter {
+public:
+    /// Create writer, which outputs JSON to \a out.
+    /// \note If \a indent is 0, compact JSON is written, otherwise each nesting level is indented by \a indent spaces.
+    /// \note Initial indentation of the output is \a depth nesting levels. This allows to write JSON, which is later
+    ///       inserted into another JSON document as a nested value.
+    /// \warning Stream \a out should outlive writer.
+    JsonWriter(std::ostream& out, std::size_t indent = 0, std::size_t depth = 0);
+
+    /// Flush buffered output (errors are ignored).
+    ~JsonWriter();
+
+    /// Begin JSON object.
+    void beginObject();
+
+    /// End JSON object.
+    void endObject();
+
+    /// Begin JSON array.
+    void beginArray();
+
+    /// End JSON array.
+    void endArray();
+
+    /// Write object key.
+    /// \note Next written value becomes the value of this key.
+    void key(std::string_view key);
+
+    /// Write \c null value.
+    void nullValue();
+
+    /// Write boolean value.
+    void boolValue(bool value);
+
+    /// Write integer value.
+    void intValue(int64_t value);
+
+    /// Write string value.
+    /// \throw nlohmann::json::type_error if \a value is not a valid UTF-8 string.
+    void stringValue(std::string_view value);
+
+    /// Write already serialized JSON \a value as is.
+    /// \note Value should be written with the same indentation settings and nesting depth as this writer.
+    void rawValue(std::string_view value);
+
+    /// Write buffered output to the stream.
+    void flush();
+
+private:
+    struct Frame {
+        bool isObject = false;
+        std::size_t size = 0;
+#ifndef NDEBUG
+        std::string lastKey;
+#endif
+    };
+
+    void beginValue();
+    void beginContainer(bool isObject, char bracket);
+    void endContainer(bool isObject, char bracket);
+    void writeNewLine(std::size_t depth);
+    void writeEscaped(std::string_view str);
+    void write(std::string_view str);
+    void write(char ch);
+
+    std::ostream& out_;
+    std::size_t indent_;
+    std::size_t depth_;
+    std::vector<Frame> stack_;
+    bool hasKey_ = false;
+    std::string buffer_;
+};
+} // namespace busrpc
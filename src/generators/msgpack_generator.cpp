@@ -0,0 +1,15 @@
+#include "generators/msgpack_generator.h"
+#include "generators/json_generator.h"
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace busrpc {
+
+void MsgPackGenerator::generate(const Project& project) const
+{
+    json doc = project;
+    json::to_msgpack(doc, out_);
+}
+} // namespace busrpc
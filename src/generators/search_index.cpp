@@ -0,0 +1,231 @@
+#include "generators/search_index.h"
+#include "constants.h"
+#include "generators/json_writer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace busrpc {
+
+namespace {
+
+bool IsTokenChar(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+           static_cast<unsigned char>(ch) >= 0x80;
+}
+
+bool IsUpper(char ch)
+{
+    return ch >= 'A' && ch <= 'Z';
+}
+
+bool IsLower(char ch)
+{
+    return ch >= 'a' && ch <= 'z';
+}
+
+std::string ToLower(std::string_view str)
+{
+    std::string result(str);
+
+    for (auto& ch: result) {
+        if (IsUpper(ch)) {
+            ch = static_cast<char>(ch - 'A' + 'a');
+        }
+    }
+
+    return result;
+}
+
+// Add lower-case \a word and it's camel-case parts (if any) to \a tokens
+void AddWordTokens(std::string_view word, std::vector<std::string>& tokens)
+{
+    tokens.push_back(ToLower(word));
+    std::size_t start = 0;
+
+    for (std::size_t i = 1; i < word.size(); ++i) {
+        // part boundary is either "aB" or "ABc" (the latter is needed to split abbreviations, like "HTTPServer")
+        bool isBoundary = IsUpper(word[i]) && (!IsUpper(word[i - 1]) || (i + 1 < word.size() && IsLower(word[i + 1])));
+
+        if (isBoundary) {
+            tokens.push_back(ToLower(word.substr(start, i - start)));
+            start = i;
+        }
+    }
+
+    if (start != 0) {
+        tokens.push_back(ToLower(word.substr(start)));
+    }
+}
+} // namespace
+
+void SearchIndex::add(const Entity& entity)
+{
+    auto id = entities_.size();
+    entities_.push_back(entity.dname());
+
+    // entity name is the last part of the dname, so it is not indexed separately
+    addTokens(entity.dname(), id);
+
+    // brief description is the first line of the description, so it is indexed below
+    for (const auto& line: entity.docs().description()) {
+        addTokens(line, id);
+    }
+}
+
+void SearchIndex::merge(SearchIndex&& other)
+{
+    auto offset = entities_.size();
+    entities_.insert(entities_.end(),
+                     std::make_move_iterator(other.entities_.begin()),
+                     std::make_move_iterator(other.entities_.end()));
+
+    for (auto& [token, ids]: other.postings_) {
+        auto& postings = postings_[token];
+
+        for (auto id: ids) {
+            postings.push_back(id + offset);
+        }
+    }
+
+    other.entities_.clear();
+    other.postings_.clear();
+}
+
+std::vector<std::string> SearchIndex::find(std::string_view prefix) const
+{
+    auto lowerPrefix = ToLower(prefix);
+    auto sortedPostings = getSortedPostings();
+    auto it = std::lower_bound(
+        sortedPostings.begin(), sortedPostings.end(), lowerPrefix, [](const auto* entry, const std::string& value) {
+            return entry->first < value;
+        });
+    std::vector<std::string> result;
+
+    for (; it != sortedPostings.end() && (*it)->first.compare(0, lowerPrefix.size(), lowerPrefix) == 0; ++it) {
+        for (auto id: (*it)->second) {
+            result.push_back(entities_[id]);
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void SearchIndex::write(std::ostream& out) const
+{
+    auto indent = out.width() > 0 ? static_cast<std::size_t>(out.width()) : 0;
+    out.width(0);
+
+    // ids are assigned in the dname order to make output independent of the order in which entities were added
+    std::vector<std::size_t> order(entities_.size());
+    std::vector<std::size_t> ids(entities_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return entities_[lhs] < entities_[rhs];
+    });
+
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        ids[order[i]] = i;
+    }
+
+    auto sortedPostings = getSortedPostings();
+    JsonWriter writer(out, indent);
+    writer.beginObject();
+    writer.key("entities");
+    writer.beginArray();
+
+    for (auto pos: order) {
+        writer.stringValue(entities_[pos]);
+    }
+
+    writer.endArray();
+    writer.key("postings");
+    writer.beginArray();
+
+    for (const auto* entry: sortedPostings) {
+        const auto& postings = entry->second;
+        std::vector<std::size_t> tokenIds;
+        tokenIds.reserve(postings.size());
+        std::transform(postings.begin(), postings.end(), std::back_inserter(tokenIds), [&ids](std::size_t id) {
+            return ids[id];
+        });
+        std::sort(tokenIds.begin(), tokenIds.end());
+        writer.beginArray();
+
+        for (auto id: tokenIds) {
+            writer.intValue(static_cast<int64_t>(id));
+        }
+
+        writer.endArray();
+    }
+
+    writer.endArray();
+    writer.key("schema");
+    writer.stringValue(Search_Index_Schema);
+    writer.key("tokens");
+    writer.beginArray();
+
+    for (const auto* entry: sortedPostings) {
+        writer.stringValue(entry->first);
+    }
+
+    writer.endArray();
+    writer.key("version");
+    writer.intValue(Search_Index_Schema_Version);
+    writer.endObject();
+    writer.flush();
+}
+
+std::vector<std::string> SearchIndex::Tokenize(std::string_view text)
+{
+    std::vector<std::string> tokens;
+
+    for (std::size_t pos = 0; pos < text.size();) {
+        if (!IsTokenChar(text[pos])) {
+            ++pos;
+            continue;
+        }
+
+        auto end = pos;
+
+        while (end < text.size() && IsTokenChar(text[end])) {
+            ++end;
+        }
+
+        AddWordTokens(text.substr(pos, end - pos), tokens);
+        pos = end;
+    }
+
+    return tokens;
+}
+
+void SearchIndex::addTokens(std::string_view text, std::size_t id)
+{
+    for (auto& token: Tokenize(text)) {
+        auto& postings = postings_[std::move(token)];
+
+        // entity tokens are added in a row, so checking the last id is enough to avoid duplicates
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+}
+
+std::vector<const SearchIndex::Postings::value_type*> SearchIndex::getSortedPostings() const
+{
+    // index is built using hash table, because tokens are sorted only when index is searched or written
+    std::vector<const Postings::value_type*> result;
+    result.reserve(postings_.size());
+
+    for (const auto& entry: postings_) {
+        result.push_back(&entry);
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+    return result;
+}
+} // namespace busrpc
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "entities/entity.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// \file search_index.h Inverted search index of the busrpc project documentation.
+
+namespace busrpc {
+
+/// Inverted index, which maps tokens of the entity dname and documentation to the entities.
+/// \note Entities are added by the documentation generators while project is traversed (see \ref JsonGenerator and
+///       \ref JsonShardsGenerator), so the index does not require separate traversal.
+/// \note Token is a maximal sequence of ASCII letters, digits and non-ASCII characters converted to the lower case.
+///       Additionally, each part of the camel-case token (for example, "my" and "struct" for "MyStruct") is a token.
+class SearchIndex {
+public:
+    /// Add \a entity to the index.
+    void add(const Entity& entity);
+
+    /// Add all entities from the \a other index to this index.
+    void merge(SearchIndex&& other);
+
+    /// Return dnames of the entities with a token starting with \a prefix in ascending order.
+    /// \note Prefix is converted to the lower case (only ASCII letters).
+    std::vector<std::string> find(std::string_view prefix) const;
+
+    /// Number of entities in the index.
+    std::size_t size() const noexcept { return entities_.size(); }
+
+    /// Output index as a JSON document.
+    /// \note Document is an object with the following properties:
+    ///       - "entities" - array of dnames of the indexed entities sorted in ascending order (entity id is an index
+    ///         in this array);
+    ///       - "postings" - array of the same size as "tokens", which contains array of ids of the entities with
+    ///         the corresponding token;
+    ///       - "schema" - \ref Search_Index_Schema;
+    ///       - "tokens" - array of tokens sorted in ascending byte order (allows prefix lookup by binary search);
+    ///       - "version" - \ref Search_Index_Schema_Version.
+    /// \note Output does not depend on the order in which entities were added. Like \c nlohmann::json, method outputs
+    ///       pretty-printed JSON if width of the output stream is set (width specifies indentation) and resets the
+    ///       width after the output.
+    /// \throw nlohmann::json::type_error if some token or dname is not a valid UTF-8 string.
+    void write(std::ostream& out) const;
+
+    /// Split \a text to tokens.
+    static std::vector<std::string> Tokenize(std::string_view text);
+
+private:
+    using Postings = std::unordered_map<std::string, std::vector<std::size_t>>;
+
+    void addTokens(std::string_view text, std::size_t id);
+    std::vector<const Postings::value_type*> getSortedPostings() const;
+
+    std::vector<std::string> entities_;
+    Postings postings_;
+};
+} // namespace busrpc
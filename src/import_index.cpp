@@ -0,0 +1,152 @@
+#include "import_index.h"
+#include "configure.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace busrpc {
+
+namespace {
+
+constexpr const char* Version_Key = "version";
+constexpr const char* Files_Key = "files";
+constexpr const char* Stamp_Key = "stamp";
+constexpr const char* Imports_Key = "imports";
+} // namespace
+
+const ImportIndex::Imports* ImportIndex::find(const std::string& file, uint64_t stamp)
+{
+    auto it = entries_.find(file);
+
+    if (it == entries_.end() || it->second.stamp != stamp) {
+        ++misses_;
+        return nullptr;
+    }
+
+    ++hits_;
+    used_.insert(file);
+    return &it->second.imports;
+}
+
+const ImportIndex::Imports& ImportIndex::store(const std::string& file, uint64_t stamp, Imports imports)
+{
+    auto& entry = entries_[file];
+    entry = {stamp, std::move(imports)};
+    used_.insert(file);
+    isImportersValid_ = false;
+    return entry.imports;
+}
+
+std::set<std::string> ImportIndex::findImporters(const std::set<std::string>& files) const
+{
+    if (!isImportersValid_) {
+        importers_.clear();
+
+        for (const auto& [file, entry]: entries_) {
+            for (const auto& import: entry.imports) {
+                importers_[import].insert(file);
+            }
+        }
+
+        isImportersValid_ = true;
+    }
+
+    std::set<std::string> result(files.begin(), files.end());
+    std::vector<std::string> pending(files.begin(), files.end());
+
+    while (!pending.empty()) {
+        auto it = importers_.find(pending.back());
+        pending.pop_back();
+
+        if (it != importers_.end()) {
+            for (const auto& importer: it->second) {
+                if (result.insert(importer).second) {
+                    pending.push_back(importer);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+bool ImportIndex::load(const std::filesystem::path& file)
+{
+    entries_.clear();
+    used_.clear();
+    isImportersValid_ = false;
+
+    std::ifstream in(file);
+
+    if (!in.is_open()) {
+        return false;
+    }
+
+    json doc = json::parse(in, nullptr, false);
+
+    if (!doc.is_object() || doc.value(Version_Key, "") != BUSRPC_VERSION || !doc[Files_Key].is_object()) {
+        return false;
+    }
+
+    std::map<std::string, Entry> entries;
+
+    for (const auto& [key, value]: doc[Files_Key].items()) {
+        if (!value.is_object() || !value[Stamp_Key].is_string() || !value[Imports_Key].is_array()) {
+            return false;
+        }
+
+        Imports imports;
+
+        for (const auto& import: value[Imports_Key]) {
+            if (!import.is_string()) {
+                return false;
+            }
+
+            imports.insert(import.get<std::string>());
+        }
+
+        try {
+            uint64_t stamp = std::stoull(value[Stamp_Key].get<std::string>(), nullptr, 16);
+            entries.emplace(key, Entry{stamp, std::move(imports)});
+        } catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    entries_ = std::move(entries);
+    return true;
+}
+
+bool ImportIndex::save(const std::filesystem::path& file) const
+{
+    json doc;
+    doc[Version_Key] = BUSRPC_VERSION;
+    doc[Files_Key] = json::object();
+
+    for (const auto& [name, entry]: entries_) {
+        if (used_.count(name)) {
+            doc[Files_Key][name] = {{Stamp_Key, HashToString(entry.stamp)}, {Imports_Key, entry.imports}};
+        }
+    }
+
+    std::ofstream out(file);
+    out << doc;
+    return static_cast<bool>(out);
+}
+
+uint64_t ImportIndex::GetStamp(const std::filesystem::path& file)
+{
+    auto modificationTime = std::filesystem::last_write_time(file).time_since_epoch().count();
+
+    return StableHash()
+        .update(static_cast<uint64_t>(std::filesystem::file_size(file)))
+        .update(static_cast<uint64_t>(modificationTime))
+        .value();
+}
+} // namespace busrpc
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+
+/// \file import_index.h Persistent index of the project import graph.
+
+namespace busrpc {
+
+/// Index of the project import graph.
+/// \note Index maps each project file to the files directly imported by it and to the file stamp (see \ref GetStamp)
+///       at the moment when imports were read. If file does not change between two command invocations, it's imports
+///       are taken from the index instead of reading the file again.
+/// \note Index is not thread-safe.
+class ImportIndex {
+public:
+    /// Files directly imported by the project file.
+    using Imports = std::set<std::string>;
+
+    /// Return imports of the \a file cached with the specified \a stamp or \c nullptr if file is not indexed or was
+    /// changed since it was indexed.
+    /// \note Method marks found entry as used (only used entries are saved by \ref save method).
+    const Imports* find(const std::string& file, uint64_t stamp);
+
+    /// Store \a imports of the \a file with the specified \a stamp and return stored imports.
+    /// \note Stored entry is marked as used.
+    const Imports& store(const std::string& file, uint64_t stamp, Imports imports);
+
+    /// Return all indexed files, which directly or indirectly import any of the \a files, including \a files
+    /// themselves.
+    /// \note Reverse adjacency list is built by the first call and reused by subsequent calls until index is changed.
+    std::set<std::string> findImporters(const std::set<std::string>& files) const;
+
+    /// Load index from the \a file.
+    /// \note Returns \c false and leaves index empty if file does not exist, can't be parsed or was created by
+    ///       another version of the development tool.
+    bool load(const std::filesystem::path& file);
+
+    /// Save index to the \a file.
+    /// \note Only entries, which were used since the index was loaded, are saved. This removes deleted files from the
+    ///       index.
+    /// \note Returns \c false if file can't be written.
+    bool save(const std::filesystem::path& file) const;
+
+    /// Number of files, which imports were found in the index.
+    std::size_t hits() const noexcept { return hits_; }
+
+    /// Number of files, which imports were not found in the index.
+    std::size_t misses() const noexcept { return misses_; }
+
+    /// Number of index entries.
+    std::size_t size() const noexcept { return entries_.size(); }
+
+    /// Calculate stamp of the \a file from it's size and last modification time.
+    /// \throw std::filesystem::filesystem_error if file attributes can't be read.
+    static uint64_t GetStamp(const std::filesystem::path& file);
+
+private:
+    struct Entry {
+        uint64_t stamp;
+        Imports imports;
+    };
+
+    std::map<std::string, Entry> entries_;
+    std::unordered_set<std::string> used_;
+    mutable std::map<std::string, std::set<std::string>> importers_;
+    mutable bool isImportersValid_ = false;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+} // namespace busrpc
@@ -1,5 +1,6 @@
 #include "parser/parser.h"
 #include "protobuf_error_collector.h"
+#include "protobuf_importer.h"
 #include "utils.h"
 
 #ifdef _MSC_VER
@@ -16,6 +17,7 @@
 
 #include <google/protobuf/compiler/importer.h>
 #include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
 #ifdef _MSC_VER
@@ -24,7 +26,12 @@
 #    pragma GCC diagnostic pop
 #endif
 
-#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 
 namespace protobuf = google::protobuf;
 
@@ -42,57 +49,187 @@ public:
         case ParserErrc::Invalid_Project_Dir: return "Directory does not represent a valid busrpc project directory.";
         case ParserErrc::Read_Failed: return "Failed to read file";
         case ParserErrc::Protobuf_Error: return "Protobuf error";
+        case ParserErrc::Invalid_Scope: return "Invalid parsing scope";
         default: return "Unknown error";
         }
     }
 };
 
-Enum* CreateEnum(GeneralCompositeEntity* entity,
-                 const std::string& name,
-                 const std::string& filename,
-                 const std::string& blockComment)
+EntityResult<Enum> CreateEnum(GeneralCompositeEntity* entity,
+                              const std::string& name,
+                              const std::string& filename,
+                              const std::string& blockComment)
 {
     switch (entity->type()) {
-    case EntityTypeId::Project: return static_cast<Project*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
-    case EntityTypeId::Api: return static_cast<Api*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Project:
+        return static_cast<Project*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Api: return static_cast<Api*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
     case EntityTypeId::Namespace:
-        return static_cast<Namespace*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
-    case EntityTypeId::Class: return static_cast<Class*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
-    case EntityTypeId::Method: return static_cast<Method*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
+        return static_cast<Namespace*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Class:
+        return static_cast<Class*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Method:
+        return static_cast<Method*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
     case EntityTypeId::Implementation:
-        return static_cast<Implementation*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
-    case EntityTypeId::Service: return static_cast<Service*>(entity)->addEnum(name, filename, EntityDocs(blockComment));
-    case EntityTypeId::Struct: return static_cast<Struct*>(entity)->addEnum(name, EntityDocs(blockComment));
+        return static_cast<Implementation*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Service:
+        return static_cast<Service*>(entity)->tryAddEnum(name, filename, EntityDocs(blockComment));
+    case EntityTypeId::Struct: return static_cast<Struct*>(entity)->tryAddEnum(name, EntityDocs(blockComment));
     default: return nullptr;
     }
 }
 
-Struct* CreateStruct(GeneralCompositeEntity* entity,
-                     const std::string& name,
-                     const std::string& filename,
-                     StructFlags flags,
-                     const std::string& blockComment)
+EntityResult<Struct> CreateStruct(GeneralCompositeEntity* entity,
+                                  const std::string& name,
+                                  const std::string& filename,
+                                  StructFlags flags,
+                                  const std::string& blockComment)
 {
     switch (entity->type()) {
     case EntityTypeId::Project:
-        return static_cast<Project*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Project*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Api:
-        return static_cast<Api*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Api*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Namespace:
-        return static_cast<Namespace*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Namespace*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Class:
-        return static_cast<Class*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Class*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Method:
-        return static_cast<Method*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Method*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Implementation:
-        return static_cast<Implementation*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
+        return static_cast<Implementation*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
     case EntityTypeId::Service:
-        return static_cast<Service*>(entity)->addStruct(name, filename, flags, EntityDocs(blockComment));
-    case EntityTypeId::Struct: return static_cast<Struct*>(entity)->addStruct(name, flags, EntityDocs(blockComment));
+        return static_cast<Service*>(entity)->tryAddStruct(name, filename, flags, EntityDocs(blockComment));
+    case EntityTypeId::Struct:
+        return static_cast<Struct*>(entity)->tryAddStruct(name, flags, EntityDocs(blockComment));
     default: return nullptr;
     }
 }
 
+// Add error explaining why nested entity 'name' could not be added to the 'entity'
+void AddNestedEntityError(ErrorCollector& ecol, const Entity* entity, const std::string& name, std::error_code ec)
+{
+    ErrorCollector::ErrorLocation location{.entity = entity->dname()};
+
+    if (ec == EntityErrc::Name_Conflict) {
+        ecol.add(location,
+                 SpecErrc::Multiple_Definitions,
+                 std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
+                 "nested entity '" + name + "' is defined more than once");
+    } else {
+        ecol.add(location,
+                 SpecErrc::Invalid_Entity,
+                 std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
+                 "failed to create nested entity '" + name + "' (" + ec.message() + ")");
+    }
+}
+
+// Input stream, which owns the data it reads from
+class StringInputStream: public protobuf::io::ZeroCopyInputStream {
+public:
+    explicit StringInputStream(std::string data):
+        data_(std::move(data)),
+        stream_(data_.data(), static_cast<int>(data_.size()))
+    { }
+
+    bool Next(const void** data, int* size) override { return stream_.Next(data, size); }
+    void BackUp(int count) override { stream_.BackUp(count); }
+    bool Skip(int count) override { return stream_.Skip(count); }
+    int64_t ByteCount() const override { return stream_.ByteCount(); }
+
+private:
+    std::string data_;
+    protobuf::io::ArrayInputStream stream_;
+};
+
+// Project source, which takes file content from the parser overlay and falls back to the underlying source if file is
+// not found in the overlay
+// Overlay files, which do not exist in the underlying source (for example, unsaved editor buffers), are added to the
+// source together with their parent directories
+class OverlayProjectSource: public ProjectSource {
+public:
+    OverlayProjectSource(std::shared_ptr<const ProjectSource> source,
+                         const std::map<std::string, std::string>& overlay):
+        source_(std::move(source)),
+        overlay_(overlay)
+    { }
+
+    bool isFile(const std::filesystem::path& file) const override
+    {
+        return overlay_.find(file.generic_string()) != overlay_.end() || source_->isFile(file);
+    }
+
+    std::optional<std::string> read(const std::filesystem::path& file) const override
+    {
+        if (auto it = overlay_.find(file.generic_string()); it != overlay_.end()) {
+            return it->second;
+        }
+
+        return source_->read(file);
+    }
+
+    bool list(const std::filesystem::path& dir,
+              std::vector<std::string>& files,
+              std::vector<std::string>& subdirs) const override
+    {
+        bool result = source_->list(dir, files, subdirs);
+        std::string prefix = dir.empty() ? std::string{} : dir.generic_string() + "/";
+
+        // overlay is ordered by path, so files of the directory and it's subdirectories are placed contiguously
+        for (auto it = overlay_.lower_bound(prefix); it != overlay_.end() && it->first.starts_with(prefix); ++it) {
+            std::string name = it->first.substr(prefix.size());
+            auto pos = name.find('/');
+            auto& names = pos == std::string::npos ? files : subdirs;
+            name.resize(std::min(pos, name.size()));
+
+            if (!name.empty() && std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(std::move(name));
+            }
+
+            result = true;
+        }
+
+        return result;
+    }
+
+private:
+    std::shared_ptr<const ProjectSource> source_;
+    const std::map<std::string, std::string>& overlay_;
+};
+
+// Source tree, which takes file content from the project source and falls back to the built-in files source tree if
+// file is not found
+class ProjectSourceTree: public protobuf::compiler::SourceTree {
+public:
+    ProjectSourceTree(const ProjectSource& source, protobuf::compiler::SourceTree* builtinTree):
+        source_(source),
+        builtinTree_(builtinTree)
+    { }
+
+    protobuf::io::ZeroCopyInputStream* Open(const std::string& filename) override
+    {
+        isFound_ = true;
+
+        if (auto content = source_.read(filename)) {
+            return new StringInputStream(std::move(*content));
+        }
+
+        auto result = builtinTree_->Open(filename);
+        isFound_ = result != nullptr;
+        return result;
+    }
+
+    std::string GetLastErrorMessage() override
+    {
+        return isFound_ ? builtinTree_->GetLastErrorMessage() : "File not found.";
+    }
+
+private:
+    const ProjectSource& source_;
+    protobuf::compiler::SourceTree* builtinTree_;
+    bool isFound_ = true;
+};
+
 std::optional<FieldTypeId> ToBusrpcType(int protobufType)
 {
     switch (protobufType) {
@@ -129,9 +266,220 @@ const TDescriptorProto* FindDescriptorProto(const protobuf::RepeatedPtrField<TDe
 
     return nullptr;
 }
+
+// Append location path of the entity described by the descriptor to the path (see 'SourceCodeInfo' message in the
+// 'google/protobuf/descriptor.proto')
+void AppendLocationPath(const protobuf::Descriptor* desc, std::vector<int>& path)
+{
+    if (desc->containing_type()) {
+        AppendLocationPath(desc->containing_type(), path);
+        path.push_back(protobuf::DescriptorProto::kNestedTypeFieldNumber);
+    } else {
+        path.push_back(protobuf::FileDescriptorProto::kMessageTypeFieldNumber);
+    }
+
+    path.push_back(desc->index());
+}
+
+void AppendLocationPath(const protobuf::EnumDescriptor* desc, std::vector<int>& path)
+{
+    if (desc->containing_type()) {
+        AppendLocationPath(desc->containing_type(), path);
+        path.push_back(protobuf::DescriptorProto::kEnumTypeFieldNumber);
+    } else {
+        path.push_back(protobuf::FileDescriptorProto::kEnumTypeFieldNumber);
+    }
+
+    path.push_back(desc->index());
+}
+
+void AppendLocationPath(const protobuf::FieldDescriptor* desc, std::vector<int>& path)
+{
+    AppendLocationPath(desc->containing_type(), path);
+    path.push_back(protobuf::DescriptorProto::kFieldFieldNumber);
+    path.push_back(desc->index());
+}
+
+void AppendLocationPath(const protobuf::EnumValueDescriptor* desc, std::vector<int>& path)
+{
+    AppendLocationPath(desc->type(), path);
+    path.push_back(protobuf::EnumDescriptorProto::kValueFieldNumber);
+    path.push_back(desc->index());
+}
+
+// Return true if directory is part of the busrpc project directory layout
+bool IsLayoutDir(const std::filesystem::path& dir)
+{
+    auto depth = std::distance(dir.begin(), dir.end());
+
+    if (dir.empty()) {
+        return true;
+    } else if (*dir.begin() == Api_Entity_Name) {
+        return depth <= 4;
+    } else if (*dir.begin() == Implementation_Entity_Name) {
+        return depth <= 2;
+    } else {
+        return false;
+    }
+}
+
+// Return name of the descriptor file of the entity represented by the directory (empty if entity has no descriptor)
+std::string GetDescriptorFile(const std::filesystem::path& dir)
+{
+    auto depth = std::distance(dir.begin(), dir.end());
+
+    if (dir.empty() || depth < 2) {
+        return {};
+    } else if (*dir.begin() == Api_Entity_Name) {
+        switch (depth) {
+        case 2: return Namespace_Desc_File;
+        case 3: return Class_Desc_File;
+        case 4: return Method_Desc_File;
+        default: return {};
+        }
+    } else if (*dir.begin() == Implementation_Entity_Name && depth == 2) {
+        return Service_Desc_File;
+    } else {
+        return {};
+    }
+}
+
+// Return true if path denotes directory or file nested in it
+bool IsWithinDir(const std::string& path, const std::string& dir)
+{
+    return dir.empty() ||
+           (path.compare(0, dir.size(), dir) == 0 && (path.size() == dir.size() || path[dir.size()] == '/'));
+}
+
+// Return true if directory does not belong to any namespace or service
+bool IsProjectLevelDir(const std::filesystem::path& dir)
+{
+    return std::distance(dir.begin(), dir.end()) < 2 ||
+           (*dir.begin() != Api_Entity_Name && *dir.begin() != Implementation_Entity_Name);
+}
+
+// Return index of the shard, which entity with the specified distinguished name belongs to
+std::size_t GetShardIndex(const std::string& dname, std::size_t shardCount)
+{
+    return static_cast<std::size_t>(StableHash().update(dname).value() % shardCount);
+}
+
+// Return index of the shard owning the file with the specified path relative to the project directory (shard of the
+// namespace or service containing the file or the first shard for other files)
+std::size_t GetFileShardIndex(const std::string& projectDname,
+                              const std::filesystem::path& file,
+                              std::size_t shardCount)
+{
+    std::vector<std::string> parts;
+
+    for (const auto& part: file) {
+        parts.push_back(part.string());
+    }
+
+    if (parts.size() < 3 || (parts[0] != Api_Entity_Name && parts[0] != Implementation_Entity_Name)) {
+        return 0;
+    }
+
+    return GetShardIndex(projectDname + "." + parts[0] + "." + parts[1], shardCount);
+}
+
+// Append files with '.proto' extension found in the directory (and it's nested layout directories if recursive flag
+// is set) to files
+void CollectProtoFiles(const ProjectSource& source,
+                       const std::filesystem::path& dir,
+                       bool isRecursive,
+                       std::vector<std::string>& files)
+{
+    std::vector<std::string> dirFiles;
+    std::vector<std::string> subdirs;
+    source.list(dir, dirFiles, subdirs);
+
+    for (const auto& file: dirFiles) {
+        if (std::filesystem::path(file).extension() == ".proto") {
+            files.push_back((dir / file).generic_string());
+        }
+    }
+
+    for (const auto& subdir: subdirs) {
+        if (isRecursive && IsLayoutDir(dir / subdir)) {
+            CollectProtoFiles(source, dir / subdir, true, files);
+        }
+    }
+}
 } // namespace
 
-std::pair<ProjectPtr, ErrorCollector> Parser::parse(std::vector<const std::error_category*> ignoredCategories) const
+// Part of the project, which should be parsed
+struct Parser::Scope {
+    // Return true if all files of the directory should be parsed
+    bool contains(const std::filesystem::path& dir) const
+    {
+        if (hasProjectLevel && IsProjectLevelDir(dir)) {
+            return true;
+        }
+
+        std::string path = dir.generic_string();
+        return std::any_of(roots.begin(), roots.end(), [&path](const auto& root) { return IsWithinDir(path, root); });
+    }
+
+    // directories, which are parsed entirely
+    std::vector<std::string> roots;
+
+    // flag indicating whether files not belonging to any namespace or service are parsed entirely
+    bool hasProjectLevel = false;
+
+    // other project files, which should be parsed
+    std::set<std::string> files;
+
+    // other directories, which contain files to be parsed
+    std::set<std::string> dirs;
+};
+
+// Leading comments of the entities defined in the parsed file
+// Comments are taken from the file descriptor proto instead of the descriptor pool, which does not store source code
+// info to save memory
+struct Parser::Comments {
+    Comments(const protobuf::SourceCodeInfo& sourceInfo, bool isLeanProfile):
+        info(sourceInfo),
+        isLean(isLeanProfile)
+    { }
+
+    // Return leading comments of the entity described by the descriptor
+    // If lean profile is used, empty string is returned unless comments are required by the project check
+    template<typename TDescriptor>
+    std::string find(const TDescriptor* desc, bool isRequired = false) const
+    {
+        if (isLean && !isRequired) {
+            return {};
+        }
+
+        if (!isIndexed) {
+            for (const auto& location: info.location()) {
+                // first location wins if there are several locations with the same path (as in the descriptor pool)
+                locations.emplace(std::vector<int>(location.path().begin(), location.path().end()),
+                                  &location.leading_comments());
+            }
+
+            isIndexed = true;
+        }
+
+        std::vector<int> path;
+        AppendLocationPath(desc, path);
+        auto it = locations.find(path);
+        return it != locations.end() ? *it->second : std::string();
+    }
+
+    const protobuf::SourceCodeInfo& info;
+    bool isLean;
+
+    // locations are indexed when comments are requested for the first time
+    mutable std::map<std::vector<int>, const std::string*> locations;
+    mutable bool isIndexed = false;
+};
+
+std::pair<ProjectPtr, ErrorCollector> Parser::parse(std::vector<const std::error_category*> ignoredCategories,
+                                                    CheckCache* cache,
+                                                    const std::string& scope,
+                                                    ParserShard shard) const
 {
     SeverityOrder orderFunc = [](std::error_code lhs, std::error_code rhs) {
         if (lhs.category() == rhs.category()) {
@@ -154,76 +502,233 @@ std::pair<ProjectPtr, ErrorCollector> Parser::parse(std::vector<const std::error
     };
 
     ErrorCollector ecol(ParserErrc::Protobuf_Error, std::move(orderFunc), std::move(ignoredCategories));
-    auto projectPtr = parse(ecol);
+    auto projectPtr = parse(ecol, cache, scope, shard);
     return std::make_pair(projectPtr, std::move(ecol));
 }
 
-ProjectPtr Parser::parse(ErrorCollector& ecol) const
+ProjectPtr Parser::parse(ErrorCollector& ecol, CheckCache* cache, const std::string& scope, ParserShard shard) const
 {
     auto projectPtr = std::make_shared<Project>(projectDir_);
-    ProtobufErrorCollector protobufCollector(ecol, ParserErrc::Protobuf_Error);
     std::filesystem::path projectPath;
     std::filesystem::path protobufPath;
 
     try {
-        InitCanonicalPathToExistingDirectory(projectPath, projectDir_.string());
+        if (!source_) {
+            InitCanonicalPathToExistingDirectory(projectPath, projectDir_.string());
+        }
 
         if (!protobufRoot_.empty()) {
             InitCanonicalPathToExistingDirectory(protobufPath, protobufRoot_.string());
         }
     } catch (const std::filesystem::filesystem_error&) { }
 
-    if (projectPath.empty() || !std::filesystem::is_regular_file(projectPath / Busrpc_Builtin_File)) {
+    std::shared_ptr<const ProjectSource> source = source_;
+
+    if (!source && !projectPath.empty()) {
+        source = std::make_shared<DiskProjectSource>(projectPath);
+    }
+
+    if (source && !overlay_.empty()) {
+        source = std::make_shared<OverlayProjectSource>(std::move(source), overlay_);
+    }
+
+    if (!source || !source->isFile(Busrpc_Builtin_File)) {
         ecol.add(ParserErrc::Invalid_Project_Dir, std::make_pair("dir", projectDir_));
         return projectPtr;
     }
 
-    protobuf::compiler::DiskSourceTree sourceTree;
-    sourceTree.MapPath("", projectPath.generic_string());
+    std::optional<Scope> parseScope;
+    CheckFilter filter;
+
+    if (shard.count == 0 || shard.index >= shard.count || (shard.count > 1 && !scope.empty())) {
+        ecol.add(ParserErrc::Invalid_Scope,
+                 std::make_pair("shard", std::to_string(shard.index) + "/" + std::to_string(shard.count)),
+                 "shard index should be less than the number of shards and scope should not be set");
+        return projectPtr;
+    } else if (!scope.empty() && scope != Project_Entity_Name) {
+        std::string dir;
+        std::vector<std::string> files;
+        std::vector<std::string> subdirs;
+
+        if (scope.compare(0, projectPtr->dname().size() + 1, projectPtr->dname() + ".") == 0) {
+            dir = scope.substr(projectPtr->dname().size() + 1);
+            std::replace(dir.begin(), dir.end(), '.', '/');
+        }
+
+        if (dir.empty() || !IsLayoutDir(dir) || !source->list(dir, files, subdirs)) {
+            ecol.add(ParserErrc::Invalid_Scope, std::make_pair("scope", scope));
+            return projectPtr;
+        }
+
+        parseScope.emplace();
+        parseScope->roots.push_back(std::move(dir));
+    } else if (shard.count > 1) {
+        parseScope.emplace();
+        parseScope->hasProjectLevel = shard.index == 0;
+
+        for (std::string dir: {Api_Entity_Name, Implementation_Entity_Name}) {
+            std::vector<std::string> files;
+            std::vector<std::string> subdirs;
+            source->list(dir, files, subdirs);
+
+            for (const auto& subdir: subdirs) {
+                if (GetShardIndex(projectPtr->dname() + "." + dir + "." + subdir, shard.count) == shard.index) {
+                    parseScope->roots.push_back(dir + "/" + subdir);
+                }
+            }
+        }
+
+        filter = [shard](const Entity* entity) {
+            return entity->type() == EntityTypeId::Project ? shard.index == 0
+                                                           : GetShardIndex(entity->dname(), shard.count) == shard.index;
+        };
+    }
+
+    // protobuf descriptors are released by the build method, so they do not occupy memory while project is checked
+    bool isLean = profile_ == ParserProfile::Lean ||
+                  (profile_ == ParserProfile::Auto && ecol.isIgnored(&doc_warn_category()));
+
+    bool hasParserErrors = false;
+
+    if (shard.count > 1) {
+        // files imported from other shards are parsed by each importing shard, but their errors are reported only by
+        // the shard owning the file
+        ErrorCollector shardEcol = ecol.filter({});
+        shardEcol.clear();
+        build(*source, protobufPath, projectPtr.get(), shardEcol, &*parseScope, isLean);
+
+        for (const auto& error: shardEcol.errors()) {
+            hasParserErrors = hasParserErrors || error.code.category() == parser_error_category();
+
+            if (error.location.file.empty() ||
+                GetFileShardIndex(projectPtr->dname(), error.location.file, shard.count) == shard.index) {
+                ecol.add(error);
+            }
+        }
+    } else {
+        build(*source, protobufPath, projectPtr.get(), ecol, parseScope ? &*parseScope : nullptr, isLean);
+        hasParserErrors = ecol.majorError() && ecol.majorError()->code.category() == parser_error_category();
+    }
+
+    if (!hasParserErrors) {
+        projectPtr->check(ecol, cache, filter);
+    }
+
+    return projectPtr;
+}
+
+void Parser::build(const ProjectSource& source,
+                   const std::filesystem::path& protobufPath,
+                   Project* project,
+                   ErrorCollector& ecol,
+                   Scope* scope,
+                   bool isLean) const
+{
+    ProtobufErrorCollector protobufCollector(ecol, ParserErrc::Protobuf_Error);
+    protobuf::compiler::DiskSourceTree builtinTree;
 
     if (!protobufPath.empty()) {
-        sourceTree.MapPath("", protobufPath.generic_string());
+        builtinTree.MapPath("", protobufPath.generic_string());
     }
 
 #ifndef _WIN32
-    sourceTree.MapPath("", "/usr/include");
-    sourceTree.MapPath("", "/usr/local/include");
+    builtinTree.MapPath("", "/usr/include");
+    builtinTree.MapPath("", "/usr/local/include");
 #endif
 
-    protobuf::compiler::Importer importer(
-        &sourceTree, ecol.getProtobufCollector() ? ecol.getProtobufCollector() : &protobufCollector);
+    ProjectSourceTree sourceTree(source, &builtinTree);
+    ProtobufImporter importer(&sourceTree,
+                              ecol.getProtobufCollector() ? ecol.getProtobufCollector() : &protobufCollector,
+                              false);
+
+    if (scope) {
+        initScope(*scope, source, importer);
+    }
+
+    parseDir(source, importer, project, ecol, scope, isLean);
+}
+
+void Parser::initScope(Scope& scope, const ProjectSource& source, ProtobufImporter& importer) const
+{
+    std::vector<std::string> pending{Busrpc_Builtin_File};
+
+    // entities containing parsed files are parsed together with their descriptors
+    auto addDirs = [&scope, &source, &pending](std::filesystem::path dir) {
+        for (; !dir.empty(); dir = dir.parent_path()) {
+            if (!scope.dirs.insert(dir.generic_string()).second) {
+                break;
+            }
 
-    parseDir(importer, projectPtr.get(), ecol);
+            if (auto descFile = GetDescriptorFile(dir); !descFile.empty() && source.isFile(dir / descFile)) {
+                pending.push_back((dir / descFile).generic_string());
+            }
+        }
+    };
 
-    if (!ecol.majorError() || ecol.majorError()->code.category() != parser_error_category()) {
-        projectPtr->check(ecol);
+    for (const auto& root: scope.roots) {
+        addDirs(root);
+        CollectProtoFiles(source, root, true, pending);
     }
 
-    return projectPtr;
+    if (scope.hasProjectLevel) {
+        for (const char* dir: {"", Api_Entity_Name, Implementation_Entity_Name}) {
+            CollectProtoFiles(source, dir, false, pending);
+        }
+    }
+
+    while (!pending.empty()) {
+        std::string file = std::move(pending.back());
+        pending.pop_back();
+
+        if (!scope.files.insert(file).second) {
+            continue;
+        }
+
+        addDirs(std::filesystem::path(file).parent_path());
+
+        if (auto fileDesc = importer.Import(file)) {
+            for (int i = 0; i < fileDesc->dependency_count(); ++i) {
+                if (source.isFile(fileDesc->dependency(i)->name())) {
+                    pending.push_back(fileDesc->dependency(i)->name());
+                }
+            }
+        }
+    }
 }
 
 GeneralCompositeEntity* Parser::visitSubdirectory(GeneralCompositeEntity* parent,
                                                   ErrorCollector& ecol,
                                                   const std::string& subdirName) const
 {
+    EntityResult<GeneralCompositeEntity> result = nullptr;
+
     switch (parent->type()) {
     case EntityTypeId::Project:
         {
             if (subdirName == Api_Entity_Name) {
-                return static_cast<Project*>(parent)->addApi();
+                result = static_cast<Project*>(parent)->tryAddApi();
             } else if (subdirName == Implementation_Entity_Name) {
-                return static_cast<Project*>(parent)->addImplementation();
+                result = static_cast<Project*>(parent)->tryAddImplementation();
             }
 
             break;
         }
-    case EntityTypeId::Api: return static_cast<Api*>(parent)->addNamespace(subdirName);
-    case EntityTypeId::Namespace: return static_cast<Namespace*>(parent)->addClass(subdirName);
-    case EntityTypeId::Class: return static_cast<Class*>(parent)->addMethod(subdirName);
-    case EntityTypeId::Implementation: return static_cast<Implementation*>(parent)->addService(subdirName);
+    case EntityTypeId::Api: result = static_cast<Api*>(parent)->tryAddNamespace(subdirName); break;
+    case EntityTypeId::Namespace: result = static_cast<Namespace*>(parent)->tryAddClass(subdirName); break;
+    case EntityTypeId::Class: result = static_cast<Class*>(parent)->tryAddMethod(subdirName); break;
+    case EntityTypeId::Implementation:
+        result = static_cast<Implementation*>(parent)->tryAddService(subdirName);
+        break;
     default: break;
     }
 
+    if (!result) {
+        AddNestedEntityError(ecol, parent, subdirName, result.error());
+        return nullptr;
+    } else if (result.value()) {
+        return result.value();
+    }
+
     // May occur only when subdirectory is not part of busrpc directory layout and should be ignored
 
     ecol.add(SpecWarn::Unexpected_Nested_Entity,
@@ -232,66 +737,66 @@ GeneralCompositeEntity* Parser::visitSubdirectory(GeneralCompositeEntity* parent
     return nullptr;
 }
 
-void Parser::parseDir(google::protobuf::compiler::Importer& importer,
+void Parser::parseDir(const ProjectSource& source,
+                      ProtobufImporter& importer,
                       GeneralCompositeEntity* entity,
-                      ErrorCollector& ecol) const
+                      ErrorCollector& ecol,
+                      const Scope* scope,
+                      bool isLean) const
 {
-    std::error_code ec;
-    std::filesystem::directory_iterator dirIt(projectDir_ / entity->dir(), ec);
-    std::set<std::string> subdirs;
-
-    while (dirIt != std::filesystem::directory_iterator() && !ec) {
-        if (dirIt->is_regular_file() && dirIt->path().extension() == ".proto") {
-            std::string relPath = (entity->dir() / dirIt->path().filename()).generic_string();
-            const protobuf::FileDescriptor* fileDesc = importer.Import(relPath.c_str());
-            protobuf::FileDescriptorProto fileDescProto;
-            bool hasErrors = true;
-
-            if (fileDesc) {
-                std::ifstream file((projectDir_ / relPath).string().c_str());
-
-                if (file.is_open()) {
-                    protobuf::io::IstreamInputStream in(&file);
-                    protobuf::io::Tokenizer tokenizer(&in, nullptr);
-                    protobuf::compiler::Parser parser;
-                    hasErrors = !parser.Parse(&tokenizer, &fileDescProto);
-                } else {
-                    ecol.add(ParserErrc::Read_Failed, std::make_pair("file", relPath), "failed to open file");
-                }
-            }
+    bool isInScope = !scope || scope->contains(entity->dir());
+    std::vector<std::string> files;
+    std::vector<std::string> subdirNames;
+    bool isListed = source.list(entity->dir(), files, subdirNames);
+    std::set<std::string> subdirs(subdirNames.begin(), subdirNames.end());
+
+    for (const auto& file: files) {
+        std::string relPath = (entity->dir() / file).generic_string();
+
+        if (std::filesystem::path(file).extension() != ".proto" ||
+            (!isInScope && scope->files.find(relPath) == scope->files.end())) {
+            continue;
+        }
 
-            if (!hasErrors) {
-                // any error should be already added to collector by the importer object
-                parseFile(fileDesc, &fileDescProto, entity, ecol);
+        const protobuf::FileDescriptor* fileDesc = importer.Import(relPath.c_str());
+        protobuf::FileDescriptorProto fileDescProto;
+        bool hasErrors = true;
+
+        if (fileDesc) {
+            if (auto content = source.read(relPath)) {
+                protobuf::io::ArrayInputStream in(content->data(), static_cast<int>(content->size()));
+                protobuf::io::Tokenizer tokenizer(&in, nullptr);
+                protobuf::compiler::Parser parser;
+                hasErrors = !parser.Parse(&tokenizer, &fileDescProto);
+            } else {
+                ecol.add(ErrorCollector::ErrorLocation{.file = relPath},
+                         ParserErrc::Read_Failed,
+                         std::make_pair("file", relPath),
+                         "failed to open file");
             }
-        } else if (dirIt->is_directory()) {
-            subdirs.insert((--(dirIt->path().end()))->string());
         }
 
-        dirIt.increment(ec);
+        if (!hasErrors) {
+            // any error should be already added to collector by the importer object
+            parseFile(fileDesc, &fileDescProto, entity, ecol, isLean);
+        }
     }
 
     for (const auto& subdir: subdirs) {
-        GeneralCompositeEntity* nestedEntity = nullptr;
+        if (!isInScope) {
+            auto subdirPath = entity->dir() / subdir;
 
-        try {
-            nestedEntity = visitSubdirectory(entity, ecol, subdir);
-        } catch (const name_conflict_error&) {
-            ecol.add(SpecErrc::Multiple_Definitions,
-                     std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
-                     "nested entity '" + subdir + "'is defined more than once");
-        } catch (const entity_error& e) {
-            ecol.add(SpecErrc::Invalid_Entity,
-                     std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
-                     "failed to create nested entity '" + subdir + "', exception caught (" + e.what() + ")");
+            if (!scope->contains(subdirPath) && scope->dirs.find(subdirPath.generic_string()) == scope->dirs.end()) {
+                continue;
+            }
         }
 
-        if (nestedEntity) {
-            parseDir(importer, nestedEntity, ecol);
+        if (auto nestedEntity = visitSubdirectory(entity, ecol, subdir)) {
+            parseDir(source, importer, nestedEntity, ecol, scope, isLean);
         }
     }
 
-    if (ec) {
+    if (!isListed) {
         ecol.add(
             ParserErrc::Read_Failed, std::make_pair("dir", entity->dir()), "can't iterate through directory content");
         return;
@@ -301,31 +806,22 @@ void Parser::parseDir(google::protobuf::compiler::Importer& importer,
 void Parser::parseFile(const protobuf::FileDescriptor* fileDesc,
                        const google::protobuf::FileDescriptorProto* fileDescProto,
                        GeneralCompositeEntity* entity,
-                       ErrorCollector& ecol) const
+                       ErrorCollector& ecol,
+                       bool isLean) const
 {
     if (fileDesc->package() != entity->dname()) {
-        ecol.add(SpecErrc::Unexpected_Package,
+        ecol.add(ErrorCollector::ErrorLocation{.file = fileDesc->name()},
+                 SpecErrc::Unexpected_Package,
                  std::make_pair("file", fileDesc->name()),
                  "file content should be placed in '" + entity->dname() + "' package");
         return;
     }
 
     std::string filename = std::filesystem::path(fileDesc->name()).filename().string();
+    Comments comments(fileDescProto->source_code_info(), isLean);
 
     for (int i = 0; i < fileDesc->enum_type_count(); ++i) {
-        auto enumDesc = fileDesc->enum_type(i);
-
-        try {
-            addEnum(entity, fileDesc->enum_type(i), filename);
-        } catch (const name_conflict_error&) {
-            ecol.add(SpecErrc::Multiple_Definitions,
-                     std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
-                     "nested entity '" + enumDesc->name() + "'is defined more than once");
-        } catch (const entity_error& e) {
-            ecol.add(SpecErrc::Invalid_Entity,
-                     std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
-                     "failed to create nested entity '" + enumDesc->name() + "', exception caught (" + e.what() + ")");
-        }
+        addEnum(entity, fileDesc->enum_type(i), comments, ecol, filename);
     }
 
     for (int i = 0; i < fileDesc->message_type_count(); ++i) {
@@ -335,14 +831,12 @@ void Parser::parseFile(const protobuf::FileDescriptor* fileDesc,
 
         assert(structDescProto);
 
+        // structures are added without throwing, but their fields are still validated by the entity constructor
         try {
-            addStruct(entity, structDesc, structDescProto, filename);
-        } catch (const name_conflict_error&) {
-            ecol.add(SpecErrc::Multiple_Definitions,
-                     std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
-                     "nested entity '" + structDesc->name() + "'is defined more than once");
+            addStruct(entity, structDesc, structDescProto, comments, ecol, filename);
         } catch (const entity_error& e) {
-            ecol.add(SpecErrc::Invalid_Entity,
+            ecol.add(ErrorCollector::ErrorLocation{.file = fileDesc->name(), .entity = entity->dname()},
+                     SpecErrc::Invalid_Entity,
                      std::make_pair(GetEntityTypeIdStr(entity->type()), entity->dname()),
                      "failed to create nested entity '" + structDesc->name() + "', exception caught (" + e.what() +
                          ")");
@@ -352,32 +846,36 @@ void Parser::parseFile(const protobuf::FileDescriptor* fileDesc,
 
 void Parser::addEnum(GeneralCompositeEntity* entity,
                      const google::protobuf::EnumDescriptor* desc,
+                     const Comments& comments,
+                     ErrorCollector& ecol,
                      const std::string& filename) const
 {
-    google::protobuf::SourceLocation source;
-    desc->GetSourceLocation(&source);
-    Enum* enumeration = CreateEnum(entity, desc->name(), filename, source.leading_comments);
+    auto result = CreateEnum(entity, desc->name(), filename, comments.find(desc));
 
-    assert(enumeration);
-    initEnum(enumeration, desc);
+    if (!result) {
+        AddNestedEntityError(ecol, entity, desc->name(), result.error());
+        return;
+    }
+
+    assert(result.value());
+    initEnum(result.value(), desc, comments);
 }
 
-void Parser::initEnum(Enum* enumeration, const google::protobuf::EnumDescriptor* desc) const
+void Parser::initEnum(Enum* enumeration, const google::protobuf::EnumDescriptor* desc, const Comments& comments) const
 {
     for (int i = 0; i < desc->value_count(); ++i) {
-        google::protobuf::SourceLocation source;
-        desc->value(i)->GetSourceLocation(&source);
-        enumeration->addConstant(desc->value(i)->name(), desc->value(i)->number(), EntityDocs(source.leading_comments));
+        enumeration->addConstant(
+            desc->value(i)->name(), desc->value(i)->number(), EntityDocs(comments.find(desc->value(i))));
     }
 }
 
 void Parser::addStruct(GeneralCompositeEntity* entity,
                        const google::protobuf::Descriptor* desc,
                        const google::protobuf::DescriptorProto* descProto,
+                       const Comments& comments,
+                       ErrorCollector& ecol,
                        const std::string& filename) const
 {
-    protobuf::SourceLocation source;
-    desc->GetSourceLocation(&source);
     StructFlags flags = StructFlags::None;
 
     for (int i = 0; i < descProto->options().uninterpreted_option_size(); ++i) {
@@ -392,13 +890,22 @@ void Parser::addStruct(GeneralCompositeEntity* entity,
         }
     }
 
-    Struct* structure = CreateStruct(entity, desc->name(), filename, flags, source.leading_comments);
-    initStruct(structure, desc, descProto);
+    auto result = CreateStruct(entity, desc->name(), filename, flags, comments.find(desc));
+
+    if (!result) {
+        AddNestedEntityError(ecol, entity, desc->name(), result.error());
+        return;
+    }
+
+    assert(result.value());
+    initStruct(result.value(), desc, descProto, comments, ecol);
 }
 
 void Parser::initStruct(Struct* structure,
                         const google::protobuf::Descriptor* desc,
-                        const google::protobuf::DescriptorProto* descProto) const
+                        const google::protobuf::DescriptorProto* descProto,
+                        const Comments& comments,
+                        ErrorCollector& ecol) const
 {
     for (int i = 0; i < desc->field_count(); ++i) {
         auto fieldDesc = desc->field(i);
@@ -406,11 +913,11 @@ void Parser::initStruct(Struct* structure,
             FindDescriptorProto<protobuf::FieldDescriptorProto>(descProto->field(), desc->field(i)->name());
 
         assert(fieldDescProto);
-        addField(structure, fieldDesc, fieldDescProto);
+        addField(structure, fieldDesc, fieldDescProto, comments);
     }
 
     for (int i = 0; i < desc->enum_type_count(); ++i) {
-        addEnum(structure, desc->enum_type(i));
+        addEnum(structure, desc->enum_type(i), comments, ecol);
     }
 
     for (int i = 0; i < desc->nested_type_count(); ++i) {
@@ -420,17 +927,18 @@ void Parser::initStruct(Struct* structure,
             const protobuf::DescriptorProto* nestedDescProto =
                 FindDescriptorProto<protobuf::DescriptorProto>(descProto->nested_type(), nestedDesc->name());
             assert(nestedDescProto);
-            addStruct(structure, nestedDesc, nestedDescProto);
+            addStruct(structure, nestedDesc, nestedDescProto, comments, ecol);
         }
     }
 }
 
 void Parser::addField(Struct* structure,
                       const google::protobuf::FieldDescriptor* desc,
-                      const google::protobuf::FieldDescriptorProto* descProto) const
+                      const google::protobuf::FieldDescriptorProto* descProto,
+                      const Comments& comments) const
 {
-    google::protobuf::SourceLocation source;
-    desc->GetSourceLocation(&source);
+    // documentation of the methods implemented by the service is always built, because it contains 'accept' command
+    std::string docs = comments.find(desc, structure->structType() == StructTypeId::Service_Implements);
     FieldFlags flags = FieldFlags::None;
     std::string defaultValue;
 
@@ -474,7 +982,7 @@ void Parser::addField(Struct* structure,
                                   flags,
                                   desc->real_containing_oneof() ? desc->real_containing_oneof()->name() : "",
                                   defaultValue,
-                                  EntityDocs(source.leading_comments));
+                                  EntityDocs(docs));
     } else if (*fieldType == FieldTypeId::Message) {
         if (!desc->is_map()) {
             structure->addStructField(desc->name(),
@@ -482,7 +990,7 @@ void Parser::addField(Struct* structure,
                                       desc->message_type()->full_name(),
                                       flags,
                                       desc->real_containing_oneof() ? desc->real_containing_oneof()->name() : "",
-                                      EntityDocs(source.leading_comments));
+                                      EntityDocs(docs));
         } else {
             auto keyType = ToBusrpcType(desc->message_type()->map_key()->type());
             assert(keyType && IsScalarFieldType(*keyType));
@@ -494,7 +1002,7 @@ void Parser::addField(Struct* structure,
                 IsScalarFieldType(*valueType) ? "" : desc->message_type()->map_value()->message_type()->full_name();
 
             structure->addMapField(
-                desc->name(), desc->number(), *keyType, *valueType, valueTypeName, EntityDocs(source.leading_comments));
+                desc->name(), desc->number(), *keyType, *valueType, valueTypeName, EntityDocs(docs));
         }
     } else {
         structure->addEnumField(desc->name(),
@@ -502,7 +1010,7 @@ void Parser::addField(Struct* structure,
                                 desc->enum_type()->full_name(),
                                 flags,
                                 desc->real_containing_oneof() ? desc->real_containing_oneof()->name() : "",
-                                EntityDocs(source.leading_comments));
+                                EntityDocs(docs));
     }
 }
 
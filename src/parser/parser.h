@@ -2,8 +2,12 @@
 
 #include "entities/project.h"
 #include "error_collector.h"
+#include "parser/project_source.h"
 
+#include <cstddef>
 #include <filesystem>
+#include <map>
+#include <memory>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -18,20 +22,19 @@ class FieldDescriptor;
 class FieldDescriptorProto;
 class FileDescriptor;
 class FileDescriptorProto;
-
-namespace compiler {
-class Importer;
-}
-
 }} // namespace google::protobuf
 
 namespace busrpc {
 
+class CheckCache;
+class ProtobufImporter;
+
 /// Parser error code.
 enum class ParserErrc {
     Invalid_Project_Dir = 1, ///< Directory does not exist or does not represent a valid busrpc project directory.
     Read_Failed = 2,         ///< Failed to read protobuf file (this code is also used if directory can't be read).
-    Protobuf_Error = 3       ///< Error reported by the internally used protobuf parser.
+    Protobuf_Error = 3,      ///< Error reported by the internally used protobuf parser.
+    Invalid_Scope = 4        ///< Parsing scope or shard does not denote an existing part of the project.
 };
 
 /// Return parser error category.
@@ -40,6 +43,21 @@ const std::error_category& parser_error_category();
 /// Create error code from the \ref ParserErrc value.
 std::error_code make_error_code(ParserErrc errc);
 
+/// Shard of the project processed by one of several independent parser invocations.
+/// \note Namespaces and services are distributed between shards by the stable hash of their distinguished names.
+///       All other entities belong to the first shard.
+struct ParserShard {
+    std::size_t index = 0; ///< Zero-based index of the shard.
+    std::size_t count = 1; ///< Total number of shards.
+};
+
+/// Parser profile determining which parts of the project are built.
+enum class ParserProfile {
+    Auto = 0, ///< Select lean profile if documentation warnings are ignored and full profile otherwise.
+    Full = 1, ///< Build all project entities together with their documentation.
+    Lean = 2  ///< Do not extract entity documentation except the one required by the project check.
+};
+
 /// \note Reads files with \a .proto extension and builds \ref Project from them.
 class Parser {
 public:
@@ -49,18 +67,59 @@ public:
     ///       the protobuf library (for example, 'google/protobuf/descriptor.proto', etc.). On *nix systems parser
     ///       additionally searches for built-in \a .proto files in '/usr/include' and '/usr/local/include' if
     ///       \a protobufRoot is not set or does not contain necessary file.
+    /// \note Parameter \a overlay maps paths of the project files (relative to the \a projectDir) to the content,
+    ///       which is used instead of the file content stored on disk (for example, unsaved editor buffer).
+    /// \note Parameter \a profile determines whether entity documentation is built (see \ref profile).
     explicit Parser(std::filesystem::path projectDir = std::filesystem::current_path(),
-                    std::filesystem::path protobufRoot = {}) noexcept:
+                    std::filesystem::path protobufRoot = {},
+                    std::map<std::string, std::string> overlay = {},
+                    ParserProfile profile = ParserProfile::Auto) noexcept:
         projectDir_(std::move(projectDir)),
-        protobufRoot_(std::move(protobufRoot))
+        protobufRoot_(std::move(protobufRoot)),
+        overlay_(std::move(overlay)),
+        profile_(profile)
+    { }
+
+    /// Create parser for the project files provided by the \a source.
+    /// \note Parser does not access project directory on disk, all project files are taken from the \a source (see
+    ///       \ref MemoryProjectSource). Built-in \a .proto files are still searched on disk as described above.
+    explicit Parser(std::shared_ptr<const ProjectSource> source,
+                    std::filesystem::path protobufRoot = {},
+                    std::map<std::string, std::string> overlay = {},
+                    ParserProfile profile = ParserProfile::Auto) noexcept:
+        protobufRoot_(std::move(protobufRoot)),
+        overlay_(std::move(overlay)),
+        source_(std::move(source)),
+        profile_(profile)
     { }
 
     /// Return project directory.
+    /// \note Empty if parser was created for the project source.
     const std::filesystem::path& projectDir() const noexcept { return projectDir_; }
 
+    /// Return source of the project files.
+    /// \note \c nullptr if parser was created for the project directory (in this case \ref DiskProjectSource is
+    ///       created when project is parsed).
+    const std::shared_ptr<const ProjectSource>& source() const noexcept { return source_; }
+
     /// Return protobuf root directory where to search for built-in \a .proto files.
     const std::filesystem::path& protobufRoot() const noexcept { return protobufRoot_; }
 
+    /// Return content of the project files overriding content stored on disk.
+    /// \note Keys are file paths relative to the project directory in the generic format ('api/file.proto').
+    /// \note Overlay files, which do not exist in the project source (for example, unsaved editor buffers of the new
+    ///       files), are parsed as if they were added to the source together with their parent directories.
+    const std::map<std::string, std::string>& overlay() const noexcept { return overlay_; }
+
+    /// Return parser profile.
+    /// \note With \ref ParserProfile::Lean profile parser does not extract entity documentation, which makes parsing
+    ///       faster. Only documentation of the methods implemented by the service (which contains \c accept
+    ///       command) is still built. Profile does not affect errors found by the parser, except documentation
+    ///       warnings, which should be ignored if lean profile is used.
+    /// \note With \ref ParserProfile::Auto profile parser selects lean profile if error collector ignores
+    ///       documentation warnings (for example, when \c check command is invoked with \c --ignore-doc option).
+    ParserProfile profile() const noexcept { return profile_; }
+
     /// Parse project directory and build \ref Project.
     /// \warning Parser does not stop working when error is encountered, which means that returned project may be
     ///          incomplete if errors are found.
@@ -68,44 +127,95 @@ public:
     ///       that should be ignored by the error collector.
     ///  \note Uses default error collector, which assumes the following priorities of the error codes:
     ///        <tt>ParserErrc > SpecErrc > SpecWarn > DocWarn > StyleWarn</tt>
-    std::pair<ProjectPtr, ErrorCollector> parse(std::vector<const std::error_category*> ignoredCategories = {}) const;
+    /// \note If \a cache is set, it is used to speed up the project check (see \ref Project::check).
+    /// \note If \a scope or \a shard is set, only part of the project is parsed (see below).
+    std::pair<ProjectPtr, ErrorCollector> parse(std::vector<const std::error_category*> ignoredCategories = {},
+                                                CheckCache* cache = nullptr,
+                                                const std::string& scope = {},
+                                                ParserShard shard = {}) const;
 
     /// Parse project directory and build \ref Project.
     /// \note Parser does not stop working when error is encountered, which means that returned project may be
     ///       incomplete if errors are found.
-    ProjectPtr parse(ErrorCollector& errorCollector) const;
+    /// \note If \a cache is set, it is used to speed up the project check (see \ref Project::check).
+    /// \note Parameter \a scope is a distinguished name of the project entity represented by a directory (for
+    ///       example, 'busrpc.api.billing' or 'busrpc.implementation.invoicer'). If it is set, parser builds only the
+    ///       entity subtree, project built-in file ('busrpc.proto') and files transitively imported by them
+    ///       (together with the descriptors of the entities containing these files). Other project files are not
+    ///       read, so the parsing cost is proportional to the size of the scope.
+    /// \note If \a shard is set, parser builds namespaces and services belonging to the shard (and all other
+    ///       entities if shard is the first one) together with the files transitively imported by them. Only
+    ///       entities belonging to the shard are checked and errors found in the files are reported only by the shard
+    ///       owning the file (even if the file is imported by other shards), which means that union of errors found
+    ///       for all shards is the same as the errors found for the whole project. Shard can't be used together
+    ///       with \a scope.
+    /// \note Project is not checked if some file fails to parse, so only parser errors are reported in this case.
+    ///       When project is sharded, this applies only to the shards, which parsed such file (owned or imported),
+    ///       while other shards still check their entities. Thus union of errors found for all shards matches the
+    ///       errors found for the whole project in this case only if entities of other shards have no errors.
+    /// \note Protobuf descriptors are only kept while project entities are built and are released before the project
+    ///       is checked. Descriptor pool does not store source code info (entity documentation is extracted from the
+    ///       file being parsed), which significantly reduces memory consumed by the parser.
+    ProjectPtr parse(ErrorCollector& errorCollector,
+                     CheckCache* cache = nullptr,
+                     const std::string& scope = {},
+                     ParserShard shard = {}) const;
 
 private:
+    struct Scope;
+    struct Comments;
+
+    void build(const ProjectSource& source,
+               const std::filesystem::path& protobufPath,
+               Project* project,
+               ErrorCollector& ecol,
+               Scope* scope,
+               bool isLean) const;
+    void initScope(Scope& scope, const ProjectSource& source, ProtobufImporter& importer) const;
     GeneralCompositeEntity* visitSubdirectory(GeneralCompositeEntity* parent,
                                               ErrorCollector& ecol,
                                               const std::string& subdirName) const;
-    void parseDir(google::protobuf::compiler::Importer& importer,
+    void parseDir(const ProjectSource& source,
+                  ProtobufImporter& importer,
                   GeneralCompositeEntity* entity,
-                  ErrorCollector& ecol) const;
+                  ErrorCollector& ecol,
+                  const Scope* scope,
+                  bool isLean) const;
     void parseFile(const google::protobuf::FileDescriptor* fileDesc,
                    const google::protobuf::FileDescriptorProto* fileDescProto,
                    GeneralCompositeEntity* entity,
-                   ErrorCollector& ecol) const;
+                   ErrorCollector& ecol,
+                   bool isLean) const;
 
     void addEnum(GeneralCompositeEntity* entity,
                  const google::protobuf::EnumDescriptor* desc,
+                 const Comments& comments,
+                 ErrorCollector& ecol,
                  const std::string& filename = {}) const;
-    void initEnum(Enum* enumeration, const google::protobuf::EnumDescriptor* desc) const;
+    void initEnum(Enum* enumeration, const google::protobuf::EnumDescriptor* desc, const Comments& comments) const;
 
     void addStruct(GeneralCompositeEntity* entity,
                    const google::protobuf::Descriptor* desc,
                    const google::protobuf::DescriptorProto* descProto,
+                   const Comments& comments,
+                   ErrorCollector& ecol,
                    const std::string& filename = {}) const;
     void initStruct(Struct* structure,
                     const google::protobuf::Descriptor* desc,
-                    const google::protobuf::DescriptorProto* descProto) const;
+                    const google::protobuf::DescriptorProto* descProto,
+                    const Comments& comments,
+                    ErrorCollector& ecol) const;
 
     void addField(Struct* structure,
                   const google::protobuf::FieldDescriptor* desc,
-                  const google::protobuf::FieldDescriptorProto* descProto) const;
+                  const google::protobuf::FieldDescriptorProto* descProto,
+                  const Comments& comments) const;
 
     std::filesystem::path projectDir_;
     std::filesystem::path protobufRoot_;
+    std::map<std::string, std::string> overlay_;
+    std::shared_ptr<const ProjectSource> source_;
+    ParserProfile profile_;
 };
 } // namespace busrpc
 
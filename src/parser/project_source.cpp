@@ -0,0 +1,145 @@
+#include "parser/project_source.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace busrpc {
+
+namespace {
+
+// Return path in the generic format without redundant components ("." for the project directory is converted to
+// empty string)
+std::string Normalize(const std::filesystem::path& path)
+{
+    std::string result = path.lexically_normal().generic_string();
+
+    if (result == ".") {
+        result.clear();
+    } else if (!result.empty() && result.back() == '/') {
+        result.pop_back();
+    }
+
+    return result;
+}
+
+const std::string& GetPath(const std::string& dir)
+{
+    return dir;
+}
+
+const std::string& GetPath(const std::pair<const std::string, std::string>& file)
+{
+    return file.first;
+}
+
+// Append names of the immediate children of the directory with the specified prefix to the names
+template<typename TContainer>
+void AppendChildren(const TContainer& container, const std::string& prefix, std::vector<std::string>& names)
+{
+    for (auto it = container.lower_bound(prefix); it != container.end(); ++it) {
+        const std::string& path = GetPath(*it);
+
+        if (path.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+
+        if (path.size() > prefix.size() && path.find('/', prefix.size()) == std::string::npos) {
+            names.push_back(path.substr(prefix.size()));
+        }
+    }
+}
+} // namespace
+
+bool DiskProjectSource::isFile(const std::filesystem::path& file) const
+{
+    std::error_code ec;
+    return std::filesystem::is_regular_file(projectDir_ / file, ec);
+}
+
+std::optional<std::string> DiskProjectSource::read(const std::filesystem::path& file) const
+{
+    std::ifstream in(projectDir_ / file, std::ios::binary);
+
+    if (!in.is_open()) {
+        return std::nullopt;
+    }
+
+    std::ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+bool DiskProjectSource::list(const std::filesystem::path& dir,
+                             std::vector<std::string>& files,
+                             std::vector<std::string>& subdirs) const
+{
+    std::error_code ec;
+    std::filesystem::directory_iterator dirIt(projectDir_ / dir, ec);
+
+    while (dirIt != std::filesystem::directory_iterator() && !ec) {
+        if (dirIt->is_regular_file()) {
+            files.push_back(dirIt->path().filename().string());
+        } else if (dirIt->is_directory()) {
+            subdirs.push_back(dirIt->path().filename().string());
+        }
+
+        dirIt.increment(ec);
+    }
+
+    return !ec;
+}
+
+MemoryProjectSource::MemoryProjectSource(std::map<std::string, std::string> files)
+{
+    for (auto& [file, content]: files) {
+        addFile(file, std::move(content));
+    }
+}
+
+void MemoryProjectSource::addFile(const std::filesystem::path& file, std::string content)
+{
+    std::filesystem::path normalized = Normalize(file);
+
+    if (normalized.has_parent_path()) {
+        addDir(normalized.parent_path());
+    }
+
+    files_[normalized.generic_string()] = std::move(content);
+}
+
+void MemoryProjectSource::addDir(const std::filesystem::path& dir)
+{
+    for (std::filesystem::path current = Normalize(dir); !current.empty(); current = current.parent_path()) {
+        if (!dirs_.insert(current.generic_string()).second) {
+            break;
+        }
+    }
+}
+
+bool MemoryProjectSource::isFile(const std::filesystem::path& file) const
+{
+    return files_.find(Normalize(file)) != files_.end();
+}
+
+std::optional<std::string> MemoryProjectSource::read(const std::filesystem::path& file) const
+{
+    auto it = files_.find(Normalize(file));
+    return it != files_.end() ? std::optional<std::string>(it->second) : std::nullopt;
+}
+
+bool MemoryProjectSource::list(const std::filesystem::path& dir,
+                               std::vector<std::string>& files,
+                               std::vector<std::string>& subdirs) const
+{
+    std::string normalized = Normalize(dir);
+
+    if (!normalized.empty() && dirs_.find(normalized) == dirs_.end()) {
+        return false;
+    }
+
+    std::string prefix = normalized.empty() ? normalized : normalized + "/";
+    AppendChildren(files_, prefix, files);
+    AppendChildren(dirs_, prefix, subdirs);
+    return true;
+}
+} // namespace busrpc
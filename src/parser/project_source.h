@@ -0,0 +1,97 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+/// \file project_source.h Sources of the busrpc project files.
+
+namespace busrpc {
+
+/// Source of the busrpc project files.
+/// \note All paths passed to the source methods are relative to the project directory. Empty path denotes project
+///       directory itself.
+class ProjectSource {
+public:
+    /// Default virtual destructor.
+    virtual ~ProjectSource() = default;
+
+    /// Return \c true if \a file exists and is a regular file.
+    virtual bool isFile(const std::filesystem::path& file) const = 0;
+
+    /// Read content of the \a file.
+    /// \note Returns \c nullopt if file does not exist or can't be read.
+    virtual std::optional<std::string> read(const std::filesystem::path& file) const = 0;
+
+    /// Append names of the regular files and subdirectories of the \a dir to \a files and \a subdirs.
+    /// \note Returns \c false if directory does not exist or can't be read. Names found before the error occurred
+    ///       are still appended.
+    virtual bool list(const std::filesystem::path& dir,
+                      std::vector<std::string>& files,
+                      std::vector<std::string>& subdirs) const = 0;
+};
+
+/// Project source, which reads files from the project directory on disk.
+class DiskProjectSource: public ProjectSource {
+public:
+    /// Create source for the \a projectDir.
+    explicit DiskProjectSource(std::filesystem::path projectDir) noexcept: projectDir_(std::move(projectDir)) { }
+
+    /// Project directory.
+    const std::filesystem::path& projectDir() const noexcept { return projectDir_; }
+
+    /// Return \c true if \a file exists and is a regular file.
+    bool isFile(const std::filesystem::path& file) const override;
+
+    /// Read content of the \a file.
+    std::optional<std::string> read(const std::filesystem::path& file) const override;
+
+    /// Append names of the regular files and subdirectories of the \a dir to \a files and \a subdirs.
+    bool list(const std::filesystem::path& dir,
+              std::vector<std::string>& files,
+              std::vector<std::string>& subdirs) const override;
+
+private:
+    std::filesystem::path projectDir_;
+};
+
+/// Project source, which stores files in memory.
+/// \note Source allows to parse project without touching the filesystem (for example, in tests).
+class MemoryProjectSource: public ProjectSource {
+public:
+    /// Create source containing \a files.
+    /// \note Parameter \a files maps file paths (relative to the project directory) to the file content.
+    explicit MemoryProjectSource(std::map<std::string, std::string> files = {});
+
+    /// Add \a file with the specified \a content.
+    /// \note If file already exists, it's content is replaced. All parent directories of the file are added
+    ///       implicitly.
+    void addFile(const std::filesystem::path& file, std::string content = {});
+
+    /// Add empty \a dir.
+    /// \note All parent directories are added implicitly.
+    void addDir(const std::filesystem::path& dir);
+
+    /// Files stored in the source.
+    /// \note Keys are file paths in the generic format ('api/file.proto').
+    const std::map<std::string, std::string>& files() const noexcept { return files_; }
+
+    /// Return \c true if \a file exists and is a regular file.
+    bool isFile(const std::filesystem::path& file) const override;
+
+    /// Read content of the \a file.
+    std::optional<std::string> read(const std::filesystem::path& file) const override;
+
+    /// Append names of the regular files and subdirectories of the \a dir to \a files and \a subdirs.
+    bool list(const std::filesystem::path& dir,
+              std::vector<std::string>& files,
+              std::vector<std::string>& subdirs) const override;
+
+private:
+    std::map<std::string, std::string> files_;
+    std::set<std::string> dirs_;
+};
+} // namespace busrpc
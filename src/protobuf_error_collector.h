@@ -45,7 +45,8 @@ public:
     /// Called by protobuf library when it encounters error when parsing protocol file.
     void AddError(const std::string& filename, int line, int column, const std::string& description) override
     {
-        collector_.add(protobufErrorCode_,
+        collector_.add(ErrorCollector::ErrorLocation{.file = filename, .line = line, .column = column},
+                       protobufErrorCode_,
                        std::make_pair("file", filename),
                        std::make_pair("line", line),
                        std::make_pair("column", column),
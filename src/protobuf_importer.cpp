@@ -0,0 +1,163 @@
+#include "protobuf_importer.h"
+
+#ifdef _MSC_VER
+#    pragma warning(push)
+#    pragma warning(disable : 4100)
+#    pragma warning(disable : 4251)
+#else
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpedantic"
+#    pragma GCC diagnostic ignored "-Wconversion"
+#    pragma GCC diagnostic ignored "-Wsign-conversion"
+#    pragma GCC diagnostic ignored "-Wshadow"
+#endif
+
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/api.pb.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/empty.pb.h>
+#include <google/protobuf/field_mask.pb.h>
+#include <google/protobuf/source_context.pb.h>
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <google/protobuf/type.pb.h>
+#include <google/protobuf/wrappers.pb.h>
+
+#ifdef _MSC_VER
+#    pragma warning(pop)
+#else
+#    pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+
+namespace protobuf = google::protobuf;
+
+namespace busrpc {
+
+namespace {
+
+// Return well-known files compiled into the linked protobuf library
+// Files are found by their message types, which guarantees that generated code is linked even if protobuf library is
+// static
+const std::vector<const protobuf::FileDescriptor*>& GetWellKnownFiles()
+{
+    static const std::vector<const protobuf::FileDescriptor*> files = {
+        protobuf::Any::descriptor()->file(),
+        protobuf::Api::descriptor()->file(),
+        protobuf::FileDescriptorProto::descriptor()->file(),
+        protobuf::Duration::descriptor()->file(),
+        protobuf::Empty::descriptor()->file(),
+        protobuf::FieldMask::descriptor()->file(),
+        protobuf::SourceContext::descriptor()->file(),
+        protobuf::Struct::descriptor()->file(),
+        protobuf::Timestamp::descriptor()->file(),
+        protobuf::Type::descriptor()->file(),
+        protobuf::DoubleValue::descriptor()->file()};
+
+    return files;
+}
+
+bool CopyWellKnownFile(const protobuf::FileDescriptor* file, protobuf::FileDescriptorProto* output)
+{
+    const auto& files = GetWellKnownFiles();
+
+    if (!file || std::find(files.begin(), files.end(), file) == files.end()) {
+        return false;
+    }
+
+    output->Clear();
+    file->CopyTo(output);
+    return true;
+}
+} // namespace
+
+bool WellKnownTypesDatabase::FindFileByName(const std::string& filename, protobuf::FileDescriptorProto* output)
+{
+    const auto& files = GetWellKnownFiles();
+    auto it = std::find_if(files.begin(), files.end(), [&filename](const auto& file) {
+        return file->name() == filename;
+    });
+
+    return it != files.end() && CopyWellKnownFile(*it, output);
+}
+
+bool WellKnownTypesDatabase::FindFileContainingSymbol(const std::string& symbolName,
+                                                      protobuf::FileDescriptorProto* output)
+{
+    return CopyWellKnownFile(protobuf::DescriptorPool::generated_pool()->FindFileContainingSymbol(symbolName),
+                             output);
+}
+
+bool WellKnownTypesDatabase::FindFileContainingExtension(const std::string&, int, protobuf::FileDescriptorProto*)
+{
+    // well-known files do not define extensions
+    return false;
+}
+
+bool WellKnownTypesDatabase::FindAllFileNames(std::vector<std::string>* output)
+{
+    for (const auto& file: GetWellKnownFiles()) {
+        output->push_back(file->name());
+    }
+
+    return true;
+}
+
+bool SourceInfoStrippingDatabase::FindFileByName(const std::string& filename, protobuf::FileDescriptorProto* output)
+{
+    if (!database_->FindFileByName(filename, output)) {
+        return false;
+    }
+
+    output->clear_source_code_info();
+    return true;
+}
+
+bool SourceInfoStrippingDatabase::FindFileContainingSymbol(const std::string& symbolName,
+                                                           protobuf::FileDescriptorProto* output)
+{
+    if (!database_->FindFileContainingSymbol(symbolName, output)) {
+        return false;
+    }
+
+    output->clear_source_code_info();
+    return true;
+}
+
+bool SourceInfoStrippingDatabase::FindFileContainingExtension(const std::string& containingType,
+                                                              int fieldNumber,
+                                                              protobuf::FileDescriptorProto* output)
+{
+    if (!database_->FindFileContainingExtension(containingType, fieldNumber, output)) {
+        return false;
+    }
+
+    output->clear_source_code_info();
+    return true;
+}
+
+bool SourceInfoStrippingDatabase::FindAllFileNames(std::vector<std::string>* output)
+{
+    return database_->FindAllFileNames(output);
+}
+
+ProtobufImporter::ProtobufImporter(protobuf::compiler::SourceTree* sourceTree,
+                                   protobuf::compiler::MultiFileErrorCollector* errorCollector,
+                                   bool keepSourceInfo):
+    sourceTreeDatabase_(sourceTree),
+    strippingDatabase_(&sourceTreeDatabase_),
+    database_(&wellKnownTypesDatabase_,
+              keepSourceInfo ? static_cast<protobuf::DescriptorDatabase*>(&sourceTreeDatabase_) : &strippingDatabase_),
+    pool_(&database_, sourceTreeDatabase_.GetValidationErrorCollector())
+{
+    pool_.EnforceWeakDependencies(true);
+    sourceTreeDatabase_.RecordErrorsTo(errorCollector);
+}
+
+const protobuf::FileDescriptor* ProtobufImporter::Import(const std::string& filename)
+{
+    return pool_.FindFileByName(filename);
+}
+} // namespace busrpc
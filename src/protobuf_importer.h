@@ -0,0 +1,116 @@
+#pragma once
+
+#ifdef _MSC_VER
+#    pragma warning(push)
+#    pragma warning(disable : 4100)
+#    pragma warning(disable : 4251)
+#else
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpedantic"
+#    pragma GCC diagnostic ignored "-Wconversion"
+#    pragma GCC diagnostic ignored "-Wsign-conversion"
+#    pragma GCC diagnostic ignored "-Wshadow"
+#endif
+
+#include <google/protobuf/compiler/importer.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor_database.h>
+
+#ifdef _MSC_VER
+#    pragma warning(pop)
+#else
+#    pragma GCC diagnostic pop
+#endif
+
+#include <string>
+#include <vector>
+
+/// \file protobuf_importer.h Protobuf importer serving well-known types from the linked protobuf library.
+
+namespace busrpc {
+
+/// Protobuf descriptor database containing well-known protobuf types ('google/protobuf/descriptor.proto',
+/// 'google/protobuf/any.proto', etc.).
+/// \note Database does not read any files. Instead, it serves descriptors compiled into the linked protobuf library.
+class WellKnownTypesDatabase: public google::protobuf::DescriptorDatabase {
+public:
+    /// Find well-known file by it's name.
+    bool FindFileByName(const std::string& filename, google::protobuf::FileDescriptorProto* output) override;
+
+    /// Find well-known file containing symbol.
+    bool FindFileContainingSymbol(const std::string& symbolName, google::protobuf::FileDescriptorProto* output) override;
+
+    /// Find well-known file containing extension.
+    bool FindFileContainingExtension(const std::string& containingType,
+                                     int fieldNumber,
+                                     google::protobuf::FileDescriptorProto* output) override;
+
+    /// Return names of all well-known files.
+    bool FindAllFileNames(std::vector<std::string>* output) override;
+};
+
+/// Protobuf descriptor database, which removes source code info (locations and comments) from the files found in the
+/// underlying database.
+/// \note Source code info usually takes most of the memory occupied by the descriptor pool. This database allows not to
+///       store it in the pool if it is not needed or obtained elsewhere.
+class SourceInfoStrippingDatabase: public google::protobuf::DescriptorDatabase {
+public:
+    /// Create database wrapping the \a database.
+    explicit SourceInfoStrippingDatabase(google::protobuf::DescriptorDatabase* database) noexcept:
+        database_(database)
+    { }
+
+    /// Find file by it's name.
+    bool FindFileByName(const std::string& filename, google::protobuf::FileDescriptorProto* output) override;
+
+    /// Find file containing symbol.
+    bool FindFileContainingSymbol(const std::string& symbolName,
+                                  google::protobuf::FileDescriptorProto* output) override;
+
+    /// Find file containing extension.
+    bool FindFileContainingExtension(const std::string& containingType,
+                                     int fieldNumber,
+                                     google::protobuf::FileDescriptorProto* output) override;
+
+    /// Return names of all files.
+    bool FindAllFileNames(std::vector<std::string>* output) override;
+
+private:
+    google::protobuf::DescriptorDatabase* database_;
+};
+
+/// Protobuf importer, which serves well-known protobuf types from the \ref WellKnownTypesDatabase.
+/// \note This class is a replacement for the \c google::protobuf::compiler::Importer. The difference is that
+///       well-known protobuf files are not searched in the source tree and are not parsed, thus source tree is only
+///       accessed for the project files and genuinely external imports.
+class ProtobufImporter {
+public:
+    /// Create importer for the \a sourceTree, which reports errors to the \a errorCollector.
+    /// \note If \a keepSourceInfo is \c false, source code info is not stored in the pool (see
+    ///       \ref SourceInfoStrippingDatabase), which means that \c GetSourceLocation method of the imported
+    ///       descriptors always fails.
+    ProtobufImporter(google::protobuf::compiler::SourceTree* sourceTree,
+                     google::protobuf::compiler::MultiFileErrorCollector* errorCollector,
+                     bool keepSourceInfo = true);
+
+    ProtobufImporter(const ProtobufImporter&) = delete;
+    ProtobufImporter(ProtobufImporter&&) = delete;
+    ProtobufImporter& operator=(const ProtobufImporter&) = delete;
+    ProtobufImporter& operator=(ProtobufImporter&&) = delete;
+
+    /// Import file and all it's dependencies.
+    /// \note Returns \c nullptr if file or it's dependencies can't be imported (errors are reported to the error
+    ///       collector passed to the constructor).
+    const google::protobuf::FileDescriptor* Import(const std::string& filename);
+
+    /// Pool containing imported files.
+    const google::protobuf::DescriptorPool* pool() const noexcept { return &pool_; }
+
+private:
+    WellKnownTypesDatabase wellKnownTypesDatabase_;
+    google::protobuf::compiler::SourceTreeDescriptorDatabase sourceTreeDatabase_;
+    SourceInfoStrippingDatabase strippingDatabase_;
+    google::protobuf::MergedDescriptorDatabase database_;
+    google::protobuf::DescriptorPool pool_;
+};
+} // namespace busrpc
@@ -0,0 +1,133 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace busrpc {
+
+// Indices processed by a single parallelFor call
+// Worker thread, which starts after all indices are taken, returns without accessing the function (it may be already
+// destroyed), so the calling thread only waits for the indices to be processed and not for the tasks to complete
+struct ThreadPool::Batch {
+    Batch(std::size_t indexCount, const std::function<void(std::size_t)>& indexFunc): count(indexCount), func(indexFunc)
+    { }
+
+    void run()
+    {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                func(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (++done == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                isDone.notify_all();
+            }
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        isDone.wait(lock, [this]() { return done == count; });
+    }
+
+    const std::size_t count;
+    const std::function<void(std::size_t)>& func;
+    std::atomic<std::size_t> next = 0;
+    std::atomic<std::size_t> done = 0;
+    std::mutex mutex;
+    std::condition_variable isDone;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    threads_.reserve(threadCount);
+
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this]() { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+    }
+
+    hasTasks_.notify_all();
+
+    for (auto& thread: threads_) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::Shared()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1u);
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    if (threads_.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+
+    hasTasks_.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t jobs, const std::function<void(std::size_t)>& func)
+{
+    auto batch = std::make_shared<Batch>(count, func);
+    std::size_t helpers = std::min({jobs, count, threadCount() + 1});
+
+    for (std::size_t i = 1; i < helpers; ++i) {
+        submit([batch]() { batch->run(); });
+    }
+
+    batch->run();
+    batch->wait();
+
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+void ThreadPool::work()
+{
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hasTasks_.wait(lock, [this]() { return isStopped_ || !tasks_.empty(); });
+
+            if (tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
+} // namespace busrpc
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \file thread_pool.h Thread pool shared by the parallel algorithms.
+
+namespace busrpc {
+
+/// Pool of worker threads executing submitted tasks.
+class ThreadPool {
+public:
+    /// Create pool with \a threadCount worker threads.
+    explicit ThreadPool(std::size_t threadCount);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /// Wait for all submitted tasks to complete and stop worker threads.
+    ~ThreadPool();
+
+    /// Return pool shared by all parallel algorithms of the development tool.
+    /// \note Shared pool is created on first use and has one worker thread less than the number of hardware threads,
+    ///       because calling thread also participates in the parallel algorithms (see \ref parallelFor).
+    static ThreadPool& Shared();
+
+    /// Number of worker threads.
+    std::size_t threadCount() const noexcept { return threads_.size(); }
+
+    /// Submit \a task for execution by one of the worker threads.
+    /// \note If pool does not have worker threads, \a task is executed by the calling thread.
+    /// \warning Task should not throw exceptions.
+    void submit(std::function<void()> task);
+
+    /// Invoke \a func for each index in [0, \a count) using at most \a jobs threads.
+    /// \note Calling thread is one of the \a jobs threads and processes indices together with the worker threads,
+    ///       which means that method can be safely called from the task executed by the pool.
+    /// \note Number of used threads is additionally limited by the number of worker threads in the pool.
+    /// \note If \a func throws, remaining indices are still processed and then first caught exception is rethrown.
+    void parallelFor(std::size_t count, std::size_t jobs, const std::function<void(std::size_t)>& func);
+
+private:
+    struct Batch;
+
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable hasTasks_;
+    std::deque<std::function<void()>> tasks_;
+    bool isStopped_ = false;
+    std::vector<std::thread> threads_;
+};
+} // namespace busrpc
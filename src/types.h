@@ -70,7 +70,10 @@ enum class CommandId {
     Version = 2, ///< Output busrpc development tool version.
     Imports = 3, ///< Output files directly or indirectly imported by the specified file(s).
     Check = 4,   ///< Check API for conformance to the busrpc specification.
-    GenDoc = 5   ///< Generate API documentation.
+    GenDoc = 5,  ///< Generate API documentation.
+    Diff = 6,    ///< Detect wire-incompatible changes between two versions of the API.
+    Run = 7,     ///< Run several commands over the project parsed once.
+    Lsp = 8      ///< Run language server for the project.
 };
 
 /// Get command name.
@@ -83,6 +86,9 @@ constexpr const char* GetCommandName(CommandId id)
     case CommandId::Imports: return "imports";
     case CommandId::Check: return "check";
     case CommandId::GenDoc: return "gendoc";
+    case CommandId::Diff: return "diff";
+    case CommandId::Run: return "run";
+    case CommandId::Lsp: return "lsp";
     default: return nullptr;
     }
 }
@@ -97,9 +103,12 @@ constexpr std::optional<CommandId> GetCommandId(std::string_view commandName)
 
     switch (commandName[0]) {
     case 'c': return commandName == "check" ? CommandId::Check : std::optional<CommandId>{};
+    case 'd': return commandName == "diff" ? CommandId::Diff : std::optional<CommandId>{};
     case 'g': return commandName == "gendoc" ? CommandId::GenDoc : std::optional<CommandId>{};
     case 'h': return commandName == "help" ? CommandId::Help : std::optional<CommandId>{};
     case 'i': return commandName == "imports" ? CommandId::Imports : std::optional<CommandId>{};
+    case 'l': return commandName == "lsp" ? CommandId::Lsp : std::optional<CommandId>{};
+    case 'r': return commandName == "run" ? CommandId::Run : std::optional<CommandId>{};
     case 'v': return commandName == "version" ? CommandId::Version : std::optional<CommandId>{};
     default: return std::nullopt;
     }
@@ -151,6 +160,18 @@ constexpr const char* GetEntityTypeIdStr(EntityTypeId id)
     }
 }
 
+/// Return \c true if entity of the specified \a type is derived from \ref CompositeEntity.
+constexpr bool IsCompositeEntityType(EntityTypeId type)
+{
+    switch (type) {
+    case EntityTypeId::Field:
+    case EntityTypeId::Constant:
+    case EntityTypeId::Implemented_Method:
+    case EntityTypeId::Invoked_Method: return false;
+    default: return true;
+    }
+}
+
 /// Return \c true if specified \a name is a valid entity name.
 /// \note Because busrpc entity names are mapped to a protobuf entities (\c message, \c enum, \c package, etc.), they
 ///       should satisfy the same constraints. Valid entity name should consist of alphanumerical characters and
@@ -1,5 +1,6 @@
 #include "utils.h"
 
+#include <iomanip>
 #include <sstream>
 
 namespace busrpc {
@@ -27,6 +28,43 @@ bool isunder(char c)
 }
 } // namespace
 
+StableHash& StableHash::update(std::string_view data) noexcept
+{
+    update(static_cast<uint64_t>(data.size()));
+    updateBytes(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    return *this;
+}
+
+StableHash& StableHash::update(uint64_t value) noexcept
+{
+    unsigned char bytes[sizeof(value)];
+
+    // always use little-endian byte order to get the same result on all platforms
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        bytes[i] = static_cast<unsigned char>((value >> (i * 8)) & 0xff);
+    }
+
+    updateBytes(bytes, sizeof(bytes));
+    return *this;
+}
+
+void StableHash::updateBytes(const unsigned char* data, std::size_t size) noexcept
+{
+    constexpr uint64_t prime = 1099511628211ULL;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        value_ ^= data[i];
+        value_ *= prime;
+    }
+}
+
+std::string HashToString(uint64_t hash)
+{
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+}
+
 std::vector<std::string> SplitString(const std::string& str, char delimiter, TokenCompressMode mode)
 {
     std::stringstream s(str);
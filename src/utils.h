@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <string_view>
@@ -9,6 +11,31 @@
 
 namespace busrpc {
 
+/// Incremental 64-bit FNV-1a hash.
+/// \note Unlike \c std::hash, calculated value does not depend on the platform or standard library implementation,
+///       which means that it can be persisted and compared with the value calculated by another process.
+class StableHash {
+public:
+    /// Append \a data to the hashed content.
+    /// \note Size of the \a data is hashed too, which guarantees that different sequences of strings with the same
+    ///       concatenation produce different hashes.
+    StableHash& update(std::string_view data) noexcept;
+
+    /// Append \a value to the hashed content.
+    StableHash& update(uint64_t value) noexcept;
+
+    /// Hash value.
+    uint64_t value() const noexcept { return value_; }
+
+private:
+    void updateBytes(const unsigned char* data, std::size_t size) noexcept;
+
+    uint64_t value_ = 14695981039346656037ULL;
+};
+
+/// Return hexadecimal representation of the \a hash padded with zeroes to 16 characters.
+std::string HashToString(uint64_t hash);
+
 /// Turns token compression on or off for \c SplitString function.
 enum class TokenCompressMode { Off = 1, On = 2 };
 
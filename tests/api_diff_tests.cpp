@@ -0,0 +1,224 @@
+#include "api_diff.h"
+#include "utils/project_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+
+namespace busrpc { namespace test {
+
+class ApiDiffTest: public ::testing::Test {
+protected:
+    // Create project with a single namespace, class and service and call \a customize to add test-specific entities
+    static std::shared_ptr<Project> CreateProject(const std::function<void(Class*)>& customize = {},
+                                                  bool hasMethod = true)
+    {
+        auto project = std::make_shared<Project>();
+        InitMinimalProject(project.get());
+        auto cls = AddClass(AddNamespace(AddApi(project.get())));
+
+        if (hasMethod) {
+            AddMethod(cls);
+        }
+
+        AddService(AddImplementation(project.get()));
+
+        if (customize) {
+            customize(cls);
+        }
+
+        return project;
+    }
+
+    static void AddTestStruct(Class* cls,
+                              const std::string& fieldName = "field1",
+                              FieldTypeId fieldType = FieldTypeId::Int32,
+                              FieldFlags fieldFlags = FieldFlags::None,
+                              StructFlags structFlags = StructFlags::None)
+    {
+        auto structure = cls->addStruct("TestStruct", "file.proto", structFlags);
+        structure->addScalarField(fieldName, 1, fieldType, fieldFlags);
+        structure->addScalarField("field2", 2, FieldTypeId::String);
+    }
+
+    static void AddTestEnum(Class* cls, int32_t constantValue = 1, bool hasConstant = true)
+    {
+        auto enumeration = cls->addEnum("TestEnum", "file.proto");
+        enumeration->addConstant("CONSTANT_0", 0);
+
+        if (hasConstant) {
+            enumeration->addConstant("CONSTANT_1", constantValue);
+        }
+    }
+};
+
+TEST_F(ApiDiffTest, Api_Change_Kind_Has_String_Representation)
+{
+    EXPECT_STREQ(GetApiChangeKindStr(ApiChangeKind::Method_Removed), "method_removed");
+    EXPECT_STREQ(GetApiChangeKindStr(ApiChangeKind::Constant_Value_Changed), "constant_value_changed");
+    EXPECT_FALSE(GetApiChangeKindStr(static_cast<ApiChangeKind>(0)));
+}
+
+TEST_F(ApiDiffTest, No_Changes_Are_Detected_For_Identical_Projects)
+{
+    auto oldProject = CreateProject();
+    auto newProject = CreateProject();
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    EXPECT_TRUE(diff.changes.empty());
+    EXPECT_EQ(diff.unchanged, 2);
+}
+
+TEST_F(ApiDiffTest, Namespace_Is_Compared_If_Its_Content_Changed)
+{
+    auto oldProject = CreateProject();
+    auto newProject = CreateProject([](Class* cls) { cls->addStruct("AddedStruct", "file.proto"); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    EXPECT_TRUE(diff.changes.empty());
+    EXPECT_EQ(diff.unchanged, 1);
+}
+
+TEST_F(ApiDiffTest, Removed_Method_Is_Detected)
+{
+    auto oldProject = CreateProject();
+    auto newProject = CreateProject({}, false);
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Method_Removed);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.method");
+}
+
+TEST_F(ApiDiffTest, Removed_Method_Params_And_Retval_Are_Detected)
+{
+    auto oldProject = CreateProject();
+    auto newProject = CreateProject([](Class* cls) { AddMethodDesc(cls->addMethod("method"), false, false, false); },
+                                    false);
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 2);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Struct_Removed);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.method.MethodDesc.Params");
+    EXPECT_EQ(diff.changes[1].kind, ApiChangeKind::Struct_Removed);
+    EXPECT_EQ(diff.changes[1].dname, "busrpc.api.namespace.class.method.MethodDesc.Retval");
+}
+
+TEST_F(ApiDiffTest, Removed_Field_And_Struct_Are_Not_Reported)
+{
+    auto oldProject = CreateProject([](Class* cls) {
+        AddTestStruct(cls);
+        cls->addStruct("RemovedStruct", "file.proto");
+    });
+    auto newProject = CreateProject([](Class* cls) {
+        cls->addStruct("TestStruct", "file.proto")->addScalarField("field2", 2, FieldTypeId::String);
+    });
+
+    EXPECT_TRUE(DiffApi(*oldProject, *newProject).changes.empty());
+}
+
+TEST_F(ApiDiffTest, Reused_Field_Number_Is_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestStruct(cls); });
+    auto newProject = CreateProject([](Class* cls) { AddTestStruct(cls, "renamed"); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Field_Number_Reused);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.TestStruct.field1");
+    EXPECT_EQ(diff.changes[0].oldValue, "field1");
+    EXPECT_EQ(diff.changes[0].newValue, "renamed");
+}
+
+TEST_F(ApiDiffTest, Changed_Field_Type_Is_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestStruct(cls); });
+    auto newProject = CreateProject([](Class* cls) { AddTestStruct(cls, "field1", FieldTypeId::Int64); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Field_Type_Changed);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.TestStruct.field1");
+    EXPECT_EQ(diff.changes[0].oldValue, "int32");
+    EXPECT_EQ(diff.changes[0].newValue, "int64");
+}
+
+TEST_F(ApiDiffTest, Changed_Field_Repeated_Flag_Is_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestStruct(cls); });
+    auto newProject =
+        CreateProject([](Class* cls) { AddTestStruct(cls, "field1", FieldTypeId::Int32, FieldFlags::Repeated); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Field_Type_Changed);
+    EXPECT_EQ(diff.changes[0].oldValue, "int32");
+    EXPECT_EQ(diff.changes[0].newValue, "repeated int32");
+}
+
+TEST_F(ApiDiffTest, Changed_Field_Flags_Are_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestStruct(cls); });
+    auto newProject = CreateProject([](Class* cls) {
+        AddTestStruct(cls, "field1", FieldTypeId::Int32, FieldFlags::Observable | FieldFlags::Hashed);
+    });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Field_Flags_Changed);
+    EXPECT_EQ(diff.changes[0].oldValue, "");
+    EXPECT_EQ(diff.changes[0].newValue, "observable,hashed");
+}
+
+TEST_F(ApiDiffTest, Changed_Struct_Flags_Are_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestStruct(cls); });
+    auto newProject = CreateProject([](Class* cls) {
+        AddTestStruct(cls, "field1", FieldTypeId::Int32, FieldFlags::None, StructFlags::Hashed);
+    });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Struct_Flags_Changed);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.TestStruct");
+    EXPECT_EQ(diff.changes[0].oldValue, "");
+    EXPECT_EQ(diff.changes[0].newValue, "hashed");
+}
+
+TEST_F(ApiDiffTest, Removed_Enum_Constant_Is_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestEnum(cls); });
+    auto newProject = CreateProject([](Class* cls) { AddTestEnum(cls, 1, false); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Constant_Removed);
+    EXPECT_EQ(diff.changes[0].dname, "busrpc.api.namespace.class.TestEnum.CONSTANT_1");
+    EXPECT_EQ(diff.changes[0].oldValue, "1");
+    EXPECT_EQ(diff.changes[0].newValue, "");
+}
+
+TEST_F(ApiDiffTest, Changed_Enum_Constant_Value_Is_Detected)
+{
+    auto oldProject = CreateProject([](Class* cls) { AddTestEnum(cls); });
+    auto newProject = CreateProject([](Class* cls) { AddTestEnum(cls, 2); });
+
+    ApiDiff diff = DiffApi(*oldProject, *newProject);
+
+    ASSERT_EQ(diff.changes.size(), 1);
+    EXPECT_EQ(diff.changes[0].kind, ApiChangeKind::Constant_Value_Changed);
+    EXPECT_EQ(diff.changes[0].oldValue, "1");
+    EXPECT_EQ(diff.changes[0].newValue, "2");
+}
+}} // namespace busrpc::test
@@ -38,4 +38,15 @@ TEST_F(ApiEntityTest, addNamespace_Stores_Added_Namespace)
     ASSERT_NE(api_->namespaces().find("namespace"), api_->namespaces().end());
     ASSERT_EQ(*(api_->namespaces().find("namespace")), ns);
 }
+
+TEST_F(ApiEntityTest, tryAddNamespace_Stores_Added_Namespace_And_Returns_Error_On_Conflict)
+{
+    auto result = api_->tryAddNamespace("namespace");
+
+    ASSERT_TRUE(result);
+    ASSERT_NE(api_->namespaces().find("namespace"), api_->namespaces().end());
+    EXPECT_EQ(*(api_->namespaces().find("namespace")), result.value());
+    EXPECT_EQ(api_->tryAddNamespace("namespace").error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(api_->namespaces().size(), 1);
+}
 }} // namespace busrpc::test
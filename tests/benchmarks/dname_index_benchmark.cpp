@@ -0,0 +1,156 @@
+#include "entities/dname_index.h"
+#include "entities/project.h"
+#include "entities/traversal.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Benchmark of the entity distinguished names index (DnameIndex) against the linear scan of the project entities,
+// which is what prefix and completion queries would cost without the index
+// Usage: busrpc-dname-index-benchmark [NAMESPACE_COUNT] [QUERY_COUNT]
+
+namespace busrpc { namespace benchmarks {
+
+namespace {
+
+constexpr std::size_t Default_Namespace_Count = 200;
+constexpr std::size_t Default_Query_Count = 1000;
+constexpr std::size_t Struct_Count = 20;
+constexpr std::size_t Field_Count = 5;
+constexpr std::size_t Max_Completion_Items = 100;
+
+using Clock = std::chrono::steady_clock;
+
+std::shared_ptr<const Project> CreateProject(std::size_t namespaceCount)
+{
+    auto project = std::make_shared<Project>();
+    auto api = project->addApi();
+
+    for (std::size_t i = 0; i < namespaceCount; ++i) {
+        auto ns = api->addNamespace("ns" + std::to_string(i));
+
+        for (std::size_t j = 0; j < Struct_Count; ++j) {
+            auto structure = ns->addStruct("Struct" + std::to_string(j), "file.proto");
+
+            for (std::size_t k = 0; k < Field_Count; ++k) {
+                structure->addScalarField(
+                    "field" + std::to_string(k), static_cast<int32_t>(k + 1), FieldTypeId::String);
+            }
+        }
+    }
+
+    return Project::Freeze(std::move(project));
+}
+
+std::size_t ScanPrefix(const Project& project, std::string_view prefix)
+{
+    std::size_t result = 0;
+
+    for (const Entity* entity: EntitySubtree(project)) {
+        if (entity->dname().starts_with(prefix)) {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+std::size_t ScanCompletions(const Project& project, std::string_view prefix)
+{
+    std::size_t result = 0;
+
+    for (const Entity* entity: EntitySubtree(project)) {
+        const auto& dname = entity->dname();
+
+        if (result < Max_Completion_Items && dname.starts_with(prefix) &&
+            dname.find('.', prefix.size()) == std::string::npos) {
+
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+// Run query for each prefix and return average query time in microseconds
+template<typename TQuery>
+double Measure(const std::vector<std::string>& prefixes, std::size_t& matches, TQuery query)
+{
+    auto start = Clock::now();
+    matches = 0;
+
+    for (const auto& prefix: prefixes) {
+        matches += query(prefix);
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(prefixes.size());
+}
+
+bool Compare(const std::string& name,
+             const std::vector<std::string>& prefixes,
+             const Project& project,
+             std::size_t (*scan)(const Project&, std::string_view),
+             std::size_t (*lookup)(const DnameIndex&, std::string_view))
+{
+    std::size_t scanMatches = 0;
+    std::size_t indexMatches = 0;
+    double scanTime = Measure(prefixes, scanMatches, [&](const std::string& prefix) { return scan(project, prefix); });
+    double indexTime = Measure(
+        prefixes, indexMatches, [&](const std::string& prefix) { return lookup(project.dnames(), prefix); });
+
+    std::cout << name << ": linear scan " << scanTime << " us/query, index " << indexTime << " us/query ("
+              << scanTime / indexTime << "x)" << std::endl;
+
+    if (scanMatches != indexMatches) {
+        std::cerr << name << ": index returned " << indexMatches << " matches instead of " << scanMatches
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+} // namespace
+
+int Run(std::size_t namespaceCount, std::size_t queryCount)
+{
+    auto project = CreateProject(namespaceCount);
+    std::vector<std::string> structPrefixes;
+    std::vector<std::string> namespacePrefixes;
+
+    for (std::size_t i = 0; i < queryCount; ++i) {
+        std::string ns = "busrpc.api.ns" + std::to_string(i % namespaceCount);
+        structPrefixes.push_back(ns + ".Struct" + std::to_string(i % Struct_Count));
+        namespacePrefixes.push_back(ns + ".");
+    }
+
+    auto start = Clock::now();
+    std::size_t size = project->dnames().size();
+    std::chrono::duration<double, std::milli> buildTime = Clock::now() - start;
+
+    std::cout << "entities: " << size << ", index build: " << buildTime.count() << " ms" << std::endl;
+
+    auto findPrefix = [](const DnameIndex& index, std::string_view prefix) { return index.findPrefix(prefix).size(); };
+    auto complete = [](const DnameIndex& index, std::string_view prefix) {
+        return index.complete(prefix, Max_Completion_Items).size();
+    };
+    bool isPrefixValid = Compare("prefix", structPrefixes, *project, ScanPrefix, findPrefix);
+    bool isCompletionValid = Compare("completion", namespacePrefixes, *project, ScanCompletions, complete);
+
+    return isPrefixValid && isCompletionValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}} // namespace busrpc::benchmarks
+
+int main(int argc, char* argv[])
+{
+    std::size_t namespaceCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 0;
+    std::size_t queryCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+    return busrpc::benchmarks::Run(namespaceCount ? namespaceCount : busrpc::benchmarks::Default_Namespace_Count,
+                                   queryCount ? queryCount : busrpc::benchmarks::Default_Query_Count);
+}
@@ -0,0 +1,142 @@
+#include "check_cache.h"
+#include "configure.h"
+#include "entities/project.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+namespace busrpc { namespace test {
+
+TEST(CheckCacheTest, find_Returns_Nullptr_For_Unknown_Hash)
+{
+    CheckCache cache;
+
+    EXPECT_FALSE(cache.find(1001));
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST(CheckCacheTest, find_Returns_Stored_Errors)
+{
+    CheckCache cache;
+    cache.store(1001, {{SpecErrc::Empty_Enum, "[spec error] empty"}, {StyleWarn::Invalid_Name_Format, "[style warn]"}});
+    auto errors = cache.find(1001);
+
+    ASSERT_TRUE(errors);
+    ASSERT_EQ(errors->size(), 2);
+    EXPECT_EQ((*errors)[0].code, SpecErrc::Empty_Enum);
+    EXPECT_EQ((*errors)[0].description, "[spec error] empty");
+    EXPECT_EQ((*errors)[1].code, StyleWarn::Invalid_Name_Format);
+    EXPECT_EQ((*errors)[1].description, "[style warn]");
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 0);
+}
+
+TEST(CheckCacheTest, load_Restores_Saved_Cache)
+{
+    TmpDir tmp;
+    CheckCache cache;
+    cache.store(1001,
+                {{DocWarn::Undocumented_Entity, "[doc warn] undocumented", {.entity = "busrpc.Struct"}},
+                 {SpecErrc::Invalid_Entity, "[spec error] invalid", {.file = "file.proto", .line = 1, .column = 2}}});
+    cache.store(0xffffffffffffffff, {});
+
+    ASSERT_TRUE(cache.save(tmp.path() / "cache.json"));
+
+    CheckCache loaded;
+
+    ASSERT_TRUE(loaded.load(tmp.path() / "cache.json"));
+    EXPECT_EQ(loaded.size(), 2);
+    ASSERT_TRUE(loaded.find(0xffffffffffffffff));
+    EXPECT_TRUE(loaded.find(0xffffffffffffffff)->empty());
+
+    auto errors = loaded.find(1001);
+
+    ASSERT_TRUE(errors);
+    ASSERT_EQ(errors->size(), 2);
+    EXPECT_EQ((*errors)[0].code, DocWarn::Undocumented_Entity);
+    EXPECT_EQ((*errors)[0].description, "[doc warn] undocumented");
+    EXPECT_EQ((*errors)[0].location.entity, "busrpc.Struct");
+    EXPECT_TRUE((*errors)[0].location.file.empty());
+    EXPECT_EQ((*errors)[0].location.line, -1);
+    EXPECT_EQ((*errors)[1].code, SpecErrc::Invalid_Entity);
+    EXPECT_EQ((*errors)[1].location.file, "file.proto");
+    EXPECT_EQ((*errors)[1].location.line, 1);
+    EXPECT_EQ((*errors)[1].location.column, 2);
+    EXPECT_TRUE((*errors)[1].location.entity.empty());
+}
+
+TEST(CheckCacheTest, save_Stores_Only_Used_Entries)
+{
+    TmpDir tmp;
+    CheckCache cache;
+    cache.store(1, {});
+    cache.store(2, {});
+    cache.save(tmp.path() / "cache.json");
+
+    CheckCache loaded;
+    loaded.load(tmp.path() / "cache.json");
+    loaded.find(2);
+    loaded.save(tmp.path() / "cache.json");
+
+    CheckCache reloaded;
+
+    ASSERT_TRUE(reloaded.load(tmp.path() / "cache.json"));
+    EXPECT_EQ(reloaded.size(), 1);
+    EXPECT_TRUE(reloaded.find(2));
+}
+
+TEST(CheckCacheTest, prune_Removes_Entries_Not_Used_Since_Previous_Call)
+{
+    CheckCache cache;
+    cache.store(1, {});
+    cache.store(2, {});
+    cache.prune();
+
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.find(2);
+    cache.store(3, {});
+    cache.prune();
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.find(1));
+    EXPECT_TRUE(cache.find(2));
+    EXPECT_TRUE(cache.find(3));
+}
+
+TEST(CheckCacheTest, load_Returns_False_And_Leaves_Cache_Empty_If_File_Is_Invalid)
+{
+    TmpDir tmp;
+    tmp.writeFile("cache.json", "{\"version\": \"0.0.0\", \"entries\": {\"1\": []}}");
+    tmp.writeFile("invalid.json", "not a json");
+    CheckCache cache;
+
+    EXPECT_FALSE(cache.load(tmp.path() / "missing.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "cache.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "invalid.json"));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(CheckCacheTest, load_Returns_False_If_Entry_Error_Or_Hash_Is_Malformed)
+{
+    std::string header = std::string("{\"version\": \"") + BUSRPC_VERSION + "\", \"entries\": {";
+    std::string category = "\"category\": \"spec error\"";
+    std::string value = "\"value\": 1";
+    std::string description = "\"description\": \"\"";
+    TmpDir tmp;
+    tmp.writeFile("valid.json", header + "\"1f\": [{" + category + ", " + value + ", " + description + "}]}}");
+    tmp.writeFile("no_category.json", header + "\"1f\": [{" + value + ", " + description + "}]}}");
+    tmp.writeFile("no_value.json", header + "\"1f\": [{" + category + ", " + description + "}]}}");
+    tmp.writeFile("no_description.json", header + "\"1f\": [{" + category + ", " + value + "}]}}");
+    tmp.writeFile("invalid_hash.json", header + "\"1fzz\": []}}");
+    CheckCache cache;
+
+    EXPECT_TRUE(cache.load(tmp.path() / "valid.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "no_category.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "no_value.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "no_description.json"));
+    EXPECT_FALSE(cache.load(tmp.path() / "invalid_hash.json"));
+    EXPECT_EQ(cache.size(), 0);
+}
+}} // namespace busrpc::test
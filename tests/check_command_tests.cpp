@@ -8,10 +8,26 @@
 #include <CLI/CLI.hpp>
 #include <gtest/gtest.h>
 
+#include <set>
 #include <sstream>
 
 namespace busrpc { namespace test {
 
+namespace {
+
+std::set<std::string> GetLines(const std::string& output)
+{
+    std::istringstream in(output);
+    std::set<std::string> lines;
+
+    for (std::string line; std::getline(in, line);) {
+        lines.insert(line);
+    }
+
+    return lines;
+}
+} // namespace
+
 TEST(CheckCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
 {
     EXPECT_EQ(CommandId::Check, GetCommandId(GetCommandName(CommandId::Check)));
@@ -43,6 +59,8 @@ TEST(CheckCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From_K
               check_error_category().message(0));
     EXPECT_NE(check_error_category().message(static_cast<int>(CheckErrc::Invalid_Project_Dir)),
               check_error_category().message(0));
+    EXPECT_NE(check_error_category().message(static_cast<int>(CheckErrc::Invalid_Scope)),
+              check_error_category().message(0));
 }
 
 TEST(CheckCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
@@ -53,6 +71,7 @@ TEST(CheckCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
     EXPECT_EQ(std::error_code(CheckErrc::Protobuf_Parsing_Failed), CommandError::Protobuf_Parsing_Failed);
     EXPECT_EQ(std::error_code(CheckErrc::File_Read_Failed), CommandError::File_Operation_Failed);
     EXPECT_EQ(std::error_code(CheckErrc::Invalid_Project_Dir), CommandError::Invalid_Argument);
+    EXPECT_EQ(std::error_code(CheckErrc::Invalid_Scope), CommandError::Invalid_Argument);
 }
 
 TEST(CheckCommandTest, Help_Is_Defined_For_The_Command)
@@ -107,6 +126,109 @@ TEST(CheckCommandTest, Protobuf_Parsing_Failed_Error_If_Some_File_Is_Not_Parsed)
     EXPECT_FALSE(err.str().empty());
 }
 
+TEST(CheckCommandTest, Invalid_Scope_Error_If_Scope_Does_Not_Denote_Entity_Directory)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    EXPECT_COMMAND_EXCEPTION(
+        CheckCommand({"tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, {}, "busrpc.api.missing"})
+            .execute(nullptr, &err),
+        CheckErrc::Invalid_Scope);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(CheckCommandTest, Command_Checks_Only_Scope_Entity_And_Its_Dependencies)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    tmp.writeFile("api/other/invalid.proto", "syntax =");
+
+    EXPECT_COMMAND_EXCEPTION(CheckCommand({"tmp", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(nullptr, &err),
+                             CheckErrc::Protobuf_Parsing_Failed);
+    CheckArgs args("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, true, {}, "busrpc.implementation.service");
+
+    EXPECT_NO_THROW(CheckCommand(std::move(args)).execute(&out, &err));
+    EXPECT_FALSE(out.str().empty());
+}
+
+TEST(CheckCommandTest, Union_Of_Shard_Outputs_Is_Same_As_Output_For_Whole_Project)
+{
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    for (const std::string name: {"first", "second", "third", "fourth"}) {
+        tmp.writeFile("api/" + name + "/namespace.proto",
+                      GetFileHeader("busrpc.api." + name) + "message NamespaceDesc {}\n");
+        tmp.writeFile("implementation/" + name + "/service.proto", GetFileHeader("busrpc.implementation." + name));
+    }
+
+    std::ostringstream expectedErr;
+    std::set<std::string> errLines;
+    CheckCommand({"tmp", BUSRPC_TESTS_PROTOBUF_ROOT}).tryExecute(nullptr, &expectedErr);
+
+    for (std::size_t index = 0; index < 3; ++index) {
+        std::ostringstream err;
+        CheckArgs args("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, {}, {}, index, 3);
+
+        CheckCommand(std::move(args)).tryExecute(nullptr, &err);
+        errLines.merge(GetLines(err.str()));
+    }
+
+    EXPECT_FALSE(expectedErr.str().empty());
+    EXPECT_EQ(errLines, GetLines(expectedErr.str()));
+}
+
+TEST(CheckCommandTest, Union_Of_Shard_Outputs_Is_Same_As_Output_For_Whole_Project_If_Some_File_Is_Not_Parsed)
+{
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    tmp.writeFile("api/broken/broken.proto", GetFileHeader("busrpc.api.broken") + "message Broken {\n");
+
+    // broken file is imported by the services, which are likely to belong to other shards
+    for (const std::string name: {"first", "second", "third", "fourth"}) {
+        tmp.writeFile("implementation/" + name + "/service.proto",
+                      GetFileHeader("busrpc.implementation." + name, {"api/broken/broken.proto"}));
+    }
+
+    std::ostringstream expectedErr;
+    std::set<std::string> errLines;
+    std::size_t brokenFileErrorCount = 0;
+    CheckCommand({"tmp", BUSRPC_TESTS_PROTOBUF_ROOT}).tryExecute(nullptr, &expectedErr);
+
+    for (std::size_t index = 0; index < 3; ++index) {
+        std::ostringstream err;
+        CheckArgs args("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, {}, {}, index, 3);
+        CheckCommand(std::move(args)).tryExecute(nullptr, &err);
+
+        for (const auto& line: GetLines(err.str())) {
+            if (line.find("file='api/broken/broken.proto'") != std::string::npos) {
+                ++brokenFileErrorCount;
+            }
+
+            errLines.insert(line);
+        }
+    }
+
+    // project is not checked if some file is not parsed, so whole project output contains only parser errors
+    EXPECT_NE(expectedErr.str().find("file='api/broken/broken.proto'"), std::string::npos);
+    EXPECT_EQ(errLines, GetLines(expectedErr.str()));
+    EXPECT_EQ(brokenFileErrorCount, 1);
+}
+
+TEST(CheckCommandTest, Invalid_Scope_Error_If_Shard_Is_Invalid)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    CheckArgs args("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, {}, {}, 3, 3);
+
+    EXPECT_COMMAND_EXCEPTION(CheckCommand(std::move(args)).execute(nullptr, &err), CheckErrc::Invalid_Scope);
+    EXPECT_FALSE(err.str().empty());
+}
+
 TEST(CheckCommandTest, Spec_Violated_Error_If_Spec_Error_Detected)
 {
     std::ostringstream err;
@@ -293,4 +415,63 @@ TEST(CheckCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcomma
     EXPECT_FALSE(out.str().empty());
     EXPECT_TRUE(err.str().empty());
 }
+
+TEST(CheckCommandTest, App_Runs_Command_For_Project_Shard)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    int argc = 8;
+    const char* argv[] = {
+        "busrpc", GetCommandName(CommandId::Check), "-r", "tmp", "-p", BUSRPC_TESTS_PROTOBUF_ROOT, "--shard", "2/2"};
+
+    EXPECT_NO_THROW(app.parse(argc, argv));
+    EXPECT_FALSE(out.str().empty());
+    EXPECT_TRUE(err.str().empty());
+}
+
+TEST(CheckCommandTest, App_Rejects_Invalid_Shard)
+{
+    for (const char* shard: {"0/2", "3/2", "1", "1/", "/2", "-1/2", "a/b", "1/2x"}) {
+        std::ostringstream out, err;
+        CLI::App app;
+        InitApp(app, out, err);
+
+        int argc = 4;
+        const char* argv[] = {"busrpc", GetCommandName(CommandId::Check), "--shard", shard};
+
+        EXPECT_THROW(app.parse(argc, argv), CLI::ParseError) << shard;
+    }
+}
+
+TEST(CheckCommandTest, Command_Output_Does_Not_Depend_On_Whether_Cache_Is_Used)
+{
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    TmpDir cacheDir("cache");
+
+    std::string undocumentedStruct = "syntax = \"proto3\";\n"
+                                     "package busrpc;\n"
+                                     "message MyStruct {}";
+    tmp.writeFile("file.proto", undocumentedStruct);
+
+    std::ostringstream expectedOut, expectedErr;
+    std::ostringstream out1, err1;
+    std::ostringstream out2, err2;
+    CheckArgs args("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, cacheDir.path() / "cache.json");
+
+    EXPECT_NO_THROW(CheckCommand({"tmp", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&expectedOut, &expectedErr));
+    EXPECT_NO_THROW(CheckCommand(args).execute(&out1, &err1));
+    EXPECT_TRUE(std::filesystem::is_regular_file(cacheDir.path() / "cache.json"));
+    EXPECT_NO_THROW(CheckCommand(args).execute(&out2, &err2));
+    EXPECT_FALSE(expectedErr.str().empty());
+    EXPECT_EQ(out1.str(), expectedOut.str());
+    EXPECT_EQ(err1.str(), expectedErr.str());
+    EXPECT_EQ(out2.str(), expectedOut.str());
+    EXPECT_EQ(err2.str(), expectedErr.str());
+}
 }} // namespace busrpc::test
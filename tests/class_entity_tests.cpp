@@ -50,6 +50,17 @@ TEST_F(ClassEntityTest, addMethod_Stores_Added_Method)
     EXPECT_EQ(cls_->methods().size(), 1);
 }
 
+TEST_F(ClassEntityTest, tryAddMethod_Stores_Added_Method_And_Returns_Error_On_Conflict)
+{
+    auto result = cls_->tryAddMethod("method");
+
+    ASSERT_TRUE(result);
+    ASSERT_NE(cls_->methods().find("method"), cls_->methods().end());
+    EXPECT_EQ(*(cls_->methods().find("method")), result.value());
+    EXPECT_EQ(cls_->tryAddMethod("method").error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(cls_->methods().size(), 1);
+}
+
 TEST_F(ClassEntityTest, Adding_ClassDesc_Struct_Sets_Class_Descriptor)
 {
     Struct* desc = nullptr;
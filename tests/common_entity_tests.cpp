@@ -31,6 +31,18 @@ public:
     }
 
     using CompositeEntity::addNestedEntity;
+    using CompositeEntity::tryAddNestedEntity;
+};
+
+class CountedEntity: public TestEntity {
+public:
+    CountedEntity(CompositeEntity* parent, EntityTypeId type, const std::string& name):
+        TestEntity(parent, type, name)
+    {
+        ++CreatedCount;
+    }
+
+    static inline int CreatedCount = 0;
 };
 
 TEST(CommonEntityTest, GetEntityTypeIdStr_Returns_Non_Nullptr_For_Known_Entity_Type)
@@ -180,6 +192,77 @@ TEST(CommonEntityTest, Composite_Entity_Throws_Name_Conflict_Error_If_Added_Enti
                                    "api");
 }
 
+TEST(CommonEntityTest, Entity_Error_Category_Messages_Are_Not_Empty)
+{
+    EXPECT_TRUE(entity_error_category().name());
+    EXPECT_FALSE(entity_error_category().message(static_cast<int>(EntityErrc::Invalid_Name)).empty());
+    EXPECT_FALSE(entity_error_category().message(static_cast<int>(EntityErrc::Name_Conflict)).empty());
+    EXPECT_FALSE(entity_error_category().message(static_cast<int>(EntityErrc::Invalid_Entity)).empty());
+    EXPECT_FALSE(entity_error_category().message(0).empty());
+}
+
+TEST(CommonEntityTest, Composite_Entity_Try_Add_Stores_Added_Nested_Entities)
+{
+    Entity* ptrInsideCb = nullptr;
+    TestCompositeEntity parent(
+        nullptr, EntityTypeId::Project, "project", [&ptrInsideCb](Entity* entity) { ptrInsideCb = entity; });
+
+    auto result = parent.tryAddNestedEntity<TestEntity>("api", EntityTypeId::Api, "api");
+
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(result.hasValue());
+    EXPECT_FALSE(result.error());
+    EXPECT_EQ(result->name(), "api");
+    ASSERT_EQ(parent.nested().size(), 1);
+    EXPECT_EQ(*(parent.nested().find("api")), result.value());
+    EXPECT_EQ(ptrInsideCb, result.value());
+}
+
+TEST(CommonEntityTest, Composite_Entity_Try_Add_Does_Not_Create_Entity_If_Name_Conflicts_With_Existing)
+{
+    TestCompositeEntity parent(nullptr, EntityTypeId::Project, "project");
+    auto entity = parent.addNestedEntity<TestEntity>(EntityTypeId::Api, "api");
+    int createdCount = CountedEntity::CreatedCount;
+
+    auto result = parent.tryAddNestedEntity<CountedEntity>("api", EntityTypeId::Implementation, "api");
+
+    EXPECT_FALSE(result);
+    EXPECT_FALSE(result.value());
+    EXPECT_EQ(result.error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(CountedEntity::CreatedCount, createdCount);
+    ASSERT_EQ(parent.nested().size(), 1);
+    EXPECT_EQ(*(parent.nested().find("api")), entity);
+}
+
+TEST(CommonEntityTest, Composite_Entity_Try_Add_Does_Not_Create_Entity_If_Name_Is_Invalid)
+{
+    TestCompositeEntity parent(nullptr, EntityTypeId::Project, "project");
+    int createdCount = CountedEntity::CreatedCount;
+
+    auto result = parent.tryAddNestedEntity<CountedEntity>("1api", EntityTypeId::Api, "1api");
+
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.error(), EntityErrc::Invalid_Name);
+    EXPECT_EQ(CountedEntity::CreatedCount, createdCount);
+    EXPECT_TRUE(parent.nested().empty());
+}
+
+TEST(CommonEntityTest, Composite_Entity_Try_Add_Returns_Invalid_Entity_Error_If_Entity_Ctor_Throws)
+{
+    Project project;
+    auto api = project.addApi();
+
+    auto structResult = api->tryAddStruct("Struct", "dir/file.proto");
+    auto enumResult = api->tryAddEnum("enum", "");
+
+    EXPECT_EQ(structResult.error(), EntityErrc::Invalid_Entity);
+    EXPECT_EQ(enumResult.error(), EntityErrc::Invalid_Entity);
+    EXPECT_TRUE(api->nested().empty());
+    EXPECT_TRUE(api->structs().empty());
+    EXPECT_TRUE(api->enums().empty());
+    EXPECT_FALSE(project.find(api->dname() + ".Struct"));
+}
+
 TEST(CommonEntityTest, On_Nested_Entity_Added_Callback_Is_Invoked_For_Added_Entity)
 {
     Entity* ptrInsideCb = nullptr;
@@ -255,6 +338,25 @@ TEST(CommonEntityTest, General_Composite_Entity_Stores_Added_Enums)
     EXPECT_EQ(*(api->enums().find("enum")), entity);
 }
 
+TEST(CommonEntityTest, General_Composite_Entity_Try_Add_Stores_Added_Structs_And_Enums)
+{
+    Project project;
+    auto api = project.addApi();
+
+    auto structResult = api->tryAddStruct("Struct", "file.proto");
+    auto enumResult = api->tryAddEnum("enum", "file.proto");
+
+    ASSERT_TRUE(structResult);
+    ASSERT_TRUE(enumResult);
+    ASSERT_NE(api->structs().find("Struct"), api->structs().end());
+    ASSERT_NE(api->enums().find("enum"), api->enums().end());
+    EXPECT_EQ(*(api->structs().find("Struct")), structResult.value());
+    EXPECT_EQ(*(api->enums().find("enum")), enumResult.value());
+    EXPECT_EQ(project.find(api->dname() + ".Struct"), structResult.value());
+    EXPECT_EQ(api->tryAddEnum("Struct", "file.proto").error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(api->enums().size(), 1);
+}
+
 TEST(CommonEntityTest, Struct_Type_Id_Is_Mapped_To_Predefined_Struct_Name_If_It_Exists)
 {
     EXPECT_EQ(StructTypeId::General, GetStructTypeId(GetPredefinedStructName(StructTypeId::General)));
@@ -0,0 +1,228 @@
+#include "api_diff.h"
+#include "app.h"
+#include "commands/diff/diff_command.h"
+#include "commands/help/help_command.h"
+#include "tests_configure.h"
+#include "utils/common.h"
+#include "utils/project_utils.h"
+
+#include <CLI/CLI.hpp>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <sstream>
+
+namespace busrpc { namespace test {
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string GetEnumFile(int32_t constantValue)
+{
+    return GetFileHeader("busrpc") + "// Enum.\n"
+                                     "enum MyEnum {\n"
+                                     "  // Constant 0.\n"
+                                     "  MY_ENUM_0 = 0;\n"
+                                     "  // Constant 1.\n"
+                                     "  MY_ENUM_1 = " +
+           std::to_string(constantValue) + ";\n}\n";
+}
+} // namespace
+
+TEST(DiffCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
+{
+    EXPECT_EQ(CommandId::Diff, GetCommandId(GetCommandName(CommandId::Diff)));
+    EXPECT_EQ(DiffCommand::Id, CommandId::Diff);
+    EXPECT_STREQ(DiffCommand::Name, GetCommandName(CommandId::Diff));
+}
+
+TEST(DiffCommandTest, Command_Error_Category_Name_Matches_Command_Name)
+{
+    EXPECT_STREQ(diff_error_category().name(), GetCommandName(CommandId::Diff));
+}
+
+TEST(DiffCommandTest, Description_For_Unknown_Command_Error_Code_Is_Not_Empty)
+{
+    EXPECT_FALSE(diff_error_category().message(0).empty());
+}
+
+TEST(DiffCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From_Known_Error_Codes_Descriptions)
+{
+    EXPECT_NE(diff_error_category().message(static_cast<int>(DiffErrc::Breaking_Change)),
+              diff_error_category().message(0));
+    EXPECT_NE(diff_error_category().message(static_cast<int>(DiffErrc::Spec_Violated)),
+              diff_error_category().message(0));
+    EXPECT_NE(diff_error_category().message(static_cast<int>(DiffErrc::Protobuf_Parsing_Failed)),
+              diff_error_category().message(0));
+    EXPECT_NE(diff_error_category().message(static_cast<int>(DiffErrc::File_Read_Failed)),
+              diff_error_category().message(0));
+    EXPECT_NE(diff_error_category().message(static_cast<int>(DiffErrc::Invalid_Project_Dir)),
+              diff_error_category().message(0));
+}
+
+TEST(DiffCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
+{
+    EXPECT_EQ(std::error_code(DiffErrc::Breaking_Change), CommandError::Spec_Violated);
+    EXPECT_EQ(std::error_code(DiffErrc::Spec_Violated), CommandError::Spec_Violated);
+    EXPECT_EQ(std::error_code(DiffErrc::Protobuf_Parsing_Failed), CommandError::Protobuf_Parsing_Failed);
+    EXPECT_EQ(std::error_code(DiffErrc::File_Read_Failed), CommandError::File_Operation_Failed);
+    EXPECT_EQ(std::error_code(DiffErrc::Invalid_Project_Dir), CommandError::Invalid_Argument);
+}
+
+TEST(DiffCommandTest, Help_Is_Defined_For_The_Command)
+{
+    HelpCommand helpCmd({CommandId::Diff});
+    std::ostringstream out, err;
+
+    EXPECT_NO_THROW(helpCmd.execute(&out, &err));
+    EXPECT_TRUE(IsHelpMessage(out.str(), CommandId::Diff));
+    EXPECT_TRUE(err.str().empty());
+}
+
+TEST(DiffCommandTest, Command_Succeeds_For_Compatible_Projects_And_Outputs_Diff)
+{
+    std::ostringstream out, err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateTestProject(oldDir);
+    CreateTestProject(newDir);
+    oldDir.writeFile("file.proto", GetEnumFile(1));
+    newDir.writeFile("file.proto", GetEnumFile(1));
+
+    EXPECT_NO_THROW(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    json diff = json::parse(out.str());
+    EXPECT_TRUE(diff["compatible"].get<bool>());
+    EXPECT_TRUE(diff["changes"].empty());
+    EXPECT_GT(diff["unchanged"].get<std::size_t>(), 0);
+}
+
+TEST(DiffCommandTest, Breaking_Change_Error_If_New_Project_Is_Not_Wire_Compatible)
+{
+    std::ostringstream out, err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateTestProject(oldDir);
+    CreateTestProject(newDir);
+    oldDir.writeFile("file.proto", GetEnumFile(1));
+    newDir.writeFile("file.proto", GetEnumFile(2));
+
+    EXPECT_COMMAND_EXCEPTION(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err),
+                             DiffErrc::Breaking_Change);
+    EXPECT_FALSE(err.str().empty());
+
+    json diff = json::parse(out.str());
+    EXPECT_FALSE(diff["compatible"].get<bool>());
+    ASSERT_EQ(diff["changes"].size(), 1);
+    EXPECT_EQ(diff["changes"][0]["dname"], "busrpc.MyEnum.MY_ENUM_1");
+    EXPECT_EQ(diff["changes"][0]["kind"], GetApiChangeKindStr(ApiChangeKind::Constant_Value_Changed));
+    EXPECT_EQ(diff["changes"][0]["old"], "1");
+    EXPECT_EQ(diff["changes"][0]["new"], "2");
+}
+
+TEST(DiffCommandTest, Invalid_Project_Dir_If_Project_Dir_Does_Not_Exist)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+
+    EXPECT_COMMAND_EXCEPTION(
+        DiffCommand({"tmp", "missing_project_dir", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(nullptr, &err),
+        DiffErrc::Invalid_Project_Dir);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(DiffCommandTest, Protobuf_Parsing_Failed_Error_If_Some_File_Is_Not_Parsed)
+{
+    std::ostringstream err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateMinimalProject(oldDir);
+    CreateMinimalProject(newDir);
+    newDir.writeFile("invalid.proto", "syntax =");
+
+    EXPECT_COMMAND_EXCEPTION(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(nullptr, &err),
+                             DiffErrc::Protobuf_Parsing_Failed);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(DiffCommandTest, Spec_Violated_Error_If_Spec_Error_Detected)
+{
+    std::ostringstream out, err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateMinimalProject(oldDir);
+    CreateMinimalProject(newDir);
+
+    std::string invalidType = "syntax = \"proto3\";\n"
+                              "package busrpc.aaa;\n"
+                              "message MyStruct {}";
+    newDir.writeFile("file.proto", invalidType);
+
+    EXPECT_COMMAND_EXCEPTION(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err),
+                             DiffErrc::Spec_Violated);
+    EXPECT_FALSE(out.str().empty());
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(DiffCommandTest, Spec_Violated_Error_Is_Not_Reported_As_Incompatibility_If_There_Are_No_Changes)
+{
+    std::ostringstream out, err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateTestProject(oldDir);
+    CreateTestProject(newDir);
+    oldDir.writeFile("file.proto", GetEnumFile(1));
+    newDir.writeFile("file.proto", GetEnumFile(1));
+    newDir.writeFile("invalid.proto", GetFileHeader("busrpc.aaa") + "message MyStruct {}");
+
+    EXPECT_COMMAND_EXCEPTION(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err),
+                             DiffErrc::Spec_Violated);
+    EXPECT_NE(err.str().find("violates the specification"), std::string::npos);
+    EXPECT_EQ(err.str().find("not wire-compatible"), std::string::npos);
+
+    json diff = json::parse(out.str());
+    EXPECT_TRUE(diff["compatible"].get<bool>());
+}
+
+TEST(DiffCommandTest, Breaking_Change_Error_If_Project_With_Spec_Error_Is_Not_Wire_Compatible)
+{
+    std::ostringstream out, err;
+    TmpDir oldDir("old");
+    TmpDir newDir("new");
+    CreateTestProject(oldDir);
+    CreateTestProject(newDir);
+    oldDir.writeFile("file.proto", GetEnumFile(1));
+    newDir.writeFile("file.proto", GetEnumFile(2));
+    newDir.writeFile("invalid.proto", GetFileHeader("busrpc.aaa") + "message MyStruct {}");
+
+    EXPECT_COMMAND_EXCEPTION(DiffCommand({"old", "new", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err),
+                             DiffErrc::Breaking_Change);
+    EXPECT_NE(err.str().find("violates the specification"), std::string::npos);
+    EXPECT_NE(err.str().find("not wire-compatible"), std::string::npos);
+
+    json diff = json::parse(out.str());
+    EXPECT_FALSE(diff["compatible"].get<bool>());
+    ASSERT_EQ(diff["changes"].size(), 1);
+    EXPECT_EQ(diff["changes"][0]["dname"], "busrpc.MyEnum.MY_ENUM_1");
+}
+
+TEST(DiffCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcommand)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    int argc = 6;
+    const char* argv[] = {"busrpc", GetCommandName(CommandId::Diff), "-p", BUSRPC_TESTS_PROTOBUF_ROOT, "tmp", "tmp"};
+
+    EXPECT_NO_THROW(app.parse(argc, argv));
+    EXPECT_FALSE(out.str().empty());
+    EXPECT_TRUE(err.str().empty());
+}
+}} // namespace busrpc::test
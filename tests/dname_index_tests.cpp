@@ -0,0 +1,163 @@
+#include "entities/dname_index.h"
+#include "entities/project.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace busrpc { namespace test {
+
+class DnameIndexTest: public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        auto api = project_.addApi();
+        auto billing = api->addNamespace("billing");
+        billing->addClass("invoice")->addMethod("create");
+        billing->addClass("account");
+        api->addNamespace("bill");
+        api->addNamespace("users")->addStruct("User", "file.proto")->addScalarField("name", 1, FieldTypeId::String);
+        project_.addImplementation()->addService("billing");
+        index_ = DnameIndex(project_);
+    }
+
+    static std::vector<std::string> GetDnames(std::span<const DnameIndex::Entry> entries)
+    {
+        std::vector<std::string> result;
+
+        for (const auto& entry: entries) {
+            result.emplace_back(entry.dname);
+        }
+
+        return result;
+    }
+
+    Project project_;
+    DnameIndex index_;
+};
+
+TEST_F(DnameIndexTest, Index_Contains_All_Subtree_Entities_Sorted_By_Dname)
+{
+    auto dnames = GetDnames(index_.entries());
+
+    EXPECT_EQ(index_.size(), dnames.size());
+    EXPECT_TRUE(std::is_sorted(dnames.begin(), dnames.end()));
+    EXPECT_EQ(dnames.front(), "busrpc");
+    EXPECT_NE(std::find(dnames.begin(), dnames.end(), "busrpc.api.users.User.name"), dnames.end());
+}
+
+TEST_F(DnameIndexTest, Empty_Index_Does_Not_Contain_Entities)
+{
+    DnameIndex index;
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.find("busrpc"));
+    EXPECT_TRUE(index.findPrefix("").empty());
+    EXPECT_TRUE(index.complete("").empty());
+}
+
+TEST_F(DnameIndexTest, find_Returns_Entity_With_Exactly_Matching_Dname)
+{
+    EXPECT_EQ(index_.find("busrpc"), &project_);
+    EXPECT_EQ(index_.find("busrpc.api.billing.invoice.create"), project_.find("api.billing.invoice.create"));
+    EXPECT_EQ(index_.find("busrpc.api.bill"), project_.find("api.bill"));
+    EXPECT_FALSE(index_.find("busrpc.api.bil"));
+    EXPECT_FALSE(index_.find("busrpc.api.billings"));
+    EXPECT_FALSE(index_.find(""));
+}
+
+TEST_F(DnameIndexTest, findPrefix_Returns_Entities_With_Dname_Starting_With_Prefix)
+{
+    EXPECT_EQ(GetDnames(index_.findPrefix("busrpc.api.bil")),
+              std::vector<std::string>({"busrpc.api.bill",
+                                        "busrpc.api.billing",
+                                        "busrpc.api.billing.account",
+                                        "busrpc.api.billing.invoice",
+                                        "busrpc.api.billing.invoice.create"}));
+    EXPECT_EQ(GetDnames(index_.findPrefix("busrpc.implementation.")),
+              std::vector<std::string>({"busrpc.implementation.billing"}));
+    EXPECT_EQ(index_.findPrefix("").size(), index_.size());
+    EXPECT_TRUE(index_.findPrefix("busrpc.api.unknown").empty());
+    EXPECT_TRUE(index_.findPrefix("busrpc.api.billing.invoice.created").empty());
+}
+
+TEST_F(DnameIndexTest, findScope_Returns_Scope_Entity_And_Nested_Entities)
+{
+    EXPECT_EQ(GetDnames(index_.findScope("busrpc.api.bill")), std::vector<std::string>({"busrpc.api.bill"}));
+    EXPECT_EQ(GetDnames(index_.findScope("busrpc.api.billing")),
+              std::vector<std::string>({"busrpc.api.billing",
+                                        "busrpc.api.billing.account",
+                                        "busrpc.api.billing.invoice",
+                                        "busrpc.api.billing.invoice.create"}));
+    EXPECT_TRUE(index_.findScope("busrpc.api.bil").empty());
+    EXPECT_TRUE(index_.findScope("busrpc.api.unknown").empty());
+}
+
+TEST_F(DnameIndexTest, complete_Returns_Entities_Without_Separator_After_Prefix)
+{
+    EXPECT_EQ(GetDnames(index_.complete("busrpc.api.bil")),
+              std::vector<std::string>({"busrpc.api.bill", "busrpc.api.billing"}));
+    EXPECT_EQ(GetDnames(index_.complete("busrpc.api.billing.")),
+              std::vector<std::string>({"busrpc.api.billing.account", "busrpc.api.billing.invoice"}));
+    EXPECT_EQ(GetDnames(index_.complete("busrpc.api.users.User.n")),
+              std::vector<std::string>({"busrpc.api.users.User.name"}));
+    EXPECT_EQ(GetDnames(index_.complete("busrpc.api.billing.invoice.create")),
+              std::vector<std::string>({"busrpc.api.billing.invoice.create"}));
+    EXPECT_EQ(GetDnames(index_.complete("")), std::vector<std::string>({"busrpc"}));
+    EXPECT_TRUE(index_.complete("busrpc.api.x").empty());
+}
+
+TEST_F(DnameIndexTest, complete_Returns_At_Most_Limit_Entities)
+{
+    EXPECT_EQ(GetDnames(index_.complete("busrpc.api.", 2)),
+              std::vector<std::string>({"busrpc.api.bill", "busrpc.api.billing"}));
+    EXPECT_TRUE(index_.complete("busrpc.api.", 0).empty());
+}
+
+TEST_F(DnameIndexTest, Moved_Index_Refers_To_The_Same_Entities)
+{
+    DnameIndex index = std::move(index_);
+
+    EXPECT_EQ(index.find("busrpc.api.billing"), project_.find("api.billing"));
+    EXPECT_EQ(GetDnames(index.findScope("busrpc.api.users")),
+              std::vector<std::string>({"busrpc.api.users", "busrpc.api.users.User", "busrpc.api.users.User.name"}));
+}
+
+TEST_F(DnameIndexTest, Index_Is_Built_When_Project_Is_Frozen)
+{
+    auto project = std::make_shared<Project>();
+    project->addApi()->addNamespace("billing");
+
+    EXPECT_EQ(project->dnames().size(), 0);
+
+    auto frozen = Project::Freeze(project);
+
+    EXPECT_EQ(frozen->dnames().size(), 3);
+    EXPECT_EQ(frozen->dnames().find("busrpc.api.billing"), frozen->find("api.billing"));
+}
+
+TEST_F(DnameIndexTest, Index_Of_Frozen_Project_Is_Built_Once_If_Accessed_Concurrently)
+{
+    auto project = std::make_shared<Project>();
+    project->addApi()->addNamespace("billing");
+    auto frozen = Project::Freeze(project);
+    std::vector<std::size_t> sizes(4);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        threads.emplace_back([&frozen, &sizes, i]() { sizes[i] = frozen->dnames().size(); });
+    }
+
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(sizes, std::vector<std::size_t>(sizes.size(), 3));
+}
+}} // namespace busrpc::test
@@ -1,6 +1,7 @@
 #include "commands/check/check_command.h"
 #include "commands/imports/imports_command.h"
 #include "error_collector.h"
+#include "protobuf_error_collector.h"
 #include "utils.h"
 
 #include <gtest/gtest.h>
@@ -59,6 +60,39 @@ TEST(ErrorCollectorTest, add_Correctly_Initializes_Error_Description)
     EXPECT_EQ(ecol.errors()[0].description, ecol.majorError()->description);
 }
 
+TEST(ErrorCollectorTest, add_Stores_Error_Location)
+{
+    ErrorCollector ecol;
+    ecol.add({.file = "dir/file.proto", .line = 1, .column = 2}, CheckErrc::Protobuf_Parsing_Failed, "test");
+    ecol.add({.entity = "busrpc.Struct"}, CheckErrc::Spec_Violated);
+    ecol.add(CheckErrc::File_Read_Failed);
+
+    ASSERT_EQ(ecol.errors().size(), 3);
+    EXPECT_EQ(ecol.errors()[0].location.file, "dir/file.proto");
+    EXPECT_EQ(ecol.errors()[0].location.line, 1);
+    EXPECT_EQ(ecol.errors()[0].location.column, 2);
+    EXPECT_TRUE(ecol.errors()[0].location.entity.empty());
+    EXPECT_NE(ecol.errors()[0].description.find("test"), std::string::npos);
+    EXPECT_TRUE(ecol.errors()[1].location.file.empty());
+    EXPECT_EQ(ecol.errors()[1].location.line, -1);
+    EXPECT_EQ(ecol.errors()[1].location.column, -1);
+    EXPECT_EQ(ecol.errors()[1].location.entity, "busrpc.Struct");
+    EXPECT_TRUE(ecol.errors()[2].location.file.empty());
+    EXPECT_TRUE(ecol.errors()[2].location.entity.empty());
+}
+
+TEST(ErrorCollectorTest, Protobuf_Errors_Are_Stored_With_Location)
+{
+    ErrorCollector ecol(CheckErrc::Protobuf_Parsing_Failed);
+    ecol.getProtobufCollector()->AddError("dir/file.proto", 3, 4, "error");
+
+    ASSERT_EQ(ecol.errors().size(), 1);
+    EXPECT_EQ(ecol.errors()[0].location.file, "dir/file.proto");
+    EXPECT_EQ(ecol.errors()[0].location.line, 3);
+    EXPECT_EQ(ecol.errors()[0].location.column, 4);
+    EXPECT_NE(ecol.errors()[0].description.find("file='dir/file.proto'"), std::string::npos);
+}
+
 TEST(ErrorCollectorTest, find_Returns_First_Found_Error_Code)
 {
     ErrorCollector ecol;
@@ -216,4 +250,55 @@ TEST(ErrorCollectorTest, Collector_Guard_Outputs_Errors_In_Destructor)
     EXPECT_NE(lines[2].find(check_error_category().message(static_cast<int>(CheckErrc::Style_Violated))),
               std::string::npos);
 }
+
+TEST(ErrorCollectorTest, add_Stores_Error_Info_Collected_By_Another_Collector)
+{
+    ErrorCollector source;
+    source.add(CheckErrc::Protobuf_Parsing_Failed, "test");
+    source.add(CheckErrc::File_Read_Failed);
+    ErrorCollector ecol(SeverityByErrorCodeValue, {});
+
+    for (const auto& error: source.errors()) {
+        ecol.add(error);
+    }
+
+    ecol.add(source.errors()[0]);
+
+    ASSERT_EQ(ecol.errors().size(), 2);
+    EXPECT_EQ(ecol.errors()[0].code, source.errors()[0].code);
+    EXPECT_EQ(ecol.errors()[0].description, source.errors()[0].description);
+    EXPECT_EQ(ecol.errors()[1].code, source.errors()[1].code);
+    EXPECT_EQ(ecol.errors()[1].description, source.errors()[1].description);
+    ASSERT_TRUE(ecol.majorError());
+    EXPECT_EQ(ecol.majorError()->code, CheckErrc::File_Read_Failed);
+}
+
+TEST(ErrorCollectorTest, add_Does_Not_Store_Error_Info_With_Ignored_Category)
+{
+    ErrorCollector source;
+    source.add(CheckErrc::Protobuf_Parsing_Failed);
+    ErrorCollector ecol({}, {&check_error_category()});
+    ecol.add(source.errors()[0]);
+
+    EXPECT_FALSE(ecol);
+    EXPECT_TRUE(ecol.errors().empty());
+}
+
+TEST(ErrorCollectorTest, filter_Creates_Collector_Without_Errors_With_Ignored_Categories)
+{
+    ErrorCollector source(SeverityByErrorCodeValue, {});
+    source.add(CheckErrc::Protobuf_Parsing_Failed);
+    source.add(ImportsErrc::File_Read_Failed);
+    source.add(CheckErrc::File_Read_Failed);
+
+    ErrorCollector ecol = source.filter({&imports_error_category()});
+
+    EXPECT_EQ(ecol.getProtobufCollector(), nullptr);
+    ASSERT_EQ(ecol.errors().size(), 2);
+    EXPECT_EQ(ecol.errors()[0].code, CheckErrc::Protobuf_Parsing_Failed);
+    EXPECT_EQ(ecol.errors()[1].code, CheckErrc::File_Read_Failed);
+    ASSERT_TRUE(ecol.majorError());
+    EXPECT_EQ(ecol.majorError()->code, CheckErrc::File_Read_Failed);
+    EXPECT_EQ(source.errors().size(), 3);
+}
 }} // namespace busrpc::test
@@ -7,11 +7,24 @@
 
 #include <CLI/CLI.hpp>
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <string>
 
 namespace busrpc { namespace test {
 
+using json = nlohmann::json;
+
+std::string ReadWholeFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
 TEST(GenDocCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
 {
     EXPECT_EQ(CommandId::GenDoc, GetCommandId(GetCommandName(CommandId::GenDoc)));
@@ -41,6 +54,10 @@ TEST(GenDocCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From_
               gendoc_error_category().message(0));
     EXPECT_NE(gendoc_error_category().message(static_cast<int>(GenDocErrc::Invalid_Project_Dir)),
               gendoc_error_category().message(0));
+    EXPECT_NE(gendoc_error_category().message(static_cast<int>(GenDocErrc::Unsupported_Format)),
+              gendoc_error_category().message(0));
+    EXPECT_NE(gendoc_error_category().message(static_cast<int>(GenDocErrc::Invalid_Scope)),
+              gendoc_error_category().message(0));
 }
 
 TEST(GenDocCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
@@ -50,6 +67,8 @@ TEST(GenDocCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
     EXPECT_EQ(std::error_code(GenDocErrc::File_Read_Failed), CommandError::File_Operation_Failed);
     EXPECT_EQ(std::error_code(GenDocErrc::File_Write_Failed), CommandError::File_Operation_Failed);
     EXPECT_EQ(std::error_code(GenDocErrc::Invalid_Project_Dir), CommandError::Invalid_Argument);
+    EXPECT_EQ(std::error_code(GenDocErrc::Unsupported_Format), CommandError::Invalid_Argument);
+    EXPECT_EQ(std::error_code(GenDocErrc::Invalid_Scope), CommandError::Invalid_Argument);
 }
 
 TEST(GenDocCommandTest, Help_Is_Defined_For_The_Command)
@@ -75,6 +94,173 @@ TEST(GenDocCommandTest, Command_Succeeds_For_Valid_Project_And_Outputs_Success_M
     EXPECT_TRUE(std::filesystem::is_regular_file(std::string("out/") + Json_Doc_File));
 }
 
+TEST(GenDocCommandTest, Command_Generates_Same_Documentation_Regardless_Of_Number_Of_Jobs)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    TmpDir parallelOutputDir("parallel_out");
+    CreateTestProject(tmp);
+
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err));
+    EXPECT_NO_THROW(
+        GenDocCommand({GenDocFormat::Json, "tmp", "parallel_out", BUSRPC_TESTS_PROTOBUF_ROOT, 4}).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_EQ(ReadWholeFile(std::string("parallel_out/") + Json_Doc_File),
+              ReadWholeFile(std::string("out/") + Json_Doc_File));
+}
+
+TEST(GenDocCommandTest, Command_Writes_Sharded_Documentation_If_Requested)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, true})
+                        .execute(&out, &err));
+    EXPECT_FALSE(out.str().empty());
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_FALSE(std::filesystem::exists(std::string("out/") + Json_Doc_File));
+    EXPECT_TRUE(std::filesystem::is_regular_file(std::filesystem::path("out") / Json_Doc_Shards_Dir /
+                                                 Json_Doc_Index_File));
+    EXPECT_TRUE(std::filesystem::is_regular_file(std::filesystem::path("out") / Json_Doc_Shards_Dir /
+                                                 "busrpc.api.json"));
+}
+
+TEST(GenDocCommandTest, Command_Rewrites_Only_Changed_Shards_And_Removes_Stale_Ones)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+    auto shardsDir = std::filesystem::path("out") / Json_Doc_Shards_Dir;
+
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, true})
+                        .execute(&out, &err));
+    ASSERT_TRUE(std::filesystem::is_regular_file(shardsDir / Doc_Manifest_File));
+
+    auto apiTime = std::filesystem::last_write_time(shardsDir / "busrpc.api.json");
+    std::filesystem::remove_all("tmp/implementation");
+
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, true})
+                        .execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_EQ(std::filesystem::last_write_time(shardsDir / "busrpc.api.json"), apiTime);
+    EXPECT_FALSE(std::filesystem::exists(shardsDir / "busrpc.implementation.json"));
+}
+
+TEST(GenDocCommandTest, Command_Writes_Binary_Documentation_With_The_Same_Schema_As_Json_Documentation)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err));
+    EXPECT_NO_THROW(GenDocCommand({GenDocFormat::Cbor, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err));
+    EXPECT_NO_THROW(
+        GenDocCommand({GenDocFormat::MsgPack, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT}).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto expected = json::parse(ReadWholeFile(std::string("out/") + Json_Doc_File));
+
+    EXPECT_EQ(json::from_cbor(ReadWholeFile(std::string("out/") + Cbor_Doc_File)), expected);
+    EXPECT_EQ(json::from_msgpack(ReadWholeFile(std::string("out/") + MsgPack_Doc_File)), expected);
+}
+
+TEST(GenDocCommandTest, Unsupported_Format_Error_If_Sharded_Documentation_Is_Requested_In_Binary_Format)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateMinimalProject(tmp);
+
+    EXPECT_COMMAND_EXCEPTION(
+        GenDocCommand({GenDocFormat::Cbor, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, true}).execute(nullptr, &err),
+        GenDocErrc::Unsupported_Format);
+    EXPECT_FALSE(err.str().empty());
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path("out") / Json_Doc_Shards_Dir));
+}
+
+TEST(GenDocCommandTest, Command_Writes_Compact_Documentation_If_Requested)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+
+    GenDocArgs args(GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, false, true);
+
+    EXPECT_NO_THROW(GenDocCommand(std::move(args)).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto doc = json::parse(ReadWholeFile(std::string("out/") + Json_Doc_File));
+
+    EXPECT_EQ(doc["schema"], Compact_Json_Schema);
+    EXPECT_EQ(doc["version"], Compact_Json_Schema_Version);
+    EXPECT_TRUE(doc["project"].is_object());
+}
+
+TEST(GenDocCommandTest, Unsupported_Format_Error_If_Compact_Documentation_Is_Requested_In_Unsupported_Format)
+{
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateMinimalProject(tmp);
+
+    for (bool sharded: {false, true}) {
+        for (auto format: {GenDocFormat::Cbor, GenDocFormat::Json}) {
+            if (!sharded && format == GenDocFormat::Json) {
+                continue;
+            }
+
+            std::ostringstream err;
+            GenDocArgs args(format, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, sharded, true);
+
+            EXPECT_COMMAND_EXCEPTION(GenDocCommand(std::move(args)).execute(nullptr, &err),
+                                     GenDocErrc::Unsupported_Format);
+            EXPECT_FALSE(err.str().empty());
+        }
+    }
+
+    EXPECT_TRUE(std::filesystem::is_empty("out"));
+}
+
+TEST(GenDocCommandTest, Command_Writes_Search_Index_If_Requested)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+    GenDocArgs args(GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, false, false, true);
+    GenDocArgs shardedArgs(GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, true, false, true);
+
+    EXPECT_NO_THROW(GenDocCommand(std::move(args)).execute(&out, &err));
+    EXPECT_NO_THROW(GenDocCommand(std::move(shardedArgs)).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto index = json::parse(ReadWholeFile(std::string("out/") + Search_Index_File));
+
+    EXPECT_EQ(index["schema"], Search_Index_Schema);
+    EXPECT_FALSE(index["entities"].empty());
+    EXPECT_EQ(index["tokens"].size(), index["postings"].size());
+    EXPECT_EQ(ReadWholeFile(std::filesystem::path("out") / Json_Doc_Shards_Dir / Search_Index_File),
+              ReadWholeFile(std::string("out/") + Search_Index_File));
+}
+
+TEST(GenDocCommandTest, Unsupported_Format_Error_If_Search_Index_Is_Requested_For_Binary_Format)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateMinimalProject(tmp);
+    GenDocArgs args(GenDocFormat::MsgPack, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, false, false, true);
+
+    EXPECT_COMMAND_EXCEPTION(GenDocCommand(std::move(args)).execute(nullptr, &err), GenDocErrc::Unsupported_Format);
+    EXPECT_FALSE(err.str().empty());
+    EXPECT_TRUE(std::filesystem::is_empty("out"));
+}
+
 TEST(GenDocCommandTest, Invalid_Project_Dir_Error_If_Project_Dir_Does_Not_Exist)
 {
     std::ostringstream err;
@@ -87,6 +273,46 @@ TEST(GenDocCommandTest, Invalid_Project_Dir_Error_If_Project_Dir_Does_Not_Exist)
     EXPECT_FALSE(std::filesystem::exists(std::string("out/") + Json_Doc_File));
 }
 
+TEST(GenDocCommandTest, Invalid_Scope_Error_If_Scope_Does_Not_Denote_Entity_Directory)
+{
+    std::ostringstream err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+    GenDocArgs args(
+        GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT, 1, false, false, false, "busrpc.api.missing");
+
+    EXPECT_COMMAND_EXCEPTION(GenDocCommand(std::move(args)).execute(nullptr, &err), GenDocErrc::Invalid_Scope);
+    EXPECT_FALSE(err.str().empty());
+    EXPECT_FALSE(std::filesystem::exists(std::string("out/") + Json_Doc_File));
+}
+
+TEST(GenDocCommandTest, Command_Documents_Only_Scope_Entity_And_Its_Dependencies)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+    GenDocArgs args(GenDocFormat::Json,
+                    "tmp",
+                    "out",
+                    BUSRPC_TESTS_PROTOBUF_ROOT,
+                    1,
+                    false,
+                    false,
+                    false,
+                    "busrpc.api.namespace.class.oneway_method");
+
+    EXPECT_NO_THROW(GenDocCommand(std::move(args)).execute(&out, &err));
+
+    std::ifstream doc(std::string("out/") + Json_Doc_File);
+    std::string content((std::istreambuf_iterator<char>(doc)), std::istreambuf_iterator<char>());
+
+    EXPECT_NE(content.find("oneway_method"), std::string::npos);
+    EXPECT_EQ(content.find("static_class"), std::string::npos);
+    EXPECT_EQ(content.find("\"service\""), std::string::npos);
+}
+
 TEST(GenDocCommandTest, File_Write_Failed_Error_If_Output_Dir_Does_Not_Exist)
 {
     std::ostringstream err;
@@ -195,7 +421,7 @@ TEST(GenDocCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcomm
     CLI::App app;
     InitApp(app, out, err);
 
-    int argc = 10;
+    int argc = 12;
     const char* argv[] = {"busrpc",
                           GetCommandName(CommandId::GenDoc),
                           "-r",
@@ -205,7 +431,9 @@ TEST(GenDocCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcomm
                           "-d",
                           "out",
                           "--format",
-                          "json"};
+                          "json",
+                          "--jobs",
+                          "2"};
 
     EXPECT_NO_THROW(app.parse(argc, argv));
     EXPECT_FALSE(out.str().empty());
@@ -35,4 +35,15 @@ TEST_F(ImplementationEntityTest, addServices_Stores_Added_Services)
     EXPECT_EQ(*(implementation_->services().find("service")), service);
     EXPECT_EQ(implementation_->services().size(), 1);
 }
+
+TEST_F(ImplementationEntityTest, tryAddService_Stores_Added_Service_And_Returns_Error_On_Conflict)
+{
+    auto result = implementation_->tryAddService("service");
+
+    ASSERT_TRUE(result);
+    ASSERT_NE(implementation_->services().find("service"), implementation_->services().end());
+    EXPECT_EQ(*(implementation_->services().find("service")), result.value());
+    EXPECT_EQ(implementation_->tryAddService("service").error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(implementation_->services().size(), 1);
+}
 }} // namespace busrpc::test
@@ -0,0 +1,126 @@
+#include "import_index.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+namespace busrpc { namespace test {
+
+TEST(ImportIndexTest, find_Returns_Nullptr_For_Unknown_File)
+{
+    ImportIndex index;
+
+    EXPECT_FALSE(index.find("file.proto", 1001));
+    EXPECT_EQ(index.hits(), 0);
+    EXPECT_EQ(index.misses(), 1);
+}
+
+TEST(ImportIndexTest, find_Returns_Nullptr_If_File_Stamp_Changed)
+{
+    ImportIndex index;
+    index.store("file.proto", 1001, {"file1.proto"});
+
+    EXPECT_FALSE(index.find("file.proto", 1002));
+    EXPECT_EQ(index.misses(), 1);
+}
+
+TEST(ImportIndexTest, find_Returns_Stored_Imports)
+{
+    ImportIndex index;
+    index.store("file.proto", 1001, {"file1.proto", "file2.proto"});
+    auto imports = index.find("file.proto", 1001);
+
+    ASSERT_TRUE(imports);
+    EXPECT_EQ(*imports, ImportIndex::Imports({"file1.proto", "file2.proto"}));
+    EXPECT_EQ(index.hits(), 1);
+    EXPECT_EQ(index.misses(), 0);
+}
+
+TEST(ImportIndexTest, findImporters_Returns_Files_Directly_Or_Indirectly_Importing_Specified_Files)
+{
+    ImportIndex index;
+    index.store("file0.proto", 0, {});
+    index.store("file1.proto", 1, {"file0.proto"});
+    index.store("file2.proto", 2, {"file1.proto"});
+    index.store("file3.proto", 3, {"file2.proto", "file0.proto"});
+    index.store("file4.proto", 4, {});
+
+    using Files = std::set<std::string>;
+
+    EXPECT_EQ(index.findImporters({"file1.proto"}), Files({"file1.proto", "file2.proto", "file3.proto"}));
+    EXPECT_EQ(index.findImporters({"file3.proto", "file4.proto"}), Files({"file3.proto", "file4.proto"}));
+
+    index.store("file4.proto", 5, {"file3.proto"});
+
+    EXPECT_EQ(index.findImporters({"file2.proto"}), Files({"file2.proto", "file3.proto", "file4.proto"}));
+}
+
+TEST(ImportIndexTest, load_Restores_Saved_Index)
+{
+    TmpDir tmp;
+    ImportIndex index;
+    index.store("file.proto", 0xffffffffffffffff, {"aaa/file 1.proto"});
+    index.store("aaa/file 1.proto", 1001, {});
+
+    ASSERT_TRUE(index.save(tmp.path() / "index.json"));
+
+    ImportIndex loaded;
+
+    ASSERT_TRUE(loaded.load(tmp.path() / "index.json"));
+    EXPECT_EQ(loaded.size(), 2);
+    ASSERT_TRUE(loaded.find("aaa/file 1.proto", 1001));
+    EXPECT_TRUE(loaded.find("aaa/file 1.proto", 1001)->empty());
+    ASSERT_TRUE(loaded.find("file.proto", 0xffffffffffffffff));
+    EXPECT_EQ(*loaded.find("file.proto", 0xffffffffffffffff), ImportIndex::Imports({"aaa/file 1.proto"}));
+}
+
+TEST(ImportIndexTest, save_Stores_Only_Used_Entries)
+{
+    TmpDir tmp;
+    ImportIndex index;
+    index.store("file1.proto", 1, {});
+    index.store("file2.proto", 2, {});
+    index.save(tmp.path() / "index.json");
+
+    ImportIndex loaded;
+    loaded.load(tmp.path() / "index.json");
+    loaded.find("file2.proto", 2);
+    loaded.save(tmp.path() / "index.json");
+
+    ImportIndex reloaded;
+
+    ASSERT_TRUE(reloaded.load(tmp.path() / "index.json"));
+    EXPECT_EQ(reloaded.size(), 1);
+    EXPECT_TRUE(reloaded.find("file2.proto", 2));
+}
+
+TEST(ImportIndexTest, load_Returns_False_And_Leaves_Index_Empty_If_File_Is_Invalid)
+{
+    TmpDir tmp;
+    ImportIndex index;
+    index.store("file.proto", 1, {});
+    tmp.writeFile("index.json", "{\"version\": \"0.0.0\", \"files\": {}}");
+
+    EXPECT_FALSE(index.load(tmp.path() / "index.json"));
+    EXPECT_EQ(index.size(), 0);
+
+    tmp.writeFile("index.json", "not a json");
+
+    EXPECT_FALSE(index.load(tmp.path() / "index.json"));
+    EXPECT_FALSE(index.load(tmp.path() / "missing.json"));
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST(ImportIndexTest, GetStamp_Changes_If_File_Is_Changed)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto", "syntax = \"proto3\";");
+    auto stamp = ImportIndex::GetStamp(tmp.path() / "file.proto");
+
+    EXPECT_EQ(ImportIndex::GetStamp(tmp.path() / "file.proto"), stamp);
+
+    tmp.writeFile("file.proto", "syntax = \"proto3\";\npackage test;");
+
+    EXPECT_NE(ImportIndex::GetStamp(tmp.path() / "file.proto"), stamp);
+    EXPECT_THROW(ImportIndex::GetStamp(tmp.path() / "missing.proto"), std::filesystem::filesystem_error);
+}
+}} // namespace busrpc::test
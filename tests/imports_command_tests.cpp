@@ -1,18 +1,62 @@
 #include "app.h"
 #include "commands/help/help_command.h"
 #include "commands/imports/imports_command.h"
+#include "import_index.h"
 #include "tests_configure.h"
 #include "utils.h"
 #include "utils/common.h"
 #include "utils/file_utils.h"
+#include "utils/project_utils.h"
 
 #include <CLI/CLI.hpp>
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <set>
 #include <sstream>
 
 namespace busrpc { namespace test {
 
+namespace {
+
+// Create files forming the following import graph: file3.proto -> aaa/file 2.proto -> file1.proto -> file0.proto,
+// file3.proto -> file1.proto
+void CreateImportGraph(TmpDir& tmp)
+{
+    tmp.writeFile("file0.proto",
+                  "syntax = \"proto3\";"
+                  "package test;");
+    tmp.writeFile("file1.proto",
+                  "syntax = \"proto3\";"
+                  "package test;"
+                  "import \"file0.proto\";");
+    tmp.writeFile("aaa/file 2.proto",
+                  "syntax = \"proto3\";"
+                  "package test.aaa;"
+                  "import \"file1.proto\";");
+    tmp.writeFile("file3.proto",
+                  "syntax = \"proto3\";"
+                  "package test;"
+                  "import \"aaa/file 2.proto\";"
+                  "import \"file1.proto\";");
+}
+
+// Run shell command in the directory and return it's exit status
+int RunInDir(const std::filesystem::path& dir, const std::string& command)
+{
+    return std::system(("cd \"" + dir.string() + "\" && " + command + " > /dev/null 2>&1").c_str());
+}
+
+// Make file modification time newer than modification time of any file created before
+void TouchFile(const std::filesystem::path& file)
+{
+    std::filesystem::last_write_time(file, std::filesystem::file_time_type::clock::now() + std::chrono::seconds(10));
+}
+} // namespace
+
 TEST(ImportsCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
 {
     EXPECT_EQ(CommandId::Imports, GetCommandId(GetCommandName(CommandId::Imports)));
@@ -40,6 +84,8 @@ TEST(ImportsCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From
               imports_error_category().message(0));
     EXPECT_NE(imports_error_category().message(static_cast<int>(ImportsErrc::Invalid_Project_Dir)),
               imports_error_category().message(0));
+    EXPECT_NE(imports_error_category().message(static_cast<int>(ImportsErrc::Output_Not_Specified)),
+              imports_error_category().message(0));
 }
 
 TEST(ImportsCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
@@ -48,6 +94,7 @@ TEST(ImportsCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
     EXPECT_EQ(std::error_code(ImportsErrc::File_Read_Failed), CommandError::File_Operation_Failed);
     EXPECT_EQ(std::error_code(ImportsErrc::File_Not_Found), CommandError::Invalid_Argument);
     EXPECT_EQ(std::error_code(ImportsErrc::Invalid_Project_Dir), CommandError::Invalid_Argument);
+    EXPECT_EQ(std::error_code(ImportsErrc::Output_Not_Specified), CommandError::Invalid_Argument);
 }
 
 TEST(ImportsCommandTest, Help_Is_Defined_For_The_Command)
@@ -301,6 +348,420 @@ TEST(ImportsCommandTest, Command_Tries_To_Proceed_After_Error)
     EXPECT_EQ(output[1], "file2.proto");
 }
 
+TEST(ImportsCommandTest, Command_Outputs_All_Project_Files_If_All_Flag_Is_Set)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    EXPECT_NO_THROW(ImportsCommand({{"file1.proto"}, "tmp", "", false, true}).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 4);
+    EXPECT_EQ(output[0], "aaa/file 2.proto");
+    EXPECT_EQ(output[1], "file0.proto");
+    EXPECT_EQ(output[2], "file1.proto");
+    EXPECT_EQ(output[3], "file3.proto");
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Makefile_Rule_For_Each_File_If_Format_Is_Depfile)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    ImportsArgs args({"file3.proto", "file1.proto"},
+                     "tmp",
+                     "",
+                     false,
+                     false,
+                     ImportsFormat::Depfile,
+                     false,
+                     1,
+                     false,
+                     false,
+                     {},
+                     {},
+                     {"gen/%.pb.cc", "gen/%.pb.h"});
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], "gen/file1.pb.cc gen/file1.pb.h: file1.proto file0.proto");
+    EXPECT_EQ(output[1], "gen/file3.pb.cc gen/file3.pb.h: file3.proto aaa/file\\ 2.proto file0.proto file1.proto");
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Ninja_Dyndep_File_If_Format_Is_Ninja)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    std::vector<std::string> outputs = {"gen/%.pb.cc", "gen/%.pb.h"};
+    ImportsArgs args({}, "tmp", "", false, true, ImportsFormat::Ninja, false, 1, false, false, {}, {}, outputs);
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 5);
+    EXPECT_EQ(output[0], "ninja_dyndep_version = 1");
+    EXPECT_EQ(output[1], "build gen/aaa/file$ 2.pb.cc: dyndep | file0.proto file1.proto");
+    EXPECT_EQ(output[2], "build gen/file0.pb.cc: dyndep");
+    EXPECT_EQ(output[3], "build gen/file1.pb.cc: dyndep | file0.proto");
+    EXPECT_EQ(output[4], "build gen/file3.pb.cc: dyndep | aaa/file$ 2.proto file0.proto file1.proto");
+}
+
+TEST(ImportsCommandTest, Output_Not_Specified_Error_If_Rules_Format_Is_Used_Without_Outputs)
+{
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    for (auto format: {ImportsFormat::Depfile, ImportsFormat::Ninja}) {
+        std::ostringstream out, err;
+
+        EXPECT_COMMAND_EXCEPTION(ImportsCommand({{"file1.proto"}, "tmp", "", false, false, format}).execute(&out, &err),
+                                 ImportsErrc::Output_Not_Specified);
+        EXPECT_TRUE(out.str().empty());
+    }
+}
+
+TEST(ImportsCommandTest, Depfile_Makes_Generated_File_Out_Of_Date_When_Imported_File_Changes)
+{
+#ifdef _WIN32
+    GTEST_SKIP() << "make is not available";
+#else
+    if (std::system("make --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "make is not available";
+    }
+
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    ImportsArgs args(
+        {}, "tmp", "", false, true, ImportsFormat::Depfile, false, 1, false, false, {}, {}, {"gen/%.pb.cc"});
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    tmp.writeFile("deps.mk", out.str());
+    tmp.writeFile("Makefile",
+                  "-include deps.mk\n"
+                  "gen/%.pb.cc:\n"
+                  "\tmkdir -p gen && touch $@\n");
+
+    ASSERT_EQ(RunInDir(tmp.path(), "make gen/file3.pb.cc"), 0);
+    EXPECT_EQ(RunInDir(tmp.path(), "make -q gen/file3.pb.cc"), 0);
+
+    TouchFile(tmp.path() / "file0.proto");
+
+    EXPECT_NE(RunInDir(tmp.path(), "make -q gen/file3.pb.cc"), 0);
+#endif
+}
+
+TEST(ImportsCommandTest, Ninja_Dyndep_File_Makes_Generated_File_Out_Of_Date_When_Imported_File_Changes)
+{
+#ifdef _WIN32
+    GTEST_SKIP() << "ninja is not available";
+#else
+    if (std::system("ninja --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "ninja is not available";
+    }
+
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    ImportsArgs args({}, "tmp", "", false, true, ImportsFormat::Ninja, false, 1, false, false, {}, {}, {"gen/%.pb.cc"});
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    tmp.writeFile("deps.txt", out.str());
+    tmp.writeFile("build.ninja",
+                  "rule gen\n"
+                  "  command = mkdir -p gen/aaa && touch '$out'\n"
+                  "rule copy\n"
+                  "  command = cp $in $out\n"
+                  "build deps.dd: copy deps.txt\n"
+                  "build gen/file0.pb.cc: gen file0.proto || deps.dd\n"
+                  "  dyndep = deps.dd\n"
+                  "build gen/file1.pb.cc: gen file1.proto || deps.dd\n"
+                  "  dyndep = deps.dd\n"
+                  "build gen/aaa/file$ 2.pb.cc: gen aaa/file$ 2.proto || deps.dd\n"
+                  "  dyndep = deps.dd\n"
+                  "build gen/file3.pb.cc: gen file3.proto || deps.dd\n"
+                  "  dyndep = deps.dd\n");
+
+    ASSERT_EQ(RunInDir(tmp.path(), "ninja gen/file3.pb.cc"), 0);
+    EXPECT_EQ(RunInDir(tmp.path(), "ninja -n gen/file3.pb.cc | grep -q 'no work to do'"), 0);
+
+    TouchFile(tmp.path() / "file0.proto");
+
+    EXPECT_NE(RunInDir(tmp.path(), "ninja -n gen/file3.pb.cc | grep -q 'no work to do'"), 0);
+#endif
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Direct_Imports_Of_Each_File_If_Format_Is_Json)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    EXPECT_NO_THROW(ImportsCommand({{"file3.proto"}, "tmp", "", false, false, ImportsFormat::Json}).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    nlohmann::json expected = {{"aaa/file 2.proto", {"file1.proto"}},
+                               {"file0.proto", nlohmann::json::array()},
+                               {"file1.proto", {"file0.proto"}},
+                               {"file3.proto", {"aaa/file 2.proto", "file1.proto"}}};
+
+    EXPECT_EQ(nlohmann::json::parse(out.str()), expected);
+}
+
+TEST(ImportsCommandTest, Command_Output_In_Fast_Mode_Is_The_Same_As_In_Normal_Mode)
+{
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    tmp.writeFile("file4.proto",
+                  "syntax = \"proto3\";\n"
+                  "package test;\n"
+                  "// import \"file3.proto\";\n"
+                  "option java_package = \"test\";\n"
+                  "import public \"file0.proto\";\n"
+                  ";\n"
+                  "import weak \"aaa/file 2.proto\";\n"
+                  "message Message { message Nested { string import = 1; } }\n"
+                  "enum Enum { ENUM_0 = 0; }\n");
+
+    for (auto format: {ImportsFormat::List, ImportsFormat::Depfile, ImportsFormat::Json}) {
+        std::ostringstream expectedOut, expectedErr, out, err;
+        std::vector<std::string> files = {"file3.proto", "file4.proto"};
+        std::vector<std::string> outputs = {"%.pb.cc"};
+
+        ImportsArgs normalArgs(files, "tmp", "", false, false, format, false, 1, false, false, {}, {}, outputs);
+        ImportsArgs fastArgs(files, "tmp", "", false, false, format, true, 2, false, false, {}, {}, outputs);
+
+        EXPECT_NO_THROW(ImportsCommand(normalArgs).execute(&expectedOut, &expectedErr));
+        EXPECT_NO_THROW(ImportsCommand(fastArgs).execute(&out, &err));
+        EXPECT_FALSE(out.str().empty());
+        EXPECT_EQ(out.str(), expectedOut.str());
+        EXPECT_TRUE(err.str().empty());
+    }
+}
+
+TEST(ImportsCommandTest, Command_Imports_File_In_Fast_Mode_If_Its_Import_Statements_Are_Malformed)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    tmp.writeFile("invalid.proto",
+                  "syntax = \"proto3\";"
+                  "package test;"
+                  "import file1.proto;");
+
+    EXPECT_COMMAND_EXCEPTION(
+        ImportsCommand({{"invalid.proto", "file1.proto"}, "tmp", "", false, false, ImportsFormat::List, true})
+            .execute(&out, &err),
+        ImportsErrc::Protobuf_Parsing_Failed);
+    EXPECT_FALSE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], "file0.proto");
+    EXPECT_EQ(output[1], "file1.proto");
+}
+
+TEST(ImportsCommandTest, Command_Does_Not_Read_File_Body_In_Fast_Mode)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+    tmp.writeFile("file4.proto",
+                  "syntax = \"proto3\";\n"
+                  "package test;\n"
+                  "import \"file1.proto\";\n"
+                  "message Message { \"unterminated\n");
+
+    EXPECT_NO_THROW(ImportsCommand({{"file4.proto"}, "tmp", "", false, false, ImportsFormat::List, true})
+                        .execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 3);
+    EXPECT_EQ(output[0], "file0.proto");
+    EXPECT_EQ(output[1], "file1.proto");
+    EXPECT_EQ(output[2], "file4.proto");
+}
+
+TEST(ImportsCommandTest, Command_Imports_File_In_Fast_Mode_If_Its_Import_Is_Not_Found)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    tmp.writeFile("file1.proto",
+                  "syntax = \"proto3\";"
+                  "package test;"
+                  "import \"missing.proto\";");
+
+    EXPECT_COMMAND_EXCEPTION(
+        ImportsCommand({{"file1.proto"}, "tmp", "", false, false, ImportsFormat::List, true}).execute(&out, &err),
+        ImportsErrc::Protobuf_Parsing_Failed);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Files_Importing_Specified_Files_If_Reverse_Flag_Is_Set)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    ImportsArgs args({"file1.proto"}, "tmp", "", false, false, ImportsFormat::List, false, 1, true);
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 3);
+    EXPECT_EQ(output[0], "aaa/file 2.proto");
+    EXPECT_EQ(output[1], "file1.proto");
+    EXPECT_EQ(output[2], "file3.proto");
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Entity_Dirs_Importing_Specified_Files_If_Entities_Flag_Is_Set)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    ImportsArgs args({"file1.proto"}, "tmp", "", true, false, ImportsFormat::List, true, 1, true, true);
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], ".");
+    EXPECT_EQ(output[1], "aaa");
+}
+
+TEST(ImportsCommandTest, Command_Reuses_Import_Index_Of_Unchanged_Files)
+{
+    TmpDir tmp;
+    TmpDir indexDir("index");
+    CreateImportGraph(tmp);
+    auto indexFile = indexDir.path() / "index.json";
+
+    ImportsArgs args({"file0.proto"}, "tmp", "", false, false, ImportsFormat::List, false, 1, true, false, indexFile);
+    std::ostringstream out1, err1, out2, err2;
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out1, &err1));
+    EXPECT_TRUE(std::filesystem::is_regular_file(indexFile));
+    EXPECT_EQ(SplitString(out1.str()).size(), 4);
+
+    ImportIndex index;
+
+    ASSERT_TRUE(index.load(indexFile));
+    EXPECT_EQ(index.size(), 4);
+
+    // make index state that unchanged 'file3.proto' does not import anything
+    for (auto file: {"file0.proto", "file1.proto", "aaa/file 2.proto"}) {
+        EXPECT_TRUE(index.find(file, ImportIndex::GetStamp(tmp.path() / file)));
+    }
+
+    index.store("file3.proto", ImportIndex::GetStamp(tmp.path() / "file3.proto"), {});
+    ASSERT_TRUE(index.save(indexFile));
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out2, &err2));
+    EXPECT_TRUE(err2.str().empty());
+
+    auto output = SplitString(out2.str());
+
+    ASSERT_EQ(output.size(), 3);
+    EXPECT_EQ(output[0], "aaa/file 2.proto");
+    EXPECT_EQ(output[1], "file0.proto");
+    EXPECT_EQ(output[2], "file1.proto");
+
+    // changed file is read again
+    tmp.writeFile("file3.proto",
+                  "syntax = \"proto3\";"
+                  "package test;"
+                  "import \"file1.proto\";");
+    std::ostringstream out3, err3;
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out3, &err3));
+    EXPECT_EQ(SplitString(out3.str()).size(), 4);
+}
+
+TEST(ImportsCommandTest, Command_Outputs_Files_Needed_To_Compile_Service_If_Service_Is_Specified)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    ImportsArgs args(
+        {}, "tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, ImportsFormat::List, false, 1, false, false, {}, "service");
+
+    EXPECT_NO_THROW(ImportsCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+    std::set<std::string> files(output.begin(), output.end());
+
+    EXPECT_EQ(files.size(), output.size());
+    EXPECT_TRUE(files.count("implementation/service/service.proto"));
+    EXPECT_TRUE(files.count("implementation/service/service_types.proto"));
+    EXPECT_TRUE(files.count("api/namespace/class/method/method.proto"));
+    EXPECT_TRUE(files.count("api/namespace/class/oneway_method/method.proto"));
+    EXPECT_TRUE(files.count("api/namespace/class/oneway_static_method/method.proto"));
+    EXPECT_TRUE(files.count("api/namespace/static_class/static_method/method.proto"));
+    EXPECT_TRUE(files.count("api/namespace/namespace_types.proto"));
+    EXPECT_TRUE(files.count("busrpc.proto"));
+    EXPECT_FALSE(files.count("api/namespace/class/class.proto"));
+    EXPECT_FALSE(files.count("api/namespace/class/method/method_types.proto"));
+    EXPECT_FALSE(files.count("implementation/implementation_types.proto"));
+}
+
+TEST(ImportsCommandTest, File_Not_Found_Error_If_Service_Does_Not_Exist)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    ImportsArgs args(
+        {}, "tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, ImportsFormat::List, false, 1, false, false, {}, "missing");
+
+    EXPECT_COMMAND_EXCEPTION(ImportsCommand(args).execute(&out, &err), ImportsErrc::File_Not_Found);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(ImportsCommandTest, File_Not_Found_Error_If_Service_Name_Is_Invalid)
+{
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    for (std::string service: {"../../service", "service/..", "../implementation/service", "/tmp"}) {
+        std::ostringstream out, err;
+        ImportsArgs args({},
+                         "tmp",
+                         BUSRPC_TESTS_PROTOBUF_ROOT,
+                         false,
+                         false,
+                         ImportsFormat::List,
+                         false,
+                         1,
+                         false,
+                         false,
+                         {},
+                         service);
+
+        EXPECT_COMMAND_EXCEPTION(ImportsCommand(args).execute(&out, &err), ImportsErrc::File_Not_Found);
+        EXPECT_TRUE(out.str().empty()) << service;
+    }
+}
+
 TEST(ImportsCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcommand)
 {
     std::ostringstream out, err;
@@ -337,4 +798,51 @@ TEST(ImportsCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcom
     EXPECT_EQ(output[0], "file1.proto");
     EXPECT_EQ(output[1], "file2.proto");
 }
+
+TEST(ImportsCommandTest, App_Runs_Command_With_All_Flag_And_Format)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateImportGraph(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    int argc = 9;
+    const char* argv[] = {
+        "busrpc", GetCommandName(CommandId::Imports), "-r", "tmp", "--all", "--format", "depfile", "-o", "%.pb.cc"};
+
+    EXPECT_NO_THROW(app.parse(argc, argv));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_EQ(SplitString(out.str()).size(), 4);
+    EXPECT_NE(out.str().find("file1.pb.cc: file1.proto"), std::string::npos);
+}
+
+TEST(ImportsCommandTest, App_Runs_Command_With_Service_Option)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    int argc = 8;
+    const char* argv[] = {"busrpc",
+                          GetCommandName(CommandId::Imports),
+                          "-r",
+                          "tmp",
+                          "-p",
+                          BUSRPC_TESTS_PROTOBUF_ROOT,
+                          "--service",
+                          "service"};
+
+    EXPECT_NO_THROW(app.parse(argc, argv));
+    EXPECT_TRUE(err.str().empty());
+
+    auto output = SplitString(out.str());
+
+    EXPECT_TRUE(std::find(output.begin(), output.end(), "api/namespace/class/method/method.proto") != output.end());
+    EXPECT_TRUE(std::find(output.begin(), output.end(), "api/namespace/class/class.proto") == output.end());
+}
 }} // namespace busrpc::test
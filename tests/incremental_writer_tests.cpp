@@ -0,0 +1,152 @@
+#include "generators/incremental_writer.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace busrpc { namespace test {
+
+TEST(IncrementalWriterTest, All_Files_Are_Written_If_Manifest_Does_Not_Exist)
+{
+    TmpDir tmp;
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_TRUE(writer.write("file1.json", "content1\n"));
+    EXPECT_TRUE(writer.write("file2.json", "content2\n"));
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.written(), 2);
+    EXPECT_EQ(writer.skipped(), 0);
+    EXPECT_EQ(writer.removed(), 0);
+    EXPECT_EQ(ReadFile(tmp.path() / "file1.json"), "content1");
+    EXPECT_EQ(ReadFile(tmp.path() / "file2.json"), "content2");
+    EXPECT_TRUE(std::filesystem::is_regular_file(tmp.path() / Doc_Manifest_File));
+}
+
+TEST(IncrementalWriterTest, Only_Changed_Files_Are_Rewritten)
+{
+    TmpDir tmp;
+
+    {
+        IncrementalWriter writer(tmp.path());
+        writer.write("file1.json", "content1\n");
+        writer.write("file2.json", "content2\n");
+        writer.commit();
+    }
+
+    auto time = std::filesystem::last_write_time(tmp.path() / "file1.json");
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_TRUE(writer.write("file1.json", "content1\n"));
+    EXPECT_TRUE(writer.write("file2.json", "changed\n"));
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.written(), 1);
+    EXPECT_EQ(writer.skipped(), 1);
+    EXPECT_EQ(writer.removed(), 0);
+    EXPECT_EQ(std::filesystem::last_write_time(tmp.path() / "file1.json"), time);
+    EXPECT_EQ(ReadFile(tmp.path() / "file2.json"), "changed");
+
+    auto manifestTime = std::filesystem::last_write_time(tmp.path() / Doc_Manifest_File);
+    IncrementalWriter unchangedWriter(tmp.path());
+
+    EXPECT_TRUE(unchangedWriter.write("file1.json", "content1\n"));
+    EXPECT_TRUE(unchangedWriter.write("file2.json", "changed\n"));
+    EXPECT_TRUE(unchangedWriter.commit());
+    EXPECT_EQ(unchangedWriter.written(), 0);
+    EXPECT_EQ(unchangedWriter.skipped(), 2);
+    EXPECT_EQ(std::filesystem::last_write_time(tmp.path() / Doc_Manifest_File), manifestTime);
+}
+
+TEST(IncrementalWriterTest, File_Is_Rewritten_If_It_Is_Removed_Since_Previous_Run)
+{
+    TmpDir tmp;
+
+    {
+        IncrementalWriter writer(tmp.path());
+        writer.write("file.json", "content\n");
+        writer.commit();
+    }
+
+    std::filesystem::remove(tmp.path() / "file.json");
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_TRUE(writer.write("file.json", "content\n"));
+    EXPECT_EQ(writer.written(), 1);
+    EXPECT_EQ(ReadFile(tmp.path() / "file.json"), "content");
+}
+
+TEST(IncrementalWriterTest, Stale_Files_Listed_In_Manifest_Are_Removed)
+{
+    TmpDir tmp;
+    tmp.writeFile("unknown.json", "unknown");
+
+    {
+        IncrementalWriter writer(tmp.path());
+        writer.write("file1.json", "content1\n");
+        writer.write("file2.json", "content2\n");
+        writer.commit();
+    }
+
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_TRUE(writer.write("file1.json", "content1\n"));
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.removed(), 1);
+    EXPECT_TRUE(std::filesystem::exists(tmp.path() / "file1.json"));
+    EXPECT_FALSE(std::filesystem::exists(tmp.path() / "file2.json"));
+    EXPECT_TRUE(std::filesystem::exists(tmp.path() / "unknown.json"));
+}
+
+TEST(IncrementalWriterTest, Invalid_Manifest_Is_Ignored)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.json", "content");
+    tmp.writeFile(Doc_Manifest_File, "{\"files\": {\"file.json\": 1001}}");
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_TRUE(writer.write("file.json", "content\n"));
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.written(), 1);
+    EXPECT_EQ(writer.removed(), 0);
+}
+
+TEST(IncrementalWriterTest, Manifest_Entries_Outside_Of_Output_Directory_Are_Ignored)
+{
+    TmpDir tmp;
+    TmpDir other("tmp_other");
+    other.writeFile("outside.json", "outside");
+    tmp.createDir("out");
+    auto relativeOutside = (other.path() / "outside.json").lexically_relative(tmp.path() / "out").generic_string();
+    auto absoluteOutside = std::filesystem::absolute(other.path() / "outside.json").generic_string();
+    tmp.writeFile("out/" + std::string(Doc_Manifest_File),
+                  "{\"files\": {\"" + relativeOutside + "\": \"1\", \"" + absoluteOutside +
+                      "\": \"1\", \"sub/../../outside.json\": \"1\"}}");
+    tmp.writeFile("outside.json", "outside");
+    IncrementalWriter writer(tmp.path() / "out");
+
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.removed(), 0);
+    EXPECT_TRUE(std::filesystem::exists(other.path() / "outside.json"));
+    EXPECT_TRUE(std::filesystem::exists(tmp.path() / "outside.json"));
+}
+
+TEST(IncrementalWriterTest, File_Is_Not_Removed_If_It_Can_Not_Be_Rewritten)
+{
+    TmpDir tmp;
+
+    {
+        IncrementalWriter writer(tmp.path());
+        writer.write("file.json", "content\n");
+        writer.commit();
+    }
+
+    // directory with the name of the temporary file makes write fail
+    tmp.createDir("file.json.tmp/dir");
+    IncrementalWriter writer(tmp.path());
+
+    EXPECT_FALSE(writer.write("file.json", "changed\n"));
+    EXPECT_TRUE(writer.commit());
+    EXPECT_EQ(writer.removed(), 0);
+    EXPECT_EQ(ReadFile(tmp.path() / "file.json"), "content");
+}
+}} // namespace busrpc::test
@@ -6,8 +6,13 @@
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
 #include <sstream>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -28,6 +33,90 @@ json GetGeneratedJson(const Project& project)
     return result;
 }
 
+Project* InitFullProject(Project* project)
+{
+    InitMinimalProject(project);
+    auto api = AddApi(project);
+    auto ns = AddNamespace(api);
+    AddMethod(AddClass(ns));
+    auto staticCls = ns->addClass("static_class");
+    AddClassDesc(staticCls, true);
+    AddMethodDesc(staticCls->addMethod("method"), true, false, false);
+    ns->addClass("class2");
+    AddService(AddImplementation(project))->parent()->addService("service2");
+    api->addNamespace("namespace2");
+    api->addStruct("Escaped",
+                   "file.proto",
+                   StructFlags::None,
+                   EntityDocs(std::vector<std::string>{"Brief \"quoted\" \\ text.",
+                                                       "Tab\t, line\nfeed, \x01 and \xD0\xAF."}));
+    return project;
+}
+
+// Replace string table indices in the compact documentation with strings
+json ExpandCompactJson(const json& value, const json& strings)
+{
+    static const std::set<std::string> tableKeys = {
+        "dir", "dname", "fieldTypeName", "file", "keyTypeName", "package", "valueTypeName"};
+    json result = value;
+
+    if (value.is_object()) {
+        for (auto& [key, member]: result.items()) {
+            member = tableKeys.count(key) && member.is_number() ? strings.at(member.get<std::size_t>())
+                                                                : ExpandCompactJson(member, strings);
+        }
+    } else if (value.is_array()) {
+        for (auto& element: result) {
+            element = ExpandCompactJson(element, strings);
+        }
+    }
+
+    return result;
+}
+
+// Remove object members with empty values (recursively)
+json RemoveEmptyMembers(const json& value)
+{
+    if (value.is_array()) {
+        json result = json::array();
+
+        for (const auto& element: value) {
+            result.push_back(RemoveEmptyMembers(element));
+        }
+
+        return result;
+    } else if (value.is_object()) {
+        json result = json::object();
+
+        for (const auto& [key, member]: value.items()) {
+            auto stripped = RemoveEmptyMembers(member);
+
+            if (!stripped.is_null() && !(stripped.is_string() && stripped.get<std::string>().empty()) &&
+                !(stripped.is_structured() && stripped.empty())) {
+                result[key] = std::move(stripped);
+            }
+        }
+
+        return result;
+    } else {
+        return value;
+    }
+}
+
+std::map<std::string, std::string> GetGeneratedShards(const Project& project, std::size_t jobs = 1)
+{
+    std::map<std::string, std::string> shards;
+    JsonShardsGenerator generator(
+        [&shards](const std::string& file, const std::string& content) {
+            EXPECT_TRUE(shards.emplace(file, content).second);
+        },
+        2,
+        jobs);
+
+    EXPECT_NO_THROW(generator.generate(project));
+    return shards;
+}
+
 void TestCommonEntityProperties(const json& obj, const Entity& entity);
 void TestGeneralCompositeEntityProperties(const json& obj, const GeneralCompositeEntity& entity);
 void TestEnumProperties(const json& obj, const Enum& enumeration);
@@ -546,4 +635,301 @@ TEST(JsonGeneratorTest,
 
     TestGeneralCompositeEntityProperties(jsonService, *service);
 }
+
+TEST(JsonGeneratorTest, Pretty_Printed_Documentation_Is_Identical_To_Json_Library_Output)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    std::ostringstream expected;
+
+    out << std::setw(4);
+    expected << std::setw(4) << json(project);
+    JsonGenerator generator(out);
+
+    EXPECT_NO_THROW(generator.generate(project));
+    EXPECT_EQ(out.width(), 0);
+    EXPECT_EQ(out.str(), expected.str());
+    EXPECT_EQ(out.str(), json::parse(out.str()).dump(4));
+}
+
+TEST(JsonGeneratorTest, Compact_Documentation_Is_Identical_To_Json_Library_Output)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    JsonGenerator generator(out);
+
+    EXPECT_NO_THROW(generator.generate(project));
+    EXPECT_EQ(out.str(), json(project).dump());
+    EXPECT_EQ(out.str(), json::parse(out.str()).dump());
+}
+
+TEST(JsonGeneratorTest, Parallel_Generator_Output_Is_Identical_To_Single_Threaded_Generator_Output)
+{
+    Project project;
+    InitFullProject(&project);
+
+    for (int indent: {0, 2}) {
+        std::ostringstream expected;
+        expected << std::setw(indent);
+        JsonGenerator(expected).generate(project);
+
+        for (std::size_t jobs: {std::size_t(2), std::size_t(3), std::size_t(8)}) {
+            std::ostringstream out;
+            out << std::setw(indent);
+            JsonGenerator generator(out, jobs);
+
+            EXPECT_NO_THROW(generator.generate(project));
+            EXPECT_EQ(out.str(), expected.str());
+        }
+    }
+}
+
+TEST(JsonGeneratorTest, Parallel_Generator_Throws_If_Project_Contains_Invalid_Utf8_String)
+{
+    Project project;
+    auto api = AddApi(&project);
+    AddNamespace(api);
+    api->addNamespace("invalid")->addStruct("Struct", "file.proto", StructFlags::None, EntityDocs("Invalid \xFF."));
+    std::ostringstream out;
+    JsonGenerator generator(out, 2);
+
+    EXPECT_THROW(generator.generate(project), json::type_error);
+}
+
+TEST(JsonGeneratorTest, Generator_Throws_If_Project_Contains_Invalid_Utf8_String)
+{
+    Project project;
+    project.addStruct("Struct", "file.proto", StructFlags::None, EntityDocs("Invalid \xFF string."));
+    std::ostringstream out;
+    JsonGenerator generator(out);
+
+    EXPECT_THROW(generator.generate(project), json::type_error);
+}
+
+TEST(JsonGeneratorTest, Compact_Generator_Outputs_Schema_Marker_And_Version)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    CompactJsonGenerator generator(out);
+
+    EXPECT_NO_THROW(generator.generate(project));
+
+    auto doc = json::parse(out.str());
+
+    EXPECT_EQ(doc["schema"], Compact_Json_Schema);
+    EXPECT_EQ(doc["version"], Compact_Json_Schema_Version);
+    EXPECT_TRUE(doc["strings"].is_array());
+    EXPECT_TRUE(doc["project"].is_object());
+}
+
+TEST(JsonGeneratorTest, Compact_Documentation_Is_Equivalent_To_Documentation_Without_Empty_Members)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    CompactJsonGenerator generator(out);
+
+    EXPECT_NO_THROW(generator.generate(project));
+
+    auto doc = json::parse(out.str());
+
+    EXPECT_EQ(ExpandCompactJson(doc["project"], doc["strings"]), RemoveEmptyMembers(json(project)));
+}
+
+TEST(JsonGeneratorTest, Compact_Documentation_String_Table_Contains_Each_String_Once)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    CompactJsonGenerator generator(out);
+
+    EXPECT_NO_THROW(generator.generate(project));
+
+    auto strings = json::parse(out.str())["strings"].get<std::vector<std::string>>();
+
+    EXPECT_EQ(std::set<std::string>(strings.begin(), strings.end()).size(), strings.size());
+    EXPECT_NE(std::find(strings.begin(), strings.end(), project.dname()), strings.end());
+}
+
+TEST(JsonGeneratorTest, Compact_Documentation_Is_Smaller_Than_Default_Documentation)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream compact;
+    std::ostringstream expected;
+    CompactJsonGenerator(compact).generate(project);
+    JsonGenerator(expected).generate(project);
+
+    EXPECT_LT(compact.str().size(), expected.str().size());
+}
+
+TEST(JsonGeneratorTest, Pretty_Printed_Compact_Documentation_Is_Identical_To_Json_Library_Output)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    std::ostringstream compact;
+
+    out << std::setw(2);
+    CompactJsonGenerator(compact).generate(project);
+
+    EXPECT_NO_THROW(CompactJsonGenerator(out).generate(project));
+    EXPECT_EQ(out.width(), 0);
+    EXPECT_EQ(out.str(), json::parse(compact.str()).dump(2));
+}
+
+TEST(JsonGeneratorTest, Compact_Generator_Throws_If_Project_Contains_Invalid_Utf8_String)
+{
+    Project project;
+    project.addStruct("Struct", "file.proto", StructFlags::None, EntityDocs("Invalid \xFF string."));
+    std::ostringstream out;
+    CompactJsonGenerator generator(out);
+
+    EXPECT_THROW(generator.generate(project), json::type_error);
+}
+
+TEST(JsonGeneratorTest, Search_Index_Is_Built_While_Documentation_Is_Generated)
+{
+    Project project;
+    InitFullProject(&project);
+    std::ostringstream out;
+    SearchIndex index;
+    JsonGenerator generator(out, 1, &index);
+
+    EXPECT_NO_THROW(generator.generate(project));
+
+    auto doc = json::parse(out.str());
+    std::vector<std::string> dnames;
+
+    // collect dnames of all entities written with the common entity data (objects with "dir" and "dname")
+    auto collect = [&dnames](const json& value, const auto& self) -> void {
+        if (value.is_object() && value.contains("dir") && value.contains("dname")) {
+            dnames.push_back(value["dname"].get<std::string>());
+        }
+
+        if (value.is_structured()) {
+            for (const auto& element: value) {
+                self(element, self);
+            }
+        }
+    };
+
+    collect(doc, collect);
+    std::sort(dnames.begin(), dnames.end());
+
+    EXPECT_EQ(index.size(), dnames.size());
+    EXPECT_EQ(index.find(""), dnames);
+    EXPECT_EQ(index.find("escap"), std::vector<std::string>{"busrpc.api.Escaped"});
+    EXPECT_EQ(index.find("feed"), std::vector<std::string>{"busrpc.api.Escaped"});
+}
+
+TEST(JsonGeneratorTest, Search_Index_Does_Not_Depend_On_Generator_Type_And_Number_Of_Jobs)
+{
+    Project project;
+    InitFullProject(&project);
+    auto writeIndex = [](const SearchIndex& index) {
+        std::ostringstream out;
+        index.write(out);
+        return out.str();
+    };
+
+    std::ostringstream out;
+    SearchIndex expected;
+    JsonGenerator(out, 1, &expected).generate(project);
+
+    for (std::size_t jobs: {std::size_t(1), std::size_t(3)}) {
+        SearchIndex index;
+        SearchIndex shardsIndex;
+        JsonGenerator(out, jobs, &index).generate(project);
+        JsonShardsGenerator([](const std::string&, const std::string&) {}, 2, jobs, &shardsIndex).generate(project);
+
+        EXPECT_EQ(writeIndex(index), writeIndex(expected));
+        EXPECT_EQ(writeIndex(shardsIndex), writeIndex(expected));
+    }
+
+    SearchIndex compactIndex;
+    CompactJsonGenerator(out, &compactIndex).generate(project);
+
+    EXPECT_EQ(writeIndex(compactIndex), writeIndex(expected));
+}
+
+TEST(JsonGeneratorTest, Sharded_Generator_Outputs_Shard_For_Each_Namespace_Class_Method_And_Service_And_Index)
+{
+    Project project;
+    InitFullProject(&project);
+    auto shards = GetGeneratedShards(project);
+
+    std::set<std::string> expectedFiles = {Json_Doc_Index_File,
+                                           "busrpc.json",
+                                           "busrpc.api.json",
+                                           "busrpc.api.namespace.json",
+                                           "busrpc.api.namespace.class.json",
+                                           "busrpc.api.namespace.class.method.json",
+                                           "busrpc.api.namespace.class2.json",
+                                           "busrpc.api.namespace.static_class.json",
+                                           "busrpc.api.namespace.static_class.method.json",
+                                           "busrpc.api.namespace2.json",
+                                           "busrpc.implementation.json",
+                                           "busrpc.implementation.service.json",
+                                           "busrpc.implementation.service2.json"};
+    std::set<std::string> files;
+
+    for (const auto& shard: shards) {
+        files.insert(shard.first);
+    }
+
+    EXPECT_EQ(files, expectedFiles);
+
+    json index = json::parse(shards[Json_Doc_Index_File]);
+    EXPECT_EQ(index["root"], project.dname());
+    ASSERT_EQ(index["shards"].size(), expectedFiles.size() - 1);
+
+    for (const auto& [dname, entry]: index["shards"].items()) {
+        ASSERT_TRUE(shards.count(entry["shard"]));
+
+        json shard = json::parse(shards[entry["shard"]]);
+        EXPECT_EQ(shard["dname"], dname);
+        EXPECT_EQ(entry["brief"], shard["docs"]["brief"]);
+        EXPECT_TRUE(entry["type"].is_string());
+    }
+
+    EXPECT_TRUE(index["shards"]["busrpc"]["parent"].is_null());
+    EXPECT_EQ(index["shards"]["busrpc.api.namespace.class"]["parent"], "busrpc.api.namespace");
+    EXPECT_EQ(index["shards"]["busrpc.api.namespace.class"]["type"], "class");
+}
+
+TEST(JsonGeneratorTest, Sharded_Generator_Replaces_Nested_Sharded_Entities_With_Links)
+{
+    Project project;
+    InitFullProject(&project);
+    auto shards = GetGeneratedShards(project);
+    json jsonProject = json::parse(shards["busrpc.json"]);
+    json jsonNs = json::parse(shards["busrpc.api.namespace.json"]);
+    json jsonCls = json::parse(shards["busrpc.api.namespace.class.json"]);
+    json jsonExpectedCls = GetGeneratedJson(project)["api"]["namespaces"]["namespace"]["classes"]["class"];
+    const auto& cls = *(*project.api()->namespaces().begin())->classes().begin();
+
+    EXPECT_EQ(jsonProject["api"],
+              json({{"brief", project.api()->docs().brief()}, {"dname", "busrpc.api"}, {"shard", "busrpc.api.json"}}));
+    EXPECT_EQ(jsonProject["implementation"]["shard"], "busrpc.implementation.json");
+    EXPECT_EQ(jsonNs["classes"]["class"],
+              json({{"brief", cls->docs().brief()},
+                    {"dname", "busrpc.api.namespace.class"},
+                    {"shard", "busrpc.api.namespace.class.json"}}));
+    EXPECT_EQ(jsonCls["methods"]["method"]["shard"], "busrpc.api.namespace.class.method.json");
+
+    jsonExpectedCls["methods"]["method"] = jsonCls["methods"]["method"];
+    EXPECT_EQ(jsonCls, jsonExpectedCls);
+}
+
+TEST(JsonGeneratorTest, Parallel_Sharded_Generator_Output_Is_Identical_To_Single_Threaded_Generator_Output)
+{
+    Project project;
+    InitFullProject(&project);
+
+    EXPECT_EQ(GetGeneratedShards(project, 4), GetGeneratedShards(project));
+}
 }} // namespace busrpc::test
@@ -0,0 +1,162 @@
+#include "generators/json_writer.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace busrpc { namespace test {
+
+// Write test document, which is equal to the one returned by GetTestJson
+void WriteTestDocument(JsonWriter& writer)
+{
+    writer.beginObject();
+    writer.key("array");
+    writer.beginArray();
+    writer.intValue(-1);
+    writer.intValue(1001);
+    writer.boolValue(true);
+    writer.nullValue();
+    writer.beginObject();
+    writer.endObject();
+    writer.beginArray();
+    writer.endArray();
+    writer.endArray();
+    writer.key("emptyArray");
+    writer.beginArray();
+    writer.endArray();
+    writer.key("emptyObject");
+    writer.beginObject();
+    writer.endObject();
+    writer.key("flag");
+    writer.boolValue(false);
+    writer.key("object");
+    writer.beginObject();
+    writer.key("Key");
+    writer.stringValue("value");
+    writer.key("key");
+    writer.beginArray();
+    writer.stringValue("str");
+    writer.endArray();
+    writer.endObject();
+    writer.key("string");
+    writer.stringValue("\"quoted\" \\ \b\f\n\r\t \x01\x1F\x7F \xD0\xAF \xE2\x82\xAC \xF0\x9F\x98\x80");
+    writer.endObject();
+}
+
+json GetTestJson()
+{
+    json obj;
+    obj["array"] = {-1, 1001, true, nullptr, json::object(), json::array()};
+    obj["emptyArray"] = json::array();
+    obj["emptyObject"] = json::object();
+    obj["flag"] = false;
+    obj["object"]["Key"] = "value";
+    obj["object"]["key"] = {"str"};
+    obj["string"] = "\"quoted\" \\ \b\f\n\r\t \x01\x1F\x7F \xD0\xAF \xE2\x82\xAC \xF0\x9F\x98\x80";
+    return obj;
+}
+
+TEST(JsonWriterTest, Compact_Output_Is_Identical_To_Json_Library_Output)
+{
+    std::ostringstream out;
+
+    {
+        JsonWriter writer(out);
+        WriteTestDocument(writer);
+    }
+
+    EXPECT_EQ(out.str(), GetTestJson().dump());
+}
+
+TEST(JsonWriterTest, Pretty_Printed_Output_Is_Identical_To_Json_Library_Output)
+{
+    std::ostringstream out;
+
+    {
+        JsonWriter writer(out, 2);
+        WriteTestDocument(writer);
+    }
+
+    EXPECT_EQ(out.str(), GetTestJson().dump(2));
+}
+
+TEST(JsonWriterTest, Scalar_Values_Are_Written_As_Json_Library_Writes_Them)
+{
+    std::ostringstream out;
+
+    {
+        JsonWriter writer(out);
+        writer.intValue(INT64_MIN);
+    }
+
+    EXPECT_EQ(out.str(), json(INT64_MIN).dump());
+}
+
+TEST(JsonWriterTest, Raw_Value_Written_With_Initial_Depth_Is_Inserted_As_Is)
+{
+    std::ostringstream nested;
+    std::ostringstream out;
+
+    {
+        JsonWriter writer(nested, 2, 1);
+        writer.beginObject();
+        writer.key("nested");
+        writer.intValue(1);
+        writer.endObject();
+    }
+
+    {
+        JsonWriter writer(out, 2);
+        writer.beginObject();
+        writer.key("object");
+        writer.rawValue(nested.str());
+        writer.endObject();
+    }
+
+    EXPECT_EQ(out.str(), json({{"object", {{"nested", 1}}}}).dump(2));
+}
+
+TEST(JsonWriterTest, Output_Is_Written_To_Stream_Only_After_Flush)
+{
+    std::ostringstream out;
+    JsonWriter writer(out);
+
+    writer.beginArray();
+    writer.endArray();
+
+    EXPECT_TRUE(out.str().empty());
+
+    writer.flush();
+
+    EXPECT_EQ(out.str(), "[]");
+}
+
+TEST(JsonWriterTest, Writer_Throws_Json_Library_Exception_If_String_Is_Not_Valid_Utf8)
+{
+    for (std::string str: {"\xFF", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xD0", "a\xE2\x82"}) {
+        std::ostringstream out;
+        JsonWriter writer(out);
+        std::string expected;
+
+        try {
+            static_cast<void>(json(str).dump());
+        } catch (const json::type_error& e) {
+            expected = e.what();
+        }
+
+        EXPECT_FALSE(expected.empty());
+
+        try {
+            writer.stringValue(str);
+            ADD_FAILURE() << "Exception is not thrown";
+        } catch (const json::type_error& e) {
+            EXPECT_EQ(e.what(), expected);
+        }
+    }
+}
+}} // namespace busrpc::test
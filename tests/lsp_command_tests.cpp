@@ -0,0 +1,666 @@
+#include "app.h"
+#include "commands/help/help_command.h"
+#include "commands/lsp/lsp_command.h"
+#include "commands/lsp/lsp_server.h"
+#include "tests_configure.h"
+#include "utils/common.h"
+#include "utils/project_utils.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace busrpc { namespace test {
+
+namespace {
+
+const std::string Struct_File = "syntax = \"proto3\";\n"
+                                "package busrpc;\n"
+                                "// My struct.\n"
+                                "message MyStruct {\n"
+                                "  // Field.\n"
+                                "  int32 field1 = 1;\n"
+                                "}\n";
+
+const std::string Undocumented_Struct_File = "syntax = \"proto3\";\n"
+                                             "package busrpc;\n"
+                                             "\n"
+                                             "message MyStruct {\n"
+                                             "  // Field.\n"
+                                             "  int32 field1 = 1;\n"
+                                             "}\n";
+
+const std::string Other_Struct_File = "syntax = \"proto3\";\n"
+                                      "package busrpc;\n"
+                                      "import \"file.proto\";\n"
+                                      "// Other struct.\n"
+                                      "message OtherStruct {\n"
+                                      "  // Field.\n"
+                                      "  MyStruct field1 = 1;\n"
+                                      "}\n";
+
+std::vector<json> ReadMessages(const std::string& output)
+{
+    std::vector<json> messages;
+    std::string header = "Content-Length: ";
+
+    for (auto pos = output.find(header); pos != std::string::npos; pos = output.find(header, pos)) {
+        auto length = std::stoul(output.substr(pos + header.size()));
+        auto contentPos = output.find("\r\n\r\n", pos) + 4;
+        messages.push_back(json::parse(output.substr(contentPos, length)));
+        pos = contentPos + length;
+    }
+
+    return messages;
+}
+
+std::string FrameMessage(const json& message)
+{
+    std::string content = message.dump();
+    return "Content-Length: " + std::to_string(content.size()) + "\r\n\r\n" + content;
+}
+
+json CreateRequest(int id, const std::string& method, json params = json::object())
+{
+    return {{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", std::move(params)}};
+}
+
+json CreateNotification(const std::string& method, json params = json::object())
+{
+    return {{"jsonrpc", "2.0"}, {"method", method}, {"params", std::move(params)}};
+}
+
+std::string GetUri(const TmpDir& dir, const std::string& file)
+{
+    return "file://" + std::filesystem::weakly_canonical(dir.path() / file).generic_string();
+}
+
+json GetTextDocumentPosition(const TmpDir& dir, const std::string& file, unsigned line, unsigned character)
+{
+    return {{"textDocument", {{"uri", GetUri(dir, file)}}}, {"position", {{"line", line}, {"character", character}}}};
+}
+
+// Return diagnostics published for the file by the last publishDiagnostics notification
+std::optional<json> FindDiagnostics(const std::vector<json>& messages, const std::string& uri)
+{
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it) {
+        if (it->value("method", "") == "textDocument/publishDiagnostics" && (*it)["params"]["uri"] == uri) {
+            return (*it)["params"]["diagnostics"];
+        }
+    }
+
+    return std::nullopt;
+}
+
+void Initialize(LspServer& server, std::ostream& out)
+{
+    server.handle(CreateRequest(1, "initialize").dump(), out);
+    server.handle(CreateNotification("initialized").dump(), out);
+}
+} // namespace
+
+TEST(LspCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
+{
+    EXPECT_EQ(CommandId::Lsp, GetCommandId(GetCommandName(CommandId::Lsp)));
+    EXPECT_EQ(LspCommand::Id, CommandId::Lsp);
+    EXPECT_STREQ(LspCommand::Name, GetCommandName(CommandId::Lsp));
+}
+
+TEST(LspCommandTest, Command_Error_Category_Name_Matches_Command_Name)
+{
+    EXPECT_STREQ(lsp_error_category().name(), GetCommandName(CommandId::Lsp));
+}
+
+TEST(LspCommandTest, Description_For_Unknown_Command_Error_Code_Is_Not_Empty)
+{
+    EXPECT_FALSE(lsp_error_category().message(0).empty());
+}
+
+TEST(LspCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From_Known_Error_Codes_Descriptions)
+{
+    EXPECT_NE(lsp_error_category().message(static_cast<int>(LspErrc::Protocol_Violated)),
+              lsp_error_category().message(0));
+    EXPECT_NE(lsp_error_category().message(static_cast<int>(LspErrc::Invalid_Project_Dir)),
+              lsp_error_category().message(0));
+}
+
+TEST(LspCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
+{
+    EXPECT_EQ(std::error_code(LspErrc::Protocol_Violated), CommandError::Invalid_Argument);
+    EXPECT_EQ(std::error_code(LspErrc::Invalid_Project_Dir), CommandError::Invalid_Argument);
+}
+
+TEST(LspCommandTest, Help_Is_Defined_For_The_Command)
+{
+    HelpCommand helpCmd({CommandId::Lsp});
+    std::ostringstream out, err;
+
+    EXPECT_NO_THROW(helpCmd.execute(&out, &err));
+    EXPECT_TRUE(IsHelpMessage(out.str(), CommandId::Lsp));
+    EXPECT_TRUE(err.str().empty());
+}
+
+TEST(LspCommandTest, Invalid_Project_Dir_Error_If_Project_Dir_Does_Not_Contain_Main_File)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+
+    EXPECT_COMMAND_EXCEPTION(LspCommand(LspArgs("tmp")).execute(&out, &err), LspErrc::Invalid_Project_Dir);
+    EXPECT_FALSE(err.str().empty());
+}
+
+TEST(LspServerTest, Server_Responds_To_Initialize_Request_With_Capabilities)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    server.handle(CreateRequest(1, "initialize").dump(), out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0]["id"], 1);
+    EXPECT_TRUE(messages[0]["result"]["capabilities"]["definitionProvider"].get<bool>());
+    EXPECT_TRUE(messages[0]["result"]["capabilities"]["hoverProvider"].get<bool>());
+    EXPECT_TRUE(messages[0]["result"]["capabilities"].contains("completionProvider"));
+}
+
+TEST(LspServerTest, Server_Rejects_Requests_Before_Initialize_Request)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    server.handle(CreateRequest(1, "textDocument/hover", GetTextDocumentPosition(tmp, "busrpc.proto", 0, 0)).dump(),
+                  out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_TRUE(messages[0].contains("error"));
+}
+
+TEST(LspServerTest, Server_Responds_With_Error_To_Unknown_Request_And_Malformed_Message)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    server.handle(CreateRequest(1, "initialize").dump(), out);
+    server.handle(CreateRequest(2, "unknown/method").dump(), out);
+    server.handle("{ malformed", out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[1]["id"], 2);
+    EXPECT_TRUE(messages[1].contains("error"));
+    EXPECT_TRUE(messages[2]["id"].is_null());
+    EXPECT_TRUE(messages[2].contains("error"));
+}
+
+TEST(LspServerTest, Project_Is_Analyzed_When_Server_Is_Initialized)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+
+    ASSERT_TRUE(server.project());
+    EXPECT_TRUE(server.project()->find("busrpc.api.namespace.class.method"));
+}
+
+TEST(LspServerTest, Diagnostics_Are_Published_For_Unsaved_Document_Content)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    EXPECT_FALSE(FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "file.proto")));
+
+    out.str("");
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "file.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", Undocumented_Struct_File}}}})
+                      .dump(),
+                  out);
+    auto diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "file.proto"));
+
+    ASSERT_TRUE(diagnostics);
+    ASSERT_EQ(diagnostics->size(), 1);
+    EXPECT_EQ((*diagnostics)[0]["range"]["start"]["line"], 3);
+    EXPECT_EQ((*diagnostics)[0]["range"]["start"]["character"], 8);
+    EXPECT_EQ((*diagnostics)[0]["range"]["end"]["line"], 3);
+    EXPECT_EQ((*diagnostics)[0]["range"]["end"]["character"], 16);
+    EXPECT_NE((*diagnostics)[0]["message"].get<std::string>().find("busrpc.MyStruct"), std::string::npos);
+}
+
+TEST(LspServerTest, Diagnostics_Are_Published_For_Unsaved_Document_Not_Existing_On_Disk)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "api/file.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", GetFileHeader("busrpc.api") + "message MyStruct {}\n"}}}})
+                      .dump(),
+                  out);
+    auto diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "api/file.proto"));
+
+    ASSERT_TRUE(server.project());
+    EXPECT_TRUE(server.project()->find("busrpc.api.MyStruct"));
+    ASSERT_TRUE(diagnostics);
+    EXPECT_FALSE(diagnostics->empty());
+    EXPECT_FALSE(std::filesystem::exists(tmp.path() / "api/file.proto"));
+}
+
+TEST(LspServerTest, Diagnostic_Character_Is_Counted_In_Utf16_Code_Units)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    // '\xF0\x9D\x84\x9E' is a character outside of the basic multilingual plane, which occupies two UTF-16 code units
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "file.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", "syntax = \"proto3\";\n/*\xF0\x9D\x84\x9E*/ message {}\n"}}}})
+                      .dump(),
+                  out);
+    auto diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "file.proto"));
+
+    ASSERT_TRUE(diagnostics);
+    ASSERT_FALSE(diagnostics->empty());
+    EXPECT_EQ((*diagnostics)[0]["range"]["start"]["line"], 1);
+    EXPECT_EQ((*diagnostics)[0]["range"]["start"]["character"], 15);
+}
+
+TEST(LspServerTest, Diagnostics_Are_Cleared_When_Errors_Are_Fixed)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "file.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", "syntax ="}}}})
+                      .dump(),
+                  out);
+    auto diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "file.proto"));
+
+    ASSERT_TRUE(diagnostics);
+    EXPECT_FALSE(diagnostics->empty());
+
+    out.str("");
+    server.handle(CreateNotification("textDocument/didChange",
+                                     {{"textDocument", {{"uri", GetUri(tmp, "file.proto")}, {"version", 2}}},
+                                      {"contentChanges", {{{"text", Struct_File}}}}})
+                      .dump(),
+                  out);
+    diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "file.proto"));
+
+    ASSERT_TRUE(diagnostics);
+    EXPECT_TRUE(diagnostics->empty());
+}
+
+TEST(LspServerTest, Unchanged_Entities_Are_Not_Checked_Again_When_Document_Changes)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    auto hits = server.cache().hits();
+    server.handle(CreateNotification("textDocument/didChange",
+                                     {{"textDocument", {{"uri", GetUri(tmp, "project_types.proto")}, {"version", 2}}},
+                                      {"contentChanges",
+                                       {{{"text", GetFileHeader("busrpc") + GetTestEnum() + GetTestStruct()}}}}})
+                      .dump(),
+                  out);
+
+    EXPECT_GT(server.cache().hits(), hits);
+    EXPECT_TRUE(server.analysisScope().empty());
+}
+
+TEST(LspServerTest, Stale_Check_Results_Are_Removed_From_Cache)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    std::vector<std::size_t> sizes;
+
+    Initialize(server, out);
+
+    for (int i = 1; i <= 3; ++i) {
+        std::string text = GetFileHeader("busrpc") + GetTestEnum() + GetTestStruct() + "// Added struct.\n" +
+                           "message Added" + std::to_string(i) + " {}\n";
+        server.handle(CreateNotification("textDocument/didChange",
+                                         {{"textDocument",
+                                           {{"uri", GetUri(tmp, "project_types.proto")}, {"version", i + 1}}},
+                                          {"contentChanges", {{{"text", std::move(text)}}}}})
+                          .dump(),
+                      out);
+        sizes.push_back(server.cache().size());
+    }
+
+    EXPECT_TRUE(server.analysisScope().empty());
+    EXPECT_EQ(sizes[1], sizes[0]);
+    EXPECT_EQ(sizes[2], sizes[0]);
+}
+
+TEST(LspServerTest, Only_Namespace_Is_Analyzed_When_Document_Belonging_To_It_Changes)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "api/namespace/added.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", GetFileHeader("busrpc.api.namespace") + "message AddedStruct {}\n"}}}})
+                      .dump(),
+                  out);
+    auto diagnostics = FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "api/namespace/added.proto"));
+
+    EXPECT_EQ(server.analysisScope(), "busrpc.api.namespace");
+    ASSERT_TRUE(server.project());
+    EXPECT_TRUE(server.project()->find("busrpc.api.namespace.AddedStruct"));
+    EXPECT_TRUE(server.project()->find("busrpc.api.namespace.class.method"));
+    EXPECT_TRUE(server.project()->find("busrpc.implementation.service"));
+    EXPECT_TRUE(server.project()->dnames().find("busrpc.api.namespace.AddedStruct"));
+    ASSERT_TRUE(diagnostics);
+    ASSERT_EQ(diagnostics->size(), 1);
+    EXPECT_NE((*diagnostics)[0]["message"].get<std::string>().find("AddedStruct"), std::string::npos);
+}
+
+TEST(LspServerTest, Diagnostics_Outside_Of_Analyzed_Namespace_Are_Kept)
+{
+    std::string undocumentedFile = GetFileHeader("busrpc.implementation.service") + "message Undocumented {}\n";
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    tmp.writeFile("implementation/service/undocumented.proto", undocumentedFile);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    auto diagnostics =
+        FindDiagnostics(ReadMessages(out.str()), GetUri(tmp, "implementation/service/undocumented.proto"));
+
+    ASSERT_TRUE(diagnostics);
+    EXPECT_EQ(diagnostics->size(), 1);
+
+    out.str("");
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "api/namespace/added.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", "syntax ="}}}})
+                      .dump(),
+                  out);
+    auto messages = ReadMessages(out.str());
+
+    EXPECT_EQ(server.analysisScope(), "busrpc.api.namespace");
+    EXPECT_TRUE(FindDiagnostics(messages, GetUri(tmp, "api/namespace/added.proto")));
+    EXPECT_FALSE(FindDiagnostics(messages, GetUri(tmp, "implementation/service/undocumented.proto")));
+
+    // file with parser error outside of the namespace requires the whole project to be analyzed
+    out.str("");
+    server.handle(CreateNotification("textDocument/didOpen",
+                                     {{"textDocument",
+                                       {{"uri", GetUri(tmp, "implementation/service/undocumented.proto")},
+                                        {"languageId", "proto"},
+                                        {"version", 1},
+                                        {"text", undocumentedFile + "// changed\n"}}}})
+                      .dump(),
+                  out);
+
+    EXPECT_TRUE(server.analysisScope().empty());
+}
+
+TEST(LspServerTest, Definition_Returns_Location_Of_Type_Declaration)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    tmp.writeFile("other.proto", Other_Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(
+        CreateRequest(2, "textDocument/definition", GetTextDocumentPosition(tmp, "other.proto", 6, 4)).dump(), out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0]["result"]["uri"], GetUri(tmp, "file.proto"));
+    EXPECT_EQ(messages[0]["result"]["range"]["start"]["line"], 3);
+    EXPECT_EQ(messages[0]["result"]["range"]["start"]["character"], 8);
+    EXPECT_EQ(messages[0]["result"]["range"]["end"]["character"], 16);
+}
+
+TEST(LspServerTest, Definition_Location_Is_Found_Using_Utf16_Positions)
+{
+    std::string structFile = "syntax = \"proto3\";\n"
+                             "package busrpc;\n"
+                             "// My struct.\n"
+                             "\t/*\xF0\x9D\x84\x9E*/ message MyStruct {\n"
+                             "  // Field.\n"
+                             "  int32 field1 = 1;\n"
+                             "}\n";
+    std::string otherFile = "syntax = \"proto3\";\n"
+                            "package busrpc;\n"
+                            "import \"file.proto\";\n"
+                            "// Other struct.\n"
+                            "message OtherStruct {\n"
+                            "  // Field.\n"
+                            "  /*\xF0\x9D\x84\x9E*/ MyStruct field1 = 1;\n"
+                            "}\n";
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", structFile);
+    tmp.writeFile("other.proto", otherFile);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(
+        CreateRequest(2, "textDocument/definition", GetTextDocumentPosition(tmp, "other.proto", 6, 9)).dump(), out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_FALSE(messages[0]["result"].is_null());
+    EXPECT_EQ(messages[0]["result"]["uri"], GetUri(tmp, "file.proto"));
+    EXPECT_EQ(messages[0]["result"]["range"]["start"]["line"], 3);
+    EXPECT_EQ(messages[0]["result"]["range"]["start"]["character"], 16);
+    EXPECT_EQ(messages[0]["result"]["range"]["end"]["character"], 24);
+}
+
+TEST(LspServerTest, Hover_Returns_Entity_Documentation)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    tmp.writeFile("other.proto", Other_Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(CreateRequest(2, "textDocument/hover", GetTextDocumentPosition(tmp, "other.proto", 6, 10)).dump(),
+                  out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    auto text = messages[0]["result"]["contents"]["value"].get<std::string>();
+    EXPECT_NE(text.find("busrpc.MyStruct"), std::string::npos);
+    EXPECT_NE(text.find("My struct."), std::string::npos);
+}
+
+TEST(LspServerTest, Hover_Returns_Null_If_Name_Is_Unknown)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("other.proto", Other_Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(CreateRequest(2, "textDocument/hover", GetTextDocumentPosition(tmp, "other.proto", 0, 0)).dump(),
+                  out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_TRUE(messages[0]["result"].is_null());
+}
+
+TEST(LspServerTest, Completion_Returns_Type_Names_Starting_With_Word_Prefix)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    tmp.writeFile("other.proto", Other_Struct_File);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(
+        CreateRequest(2, "textDocument/completion", GetTextDocumentPosition(tmp, "other.proto", 6, 4)).dump(), out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0]["result"].size(), 1);
+    EXPECT_EQ(messages[0]["result"][0]["label"], "MyStruct");
+    EXPECT_EQ(messages[0]["result"][0]["detail"], "busrpc.MyStruct");
+}
+
+TEST(LspServerTest, Completion_Returns_Nested_Names_After_Separator)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    tmp.writeFile("file.proto", Struct_File);
+    tmp.writeFile("other.proto", Other_Struct_File + "// MyStruct.\n");
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    Initialize(server, out);
+    out.str("");
+    server.handle(
+        CreateRequest(2, "textDocument/completion", GetTextDocumentPosition(tmp, "other.proto", 8, 12)).dump(), out);
+    auto messages = ReadMessages(out.str());
+
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0]["result"].size(), 1);
+    EXPECT_EQ(messages[0]["result"][0]["label"], "field1");
+    EXPECT_EQ(messages[0]["result"][0]["detail"], "busrpc.MyStruct.field1");
+}
+
+TEST(LspServerTest, serve_Returns_True_If_Exit_Notification_Follows_Shutdown_Request)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    std::istringstream in(FrameMessage(CreateRequest(1, "initialize")) + FrameMessage(CreateRequest(2, "shutdown")) +
+                          FrameMessage(CreateNotification("exit")) + FrameMessage(CreateRequest(3, "shutdown")));
+
+    EXPECT_TRUE(server.serve(in, out));
+    EXPECT_TRUE(server.isShutdown());
+    EXPECT_TRUE(server.isExited());
+    EXPECT_EQ(ReadMessages(out.str()).size(), 2);
+}
+
+TEST(LspServerTest, serve_Coalesces_Document_Changes_Received_Before_Analysis)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    std::string uri = GetUri(tmp, "api/namespace/added.proto");
+    std::string header = GetFileHeader("busrpc.api.namespace");
+    std::string input = FrameMessage(CreateRequest(1, "initialize")) + FrameMessage(CreateNotification("initialized"));
+
+    input += FrameMessage(CreateNotification(
+        "textDocument/didOpen",
+        {{"textDocument", {{"uri", uri}, {"languageId", "proto"}, {"version", 1}, {"text", header}}}}));
+
+    for (int version = 2; version < 5; ++version) {
+        std::string text = header + "// Added struct.\nmessage AddedStruct" + std::to_string(version) + " {}\n";
+        input += FrameMessage(CreateNotification("textDocument/didChange",
+                                                 {{"textDocument", {{"uri", uri}, {"version", version}}},
+                                                  {"contentChanges", {{{"text", text}}}}}));
+    }
+
+    input += FrameMessage(CreateRequest(2, "shutdown")) + FrameMessage(CreateNotification("exit"));
+    std::istringstream in(input);
+
+    EXPECT_TRUE(server.serve(in, out));
+
+    auto messages = ReadMessages(out.str());
+    auto analysisCount = std::count_if(messages.begin(), messages.end(), [](const json& message) {
+        return message.value("method", "") == "window/logMessage";
+    });
+
+    EXPECT_EQ(analysisCount, 1);
+    ASSERT_TRUE(server.project());
+    EXPECT_TRUE(server.project()->find("busrpc.api.namespace.AddedStruct4"));
+    EXPECT_FALSE(server.project()->find("busrpc.api.namespace.AddedStruct3"));
+}
+
+TEST(LspServerTest, serve_Returns_False_If_Input_Is_Exhausted_Without_Exit_Notification)
+{
+    std::ostringstream out;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    LspServer server(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    std::istringstream in(FrameMessage(CreateRequest(1, "initialize")));
+
+    EXPECT_FALSE(server.serve(in, out));
+    EXPECT_FALSE(server.isExited());
+}
+}} // namespace busrpc::test
@@ -45,6 +45,17 @@ TEST_F(NamespaceEntityTest, addClass_Stores_Added_Class)
     EXPECT_EQ(ns_->classes().size(), 1);
 }
 
+TEST_F(NamespaceEntityTest, tryAddClass_Stores_Added_Class_And_Returns_Error_On_Conflict)
+{
+    auto result = ns_->tryAddClass("class");
+
+    ASSERT_TRUE(result);
+    ASSERT_NE(ns_->classes().find("class"), ns_->classes().end());
+    EXPECT_EQ(*(ns_->classes().find("class")), result.value());
+    EXPECT_EQ(ns_->tryAddClass("class").error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(ns_->classes().size(), 1);
+}
+
 TEST_F(NamespaceEntityTest, Adding_NamespaceDesc_Struct_Sets_Namespace_Descriptor)
 {
     Struct* desc = nullptr;
@@ -5,8 +5,41 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 namespace busrpc { namespace test {
 
+namespace {
+
+std::set<std::string> GetErrorDescriptions(const ErrorCollector& ecol)
+{
+    std::set<std::string> descriptions;
+
+    for (const auto& error: ecol.errors()) {
+        descriptions.insert(error.description);
+    }
+
+    return descriptions;
+}
+
+// Create test project with several namespaces and services, some of which contain errors
+void CreateShardedTestProject(MemoryProjectSource& source)
+{
+    CreateTestProject(source);
+    source.addFile("project_types.proto",
+                   GetFileHeader("busrpc") + GetTestStruct() + "message Undocumented {}\n");
+
+    for (const std::string name: {"first", "second", "third", "fourth", "fifth", "sixth"}) {
+        source.addFile("api/" + name + "/namespace.proto",
+                       GetFileHeader("busrpc.api." + name) + "message NamespaceDesc {}\n");
+        source.addFile("api/" + name + "/types.proto",
+                       GetFileHeader("busrpc.api." + name) + "enum bad_name { BAD_NAME_UNKNOWN = 0; }\n");
+        source.addFile("implementation/" + name + "/service.proto",
+                       GetFileHeader("busrpc.implementation." + name) + "message Undocumented {}\n");
+    }
+}
+} // namespace
+
 TEST(ParserTest, File_Error_Category_Name_Is_Not_Empty)
 {
     EXPECT_TRUE(parser_error_category().name());
@@ -32,6 +65,20 @@ TEST(ParserTest, Ctor_Correctly_Initiliazes_Object)
 
     EXPECT_EQ(parser.projectDir(), projectDir);
     EXPECT_EQ(parser.protobufRoot(), protobufRoot);
+    EXPECT_FALSE(parser.source());
+    EXPECT_EQ(parser.profile(), ParserProfile::Auto);
+}
+
+TEST(ParserTest, Source_Ctor_Correctly_Initiliazes_Object)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    std::filesystem::path protobufRoot("protobuf_root");
+    Parser parser(source, protobufRoot);
+
+    EXPECT_TRUE(parser.projectDir().empty());
+    EXPECT_EQ(parser.source(), source);
+    EXPECT_EQ(parser.protobufRoot(), protobufRoot);
+    EXPECT_EQ(parser.profile(), ParserProfile::Auto);
 }
 
 TEST(ParserTest, Parser_Correctly_Parses_Test_Project)
@@ -452,43 +499,79 @@ TEST(ParserTest, Invalid_Project_Dir_Parser_Error_If_Project_Directory_Does_Not_
     EXPECT_TRUE(parser.parse().second.find(ParserErrc::Invalid_Project_Dir));
 }
 
+TEST(ParserTest, Invalid_Project_Dir_Parser_Error_If_Project_Source_Does_Not_Contain_Builtin_File)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    source->addFile("file.proto", GetFileHeader("busrpc"));
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    EXPECT_TRUE(parser.parse().second.find(ParserErrc::Invalid_Project_Dir));
+}
+
+TEST(ParserTest, Parser_Builds_Same_Project_From_Memory_Source_And_Directory)
+{
+    TmpDir dir;
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(dir);
+    CreateTestProject(*source);
+
+    auto [dirProject, dirEcol] = Parser(dir.path(), BUSRPC_TESTS_PROTOBUF_ROOT).parse();
+    auto [sourceProject, sourceEcol] = Parser(source, BUSRPC_TESTS_PROTOBUF_ROOT).parse();
+
+    EXPECT_EQ(dirEcol.errors().size(), 0);
+    EXPECT_EQ(sourceEcol.errors().size(), 0);
+    ASSERT_TRUE(dirProject);
+    ASSERT_TRUE(sourceProject);
+    EXPECT_EQ(sourceProject->contentHash(sourceProject.get()), dirProject->contentHash(dirProject.get()));
+}
+
+TEST(ParserTest, Protobuf_Error_Parser_Error_If_Imported_File_Is_Not_Found_In_Project_Source)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("file.proto", GetFileHeader("busrpc", {"missing.proto"}));
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    EXPECT_TRUE(parser.parse().second.find(ParserErrc::Protobuf_Error));
+}
+
 TEST(ParserTest, Unexpected_Nested_Entity_Spec_Warn_If_Unknown_Directory_Is_Found_In_Project_Directory)
 {
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.createDir("unknown_dir");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addDir("unknown_dir");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_TRUE(parser.parse().second.find(SpecWarn::Unexpected_Nested_Entity));
 }
 
 TEST(ParserTest, Unexpected_Nested_Entity_Spec_Warn_If_Directory_Is_Found_In_Method_Directory)
 {
-    TmpDir tmp;
-    CreateTestProject(tmp);
-    tmp.createDir("api/namespace/class/method/some_dir");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    source->addDir("api/namespace/class/method/some_dir");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_TRUE(parser.parse().second.find(SpecWarn::Unexpected_Nested_Entity));
 }
 
 TEST(ParserTest, Unexpected_Nested_Entity_Spec_Warn_If_Directory_Is_Found_In_Service_Directory)
 {
-    TmpDir tmp;
-    CreateTestProject(tmp);
-    tmp.createDir(JoinStrings(Implementation_Entity_Name, "service/some_dir"));
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    source->addDir(JoinStrings(Implementation_Entity_Name, "service/some_dir"));
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_TRUE(parser.parse().second.find(SpecWarn::Unexpected_Nested_Entity));
 }
 
 TEST(ParserTest, Unexpected_Directories_Are_Ignored_By_Parser)
 {
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.writeFile("unknown_dir/file.proto", "invalid protobuf file");
-    tmp.writeFile("CallMessage/file.proto", "invalid protobuf file");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("unknown_dir/file.proto", "invalid protobuf file");
+    source->addFile("CallMessage/file.proto", "invalid protobuf file");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     ErrorCollector ecol = parser.parse().second;
 
@@ -497,10 +580,10 @@ TEST(ParserTest, Unexpected_Directories_Are_Ignored_By_Parser)
 
 TEST(ParserTest, Files_With_Extension_Other_Than_proto_Are_Ignored_By_Parser)
 {
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.writeFile("file.proto1", "invalid protobuf file");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("file.proto1", "invalid protobuf file");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_FALSE(parser.parse().second);
 }
@@ -510,10 +593,10 @@ TEST(ParserTest, Unexpected_Package_Spec_Error_If_File_Content_Is_Not_Placed_Int
     std::string content = "syntax = \"proto3\";\n"
                           "package busrpc.aaa;\n"
                           "message MyStruct {}\n";
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.writeFile("file.proto", content);
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("file.proto", content);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_TRUE(parser.parse().second.find(SpecErrc::Unexpected_Package));
 }
@@ -525,11 +608,11 @@ TEST(ParserTest, Multiple_Definitions_Spec_Error_If_Next_Level_Entity_Conflicts_
                           "enum api {\n"
                           "  CONSTANT_0 = 0;\n"
                           "}\n";
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.writeFile("file.proto", content);
-    tmp.createDir("api");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("file.proto", content);
+    source->addDir("api");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     auto [projectPtr, ecol] = parser.parse();
 
@@ -539,22 +622,307 @@ TEST(ParserTest, Multiple_Definitions_Spec_Error_If_Next_Level_Entity_Conflicts_
 
 TEST(ParserTest, Invalid_Entity_Spec_Error_If_Entity_Has_Invalid_Name)
 {
-    TmpDir tmp;
-    CreateMinimalProject(tmp);
-    tmp.createDir("api/namespace.proto");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addDir("api/namespace.proto");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
 
     EXPECT_TRUE(parser.parse().second.find(SpecErrc::Invalid_Entity));
 }
 
 TEST(ParserTest, Protobuf_Error_Parser_Error_If_File_Has_Invalid_Protobuf_Syntax)
 {
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("invalid.proto", "syntax =");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    EXPECT_TRUE(parser.parse().second.find(ParserErrc::Protobuf_Error));
+}
+
+TEST(ParserTest, Overlay_Content_Is_Parsed_Instead_Of_File_Content)
+{
+    std::string content = "syntax = \"proto3\";\n"
+                          "package busrpc;\n"
+                          "// My struct.\n"
+                          "message MyStruct {}\n";
     TmpDir tmp;
     CreateMinimalProject(tmp);
-    tmp.writeFile("invalid.proto", "syntax =");
-    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT);
+    tmp.writeFile("file.proto", "syntax =");
+    Parser parser(tmp.path(), BUSRPC_TESTS_PROTOBUF_ROOT, {{"file.proto", content}});
 
-    EXPECT_TRUE(parser.parse().second.find(ParserErrc::Protobuf_Error));
+    auto [projectPtr, ecol] = parser.parse();
+
+    EXPECT_FALSE(ecol.find(ParserErrc::Protobuf_Error));
+    EXPECT_TRUE(projectPtr->find("busrpc.MyStruct"));
+}
+
+TEST(ParserTest, Overlay_Files_Not_Existing_On_Disk_Are_Parsed)
+{
+    std::string nsContent = "syntax = \"proto3\";\n"
+                            "package busrpc.api.billing;\n"
+                            "message NamespaceDesc {}\n";
+    std::string content = "syntax = \"proto3\";\n"
+                          "package busrpc;\n"
+                          "import \"api/billing/namespace.proto\";\n"
+                          "message MyStruct {\n"
+                          "  busrpc.api.billing.NamespaceDesc field1 = 1;\n"
+                          "}\n";
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    Parser parser(tmp.path(),
+                  BUSRPC_TESTS_PROTOBUF_ROOT,
+                  {{"file.proto", content}, {"api/billing/namespace.proto", nsContent}});
+
+    auto [projectPtr, ecol] = parser.parse();
+
+    EXPECT_FALSE(ecol.find(ParserErrc::Protobuf_Error));
+    EXPECT_TRUE(projectPtr->find("busrpc.MyStruct"));
+    EXPECT_TRUE(projectPtr->find("busrpc.api.billing.NamespaceDesc"));
+    EXPECT_FALSE(std::filesystem::exists(tmp.path() / "file.proto"));
+}
+
+TEST(ParserTest, Protobuf_Errors_Are_Located_In_File)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateMinimalProject(*source);
+    source->addFile("api/invalid.proto", "syntax = \"proto3\";\n  message {}\n");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto error = parser.parse().second.find(ParserErrc::Protobuf_Error);
+
+    ASSERT_TRUE(error);
+    EXPECT_EQ(error->location.file, "api/invalid.proto");
+    EXPECT_EQ(error->location.line, 1);
+    EXPECT_EQ(error->location.column, 10);
+}
+
+TEST(ParserTest, Scoped_Parsing_Builds_Scope_Entity_And_Its_Dependencies)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    source->addFile("api/other/namespace.proto", "invalid protobuf file");
+    source->addFile("api/other/class/class.proto", "invalid protobuf file");
+    source->addFile("implementation/other/service.proto", "invalid protobuf file");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto [project, ecol] = parser.parse({}, nullptr, "busrpc.implementation.service");
+
+    EXPECT_EQ(ecol.errors().size(), 0);
+    ASSERT_TRUE(project);
+    EXPECT_TRUE(project->find("busrpc.implementation.service.ServiceDesc"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.class.method.MethodDesc"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.class.ClassDesc"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.NamespaceDesc"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.static_class.static_method.MethodDesc"));
+    EXPECT_TRUE(project->errc());
+    EXPECT_FALSE(project->find("busrpc.api.other"));
+    EXPECT_FALSE(project->find("busrpc.implementation.other"));
+    EXPECT_FALSE(project->find("busrpc.implementation.TestStruct"));
+}
+
+TEST(ParserTest, Scoped_Parsing_Does_Not_Build_Files_Not_Imported_By_Scope)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto [project, ecol] = parser.parse({}, nullptr, "busrpc.api.namespace.class.oneway_method");
+
+    EXPECT_EQ(ecol.errors().size(), 0);
+    ASSERT_TRUE(project);
+    ASSERT_TRUE(project->api());
+    EXPECT_TRUE(project->find("busrpc.api.namespace.class.oneway_method.MethodDesc"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.class.ClassDesc"));
+    EXPECT_FALSE(project->find("busrpc.api.namespace.class.method"));
+    EXPECT_FALSE(project->find("busrpc.api.namespace.static_class"));
+    EXPECT_FALSE(project->implementation());
+}
+
+TEST(ParserTest, Scoped_Parsing_Reports_Errors_Found_In_Scope)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    source->addFile("api/namespace/class/method/invalid.proto", "syntax =");
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto scopedEcol = parser.parse({}, nullptr, "busrpc.api.namespace").second;
+
+    EXPECT_TRUE(scopedEcol.find(ParserErrc::Protobuf_Error));
+    EXPECT_EQ(scopedEcol.errors().size(), parser.parse().second.errors().size());
+    EXPECT_FALSE(parser.parse({}, nullptr, "busrpc.implementation").second.find(ParserErrc::Protobuf_Error));
+}
+
+TEST(ParserTest, Project_Scope_Is_Same_As_No_Scope)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto fullProject = parser.parse().first;
+    auto scopedProject = parser.parse({}, nullptr, Project_Entity_Name).first;
+
+    EXPECT_EQ(scopedProject->contentHash(scopedProject.get()), fullProject->contentHash(fullProject.get()));
+}
+
+TEST(ParserTest, Scoped_Parsing_Result_Spliced_Into_Project_Is_Same_As_Full_Parsing_Result)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+    FrozenProjectPtr project = Project::Freeze(parser.parse().first);
+
+    source->addFile("api/namespace/added.proto",
+                    GetFileHeader("busrpc.api.namespace") + "// Added struct.\nmessage AddedStruct {}\n");
+    auto part = parser.parse({}, nullptr, "busrpc.api.namespace").first;
+    auto expected = Project::Freeze(parser.parse().first);
+
+    ASSERT_TRUE(Project::Splice(project, part, "busrpc.api.namespace"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.AddedStruct"));
+    EXPECT_EQ(project->contentHash(project.get()), expected->contentHash(expected.get()));
+    EXPECT_EQ(project->dnames().size(), expected->dnames().size());
+    EXPECT_EQ(GetErrorDescriptions(project->check()), GetErrorDescriptions(expected->check()));
+}
+
+TEST(ParserTest, Invalid_Scope_Parser_Error_If_Scope_Does_Not_Denote_Entity_Directory)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    source->addFile("unknown_dir/file.proto", GetFileHeader("busrpc.unknown_dir"));
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    EXPECT_TRUE(parser.parse({}, nullptr, "busrpc.api.missing").second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, "other.api.namespace").second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, "busrpc.unknown_dir").second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, "busrpc.").second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, "busrpc.api.namespace.class.method.MethodDesc")
+                    .second.find(ParserErrc::Invalid_Scope));
+}
+
+TEST(ParserTest, Union_Of_Errors_Found_For_All_Shards_Is_Same_As_Errors_Found_For_Whole_Project)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateShardedTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto expected = GetErrorDescriptions(parser.parse().second);
+
+    ASSERT_GT(expected.size(), 6);
+
+    for (std::size_t count: {2u, 3u, 5u}) {
+        std::set<std::string> actual;
+
+        for (std::size_t index = 0; index < count; ++index) {
+            actual.merge(GetErrorDescriptions(parser.parse({}, nullptr, {}, {index, count}).second));
+        }
+
+        EXPECT_EQ(actual, expected) << "shard count " << count;
+    }
+}
+
+TEST(ParserTest, Sharded_Parsing_Builds_Entity_Directory_Only_For_Shard_It_Belongs_To)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateShardedTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+    std::size_t serviceCount = 0;
+    std::size_t implementationTypesCount = 0;
+
+    for (std::size_t index = 0; index < 3; ++index) {
+        auto [project, ecol] = parser.parse({}, nullptr, {}, {index, 3});
+
+        ASSERT_TRUE(project);
+        EXPECT_TRUE(project->errc());
+        serviceCount += project->find("busrpc.implementation.service.ServiceDesc") ? 1u : 0u;
+        implementationTypesCount += project->find("busrpc.implementation.TestStruct") ? 1u : 0u;
+
+        if (index == 0) {
+            EXPECT_TRUE(project->find("busrpc.implementation.TestStruct"));
+        }
+    }
+
+    EXPECT_EQ(serviceCount, 1);
+    EXPECT_EQ(implementationTypesCount, 1);
+}
+
+TEST(ParserTest, Single_Shard_Is_Same_As_No_Shard)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateShardedTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto [fullProject, fullEcol] = parser.parse();
+    auto [shardProject, shardEcol] = parser.parse({}, nullptr, {}, {0, 1});
+
+    EXPECT_EQ(shardProject->contentHash(shardProject.get()), fullProject->contentHash(fullProject.get()));
+    EXPECT_EQ(GetErrorDescriptions(shardEcol), GetErrorDescriptions(fullEcol));
+}
+
+TEST(ParserTest, Invalid_Scope_Parser_Error_If_Shard_Is_Invalid)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    EXPECT_TRUE(parser.parse({}, nullptr, {}, {0, 0}).second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, {}, {2, 2}).second.find(ParserErrc::Invalid_Scope));
+    EXPECT_TRUE(parser.parse({}, nullptr, "busrpc.api.namespace", {0, 2}).second.find(ParserErrc::Invalid_Scope));
+}
+
+TEST(ParserTest, Lean_Profile_Does_Not_Build_Documentation_Except_Accepted_Values)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT, {}, ParserProfile::Lean);
+
+    auto project = parser.parse({&doc_warn_category()}).first;
+
+    ASSERT_TRUE(project);
+    ASSERT_TRUE(project->find("busrpc.api.namespace.TestStruct"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.TestStruct")->docs().description().empty());
+    ASSERT_TRUE(project->find("busrpc.api.namespace.TestEnum"));
+    EXPECT_TRUE(project->find("busrpc.api.namespace.TestEnum")->docs().description().empty());
+
+    auto service = static_cast<const Service*>(project->find("busrpc.implementation.service"));
+
+    ASSERT_TRUE(service);
+    EXPECT_TRUE(service->author().empty());
+
+    auto implMethod = service->implementedMethods().find("busrpc.api.namespace.class.method");
+
+    ASSERT_NE(implMethod, service->implementedMethods().end());
+    ASSERT_TRUE(implMethod->acceptedObjectId());
+    EXPECT_EQ(*implMethod->acceptedObjectId(), "1");
+    EXPECT_EQ(implMethod->acceptedParams().size(), 1);
+}
+
+TEST(ParserTest, Auto_Profile_Is_Lean_Only_If_Documentation_Warnings_Are_Ignored)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateTestProject(*source);
+    Parser parser(source, BUSRPC_TESTS_PROTOBUF_ROOT);
+
+    auto fullProject = parser.parse({&style_warn_category()}).first;
+    auto leanProject = parser.parse({&doc_warn_category()}).first;
+
+    ASSERT_TRUE(fullProject->find("busrpc.api.namespace.TestStruct"));
+    ASSERT_TRUE(leanProject->find("busrpc.api.namespace.TestStruct"));
+    EXPECT_FALSE(fullProject->find("busrpc.api.namespace.TestStruct")->docs().description().empty());
+    EXPECT_TRUE(leanProject->find("busrpc.api.namespace.TestStruct")->docs().description().empty());
+}
+
+TEST(ParserTest, Lean_Profile_Does_Not_Affect_Errors_Except_Documentation_Warnings)
+{
+    auto source = std::make_shared<MemoryProjectSource>();
+    CreateShardedTestProject(*source);
+    Parser fullParser(source, BUSRPC_TESTS_PROTOBUF_ROOT, {}, ParserProfile::Full);
+    Parser leanParser(source, BUSRPC_TESTS_PROTOBUF_ROOT, {}, ParserProfile::Lean);
+
+    auto fullEcol = fullParser.parse({&doc_warn_category()}).second;
+    auto leanEcol = leanParser.parse({&doc_warn_category()}).second;
+
+    EXPECT_FALSE(fullEcol.errors().empty());
+    EXPECT_EQ(GetErrorDescriptions(leanEcol), GetErrorDescriptions(fullEcol));
 }
 
 TEST(ParserTest, Default_Severity_Of_Errors_Is_ParserErrc_SpecErrc_SpecWarn_DocWarn_StyleWarn)
@@ -1,3 +1,4 @@
+#include "check_cache.h"
 #include "entities/project.h"
 #include "utils/common.h"
 #include "utils/project_utils.h"
@@ -1161,4 +1162,125 @@ TEST_F(ProjectCheckTest, Empty_Struct_Can_Be_Marked_As_Hashed)
 
     EXPECT_FALSE(ecol);
 }
+
+TEST_F(ProjectCheckTest, Content_Hash_Is_Equal_For_Entities_With_Equal_Content)
+{
+    Project project1;
+    Project project2;
+    InitProject(&project1);
+    InitProject(&project2);
+
+    EXPECT_EQ(project1.contentHash(&project1), project2.contentHash(&project2));
+    EXPECT_EQ(project1.contentHash(project1.api()), project2.contentHash(project2.api()));
+    EXPECT_NE(project1.contentHash(project1.api()), project1.contentHash(project1.implementation()));
+}
+
+TEST_F(ProjectCheckTest, Content_Hash_Changes_If_Nested_Entity_Changes)
+{
+    auto structure = project_.addStruct("MyStruct", "1.proto", StructFlags::None, EntityDocs("Structure."));
+    auto nested = structure->addStruct("Nested", StructFlags::None, EntityDocs("Nested structure."));
+    auto projectHash = project_.contentHash(&project_);
+    auto structHash = project_.contentHash(structure);
+
+    nested->addScalarField("field1", 1, FieldTypeId::Int32);
+
+    EXPECT_NE(project_.contentHash(&project_), projectHash);
+    EXPECT_NE(project_.contentHash(structure), structHash);
+}
+
+TEST_F(ProjectCheckTest, Content_Hash_Changes_If_Referenced_Type_Encodability_Changes)
+{
+    auto referenced = project_.addStruct("Referenced", "1.proto", StructFlags::None, EntityDocs("Referenced."));
+    auto structure = project_.addStruct("MyStruct", "1.proto", StructFlags::None, EntityDocs("Structure."));
+    structure->addStructField("field1", 1, referenced->dname());
+    auto structHash = project_.contentHash(structure);
+
+    referenced->addScalarField("field1", 1, FieldTypeId::Double);
+
+    EXPECT_NE(project_.contentHash(structure), structHash);
+}
+
+TEST_F(ProjectCheckTest, Check_With_Cache_Collects_Same_Errors_As_Check_Without_Cache)
+{
+    auto structure = project_.addStruct("myStruct", "1.proto", StructFlags::Hashed);
+    structure->addScalarField("Field1", 1, FieldTypeId::Double, FieldFlags::Observable);
+    structure->addStructField("field2", 2, "busrpc.Unknown");
+    project_.addEnum("MyEnum", "1.proto")->addConstant("CONSTANT_1", 1);
+    CheckCache cache;
+
+    ErrorCollector expected = project_.check();
+    ErrorCollector first;
+    project_.check(first, &cache);
+    ErrorCollector second;
+    project_.check(second, &cache);
+
+    ASSERT_FALSE(expected.errors().empty());
+    ASSERT_EQ(first.errors().size(), expected.errors().size());
+    ASSERT_EQ(second.errors().size(), expected.errors().size());
+
+    for (std::size_t i = 0; i < expected.errors().size(); ++i) {
+        EXPECT_EQ(first.errors()[i].code, expected.errors()[i].code);
+        EXPECT_EQ(first.errors()[i].description, expected.errors()[i].description);
+        EXPECT_EQ(second.errors()[i].code, expected.errors()[i].code);
+        EXPECT_EQ(second.errors()[i].description, expected.errors()[i].description);
+    }
+
+    EXPECT_NE(cache.hits(), 0);
+    EXPECT_EQ(cache.hits(), cache.misses());
+}
+
+TEST_F(ProjectCheckTest, Check_With_Cache_Respects_Ignored_Categories_When_Replaying_Errors)
+{
+    project_.addStruct("myStruct", "1.proto", StructFlags::None, EntityDocs("Structure."));
+    CheckCache cache;
+
+    ErrorCollector first;
+    project_.check(first, &cache);
+    ErrorCollector second({}, {&style_warn_category()});
+    project_.check(second, &cache);
+
+    EXPECT_TRUE(first.find(StyleWarn::Invalid_Name_Format));
+    EXPECT_FALSE(second.find(StyleWarn::Invalid_Name_Format));
+    EXPECT_NE(cache.hits(), 0);
+}
+
+TEST_F(ProjectCheckTest, Check_With_Filter_Checks_Only_Selected_Entities)
+{
+    project_.addStruct("myStruct", "1.proto", StructFlags::None, EntityDocs("Structure."));
+    auto ns = api_->addNamespace("namespace");
+    auto service = implementation_->addService("service");
+
+    ErrorCollector projectOnly;
+    project_.check(projectOnly, nullptr, [](const Entity* entity) { return entity->type() == EntityTypeId::Project; });
+    ErrorCollector namespaceOnly;
+    project_.check(namespaceOnly, nullptr, [ns](const Entity* entity) { return entity == ns; });
+    ErrorCollector serviceOnly;
+    project_.check(serviceOnly, nullptr, [service](const Entity* entity) { return entity == service; });
+
+    EXPECT_EQ(projectOnly.errors().size(), 1);
+    EXPECT_TRUE(projectOnly.find(StyleWarn::Invalid_Name_Format));
+    EXPECT_EQ(namespaceOnly.errors().size(), 1);
+    EXPECT_TRUE(namespaceOnly.find(SpecErrc::No_Descriptor));
+    EXPECT_EQ(serviceOnly.errors().size(), 1);
+    EXPECT_TRUE(serviceOnly.find(SpecErrc::No_Descriptor));
+}
+
+TEST_F(ProjectCheckTest, Check_Errors_Are_Located_At_Entity_Which_Is_Their_Subject)
+{
+    auto enumeration = api_->addEnum("MyEnum", "1.proto");
+    Project project;
+    AddException(&project);
+    AddCallMessage(&project);
+    AddResultMessage(&project);
+
+    auto ecol = project_.check();
+    auto builtinEcol = project.check();
+
+    ASSERT_TRUE(ecol.find(SpecErrc::Empty_Enum));
+    EXPECT_EQ(ecol.find(SpecErrc::Empty_Enum)->location.entity, enumeration->dname());
+    EXPECT_TRUE(ecol.find(SpecErrc::Empty_Enum)->location.file.empty());
+    ASSERT_TRUE(builtinEcol.find(SpecErrc::Missing_Builtin));
+    EXPECT_EQ(builtinEcol.find(SpecErrc::Missing_Builtin)->location.file, Busrpc_Builtin_File);
+    EXPECT_TRUE(builtinEcol.find(SpecErrc::Missing_Builtin)->location.entity.empty());
+}
 }} // namespace busrpc::test
@@ -4,6 +4,8 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace busrpc { namespace test {
 
@@ -139,6 +141,29 @@ TEST_F(ProjectEntityTest, addImplementation_Initializes_Implementation_Entity)
     EXPECT_EQ(implementation, project.implementation());
 }
 
+TEST_F(ProjectEntityTest, tryAddApi_And_tryAddImplementation_Initialize_Entities)
+{
+    Project project;
+    auto api = project.tryAddApi();
+    auto implementation = project.tryAddImplementation();
+
+    ASSERT_TRUE(api);
+    ASSERT_TRUE(implementation);
+    EXPECT_EQ(api.value(), project.api());
+    EXPECT_EQ(implementation.value(), project.implementation());
+    EXPECT_EQ(project.tryAddApi().error(), EntityErrc::Name_Conflict);
+    EXPECT_EQ(project.api(), api.value());
+}
+
+TEST_F(ProjectEntityTest, tryAddApi_Returns_Error_If_Name_Conflicts_With_Project_Type)
+{
+    Project project;
+
+    ASSERT_TRUE(project.tryAddEnum(Api_Entity_Name, "file.proto"));
+    EXPECT_EQ(project.tryAddApi().error(), EntityErrc::Name_Conflict);
+    EXPECT_FALSE(project.api());
+}
+
 TEST_F(ProjectEntityTest, find_Returns_Correct_Entity_If_It_Exists)
 {
     std::string apiPrefix = JoinStrings(Project_Entity_Name, ".", Api_Entity_Name, ".");
@@ -199,4 +224,102 @@ TEST_F(ProjectEntityTest, Entity_Directory_Is_Updated_When_New_Entity_Is_Added)
     EXPECT_TRUE(ns3 = api_->addNamespace("ns3"));
     EXPECT_EQ(project_->find(JoinStrings(Api_Entity_Name, ".ns3")), ns3);
 }
+
+TEST_F(ProjectEntityTest, Freeze_Returns_Read_Only_View_Of_The_Same_Project)
+{
+    auto contentHash = project_->contentHash(project_.get());
+    FrozenProjectPtr frozen = Project::Freeze(project_);
+
+    ASSERT_EQ(frozen.get(), project_.get());
+    EXPECT_TRUE(frozen->isFrozen());
+    EXPECT_EQ(frozen->contentHash(frozen.get()), contentHash);
+    EXPECT_EQ(frozen->find(JoinStrings(Api_Entity_Name, ".ns1.cls1.method1")), method1_);
+    EXPECT_EQ(Project::Freeze(project_), frozen);
+}
+
+TEST_F(ProjectEntityTest, Freeze_Returns_Nullptr_For_Null_Project)
+{
+    EXPECT_FALSE(Project::Freeze(nullptr));
+}
+
+TEST_F(ProjectEntityTest, Project_Is_Not_Frozen_After_Creation)
+{
+    EXPECT_FALSE(project_->isFrozen());
+}
+
+TEST_F(ProjectEntityTest, Frozen_Project_Can_Be_Read_By_Several_Threads_Concurrently)
+{
+    std::string dname = JoinStrings(Api_Entity_Name, ".ns2.Struct1.NestedStruct1");
+    auto expectedHash = project_->contentHash(project_.get());
+    auto expectedErrors = project_->check().errors().size();
+    FrozenProjectPtr frozen = Project::Freeze(project_);
+    std::vector<std::thread> threads;
+    std::vector<int> results(4, 0);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&frozen, &dname, &results, expectedHash, expectedErrors, i]() {
+            for (int j = 0; j < 10; ++j) {
+                if (frozen->find(dname) == frozen->find(dname) && frozen->contentHash(frozen.get()) == expectedHash &&
+                    frozen->check().errors().size() == expectedErrors) {
+                    ++results[i];
+                }
+            }
+        });
+    }
+
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(results, std::vector<int>(4, 10));
+}
+
+TEST_F(ProjectEntityTest, Splice_Replaces_Namespace_Subtree_With_Subtree_From_Part)
+{
+    auto part = std::make_shared<Project>(Test_Root);
+    auto partStruct = part->addApi()->addNamespace("ns1")->addStruct("Struct2", "file5.proto");
+    part->addImplementation()->addService("other");
+    FrozenProjectPtr frozen = Project::Freeze(std::move(project_));
+
+    ASSERT_TRUE(Project::Splice(frozen, part, "busrpc.api.ns1"));
+    EXPECT_TRUE(frozen->isFrozen());
+    EXPECT_EQ(frozen->find("api.ns1.Struct2"), partStruct);
+    EXPECT_EQ(frozen->dnames().find("busrpc.api.ns1.Struct2"), partStruct);
+    EXPECT_EQ(frozen->find("api.ns1")->parent(), api_);
+    EXPECT_EQ(api_->namespaces().size(), 2);
+    EXPECT_FALSE(frozen->find("api.ns1.cls1"));
+    EXPECT_FALSE(frozen->dnames().find("busrpc.api.ns1.cls1.method1"));
+    EXPECT_EQ(frozen->find("api.ns2.Struct1"), struct1_);
+    EXPECT_FALSE(frozen->find("implementation.other"));
+}
+
+TEST_F(ProjectEntityTest, Splice_Removes_Service_Missing_In_Part)
+{
+    FrozenProjectPtr frozen = Project::Freeze(std::move(project_));
+
+    ASSERT_TRUE(Project::Splice(frozen, std::make_shared<Project>(Test_Root), "busrpc.implementation.service"));
+    EXPECT_TRUE(implementation_->services().empty());
+    EXPECT_FALSE(frozen->find("implementation.service"));
+    EXPECT_FALSE(frozen->find("implementation.service.Enum1"));
+    EXPECT_FALSE(frozen->dnames().find("busrpc.implementation.service"));
+    EXPECT_EQ(frozen->find("implementation.Struct1"), implementationStruct1_);
+}
+
+TEST_F(ProjectEntityTest, Splice_Fails_If_Project_Is_Shared_Or_Entity_Is_Not_Namespace_Or_Service)
+{
+    FrozenProjectPtr frozen = Project::Freeze(std::move(project_));
+    auto part = std::make_shared<Project>(Test_Root);
+
+    EXPECT_FALSE(Project::Splice(frozen, part, "busrpc.api.ns1.cls1"));
+    EXPECT_FALSE(Project::Splice(frozen, part, "busrpc.api"));
+    EXPECT_FALSE(Project::Splice(frozen, part, "busrpc"));
+
+    {
+        FrozenProjectPtr copy = frozen;
+        EXPECT_FALSE(Project::Splice(frozen, part, "busrpc.api.ns1"));
+    }
+
+    EXPECT_EQ(frozen->find("api.ns1.cls1"), cls1_);
+    EXPECT_TRUE(frozen->dnames().find("busrpc.api.ns1.cls1"));
+}
 }} // namespace busrpc::test
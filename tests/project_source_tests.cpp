@@ -0,0 +1,124 @@
+#include "parser/project_source.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace busrpc { namespace test {
+
+namespace {
+
+std::vector<std::string> Sorted(std::vector<std::string> names)
+{
+    std::sort(names.begin(), names.end());
+    return names;
+}
+} // namespace
+
+TEST(ProjectSourceTest, Memory_Source_Ctor_Correctly_Initializes_Object)
+{
+    MemoryProjectSource source({{"busrpc.proto", "content"}, {"./api/file.proto", "api content"}});
+
+    EXPECT_EQ(source.files().size(), 2);
+    EXPECT_EQ(source.read("busrpc.proto"), "content");
+    EXPECT_EQ(source.read("api/file.proto"), "api content");
+}
+
+TEST(ProjectSourceTest, Memory_Source_isFile_Returns_True_Only_For_Added_Files)
+{
+    MemoryProjectSource source;
+    source.addFile("api/namespace/file.proto");
+
+    EXPECT_TRUE(source.isFile("api/namespace/file.proto"));
+    EXPECT_TRUE(source.isFile("api//namespace/./file.proto"));
+    EXPECT_FALSE(source.isFile("api/namespace"));
+    EXPECT_FALSE(source.isFile("api/namespace/other.proto"));
+}
+
+TEST(ProjectSourceTest, Memory_Source_read_Returns_Nullopt_For_Unknown_File)
+{
+    MemoryProjectSource source;
+    source.addDir("api");
+
+    EXPECT_FALSE(source.read("file.proto"));
+    EXPECT_FALSE(source.read("api"));
+}
+
+TEST(ProjectSourceTest, Memory_Source_addFile_Replaces_Content_Of_Existing_File)
+{
+    MemoryProjectSource source;
+    source.addFile("file.proto", "old");
+    source.addFile("file.proto", "new");
+
+    EXPECT_EQ(source.files().size(), 1);
+    EXPECT_EQ(source.read("file.proto"), "new");
+}
+
+TEST(ProjectSourceTest, Memory_Source_list_Returns_Immediate_Children_Of_Directory)
+{
+    MemoryProjectSource source;
+    source.addFile("busrpc.proto");
+    source.addFile("api/api.proto");
+    source.addFile("api/namespace/class/class.proto");
+    source.addFile("api_types.proto");
+    source.addDir("implementation/service");
+
+    std::vector<std::string> files;
+    std::vector<std::string> subdirs;
+
+    EXPECT_TRUE(source.list("", files, subdirs));
+    EXPECT_EQ(Sorted(files), std::vector<std::string>({"api_types.proto", "busrpc.proto"}));
+    EXPECT_EQ(Sorted(subdirs), std::vector<std::string>({"api", "implementation"}));
+
+    files.clear();
+    subdirs.clear();
+
+    EXPECT_TRUE(source.list("api", files, subdirs));
+    EXPECT_EQ(files, std::vector<std::string>({"api.proto"}));
+    EXPECT_EQ(subdirs, std::vector<std::string>({"namespace"}));
+
+    files.clear();
+    subdirs.clear();
+
+    EXPECT_TRUE(source.list("implementation/service", files, subdirs));
+    EXPECT_TRUE(files.empty());
+    EXPECT_TRUE(subdirs.empty());
+}
+
+TEST(ProjectSourceTest, Memory_Source_list_Returns_False_For_Unknown_Directory)
+{
+    MemoryProjectSource source;
+    source.addFile("api/api.proto");
+
+    std::vector<std::string> files;
+    std::vector<std::string> subdirs;
+
+    EXPECT_FALSE(source.list("implementation", files, subdirs));
+    EXPECT_FALSE(source.list("api/api.proto", files, subdirs));
+    EXPECT_TRUE(files.empty());
+    EXPECT_TRUE(subdirs.empty());
+}
+
+TEST(ProjectSourceTest, Disk_Source_Reads_Files_From_Project_Directory)
+{
+    TmpDir tmp;
+    tmp.writeFile("busrpc.proto", "content");
+    tmp.writeFile("api/api.proto", "api content");
+    tmp.createDir("implementation");
+    DiskProjectSource source(tmp.path());
+
+    std::vector<std::string> files;
+    std::vector<std::string> subdirs;
+
+    EXPECT_EQ(source.projectDir(), tmp.path());
+    EXPECT_TRUE(source.isFile("busrpc.proto"));
+    EXPECT_FALSE(source.isFile("api"));
+    EXPECT_EQ(source.read("api/api.proto"), "api content");
+    EXPECT_FALSE(source.read("missing.proto"));
+    EXPECT_TRUE(source.list("", files, subdirs));
+    EXPECT_EQ(files, std::vector<std::string>({"busrpc.proto"}));
+    EXPECT_EQ(Sorted(subdirs), std::vector<std::string>({"api", "implementation"}));
+    EXPECT_FALSE(source.list("missing", files, subdirs));
+}
+}} // namespace busrpc::test
@@ -0,0 +1,172 @@
+#include "protobuf_importer.h"
+#include "utils/file_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace busrpc { namespace test {
+
+namespace {
+
+class TestErrorCollector: public google::protobuf::compiler::MultiFileErrorCollector {
+public:
+    void AddError(const std::string& filename, int line, int, const std::string&) override
+    {
+        errors.emplace_back(filename, line);
+    }
+
+    std::vector<std::pair<std::string, int>> errors;
+};
+} // namespace
+
+TEST(WellKnownTypesDatabaseTest, FindFileByName_Returns_Well_Known_File)
+{
+    WellKnownTypesDatabase database;
+    google::protobuf::FileDescriptorProto file;
+
+    EXPECT_TRUE(database.FindFileByName("google/protobuf/descriptor.proto", &file));
+    EXPECT_EQ(file.name(), "google/protobuf/descriptor.proto");
+    EXPECT_TRUE(database.FindFileByName("google/protobuf/any.proto", &file));
+    EXPECT_EQ(file.name(), "google/protobuf/any.proto");
+}
+
+TEST(WellKnownTypesDatabaseTest, FindFileByName_Fails_For_Unknown_File)
+{
+    WellKnownTypesDatabase database;
+    google::protobuf::FileDescriptorProto file;
+
+    EXPECT_FALSE(database.FindFileByName("file.proto", &file));
+    EXPECT_FALSE(database.FindFileByName("google/protobuf/unknown.proto", &file));
+}
+
+TEST(WellKnownTypesDatabaseTest, FindFileContainingSymbol_Returns_Well_Known_File)
+{
+    WellKnownTypesDatabase database;
+    google::protobuf::FileDescriptorProto file;
+
+    EXPECT_TRUE(database.FindFileContainingSymbol("google.protobuf.Timestamp", &file));
+    EXPECT_EQ(file.name(), "google/protobuf/timestamp.proto");
+    EXPECT_FALSE(database.FindFileContainingSymbol("busrpc.Unknown", &file));
+}
+
+TEST(WellKnownTypesDatabaseTest, FindAllFileNames_Returns_All_Well_Known_Files)
+{
+    WellKnownTypesDatabase database;
+    std::vector<std::string> files;
+
+    EXPECT_TRUE(database.FindAllFileNames(&files));
+    EXPECT_NE(std::find(files.begin(), files.end(), "google/protobuf/descriptor.proto"), files.end());
+    EXPECT_NE(std::find(files.begin(), files.end(), "google/protobuf/wrappers.proto"), files.end());
+}
+
+TEST(SourceInfoStrippingDatabaseTest, Files_Do_Not_Contain_Source_Code_Info)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto",
+                  "syntax = \"proto3\";\n"
+                  "// Structure.\n"
+                  "message Struct {}");
+
+    google::protobuf::compiler::DiskSourceTree sourceTree;
+    sourceTree.MapPath("", tmp.path().string());
+    google::protobuf::compiler::SourceTreeDescriptorDatabase sourceTreeDatabase(&sourceTree);
+    SourceInfoStrippingDatabase database(&sourceTreeDatabase);
+    google::protobuf::FileDescriptorProto file;
+    google::protobuf::FileDescriptorProto strippedFile;
+
+    ASSERT_TRUE(sourceTreeDatabase.FindFileByName("file.proto", &file));
+    ASSERT_TRUE(database.FindFileByName("file.proto", &strippedFile));
+    EXPECT_TRUE(file.has_source_code_info());
+    EXPECT_EQ(strippedFile.message_type_size(), 1);
+    EXPECT_FALSE(strippedFile.has_source_code_info());
+    EXPECT_FALSE(database.FindFileByName("missing.proto", &strippedFile));
+}
+
+TEST(ProtobufImporterTest, Well_Known_Files_Are_Imported_Without_Protobuf_Root)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto",
+                  "syntax = \"proto3\";\n"
+                  "import \"google/protobuf/descriptor.proto\";\n"
+                  "import \"google/protobuf/timestamp.proto\";\n"
+                  "message Struct { google.protobuf.Timestamp field1 = 1; }\n"
+                  "extend google.protobuf.FieldOptions { bool option1 = 50000; }");
+
+    google::protobuf::compiler::DiskSourceTree sourceTree;
+    sourceTree.MapPath("", tmp.path().string());
+    TestErrorCollector ecol;
+    ProtobufImporter importer(&sourceTree, &ecol);
+
+    EXPECT_TRUE(importer.Import("file.proto"));
+    EXPECT_TRUE(ecol.errors.empty());
+    EXPECT_TRUE(importer.pool()->FindMessageTypeByName("google.protobuf.Timestamp"));
+}
+
+TEST(ProtobufImporterTest, Validation_Errors_Contain_Line_Numbers)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto",
+                  "syntax = \"proto3\";\n"
+                  "message Struct {\n"
+                  "  Unknown field1 = 1;\n"
+                  "}");
+
+    google::protobuf::compiler::DiskSourceTree sourceTree;
+    sourceTree.MapPath("", tmp.path().string());
+    TestErrorCollector ecol;
+    ProtobufImporter importer(&sourceTree, &ecol);
+
+    EXPECT_FALSE(importer.Import("file.proto"));
+    ASSERT_EQ(ecol.errors.size(), 1);
+    EXPECT_EQ(ecol.errors[0].first, "file.proto");
+    EXPECT_EQ(ecol.errors[0].second, 2);
+}
+
+TEST(ProtobufImporterTest, Source_Code_Info_Is_Not_Stored_If_Not_Requested)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto",
+                  "syntax = \"proto3\";\n"
+                  "// Structure.\n"
+                  "message Struct {}");
+
+    google::protobuf::compiler::DiskSourceTree sourceTree;
+    sourceTree.MapPath("", tmp.path().string());
+    TestErrorCollector ecol;
+    ProtobufImporter importer(&sourceTree, &ecol);
+    ProtobufImporter strippingImporter(&sourceTree, &ecol, false);
+    google::protobuf::SourceLocation location;
+
+    auto file = importer.Import("file.proto");
+    auto strippedFile = strippingImporter.Import("file.proto");
+
+    ASSERT_TRUE(file);
+    ASSERT_TRUE(strippedFile);
+    EXPECT_TRUE(file->message_type(0)->GetSourceLocation(&location));
+    EXPECT_EQ(location.leading_comments, " Structure.\n");
+    EXPECT_FALSE(strippedFile->message_type(0)->GetSourceLocation(&location));
+    EXPECT_TRUE(ecol.errors.empty());
+}
+
+TEST(ProtobufImporterTest, Validation_Errors_Contain_Line_Numbers_If_Source_Code_Info_Is_Not_Stored)
+{
+    TmpDir tmp;
+    tmp.writeFile("file.proto",
+                  "syntax = \"proto3\";\n"
+                  "message Struct {\n"
+                  "  Unknown field1 = 1;\n"
+                  "}");
+
+    google::protobuf::compiler::DiskSourceTree sourceTree;
+    sourceTree.MapPath("", tmp.path().string());
+    TestErrorCollector ecol;
+    ProtobufImporter importer(&sourceTree, &ecol, false);
+
+    EXPECT_FALSE(importer.Import("file.proto"));
+    ASSERT_EQ(ecol.errors.size(), 1);
+    EXPECT_EQ(ecol.errors[0].second, 2);
+}
+}} // namespace busrpc::test
@@ -0,0 +1,184 @@
+#include "app.h"
+#include "commands/help/help_command.h"
+#include "commands/run/run_command.h"
+#include "tests_configure.h"
+#include "utils.h"
+#include "utils/common.h"
+#include "utils/project_utils.h"
+
+#include <CLI/CLI.hpp>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+namespace busrpc { namespace test {
+
+namespace {
+
+void WriteUndocumentedStruct(TmpDir& projectDir)
+{
+    std::string undocumentedStruct = "syntax = \"proto3\";\n"
+                                     "package busrpc;\n"
+                                     "message MyStruct {}";
+    projectDir.writeFile("file.proto", undocumentedStruct);
+}
+} // namespace
+
+TEST(RunCommandTest, Command_Name_And_Id_Are_Mapped_To_Each_Other)
+{
+    EXPECT_EQ(CommandId::Run, GetCommandId(GetCommandName(CommandId::Run)));
+    EXPECT_EQ(RunCommand::Id, CommandId::Run);
+    EXPECT_STREQ(RunCommand::Name, GetCommandName(CommandId::Run));
+}
+
+TEST(RunCommandTest, Command_Error_Category_Name_Matches_Command_Name)
+{
+    EXPECT_STREQ(run_error_category().name(), GetCommandName(CommandId::Run));
+}
+
+TEST(RunCommandTest, Description_For_Unknown_Command_Error_Code_Is_Not_Empty)
+{
+    EXPECT_FALSE(run_error_category().message(0).empty());
+}
+
+TEST(RunCommandTest, Description_For_Unknown_Command_Error_Code_Differs_From_Known_Error_Codes_Descriptions)
+{
+    EXPECT_NE(run_error_category().message(static_cast<int>(RunErrc::Spec_Violated)),
+              run_error_category().message(0));
+    EXPECT_NE(run_error_category().message(static_cast<int>(RunErrc::Protobuf_Parsing_Failed)),
+              run_error_category().message(0));
+    EXPECT_NE(run_error_category().message(static_cast<int>(RunErrc::File_Operation_Failed)),
+              run_error_category().message(0));
+    EXPECT_NE(run_error_category().message(static_cast<int>(RunErrc::Invalid_Argument)),
+              run_error_category().message(0));
+}
+
+TEST(RunCommandTest, Error_Codes_Are_Mapped_To_Appropriate_Error_Conditions)
+{
+    EXPECT_EQ(std::error_code(RunErrc::Spec_Violated), CommandError::Spec_Violated);
+    EXPECT_EQ(std::error_code(RunErrc::Protobuf_Parsing_Failed), CommandError::Protobuf_Parsing_Failed);
+    EXPECT_EQ(std::error_code(RunErrc::File_Operation_Failed), CommandError::File_Operation_Failed);
+    EXPECT_EQ(std::error_code(RunErrc::Invalid_Argument), CommandError::Invalid_Argument);
+}
+
+TEST(RunCommandTest, Help_Is_Defined_For_The_Command)
+{
+    HelpCommand helpCmd({CommandId::Run});
+    std::ostringstream out, err;
+
+    EXPECT_NO_THROW(helpCmd.execute(&out, &err));
+    EXPECT_TRUE(IsHelpMessage(out.str(), CommandId::Run));
+    EXPECT_TRUE(err.str().empty());
+}
+
+TEST(RunCommandTest, Command_Succeeds_If_All_Commands_Succeed)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateTestProject(tmp);
+
+    RunArgs args({CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT),
+                  GenDocArgs(GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT)});
+
+    EXPECT_NO_THROW(RunCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_NE(out.str().find("check: 0\n"), std::string::npos);
+    EXPECT_NE(out.str().find("gendoc: 0\n"), std::string::npos);
+    EXPECT_TRUE(std::filesystem::is_regular_file(std::string("out/") + Json_Doc_File));
+}
+
+TEST(RunCommandTest, Each_Command_Filters_Errors_By_Its_Own_Ignored_Categories)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateMinimalProject(tmp);
+    WriteUndocumentedStruct(tmp);
+
+    RunArgs args({CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, true),
+                  CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, true, false, true),
+                  GenDocArgs(GenDocFormat::Json, "tmp", "out", BUSRPC_TESTS_PROTOBUF_ROOT)});
+
+    EXPECT_COMMAND_EXCEPTION(RunCommand(args).execute(&out, &err), RunErrc::Spec_Violated);
+    EXPECT_FALSE(err.str().empty());
+
+    auto output = SplitString(out.str());
+    auto docRuleViolated = std::to_string(static_cast<int>(CheckErrc::Doc_Rule_Violated));
+
+    ASSERT_GE(output.size(), 3);
+    EXPECT_EQ(output[output.size() - 3].find("check: " + docRuleViolated), 0);
+    EXPECT_EQ(output[output.size() - 2], "check: 0");
+    EXPECT_EQ(output[output.size() - 1], "gendoc: 0");
+    EXPECT_TRUE(std::filesystem::is_regular_file(std::string("out/") + Json_Doc_File));
+}
+
+TEST(RunCommandTest, Command_Returns_Most_Severe_Error_Of_Executed_Commands)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+    WriteUndocumentedStruct(tmp);
+
+    RunArgs args({CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, true),
+                  CheckArgs("missing_project_dir", BUSRPC_TESTS_PROTOBUF_ROOT)});
+
+    EXPECT_COMMAND_EXCEPTION(RunCommand(args).execute(&out, &err), RunErrc::Invalid_Argument);
+    EXPECT_NE(out.str().find("check: " + std::to_string(static_cast<int>(CheckErrc::Invalid_Project_Dir))),
+              std::string::npos);
+}
+
+TEST(RunCommandTest, Command_Saves_Check_Cache)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateTestProject(tmp);
+
+    RunArgs args({CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT, false, false, false, false, "tmp/cache.json"),
+                  CheckArgs("tmp", BUSRPC_TESTS_PROTOBUF_ROOT)});
+
+    EXPECT_NO_THROW(RunCommand(args).execute(&out, &err));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_TRUE(std::filesystem::is_regular_file("tmp/cache.json"));
+}
+
+TEST(RunCommandTest, App_Runs_Command_If_Command_Name_Is_Specified_As_Subcommand)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    TmpDir outputDir("out");
+    CreateMinimalProject(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    std::string checkCommand = std::string("check -r tmp -p ") + BUSRPC_TESTS_PROTOBUF_ROOT + " -w";
+    std::string genDocCommand = std::string("gendoc -r tmp -p ") + BUSRPC_TESTS_PROTOBUF_ROOT + " -d out";
+
+    int argc = 4;
+    const char* argv[] = {"busrpc", GetCommandName(CommandId::Run), checkCommand.c_str(), genDocCommand.c_str()};
+
+    EXPECT_NO_THROW(app.parse(argc, argv));
+    EXPECT_TRUE(err.str().empty());
+    EXPECT_NE(out.str().find("check: 0\n"), std::string::npos);
+    EXPECT_NE(out.str().find("gendoc: 0\n"), std::string::npos);
+    EXPECT_TRUE(std::filesystem::is_regular_file(std::string("out/") + Json_Doc_File));
+}
+
+TEST(RunCommandTest, App_Fails_If_Command_Can_Not_Be_Run_In_Batch)
+{
+    std::ostringstream out, err;
+    TmpDir tmp;
+    CreateMinimalProject(tmp);
+
+    CLI::App app;
+    InitApp(app, out, err);
+
+    int argc = 3;
+    const char* argv[] = {"busrpc", GetCommandName(CommandId::Run), "imports -r tmp busrpc.proto"};
+
+    EXPECT_THROW(app.parse(argc, argv), CLI::ParseError);
+}
+}} // namespace busrpc::test
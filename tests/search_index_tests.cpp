@@ -0,0 +1,110 @@
+#include "entities/project.h"
+#include "generators/search_index.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace busrpc { namespace test {
+
+using Strings = std::vector<std::string>;
+
+TEST(SearchIndexTest, Text_Is_Split_To_Lower_Case_Words_And_Camel_Case_Parts)
+{
+    EXPECT_EQ(SearchIndex::Tokenize(""), Strings{});
+    EXPECT_EQ(SearchIndex::Tokenize("busrpc.api.my_namespace"), (Strings{"busrpc", "api", "my", "namespace"}));
+    EXPECT_EQ(SearchIndex::Tokenize("  Brief, text. "), (Strings{"brief", "text"}));
+    EXPECT_EQ(SearchIndex::Tokenize("MyHTTPServer2"), (Strings{"myhttpserver2", "my", "http", "server2"}));
+    EXPECT_EQ(SearchIndex::Tokenize("\xD0\xAF\xD0\xAF-x"), (Strings{"\xD0\xAF\xD0\xAF", "x"}));
+}
+
+TEST(SearchIndexTest, Entities_Are_Found_By_Token_Prefix)
+{
+    Project project;
+    project.addStruct("FirstStruct", "file.proto", StructFlags::None, EntityDocs(Strings{"Brief.", "Hidden gem."}));
+    project.addStruct("Second", "file.proto", StructFlags::None, EntityDocs("Another brief."));
+    SearchIndex index;
+
+    for (const auto& structure: project.structs()) {
+        index.add(*structure);
+    }
+
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(index.find("struct"), Strings{"busrpc.FirstStruct"});
+    EXPECT_EQ(index.find("GE"), Strings{"busrpc.FirstStruct"});
+    EXPECT_EQ(index.find("bri"), (Strings{"busrpc.FirstStruct", "busrpc.Second"}));
+    EXPECT_EQ(index.find("busrpc"), (Strings{"busrpc.FirstStruct", "busrpc.Second"}));
+    EXPECT_EQ(index.find("another"), Strings{"busrpc.Second"});
+    EXPECT_TRUE(index.find("unknown").empty());
+}
+
+TEST(SearchIndexTest, Merged_Index_Contains_Entities_Of_Both_Indices)
+{
+    Project project;
+    project.addStruct("First", "file.proto", StructFlags::None, EntityDocs("Common brief."));
+    project.addStruct("Second", "file.proto", StructFlags::None, EntityDocs("Common brief."));
+    SearchIndex index;
+    SearchIndex other;
+
+    index.add(**project.structs().begin());
+    other.add(**project.structs().rbegin());
+    index.merge(std::move(other));
+
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(other.size(), 0);
+    EXPECT_EQ(index.find("common"), (Strings{"busrpc.First", "busrpc.Second"}));
+    EXPECT_EQ(index.find("second"), Strings{"busrpc.Second"});
+}
+
+TEST(SearchIndexTest, Written_Index_Does_Not_Depend_On_Order_Of_Added_Entities)
+{
+    Project project;
+    project.addStruct("First", "file.proto", StructFlags::None, EntityDocs("Common brief."));
+    project.addStruct("Second", "file.proto", StructFlags::None, EntityDocs("Another brief."));
+    SearchIndex index;
+    SearchIndex reversedIndex;
+    std::ostringstream out;
+    std::ostringstream reversedOut;
+
+    index.add(**project.structs().begin());
+    index.add(**project.structs().rbegin());
+    reversedIndex.add(**project.structs().rbegin());
+    reversedIndex.add(**project.structs().begin());
+    index.write(out);
+    reversedIndex.write(reversedOut);
+
+    EXPECT_EQ(out.str(), reversedOut.str());
+}
+
+TEST(SearchIndexTest, Written_Index_Maps_Sorted_Tokens_To_Entity_Ids)
+{
+    Project project;
+    project.addStruct("Second", "file.proto", StructFlags::None, EntityDocs("Another brief."));
+    project.addStruct("First", "file.proto", StructFlags::None, EntityDocs("Common brief."));
+    SearchIndex index;
+    std::ostringstream out;
+
+    for (const auto& structure: project.structs()) {
+        index.add(*structure);
+    }
+
+    out << std::setw(2);
+    index.write(out);
+
+    EXPECT_EQ(out.width(), 0);
+
+    auto doc = json::parse(out.str());
+
+    EXPECT_EQ(doc["schema"], Search_Index_Schema);
+    EXPECT_EQ(doc["version"], Search_Index_Schema_Version);
+    EXPECT_EQ(doc["entities"], json({"busrpc.First", "busrpc.Second"}));
+    EXPECT_EQ(doc["tokens"], json({"another", "brief", "busrpc", "common", "first", "second"}));
+    EXPECT_EQ(doc["postings"], json({{1}, {0, 1}, {0, 1}, {0}, {0}, {1}}));
+}
+}} // namespace busrpc::test
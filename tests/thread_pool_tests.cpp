@@ -0,0 +1,120 @@
+#include "thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace busrpc { namespace test {
+
+TEST(ThreadPoolTest, Pool_Is_Created_With_Specified_Number_Of_Threads)
+{
+    EXPECT_EQ(ThreadPool(0).threadCount(), 0);
+    EXPECT_EQ(ThreadPool(3).threadCount(), 3);
+}
+
+TEST(ThreadPoolTest, Submitted_Tasks_Are_Executed_Before_Pool_Is_Destroyed)
+{
+    std::atomic<int> executed = 0;
+
+    {
+        ThreadPool pool(2);
+
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&executed]() { ++executed; });
+        }
+    }
+
+    EXPECT_EQ(executed, 100);
+}
+
+TEST(ThreadPoolTest, Submitted_Task_Is_Executed_By_Calling_Thread_If_Pool_Does_Not_Have_Threads)
+{
+    ThreadPool pool(0);
+    std::thread::id executorId;
+
+    pool.submit([&executorId]() { executorId = std::this_thread::get_id(); });
+
+    EXPECT_EQ(executorId, std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, parallelFor_Invokes_Function_Once_For_Each_Index)
+{
+    ThreadPool pool(3);
+    std::vector<int> counters(1000, 0);
+
+    pool.parallelFor(counters.size(), 4, [&counters](std::size_t i) { ++counters[i]; });
+
+    EXPECT_EQ(counters, std::vector<int>(1000, 1));
+}
+
+TEST(ThreadPoolTest, parallelFor_Does_Not_Use_More_Threads_Than_Specified)
+{
+    ThreadPool pool(3);
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+
+    pool.parallelFor(1000, 2, [&](std::size_t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threadIds.insert(std::this_thread::get_id());
+    });
+
+    EXPECT_LE(threadIds.size(), 2);
+
+    threadIds.clear();
+    pool.parallelFor(1000, 1, [&](std::size_t) { threadIds.insert(std::this_thread::get_id()); });
+
+    EXPECT_EQ(threadIds, std::set<std::thread::id>({std::this_thread::get_id()}));
+}
+
+TEST(ThreadPoolTest, parallelFor_Processes_All_Indices_And_Rethrows_Exception)
+{
+    ThreadPool pool(3);
+    std::atomic<int> processed = 0;
+
+    EXPECT_THROW(pool.parallelFor(100,
+                                  4,
+                                  [&processed](std::size_t i) {
+                                      ++processed;
+
+                                      if (i % 10 == 0) {
+                                          throw std::runtime_error("error");
+                                      }
+                                  }),
+                 std::runtime_error);
+    EXPECT_EQ(processed, 100);
+}
+
+TEST(ThreadPoolTest, parallelFor_Does_Not_Deadlock_When_Called_From_Pool_Tasks)
+{
+    ThreadPool pool(2);
+    std::atomic<int> processed = 0;
+
+    pool.parallelFor(8, 3, [&pool, &processed](std::size_t) {
+        pool.parallelFor(8, 3, [&processed](std::size_t) { ++processed; });
+    });
+
+    EXPECT_EQ(processed, 64);
+}
+
+TEST(ThreadPoolTest, parallelFor_Does_Nothing_For_Zero_Count)
+{
+    ThreadPool pool(2);
+    bool isInvoked = false;
+
+    pool.parallelFor(0, 3, [&isInvoked](std::size_t) { isInvoked = true; });
+
+    EXPECT_FALSE(isInvoked);
+}
+
+TEST(ThreadPoolTest, Shared_Pool_Is_The_Same_For_All_Calls)
+{
+    EXPECT_EQ(&ThreadPool::Shared(), &ThreadPool::Shared());
+    EXPECT_EQ(ThreadPool::Shared().threadCount() + 1, std::max(std::thread::hardware_concurrency(), 1u));
+}
+}} // namespace busrpc::test
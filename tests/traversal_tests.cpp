@@ -0,0 +1,175 @@
+#include "entities/traversal.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace busrpc { namespace test {
+
+class TraversalTest: public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        api_ = project_.addApi();
+        auto ns = api_->addNamespace("namespace");
+        auto cls = ns->addClass("class");
+        auto structure = cls->addStruct("Struct", "file.proto");
+        structure->addScalarField("field", 1, FieldTypeId::Int32);
+        structure->addEnum("Enum")->addConstant("CONSTANT", 0);
+        cls->addMethod("method");
+        implementation_ = project_.addImplementation();
+        implementation_->addService("service");
+    }
+
+    static std::vector<std::string> GetDnames(const Entity& root)
+    {
+        std::vector<std::string> result;
+
+        for (const Entity* entity: EntitySubtree(root)) {
+            result.push_back(entity->dname());
+        }
+
+        return result;
+    }
+
+    Project project_;
+    Api* api_ = nullptr;
+    Implementation* implementation_ = nullptr;
+};
+
+TEST_F(TraversalTest, IsCompositeEntityType_Returns_False_Only_For_Entities_Without_Nested_Entities)
+{
+    EXPECT_TRUE(IsCompositeEntityType(EntityTypeId::Project));
+    EXPECT_TRUE(IsCompositeEntityType(EntityTypeId::Namespace));
+    EXPECT_TRUE(IsCompositeEntityType(EntityTypeId::Struct));
+    EXPECT_TRUE(IsCompositeEntityType(EntityTypeId::Enum));
+    EXPECT_TRUE(IsCompositeEntityType(EntityTypeId::Service));
+    EXPECT_FALSE(IsCompositeEntityType(EntityTypeId::Field));
+    EXPECT_FALSE(IsCompositeEntityType(EntityTypeId::Constant));
+}
+
+TEST_F(TraversalTest, Entity_Subtree_Is_Traversed_In_Depth_First_Order)
+{
+    std::vector<std::string> expected = {"busrpc",
+                                         "busrpc.api",
+                                         "busrpc.api.namespace",
+                                         "busrpc.api.namespace.class",
+                                         "busrpc.api.namespace.class.Struct",
+                                         "busrpc.api.namespace.class.Struct.Enum",
+                                         "busrpc.api.namespace.class.Struct.Enum.CONSTANT",
+                                         "busrpc.api.namespace.class.Struct.field",
+                                         "busrpc.api.namespace.class.method",
+                                         "busrpc.implementation",
+                                         "busrpc.implementation.service"};
+
+    EXPECT_EQ(GetDnames(project_), expected);
+}
+
+TEST_F(TraversalTest, Entity_Subtree_Of_Simple_Entity_Contains_Only_Root)
+{
+    auto field = project_.find("busrpc.api.namespace.class.Struct.field");
+
+    ASSERT_TRUE(field);
+    EXPECT_EQ(GetDnames(*field), std::vector<std::string>({field->dname()}));
+}
+
+TEST_F(TraversalTest, Entity_Iterator_Returns_Depth_Relative_To_Subtree_Root)
+{
+    std::map<std::string, std::size_t> depths;
+
+    for (auto it = EntityIterator(project_.api()); it != EntityIterator(); ++it) {
+        depths[(*it)->name()] = it.depth();
+    }
+
+    EXPECT_EQ(depths["api"], 0);
+    EXPECT_EQ(depths["namespace"], 1);
+    EXPECT_EQ(depths["method"], 3);
+    EXPECT_EQ(depths["CONSTANT"], 5);
+}
+
+TEST_F(TraversalTest, Entity_Iterator_Does_Not_Visit_Nested_Entities_If_They_Are_Skipped)
+{
+    std::vector<std::string> names;
+
+    for (auto it = EntityIterator(&project_); it != EntityIterator(); ++it) {
+        names.push_back((*it)->name());
+
+        if ((*it)->type() == EntityTypeId::Class || (*it)->type() == EntityTypeId::Field) {
+            it.skipNested();
+        }
+    }
+
+    EXPECT_EQ(names, std::vector<std::string>({"busrpc", "api", "namespace", "class", "implementation", "service"}));
+}
+
+TEST_F(TraversalTest, Entity_Iterator_Does_Not_Overflow_Stack_For_Deeply_Nested_Entities)
+{
+    Struct* structure = api_->addStruct("Deep", "file.proto");
+
+    for (int i = 0; i < 2000; ++i) {
+        structure = structure->addStruct("Nested");
+    }
+
+    std::size_t maxDepth = 0;
+
+    for (auto it = EntityIterator(project_.api()); it != EntityIterator(); ++it) {
+        maxDepth = std::max(maxDepth, it.depth());
+    }
+
+    EXPECT_EQ(maxDepth, 2001);
+}
+
+TEST_F(TraversalTest, VisitEntity_Invokes_Visitor_For_Concrete_Entity_Type)
+{
+    struct Visitor {
+        void operator()(const Struct& structure) { names.push_back("struct " + structure.name()); }
+        void operator()(const Field& field) { names.push_back("field " + field.name()); }
+
+        std::vector<std::string> names;
+    } visitor;
+
+    ForEachEntity(project_, visitor);
+
+    EXPECT_EQ(visitor.names, std::vector<std::string>({"struct Struct", "field field"}));
+}
+
+TEST_F(TraversalTest, VisitEntity_Invokes_Generic_Visitor_For_Any_Entity)
+{
+    std::size_t count = 0;
+
+    ForEachEntity(project_, [&count](const Entity&) { ++count; });
+
+    EXPECT_EQ(count, GetDnames(project_).size());
+}
+
+TEST_F(TraversalTest, GetIndependentSubtrees_Returns_Namespaces_And_Services)
+{
+    auto subtrees = GetIndependentSubtrees(project_);
+
+    ASSERT_EQ(subtrees.size(), 2);
+    EXPECT_EQ(subtrees[0]->dname(), "busrpc.api.namespace");
+    EXPECT_EQ(subtrees[1]->dname(), "busrpc.implementation.service");
+    EXPECT_TRUE(GetIndependentSubtrees(Project()).empty());
+}
+
+TEST_F(TraversalTest, ParallelForEach_Invokes_Function_For_Each_Subtree_Root)
+{
+    api_->addNamespace("namespace2");
+    implementation_->addService("service2");
+    auto subtrees = GetIndependentSubtrees(project_);
+    std::atomic<std::size_t> total = 0;
+
+    ParallelForEach(subtrees, 4, [&](const Entity& root) {
+        for (const Entity* entity: EntitySubtree(root)) {
+            (void)entity;
+            ++total;
+        }
+    });
+
+    EXPECT_EQ(total, GetDnames(project_).size() - 3);
+}
+}} // namespace busrpc::test
@@ -474,14 +474,28 @@ std::string GetServiceDescriptor()
            "}\n";
 }
 
-void CreateMinimalProject(TmpDir& projectDir)
+namespace {
+
+// Adapter, which allows to use the same code to create project on disk and in memory
+struct MemoryProjectDir {
+    void writeFile(const std::filesystem::path& file, const std::string& content = {})
+    {
+        source.addFile(file, content);
+    }
+
+    MemoryProjectSource& source;
+};
+
+template<typename TProjectDir>
+void CreateMinimalProjectImpl(TProjectDir& projectDir)
 {
     projectDir.writeFile("busrpc.proto", GetMainFile());
 }
 
-void CreateTestProject(TmpDir& projectDir)
+template<typename TProjectDir>
+void CreateTestProjectImpl(TProjectDir& projectDir)
 {
-    CreateMinimalProject(projectDir);
+    CreateMinimalProjectImpl(projectDir);
     projectDir.writeFile("project_types.proto", GetFileHeader("busrpc") + GetTestEnum() + GetTestStruct());
 
     projectDir.writeFile("api/api_types.proto", GetFileHeader("busrpc.api") + GetTestEnum() + GetTestStruct());
@@ -541,4 +555,27 @@ void CreateTestProject(TmpDir& projectDir)
     projectDir.writeFile("implementation/service/service_types.proto",
                          GetFileHeader("busrpc.implementation.service") + GetTestEnum() + GetTestStruct());
 }
+} // namespace
+
+void CreateMinimalProject(TmpDir& projectDir)
+{
+    CreateMinimalProjectImpl(projectDir);
+}
+
+void CreateMinimalProject(MemoryProjectSource& source)
+{
+    MemoryProjectDir projectDir{source};
+    CreateMinimalProjectImpl(projectDir);
+}
+
+void CreateTestProject(TmpDir& projectDir)
+{
+    CreateTestProjectImpl(projectDir);
+}
+
+void CreateTestProject(MemoryProjectSource& source)
+{
+    MemoryProjectDir projectDir{source};
+    CreateTestProjectImpl(projectDir);
+}
 }} // namespace busrpc::test
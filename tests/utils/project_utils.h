@@ -1,6 +1,7 @@
 #pragma once
 
 #include "entities/project.h"
+#include "parser/project_source.h"
 #include "utils/file_utils.h"
 
 #include <memory>
@@ -98,5 +99,7 @@ std::string GetOnewayStaticMethodDescriptor();
 std::string GetServiceDescriptor();
 
 void CreateMinimalProject(TmpDir& projectDir);
+void CreateMinimalProject(MemoryProjectSource& source);
 void CreateTestProject(TmpDir& projectDir);
+void CreateTestProject(MemoryProjectSource& source);
 }} // namespace busrpc::test
\ No newline at end of file
@@ -334,4 +334,24 @@ TEST(UtilsTest, InitRelativePathToExistingFile_Returns_Relative_Path_Without_Lea
     EXPECT_TRUE(path.is_relative());
     EXPECT_EQ(path, "tmp/subdir/file2.txt");
 }
+
+TEST(UtilsTest, StableHash_Does_Not_Depend_On_Platform)
+{
+    EXPECT_EQ(StableHash().value(), 14695981039346656037ULL);
+    EXPECT_EQ(StableHash().update("test").value(), StableHash().update("test").value());
+    EXPECT_EQ(HashToString(StableHash().update("").value()), "a8c7f832281a39c5");
+}
+
+TEST(UtilsTest, StableHash_Differs_For_Different_Sequences_With_Same_Concatenation)
+{
+    EXPECT_NE(StableHash().update("ab").update("c").value(), StableHash().update("a").update("bc").value());
+    EXPECT_NE(StableHash().update("test").value(), StableHash().update(1001).value());
+}
+
+TEST(UtilsTest, HashToString_Pads_Hash_With_Zeroes)
+{
+    EXPECT_EQ(HashToString(0), "0000000000000000");
+    EXPECT_EQ(HashToString(0x1001), "0000000000001001");
+    EXPECT_EQ(HashToString(0xffffffffffffffff), "ffffffffffffffff");
+}
 }} // namespace busrpc::test